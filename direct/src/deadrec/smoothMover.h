@@ -69,6 +69,14 @@ PUBLISHED:
   INLINE bool set_pos_hpr(const LVecBase3f &pos, const LVecBase3f &hpr);
   INLINE bool set_pos_hpr(float x, float y, float z, float h, float p, float r);
 
+  // These methods are used to decode a position update expressed as a
+  // change from the previous update, rather than as an absolute
+  // value.
+  INLINE bool add_x(float dx);
+  INLINE bool add_y(float dy);
+  INLINE bool add_z(float dz);
+  INLINE bool add_h(float dh);
+
   INLINE const LPoint3f &get_sample_pos() const;
   INLINE const LVecBase3f &get_sample_hpr() const;
 
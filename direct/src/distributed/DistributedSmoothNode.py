@@ -275,6 +275,32 @@ class DistributedSmoothNode(DistributedNode.DistributedNode,
         self.setComponentR(r)
         self.setComponentTLive(timestamp)
 
+    # These are the delta-encoded variants sent when the broadcaster
+    # has delta broadcasts enabled; each component is relative to the
+    # previous update.
+    def setSmDeltaH(self, dh, timestamp=None):
+        self._checkResume(timestamp)
+        self.setComponentDH(dh)
+        self.setComponentTLive(timestamp)
+    def setSmDeltaXY(self, dx, dy, timestamp=None):
+        self._checkResume(timestamp)
+        self.setComponentDX(dx)
+        self.setComponentDY(dy)
+        self.setComponentTLive(timestamp)
+    def setSmDeltaXYH(self, dx, dy, dh, timestamp=None):
+        self._checkResume(timestamp)
+        self.setComponentDX(dx)
+        self.setComponentDY(dy)
+        self.setComponentDH(dh)
+        self.setComponentTLive(timestamp)
+    def setSmDeltaXYZH(self, dx, dy, dz, dh, timestamp=None):
+        self._checkResume(timestamp)
+        self.setComponentDX(dx)
+        self.setComponentDY(dy)
+        self.setComponentDZ(dz)
+        self.setComponentDH(dh)
+        self.setComponentTLive(timestamp)
+
     ### component set pos and hpr functions ###
 
     ### These are the component functions that are invoked
@@ -299,6 +325,18 @@ class DistributedSmoothNode(DistributedNode.DistributedNode,
     def setComponentR(self, r):
         self.smoother.setR(r)
     @report(types = ['args'], dConfigParam = 'smoothnode')
+    def setComponentDX(self, dx):
+        self.smoother.addX(dx)
+    @report(types = ['args'], dConfigParam = 'smoothnode')
+    def setComponentDY(self, dy):
+        self.smoother.addY(dy)
+    @report(types = ['args'], dConfigParam = 'smoothnode')
+    def setComponentDZ(self, dz):
+        self.smoother.addZ(dz)
+    @report(types = ['args'], dConfigParam = 'smoothnode')
+    def setComponentDH(self, dh):
+        self.smoother.addH(dh)
+    @report(types = ['args'], dConfigParam = 'smoothnode')
     def setComponentL(self, l):
         if (l != self.zoneId):
             # only perform set location if location is different
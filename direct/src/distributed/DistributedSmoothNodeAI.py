@@ -63,6 +63,22 @@ class DistributedSmoothNodeAI(DistributedNodeAI.DistributedNodeAI,
     def setSmPosHprL(self, l, x, y, z, h, p, r, t=None):
         self.setPosHpr(x, y, z, h, p, r)
 
+    def setSmDeltaH(self, dh, t=None):
+        self.setH(self.getH() + dh)
+
+    def setSmDeltaXY(self, dx, dy, t=None):
+        self.setX(self.getX() + dx)
+        self.setY(self.getY() + dy)
+
+    def setSmDeltaXYH(self, dx, dy, dh, t=None):
+        self.setX(self.getX() + dx)
+        self.setY(self.getY() + dy)
+        self.setH(self.getH() + dh)
+
+    def setSmDeltaXYZH(self, dx, dy, dz, dh, t=None):
+        self.setPos(self.getX() + dx, self.getY() + dy, self.getZ() + dz)
+        self.setH(self.getH() + dh)
+
     def clearSmoothing(self, bogus = None):
         pass
 
@@ -84,6 +100,14 @@ class DistributedSmoothNodeAI(DistributedNodeAI.DistributedNodeAI,
         pass
     def setComponentT(self, t):
         pass
+    def setComponentDX(self, dx):
+        self.setX(self.getX() + dx)
+    def setComponentDY(self, dy):
+        self.setY(self.getY() + dy)
+    def setComponentDZ(self, dz):
+        self.setZ(self.getZ() + dz)
+    def setComponentDH(self, dh):
+        self.setH(self.getH() + dh)
 
     def getComponentX(self):
         return self.getX()
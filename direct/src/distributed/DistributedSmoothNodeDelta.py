@@ -0,0 +1,12 @@
+"""DistributedSmoothNodeDelta module: contains the DistributedSmoothNodeDelta class"""
+
+import DistributedSmoothNode
+
+class DistributedSmoothNodeDelta(DistributedSmoothNode.DistributedSmoothNode):
+    """
+    A DistributedSmoothNode whose dclass, defined in
+    smoothNodeDelta.dc, includes the delta-encoded position fields.
+    The handlers for those fields are inherited from
+    DistributedSmoothNode.
+    """
+    pass
@@ -0,0 +1,9 @@
+import DistributedSmoothNodeAI
+
+class DistributedSmoothNodeDeltaAI(DistributedSmoothNodeAI.DistributedSmoothNodeAI):
+    """
+    The AI side of DistributedSmoothNodeDelta.  The handlers for the
+    delta-encoded position fields are inherited from
+    DistributedSmoothNodeAI.
+    """
+    pass
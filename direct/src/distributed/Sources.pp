@@ -23,3 +23,23 @@
 
   #define IGATESCAN all
 #end lib_target
+
+#begin test_bin_target
+  #define BUILD_TARGET $[HAVE_PYTHON]
+  #define USE_PACKAGES openssl native_net net python
+
+  #define TARGET test_smooth_delta
+  #define LOCAL_LIBS \
+    distributed directbase dcparser
+  #define OTHER_LIBS \
+    pgraph:c event:c downloader:c panda:m express:c pandaexpress:m \
+    interrogatedb:c dconfig:c dtoolconfig:m \
+    dtoolutil:c dtoolbase:c dtool:m \
+    prc:c pstatclient:c pandabase:c linmath:c putil:c \
+    pipeline:c $[if $[HAVE_NET],net:c] $[if $[WANT_NATIVE_NET],nativenet:c] \
+    pystub
+
+  #define SOURCES \
+    test_smooth_delta.cxx
+
+#end test_bin_target
@@ -30,6 +30,9 @@ CHANNEL_TYPE CDistributedSmoothNodeBase::_ai_id;
 PyObject *CDistributedSmoothNodeBase::_clock_delta = NULL;
 #endif
 
+int CDistributedSmoothNodeBase::_num_messages_sent = 0;
+int CDistributedSmoothNodeBase::_num_bytes_sent = 0;
+
 ////////////////////////////////////////////////////////////////////
 //     Function: CDistributedSmoothNodeBase::Constructor
 //       Access: Published
@@ -39,6 +42,9 @@ CDistributedSmoothNodeBase::
 CDistributedSmoothNodeBase() {
   _currL[0] = 0;
   _currL[1] = 0;
+  _delta_broadcast = smooth_node_delta_broadcast;
+  _has_delta_fields = false;
+  _deltas_since_keyframe = 0;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -70,6 +76,19 @@ initialize(const NodePath &node_path, DCClass *dclass, CHANNEL_TYPE do_id) {
   _store_xyz = _node_path.get_pos();
   _store_hpr = _node_path.get_hpr();
   _store_stop = false;
+
+  _sent_xyz = _store_xyz;
+  _sent_hpr = _store_hpr;
+  _deltas_since_keyframe = 0;
+
+  // The delta fields are only defined for dclasses derived from
+  // DistributedSmoothNodeDelta, in smoothNodeDelta.dc; for any other
+  // dclass we quietly send absolute updates only.
+  _has_delta_fields = 
+    (_dclass->get_field_by_name("setSmDeltaH") != (DCField *)NULL &&
+     _dclass->get_field_by_name("setSmDeltaXY") != (DCField *)NULL &&
+     _dclass->get_field_by_name("setSmDeltaXYH") != (DCField *)NULL &&
+     _dclass->get_field_by_name("setSmDeltaXYZH") != (DCField *)NULL);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -140,10 +159,19 @@ broadcast_pos_hpr_full() {
   } else if (flags == 0) {
     // No change.  Send one and only one "stop" message.
     if (!_store_stop) {
+      if (_deltas_since_keyframe != 0) {
+        // Make sure the ram fields reflect where we came to rest.
+        d_setSmPosHpr(_store_xyz[0], _store_xyz[1], _store_xyz[2], 
+                      _store_hpr[0], _store_hpr[1], _store_hpr[2]);
+      }
       _store_stop = true;
       d_setSmStop();
     }
 
+  } else if (send_delta(flags)) {
+    // Sent as a delta from the previous update.
+    _store_stop = false;
+
   } else if (only_changed(flags, F_new_h)) {
     // Only change in H.
     _store_stop = false;
@@ -223,10 +251,19 @@ broadcast_pos_hpr_xyh() {
   if (flags == 0) {
     // No change.  Send one and only one "stop" message.
     if (!_store_stop) {
+      if (_deltas_since_keyframe != 0) {
+        // Make sure the ram fields reflect where we came to rest.
+        d_setSmPosHpr(_store_xyz[0], _store_xyz[1], _store_xyz[2], 
+                      _store_hpr[0], _store_hpr[1], _store_hpr[2]);
+      }
       _store_stop = true;
       d_setSmStop();
     }
 
+  } else if (send_delta(flags)) {
+    // Sent as a delta from the previous update.
+    _store_stop = false;
+
   } else if (only_changed(flags, F_new_h)) {
     // Only change in H.
     _store_stop = false;
@@ -269,10 +306,19 @@ broadcast_pos_hpr_xy() {
   if (flags == 0) {
     // No change.  Send one and only one "stop" message.
     if (!_store_stop) {
+      if (_deltas_since_keyframe != 0) {
+        // Make sure the ram fields reflect where we came to rest.
+        d_setSmPosHpr(_store_xyz[0], _store_xyz[1], _store_xyz[2], 
+                      _store_hpr[0], _store_hpr[1], _store_hpr[2]);
+      }
       _store_stop = true;
       d_setSmStop();
     }
 
+  } else if (send_delta(flags)) {
+    // Sent as a delta from the previous update.
+    _store_stop = false;
+
   } else {
     // Any other change.
     _store_stop = false;
@@ -280,6 +326,92 @@ broadcast_pos_hpr_xy() {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: CDistributedSmoothNodeBase::send_delta
+//       Access: Private
+//  Description: Attempts to send the changed components indicated by
+//               flags as one of the setSmDelta* messages, which carry
+//               each component as a single byte relative to the
+//               position last sent.  Returns true if a message was
+//               sent, or false if delta broadcasts are disabled, a
+//               component changed by more than a delta can represent,
+//               or p or r changed; in this case the caller should
+//               send an absolute update instead.
+//
+//               Since the delta fields are not stored in ram, a
+//               complete setSmPosHpr is sent instead every
+//               smooth-node-delta-keyframe-interval updates, so that
+//               clients entering the zone see a recent position.
+////////////////////////////////////////////////////////////////////
+bool CDistributedSmoothNodeBase::
+send_delta(int flags) {
+  if (!_delta_broadcast || !_has_delta_fields ||
+      (flags & (F_new_p | F_new_r)) != 0) {
+    return false;
+  }
+
+  if (_deltas_since_keyframe >= smooth_node_delta_keyframe_interval) {
+    d_setSmPosHpr(_store_xyz[0], _store_xyz[1], _store_xyz[2], 
+                  _store_hpr[0], _store_hpr[1], _store_hpr[2]);
+    return true;
+  }
+
+  // Take the heading change the short way around the circle.
+  float delta_h = _store_hpr[0] - _sent_hpr[0];
+  delta_h -= 360.0f * cfloor((delta_h + 180.0f) / 360.0f);
+
+  int dx = quantize_delta(_store_xyz[0] - _sent_xyz[0]);
+  int dy = quantize_delta(_store_xyz[1] - _sent_xyz[1]);
+  int dz = quantize_delta(_store_xyz[2] - _sent_xyz[2]);
+  int dh = quantize_delta(delta_h);
+
+  bool send_x = true;
+  bool send_y = true;
+  bool send_z = false;
+  bool send_h = true;
+  if (only_changed(flags, F_new_h)) {
+    send_x = false;
+    send_y = false;
+  } else if (only_changed(flags, F_new_x | F_new_y)) {
+    send_h = false;
+  } else if (!only_changed(flags, F_new_x | F_new_y | F_new_h)) {
+    send_z = true;
+  }
+
+  if ((send_x && (dx < -127 || dx > 127)) ||
+      (send_y && (dy < -127 || dy > 127)) ||
+      (send_z && (dz < -127 || dz > 127)) ||
+      (send_h && (dh < -127 || dh > 127))) {
+    // Too far to express as a delta.
+    return false;
+  }
+
+  if (!send_x) {
+    d_setSmDeltaH(dh);
+  } else if (!send_h) {
+    d_setSmDeltaXY(dx, dy);
+  } else if (!send_z) {
+    d_setSmDeltaXYH(dx, dy, dh);
+  } else {
+    d_setSmDeltaXYZH(dx, dy, dz, dh);
+  }
+
+  // Accumulate the deltas exactly the way SmoothMover will on the
+  // receiving end.
+  if (send_x) {
+    _sent_xyz[0] += (float)(dx / 10.0);
+    _sent_xyz[1] += (float)(dy / 10.0);
+  }
+  if (send_z) {
+    _sent_xyz[2] += (float)(dz / 10.0);
+  }
+  if (send_h) {
+    _sent_hpr[0] += (float)(dh / 10.0);
+  }
+  ++_deltas_since_keyframe;
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: CDistributedSmoothNodeBase::begin_send_update
 //       Access: Private
@@ -340,6 +472,8 @@ finish_send_update(DCPacker &packer) {
   bool pack_ok = packer.end_pack();
   if (pack_ok) {
     Datagram dg(packer.get_data(), packer.get_length());
+    ++_num_messages_sent;
+    _num_bytes_sent += dg.get_length();
     _repository->send_datagram(dg);
 
   } else {
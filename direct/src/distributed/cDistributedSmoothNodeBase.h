@@ -57,8 +57,19 @@ PUBLISHED:
   void set_curr_l(PN_uint64 l);
   void print_curr_l();
 
+  INLINE void set_delta_broadcast(bool flag);
+  INLINE bool get_delta_broadcast() const;
+
+  INLINE static int get_num_messages_sent();
+  INLINE static int get_num_bytes_sent();
+  INLINE static void reset_sent_counts();
+
 private:
   INLINE static bool only_changed(int flags, int compare);
+  INLINE static float quantize(float value);
+  INLINE static int quantize_delta(float delta);
+
+  bool send_delta(int flags);
 
   INLINE void d_setSmStop();
   INLINE void d_setSmH(float h);
@@ -72,6 +83,11 @@ private:
   INLINE void d_setSmPosHpr(float x, float y, float z, float h, float p, float r);
   INLINE void d_setSmPosHprL(float x, float y, float z, float h, float p, float r, PN_uint64 l);
 
+  INLINE void d_setSmDeltaH(int dh);
+  INLINE void d_setSmDeltaXY(int dx, int dy);
+  INLINE void d_setSmDeltaXYH(int dx, int dy, int dh);
+  INLINE void d_setSmDeltaXYZH(int dx, int dy, int dz, int dh);
+
   void begin_send_update(DCPacker &packer, const string &field_name);
   void finish_send_update(DCPacker &packer);
 
@@ -101,6 +117,19 @@ private:
   // contains most recently sent location info as
   // index 0, index 1 contains most recently set location info
   PN_uint64 _currL[2];
+
+  // The pos/hpr as the receiving clients have reconstructed it from
+  // the messages sent so far.  Delta updates are computed relative to
+  // this, rather than to _store_xyz/_store_hpr, so that quantization
+  // error does not accumulate.
+  LPoint3f _sent_xyz;
+  LVecBase3f _sent_hpr;
+  bool _delta_broadcast;
+  bool _has_delta_fields;
+  int _deltas_since_keyframe;
+
+  static int _num_messages_sent;
+  static int _num_bytes_sent;
 };
 
 #include "cDistributedSmoothNodeBase.I"
@@ -47,6 +47,24 @@ ConfigVariableBool handle_datagrams_internally
           "for performance reasons.  When it is false, all datagrams "
           "are handled by the Python implementation."));
 
+ConfigVariableBool smooth_node_delta_broadcast
+("smooth-node-delta-broadcast", false,
+ PRC_DESC("Set this true to have CDistributedSmoothNodeBase send "
+          "position updates as small deltas from the previously sent "
+          "position, via the setSmDelta* fields, whenever the dclass "
+          "defines them and the change fits.  This reduces outbound "
+          "bandwidth for walking avatars.  The fields are defined by "
+          "DistributedSmoothNodeDelta in smoothNodeDelta.dc, which must "
+          "be loaded by both the client and the server."));
+
+ConfigVariableInt smooth_node_delta_keyframe_interval
+("smooth-node-delta-keyframe-interval", 10,
+ PRC_DESC("When smooth-node-delta-broadcast is in effect, this is the "
+          "maximum number of consecutive delta updates that will be sent "
+          "before a complete setSmPosHpr is sent again.  The complete "
+          "update refreshes the ram fields seen by clients that enter "
+          "the zone later."));
+
 ////////////////////////////////////////////////////////////////////
 //     Function: init_libdistributed
 //  Description: Initializes the library.  This must be called at
@@ -28,6 +28,8 @@ extern ConfigVariableInt game_server_timeout_ms;
 extern ConfigVariableDouble min_lag;
 extern ConfigVariableDouble max_lag;
 extern ConfigVariableBool handle_datagrams_internally;
+extern ConfigVariableBool smooth_node_delta_broadcast;
+extern ConfigVariableInt smooth_node_delta_keyframe_interval;
 
 extern EXPCL_DIRECT void init_libdistributed();
 
@@ -0,0 +1,200 @@
+// Filename: test_smooth_delta.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "cDistributedSmoothNodeBase.h"
+#include "cConnectionRepository.h"
+#include "dcFile.h"
+#include "dcClass.h"
+#include "pandaNode.h"
+#include "pvector.h"
+
+// This program compares the number of bytes sent by
+// CDistributedSmoothNodeBase::broadcast_pos_hpr_full() with and
+// without delta broadcasts, over one or more recorded walk paths.
+//
+// Usage: test_smooth_delta file.dc smoothNodeDelta.dc [path.txt ...]
+//
+// The first dc file should define DistributedSmoothNode, e.g. direct.dc.
+//
+// Each path file lists one sample per broadcast period, as six
+// numbers per line: x y z h p r.  Lines beginning with # are ignored.
+// If no path file is named, a synthetic walk is used instead.
+//
+// The messages are sent to an unconnected repository that is
+// bundling messages, so they are collected and thrown away rather
+// than sent anywhere.
+
+typedef pvector<LVecBase3f> Samples;
+
+class WalkPath {
+public:
+  string _name;
+  Samples _pos;
+  Samples _hpr;
+};
+
+static bool
+read_path(const string &filename, WalkPath &path) {
+  ifstream in(filename.c_str());
+  if (!in) {
+    nout << "Unable to read " << filename << "\n";
+    return false;
+  }
+  path._name = filename;
+
+  string line;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    istringstream strm(line);
+    float x, y, z, h, p, r;
+    if (strm >> x >> y >> z >> h >> p >> r) {
+      path._pos.push_back(LVecBase3f(x, y, z));
+      path._hpr.push_back(LVecBase3f(h, p, r));
+    }
+  }
+  return true;
+}
+
+static void
+make_synthetic_path(WalkPath &path) {
+  // An avatar walking at 16 feet per second, broadcasting five times
+  // per second, around the block with a pause at each corner.
+  path._name = "synthetic walk";
+  static const float speed = 16.0f * 0.2f;
+  LVecBase3f pos(0.0f, 0.0f, 0.0f);
+  float h = 0.0f;
+  for (int corner = 0; corner < 40; ++corner) {
+    LVector3f forward(-csin(deg_2_rad(h)), ccos(deg_2_rad(h)), 0.0f);
+    for (int step = 0; step < 50; ++step) {
+      pos += forward * speed;
+      // A gentle slope every other block.
+      if ((corner & 1) != 0) {
+        pos[2] += 0.05f;
+      }
+      path._pos.push_back(pos);
+      path._hpr.push_back(LVecBase3f(h, 0.0f, 0.0f));
+    }
+    for (int step = 0; step < 10; ++step) {
+      path._pos.push_back(pos);
+      path._hpr.push_back(LVecBase3f(h, 0.0f, 0.0f));
+    }
+    for (int step = 0; step < 5; ++step) {
+      h += 18.0f;
+      path._pos.push_back(pos);
+      path._hpr.push_back(LVecBase3f(h, 0.0f, 0.0f));
+    }
+  }
+}
+
+static void
+run_path(CConnectionRepository &repository, DCClass *dclass,
+         const WalkPath &path, bool delta,
+         int &num_messages, int &num_bytes) {
+  NodePath np("walker");
+  np.set_pos(path._pos[0]);
+  np.set_hpr(path._hpr[0]);
+
+  CDistributedSmoothNodeBase node;
+  node.initialize(np, dclass, 1000);
+  node.set_delta_broadcast(delta);
+
+  CDistributedSmoothNodeBase::reset_sent_counts();
+  repository.start_message_bundle();
+  node.send_everything();
+  for (size_t i = 1; i < path._pos.size(); ++i) {
+    np.set_pos(path._pos[i]);
+    np.set_hpr(path._hpr[i]);
+    node.broadcast_pos_hpr_full();
+  }
+  repository.abandon_message_bundles();
+
+  num_messages = CDistributedSmoothNodeBase::get_num_messages_sent();
+  num_bytes = CDistributedSmoothNodeBase::get_num_bytes_sent();
+}
+
+int
+main(int argc, char *argv[]) {
+  if (argc < 3) {
+    nout << "test_smooth_delta file.dc smoothNodeDelta.dc [path.txt ...]\n";
+    return 1;
+  }
+
+  DCFile dc_file;
+  if (!dc_file.read(Filename::from_os_specific(argv[1])) ||
+      !dc_file.read(Filename::from_os_specific(argv[2]))) {
+    return 1;
+  }
+  DCClass *dclass = dc_file.get_class_by_name("DistributedSmoothNodeDelta");
+  if (dclass == (DCClass *)NULL) {
+    nout << "The dc files do not define DistributedSmoothNodeDelta.\n";
+    return 1;
+  }
+
+  CConnectionRepository repository;
+  repository.set_want_message_bundling(true);
+  CDistributedSmoothNodeBase::set_repository(&repository, false, 0);
+
+#ifdef HAVE_PYTHON
+  // The timestamp on each message is computed from the ClockDelta
+  // object's delta attribute; we just need something that has one.
+  Py_Initialize();
+  PyObject *clock_delta = PyModule_New((char *)"ClockDelta");
+  PyObject *zero = PyFloat_FromDouble(0.0);
+  PyObject_SetAttrString(clock_delta, (char *)"delta", zero);
+  Py_DECREF(zero);
+  CDistributedSmoothNodeBase::set_clock_delta(clock_delta);
+#endif  // HAVE_PYTHON
+
+  pvector<WalkPath> paths;
+  for (int i = 3; i < argc; ++i) {
+    paths.push_back(WalkPath());
+    if (!read_path(argv[i], paths.back())) {
+      return 1;
+    }
+  }
+  if (paths.empty()) {
+    paths.push_back(WalkPath());
+    make_synthetic_path(paths.back());
+  }
+
+  int total_abs = 0;
+  int total_delta = 0;
+  pvector<WalkPath>::const_iterator pi;
+  for (pi = paths.begin(); pi != paths.end(); ++pi) {
+    const WalkPath &path = (*pi);
+    if (path._pos.empty()) {
+      continue;
+    }
+    int abs_messages, abs_bytes, delta_messages, delta_bytes;
+    run_path(repository, dclass, path, false, abs_messages, abs_bytes);
+    run_path(repository, dclass, path, true, delta_messages, delta_bytes);
+    total_abs += abs_bytes;
+    total_delta += delta_bytes;
+
+    nout << path._name << ": " << path._pos.size() << " samples\n"
+         << "  absolute: " << abs_messages << " messages, "
+         << abs_bytes << " bytes\n"
+         << "  delta:    " << delta_messages << " messages, "
+         << delta_bytes << " bytes\n";
+  }
+
+  if (total_abs != 0) {
+    nout << "Delta broadcasts sent " << total_delta << " of "
+         << total_abs << " bytes ("
+         << (100.0 * total_delta / total_abs) << "%).\n";
+  }
+  return 0;
+}
@@ -22,6 +22,7 @@
     cConstrainHprInterval.cxx cConstrainHprInterval.I cConstrainHprInterval.h \
     cConstrainPosHprInterval.cxx cConstrainPosHprInterval.I cConstrainPosHprInterval.h \
     cLerpInterval.cxx cLerpInterval.I cLerpInterval.h \
+    cLerpNodePathBatch.cxx cLerpNodePathBatch.I cLerpNodePathBatch.h \
     cLerpNodePathInterval.cxx cLerpNodePathInterval.I cLerpNodePathInterval.h \
     cLerpAnimEffectInterval.cxx cLerpAnimEffectInterval.I cLerpAnimEffectInterval.h \
     cMetaInterval.cxx cMetaInterval.I cMetaInterval.h \
@@ -40,6 +41,7 @@
     cConstrainHprInterval.I cConstrainHprInterval.h \
     cConstrainPosHprInterval.I cConstrainPosHprInterval.h \
     cLerpInterval.I cLerpInterval.h \
+    cLerpNodePathBatch.I cLerpNodePathBatch.h \
     cLerpNodePathInterval.I cLerpNodePathInterval.h \
     cLerpAnimEffectInterval.I cLerpAnimEffectInterval.h \
     cMetaInterval.I cMetaInterval.h \
@@ -50,3 +52,41 @@
 
   #define IGATESCAN all
 #end lib_target
+
+#begin test_bin_target
+  #define TARGET test_meta_interval
+  #define LOCAL_LIBS \
+    interval directbase
+  #define OTHER_LIBS \
+    downloader:c linmath:c lerp:c \
+    chan:c event:c gobj:c pnmimage:c mathutil:c \
+    pgraph:c putil:c panda:m express:c pandaexpress:m \
+    interrogatedb:c dconfig:c dtoolconfig:m \
+    dtoolutil:c dtoolbase:c dtool:m \
+    pandabase:c prc:c gsgbase:c pstatclient:c \
+    $[if $[HAVE_NET],net:c] $[if $[WANT_NATIVE_NET],nativenet:c] \
+    pipeline:c pystub
+
+  #define SOURCES \
+    test_meta_interval.cxx
+
+#end test_bin_target
+
+#begin test_bin_target
+  #define TARGET test_lerp_batch
+  #define LOCAL_LIBS \
+    interval directbase
+  #define OTHER_LIBS \
+    downloader:c linmath:c lerp:c \
+    chan:c event:c gobj:c pnmimage:c mathutil:c \
+    pgraph:c putil:c panda:m express:c pandaexpress:m \
+    interrogatedb:c dconfig:c dtoolconfig:m \
+    dtoolutil:c dtoolbase:c dtool:m \
+    pandabase:c prc:c gsgbase:c pstatclient:c \
+    $[if $[HAVE_NET],net:c] $[if $[WANT_NATIVE_NET],nativenet:c] \
+    pipeline:c pystub
+
+  #define SOURCES \
+    test_lerp_batch.cxx
+
+#end test_bin_target
@@ -14,6 +14,7 @@
 
 #include "cConstrainHprInterval.h"
 #include "config_interval.h"
+#include "cLerpNodePathBatch.h"
 #include "lvecBase3.h"
 
 TypeHandle CConstrainHprInterval::_type_handle;
@@ -56,6 +57,10 @@ priv_step(double t) {
   _curr_t = t;
 
   if(! _target.is_empty()) {
+    // Make sure we see (and aren't later overwritten by) any lerps
+    // stepped earlier in this frame.
+    CLerpNodePathBatch::flush_current();
+
     if(_wrt) {
       if(! _node.is_same_graph(_target)){
         interval_cat.warning()
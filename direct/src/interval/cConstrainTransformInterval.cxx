@@ -15,6 +15,7 @@
 #include "cConstrainTransformInterval.h"
 #include "transformState.h"
 #include "config_interval.h"
+#include "cLerpNodePathBatch.h"
 
 TypeHandle CConstrainTransformInterval::_type_handle;
 
@@ -55,6 +56,10 @@ priv_step(double t) {
   _curr_t = t;
 
   if(! _target.is_empty()) {
+    // Make sure we see (and aren't later overwritten by) any lerps
+    // stepped earlier in this frame.
+    CLerpNodePathBatch::flush_current();
+
     CPT(TransformState) transform;
     if(_wrt) {
       if(! _node.is_same_graph(_target)){
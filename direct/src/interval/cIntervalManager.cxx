@@ -14,6 +14,7 @@
 
 #include "cIntervalManager.h"
 #include "cMetaInterval.h"
+#include "config_interval.h"
 #include "dcast.h"
 #include "eventQueue.h"
 #include "mutexHolder.h"
@@ -30,6 +31,7 @@ CIntervalManager() {
   _first_slot = 0;
   _next_event_index = 0;
   _event_queue = EventQueue::get_global_event_queue();
+  _batch_lerps = interval_batch_lerps;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -288,6 +290,14 @@ void CIntervalManager::
 step() {
   MutexHolder holder(_lock);
 
+  // Each thread has its own current batch; if some other manager is
+  // already in the middle of its step() in this thread, its pending
+  // lerps are applied before ours begin.
+  bool batch_lerps = _batch_lerps;
+  if (batch_lerps) {
+    _lerp_batch.begin();
+  }
+
   NameIndex::iterator ni;
   ni = _name_index.begin();
   while (ni != _name_index.end()) {
@@ -309,6 +319,10 @@ step() {
     }
   }
 
+  if (batch_lerps) {
+    _lerp_batch.end();
+  }
+
   _next_event_index = 0;
 }
 
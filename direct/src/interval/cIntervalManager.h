@@ -17,6 +17,7 @@
 
 #include "directbase.h"
 #include "cInterval.h"
+#include "cLerpNodePathBatch.h"
 #include "pointerTo.h"
 #include "pvector.h"
 #include "pmap.h"
@@ -48,6 +49,9 @@ PUBLISHED:
   INLINE void set_event_queue(EventQueue *event_queue);
   INLINE EventQueue *get_event_queue() const;
 
+  INLINE void set_batch_lerps(bool batch_lerps);
+  INLINE bool get_batch_lerps() const;
+
   int add_c_interval(CInterval *interval, bool external);
   int find_c_interval(const string &name) const;
 
@@ -92,6 +96,9 @@ private:
   int _first_slot;
   int _next_event_index;
 
+  bool _batch_lerps;
+  CLerpNodePathBatch _lerp_batch;
+
   Mutex _lock;
 
   static CIntervalManager *_global_ptr;
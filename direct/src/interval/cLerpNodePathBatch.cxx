@@ -0,0 +1,301 @@
+// Filename: cLerpNodePathBatch.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "cLerpNodePathBatch.h"
+#include "config_interval.h"
+
+#if defined(THREAD_POSIX_IMPL)
+#include <pthread.h>
+
+// The current batch is kept separately for each thread.
+static pthread_key_t current_key;
+#define GET_CURRENT_BATCH() ((CLerpNodePathBatch *)pthread_getspecific(current_key))
+#define SET_CURRENT_BATCH(batch) pthread_setspecific(current_key, (batch))
+
+#elif defined(THREAD_WIN32_IMPL)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+static DWORD current_key = TLS_OUT_OF_INDEXES;
+#define GET_CURRENT_BATCH() ((CLerpNodePathBatch *)TlsGetValue(current_key))
+#define SET_CURRENT_BATCH(batch) TlsSetValue(current_key, (batch))
+
+#else
+// Without true threads, all intervals are stepped in the one OS
+// thread.  With simple threads, a manager's step() does not yield, so
+// one slot is still enough.
+static CLerpNodePathBatch *current_batch = NULL;
+#define GET_CURRENT_BATCH() (current_batch)
+#define SET_CURRENT_BATCH(batch) (current_batch = (batch))
+
+#endif
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+CLerpNodePathBatch::
+CLerpNodePathBatch() :
+  _prev(NULL),
+  _active(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::Destructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+CLerpNodePathBatch::
+~CLerpNodePathBatch() {
+  if (_active) {
+    end();
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::get_current
+//       Access: Public, Static
+//  Description: Returns the batch that is currently collecting lerp
+//               results in this thread, or NULL if lerps should be
+//               applied to their nodes immediately.
+////////////////////////////////////////////////////////////////////
+CLerpNodePathBatch *CLerpNodePathBatch::
+get_current() {
+  return GET_CURRENT_BATCH();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::init_current
+//       Access: Public, Static
+//  Description: Allocates the per-thread slot for the current batch.
+//               This is called by init_libinterval().
+////////////////////////////////////////////////////////////////////
+void CLerpNodePathBatch::
+init_current() {
+#if defined(THREAD_POSIX_IMPL)
+  int result = pthread_key_create(&current_key, NULL);
+  nassertv(result == 0);
+#elif defined(THREAD_WIN32_IMPL)
+  current_key = TlsAlloc();
+  nassertv(current_key != TLS_OUT_OF_INDEXES);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::begin
+//       Access: Public
+//  Description: Makes this the current batch in this thread.  Until
+//               end() is called, CLerpNodePathIntervals stepped in
+//               this thread will accumulate their results here
+//               instead of applying them directly.  If another batch
+//               was current, its results are applied first, so that
+//               our lerps start from them.
+////////////////////////////////////////////////////////////////////
+void CLerpNodePathBatch::
+begin() {
+  nassertv(!_active);
+  _prev = GET_CURRENT_BATCH();
+  if (_prev != (CLerpNodePathBatch *)NULL) {
+    _prev->flush();
+  }
+  _active = true;
+  SET_CURRENT_BATCH(this);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::flush
+//       Access: Public
+//  Description: Applies all of the pending results to their nodes,
+//               making one TransformState and/or RenderState for
+//               each node that changed.  The batch remains current.
+////////////////////////////////////////////////////////////////////
+void CLerpNodePathBatch::
+flush() {
+  Thread *current_thread = Thread::get_current_thread();
+
+  Entries::iterator ei;
+  for (ei = _entries.begin(); ei != _entries.end(); ++ei) {
+    const Entry &entry = (*ei);
+    const NodePath &node = entry._node;
+
+    if (entry._transform_changed) {
+      CPT(TransformState) prev_transform = node.get_prev_transform(current_thread);
+      node.set_transform(entry.make_transform(), current_thread);
+      if (entry._all_fluid) {
+        // Every lerp on this node was fluid, so leave the prev
+        // transform as it was, as each of them would have done.
+        node.set_prev_transform(prev_transform, current_thread);
+      } else {
+        node.node()->reset_prev_transform(current_thread);
+      }
+    }
+
+    if (entry._state_changed) {
+      node.set_state(entry._state, current_thread);
+    }
+
+    _slots[entry._slot] = -1;
+  }
+
+  _entries.clear();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::end
+//       Access: Public
+//  Description: Applies all of the pending results, and stops
+//               collecting; the batch that was current before
+//               begin(), if any, becomes current again.
+////////////////////////////////////////////////////////////////////
+void CLerpNodePathBatch::
+end() {
+  nassertv(_active && GET_CURRENT_BATCH() == this);
+  flush();
+  SET_CURRENT_BATCH(_prev);
+  _prev = NULL;
+  _active = false;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::get_entry
+//       Access: Public
+//  Description: Returns the pending entry for the indicated node,
+//               initializing it from the node's current transform and
+//               state if this is the first lerp on the node since the
+//               last flush.  Returns NULL if the node's transform
+//               cannot be decomposed into components; in this case
+//               the lerp should be applied directly.
+//
+//               The pointer is valid only until the next call to
+//               get_entry() or flush().
+////////////////////////////////////////////////////////////////////
+CLerpNodePathBatch::Entry *CLerpNodePathBatch::
+get_entry(const NodePath &node) {
+  PandaNode *pnode = node.node();
+  size_t mask = _slots.size() - 1;
+  size_t slot = 0;
+  if (!_slots.empty()) {
+    slot = hash_node(pnode) & mask;
+    while (_slots[slot] != -1) {
+      Entry &entry = _entries[_slots[slot]];
+      if (entry._node.node() == pnode) {
+        return &entry;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  CPT(TransformState) transform = node.get_transform();
+  if (!transform->has_components()) {
+    return NULL;
+  }
+
+  if ((_entries.size() + 1) * 2 > _slots.size()) {
+    // Keep the table no more than half full.
+    grow_slots();
+    mask = _slots.size() - 1;
+    slot = hash_node(pnode) & mask;
+    while (_slots[slot] != -1) {
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  _slots[slot] = (int)_entries.size();
+  _entries.push_back(Entry());
+  Entry &entry = _entries.back();
+  entry._node = node;
+  entry._slot = slot;
+  entry.set_transform(transform);
+  entry._state = node.get_state();
+  return &entry;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::grow_slots
+//       Access: Private
+//  Description: Doubles the size of the hash table, and re-enters the
+//               pending entries in it.
+////////////////////////////////////////////////////////////////////
+void CLerpNodePathBatch::
+grow_slots() {
+  size_t size = max(_slots.size() * 2, (size_t)64);
+  _slots.assign(size, -1);
+
+  size_t mask = size - 1;
+  for (size_t i = 0; i < _entries.size(); ++i) {
+    size_t slot = hash_node(_entries[i]._node.node()) & mask;
+    while (_slots[slot] != -1) {
+      slot = (slot + 1) & mask;
+    }
+    _slots[slot] = (int)i;
+    _entries[i]._slot = slot;
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::Entry::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+CLerpNodePathBatch::Entry::
+Entry() :
+  _pos(0.0f, 0.0f, 0.0f),
+  _hpr(0.0f, 0.0f, 0.0f),
+  _quat(LQuaternionf::ident_quat()),
+  _scale(1.0f, 1.0f, 1.0f),
+  _shear(0.0f, 0.0f, 0.0f),
+  _quat_given(false),
+  _transform_changed(false),
+  _all_fluid(true),
+  _state_changed(false),
+  _slot(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::Entry::set_transform
+//       Access: Public
+//  Description: Loads the components from the indicated transform,
+//               which must have components.
+////////////////////////////////////////////////////////////////////
+void CLerpNodePathBatch::Entry::
+set_transform(const TransformState *transform) {
+  nassertv(transform->has_components());
+  _pos = transform->get_pos();
+  _scale = transform->get_scale();
+  _shear = transform->get_shear();
+  _quat_given = transform->quat_given();
+  if (_quat_given) {
+    _quat = transform->get_quat();
+  } else {
+    _hpr = transform->get_hpr();
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CLerpNodePathBatch::Entry::make_transform
+//       Access: Public
+//  Description: Returns a TransformState built from the components.
+//               This is the only point at which the state cache is
+//               consulted.
+////////////////////////////////////////////////////////////////////
+CPT(TransformState) CLerpNodePathBatch::Entry::
+make_transform() const {
+  if (_quat_given) {
+    return TransformState::make_pos_quat_scale_shear(_pos, _quat, _scale, _shear);
+  }
+  return TransformState::make_pos_hpr_scale_shear(_pos, _hpr, _scale, _shear);
+}
@@ -0,0 +1,110 @@
+// Filename: cLerpNodePathBatch.h
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef CLERPNODEPATHBATCH_H
+#define CLERPNODEPATHBATCH_H
+
+#include "directbase.h"
+#include "nodePath.h"
+#include "transformState.h"
+#include "renderState.h"
+#include "luse.h"
+#include "pvector.h"
+#include "selectThreadImpl.h"
+
+////////////////////////////////////////////////////////////////////
+//       Class : CLerpNodePathBatch
+// Description : Collects the transform and state changes made by
+//               CLerpNodePathIntervals during one call to
+//               CIntervalManager::step(), and applies them to each
+//               node once at the end.
+//
+//               While a batch is current, each lerp writes its
+//               results into a per-node Entry, which holds the
+//               transform as separate components rather than as a
+//               TransformState.  Several lerps on the same node
+//               (e.g. a pos lerp and an hpr lerp in a Parallel)
+//               therefore produce only one TransformState, and one
+//               trip through the state cache, per frame.
+//
+//               Each thread has its own current batch, so managers
+//               stepped on different threads collect their lerps
+//               separately.  If a manager is stepped while another
+//               batch is current on the same thread (e.g. from a Func
+//               interval), the outer batch is flushed and set aside
+//               until the inner step is done.
+////////////////////////////////////////////////////////////////////
+class EXPCL_DIRECT CLerpNodePathBatch {
+public:
+  CLerpNodePathBatch();
+  ~CLerpNodePathBatch();
+
+  void begin();
+  void flush();
+  void end();
+
+  static CLerpNodePathBatch *get_current();
+  INLINE static void flush_current();
+  static void init_current();
+
+  class Entry {
+  public:
+    Entry();
+    void set_transform(const TransformState *transform);
+    CPT(TransformState) make_transform() const;
+
+    INLINE LVecBase3f get_hpr() const;
+    INLINE LQuaternionf get_quat() const;
+    INLINE void set_hpr(const LVecBase3f &hpr);
+    INLINE void set_quat(const LQuaternionf &quat);
+
+    LPoint3f _pos;
+    LVecBase3f _hpr;
+    LQuaternionf _quat;
+    LVecBase3f _scale;
+    LVecBase3f _shear;
+    bool _quat_given;
+
+    bool _transform_changed;
+    bool _all_fluid;
+    CPT(RenderState) _state;
+    bool _state_changed;
+
+    NodePath _node;
+    size_t _slot;
+  };
+
+  Entry *get_entry(const NodePath &node);
+
+private:
+  INLINE static size_t hash_node(const PandaNode *node);
+  void grow_slots();
+
+  // The pending entries, in the order their nodes were first lerped,
+  // and an open-addressed hash table of indexes into _entries, keyed
+  // on each entry's PandaNode.  Both keep their capacity from frame
+  // to frame, so a steady set of lerps allocates nothing.
+  typedef pvector<Entry> Entries;
+  Entries _entries;
+  typedef pvector<int> Slots;
+  Slots _slots;
+
+  // The batch that was current on this thread before begin().
+  CLerpNodePathBatch *_prev;
+  bool _active;
+};
+
+#include "cLerpNodePathBatch.I"
+
+#endif
@@ -13,6 +13,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "cLerpNodePathInterval.h"
+#include "cLerpNodePathBatch.h"
 #include "lerp_helpers.h"
 #include "transformState.h"
 #include "renderState.h"
@@ -125,14 +126,35 @@ priv_step(double t) {
   _state = S_started;
   double d = compute_delta(t);
 
+  // If the interval manager is batching lerps, a local lerp reads and
+  // writes the node's pending entry instead of the node itself.  A
+  // lerp relative to another node needs to see the real net
+  // transforms, so the pending results are applied first.
+  CLerpNodePathBatch::Entry *entry = NULL;
+  CLerpNodePathBatch *batch = CLerpNodePathBatch::get_current();
+  if (batch != (CLerpNodePathBatch *)NULL) {
+    if (_other.is_empty()) {
+      entry = batch->get_entry(_node);
+    } else {
+      batch->flush();
+    }
+  }
+
   // Save this in case we want to restore it later.
-  CPT(TransformState) prev_transform = _node.get_prev_transform();
+  CPT(TransformState) prev_transform;
+  if (entry == (CLerpNodePathBatch::Entry *)NULL) {
+    prev_transform = _node.get_prev_transform();
+  }
 
   if ((_flags & (F_end_pos | F_end_hpr | F_end_quat | F_end_scale | F_end_shear)) != 0) {
     // We have some transform lerp.
     CPT(TransformState) transform;
 
-    if (_other.is_empty()) {
+    if (entry != (CLerpNodePathBatch::Entry *)NULL) {
+      // The current components come from the batch entry; we don't
+      // need a TransformState at all.
+
+    } else if (_other.is_empty()) {
       // If there is no other node, it's a local transform lerp.
       transform = _node.get_transform();
     } else {
@@ -153,12 +175,12 @@ priv_step(double t) {
 
       } else if ((_flags & F_bake_in_start) != 0) {
         // Get the current starting pos, and bake it in.
-        set_start_pos(transform->get_pos());
+        set_start_pos(entry != NULL ? entry->_pos : transform->get_pos());
         lerp_value(pos, d, _start_pos, _end_pos);
 
       } else {
         // "smart" lerp from the current pos to the new pos.
-        pos = transform->get_pos();
+        pos = (entry != NULL) ? entry->_pos : transform->get_pos();
         lerp_value_from_prev(pos, d, _prev_d, pos, _end_pos);
       }
     }
@@ -172,11 +194,11 @@ priv_step(double t) {
         lerp_value(hpr, d, _start_hpr, _end_hpr);
 
       } else if ((_flags & F_bake_in_start) != 0) {
-        set_start_hpr(transform->get_hpr());
+        set_start_hpr(entry != NULL ? entry->get_hpr() : transform->get_hpr());
         lerp_value(hpr, d, _start_hpr, _end_hpr);
 
       } else {
-        hpr = transform->get_hpr();
+        hpr = (entry != NULL) ? entry->get_hpr() : transform->get_hpr();
         lerp_value_from_prev(hpr, d, _prev_d, hpr, _end_hpr);
       }
     }
@@ -191,14 +213,14 @@ priv_step(double t) {
           setup_slerp();
 
         } else if ((_flags & F_bake_in_start) != 0) {
-          set_start_quat(transform->get_quat());
+          set_start_quat(entry != NULL ? entry->get_quat() : transform->get_quat());
           setup_slerp();
 
         } else {
           if (_prev_d == 1.0) {
             _start_quat = _end_quat;
           } else {
-            LQuaternionf prev_value = transform->get_quat();
+            LQuaternionf prev_value = (entry != NULL) ? entry->get_quat() : transform->get_quat();
             _start_quat = (prev_value - _prev_d * _end_quat) / (1.0 - _prev_d);
           }
           setup_slerp();
@@ -216,11 +238,11 @@ priv_step(double t) {
         lerp_value(scale, d, _start_scale, _end_scale);
 
       } else if ((_flags & F_bake_in_start) != 0) {
-        set_start_scale(transform->get_scale());
+        set_start_scale(entry != NULL ? entry->_scale : transform->get_scale());
         lerp_value(scale, d, _start_scale, _end_scale);
 
       } else {
-        scale = transform->get_scale();
+        scale = (entry != NULL) ? entry->_scale : transform->get_scale();
         lerp_value_from_prev(scale, d, _prev_d, scale, _end_scale);
       }
     }
@@ -229,21 +251,50 @@ priv_step(double t) {
         lerp_value(shear, d, _start_shear, _end_shear);
 
       } else if ((_flags & F_bake_in_start) != 0) {
-        set_start_shear(transform->get_shear());
+        set_start_shear(entry != NULL ? entry->_shear : transform->get_shear());
         lerp_value(shear, d, _start_shear, _end_shear);
 
       } else {
-        shear = transform->get_shear();
+        shear = (entry != NULL) ? entry->_shear : transform->get_shear();
         lerp_value_from_prev(shear, d, _prev_d, shear, _end_shear);
       }
     }
 
+    if (entry != (CLerpNodePathBatch::Entry *)NULL) {
+      // Store just the components we computed into the batch entry.
+      // The node's TransformState will be made once, when the batch
+      // is flushed.
+      if ((_flags & F_end_pos) != 0) {
+        entry->_pos = pos;
+      }
+      if ((_flags & F_end_hpr) != 0) {
+        entry->set_hpr(hpr);
+      }
+      if ((_flags & F_end_quat) != 0) {
+        entry->set_quat(quat);
+      }
+      if ((_flags & F_end_scale) != 0) {
+        entry->_scale = scale;
+      }
+      if ((_flags & F_end_shear) != 0) {
+        entry->_shear = shear;
+      }
+      entry->_transform_changed = true;
+      if ((_flags & F_fluid) == 0) {
+        entry->_all_fluid = false;
+      }
+    }
+
     // Now apply the modifications back to the transform.  We want to
     // be a little careful here, because we don't want to assume the
     // transform has hpr/scale components if they're not needed.  And
     // in any case, we only want to apply the components that we
     // computed, above.
     unsigned int transform_flags = _flags & (F_end_pos | F_end_hpr | F_end_quat | F_end_scale);
+    if (entry != (CLerpNodePathBatch::Entry *)NULL) {
+      // Already handled above.
+      transform_flags = 0;
+    }
     switch (transform_flags) {
     case 0:
       break;
@@ -369,7 +420,7 @@ priv_step(double t) {
       interval_cat.error()
         << "Internal error in CLerpNodePathInterval::priv_step().\n";
     }
-    if ((_flags & F_end_shear) != 0) {
+    if ((_flags & F_end_shear) != 0 && entry == (CLerpNodePathBatch::Entry *)NULL) {
       // Also apply changes to shear.
       if (transform_flags == (F_end_pos | F_end_hpr | F_end_scale) ||
           transform_flags == (F_end_pos | F_end_quat | F_end_scale)) {
@@ -385,7 +436,7 @@ priv_step(double t) {
     }
   }
 
-  if ((_flags & F_fluid) != 0) {
+  if ((_flags & F_fluid) != 0 && entry == (CLerpNodePathBatch::Entry *)NULL) {
     // If we have the fluid flag set, we shouldn't mess with the prev
     // transform.  Therefore, restore it to what it was before we
     // started messing with it.
@@ -396,7 +447,11 @@ priv_step(double t) {
     // We have some render state lerp.
     CPT(RenderState) state;
 
-    if (_other.is_empty()) {
+    if (entry != (CLerpNodePathBatch::Entry *)NULL) {
+      // The pending state from earlier lerps in this batch.
+      state = entry->_state;
+
+    } else if (_other.is_empty()) {
       // If there is no other node, it's a local state lerp.  This is
       // most common.
       state = _node.get_state();
@@ -521,7 +576,10 @@ priv_step(double t) {
 
 
     // Now apply the new state back to the node.
-    if (_other.is_empty()) {
+    if (entry != (CLerpNodePathBatch::Entry *)NULL) {
+      entry->_state = state;
+      entry->_state_changed = true;
+    } else if (_other.is_empty()) {
       _node.set_state(state);
     } else {
       _node.set_state(_other, state);
@@ -369,7 +369,7 @@ priv_initialize(double t) {
 
   recompute();
   _next_event_index = 0;
-  _active.clear();
+  clear_active();
 
   int now = double_to_int_time(t);
 
@@ -384,10 +384,10 @@ priv_initialize(double t) {
   */
 
   // Now look for events from the beginning up to the current time.
+  size_t end_index = find_event_index(now);
   _processing_events = true;
   ActiveEvents new_active;
-  while (_next_event_index < _events.size() &&
-         _events[_next_event_index]->_time <= now) {
+  while (_next_event_index < end_index) {
     PlaybackEvent *event = _events[_next_event_index];
     _next_event_index++;
     
@@ -418,7 +418,7 @@ priv_instant() {
 
   check_stopped(get_class_type(), "priv_instant");
   recompute();
-  _active.clear();
+  clear_active();
 
   // Apply all of the events.  This just means we invoke "instant" for
   // any end or instant event, ignoring the begin events.
@@ -471,15 +471,16 @@ priv_step(double t) {
   */
 
   // Now look for events between the last time we ran and the current
-  // time.
+  // time.  The far end of that window is found with a binary search,
+  // so that only the events within the window are visited, however
+  // far the time has jumped.
+  size_t end_index = find_event_index(now);
 
   _processing_events = true;
-  if (_next_event_index < _events.size() &&
-      _events[_next_event_index]->_time <= now) {
+  if (_next_event_index < end_index) {
     // The normal case: time is increasing.
     ActiveEvents new_active;
-    while (_next_event_index < _events.size() &&
-           _events[_next_event_index]->_time <= now) {
+    while (_next_event_index < end_index) {
       PlaybackEvent *event = _events[_next_event_index];
       _next_event_index++;
 
@@ -492,8 +493,7 @@ priv_step(double t) {
   } else {
     // A less usual case: time is decreasing.
     ActiveEvents new_active;
-    while (_next_event_index > 0 && 
-           _events[_next_event_index - 1]->_time > now) {
+    while (_next_event_index > end_index) {
       _next_event_index--;
       PlaybackEvent *event = _events[_next_event_index];
 
@@ -573,7 +573,7 @@ priv_reverse_initialize(double t) {
 
   recompute();
   _next_event_index = _events.size();
-  _active.clear();
+  clear_active();
 
   int now = double_to_int_time(t);
 
@@ -588,10 +588,10 @@ priv_reverse_initialize(double t) {
   */
 
   // Now look for events from the end down to the current time.
+  size_t begin_index = find_event_index(now);
   _processing_events = true;
   ActiveEvents new_active;
-  while (_next_event_index > 0 && 
-         _events[_next_event_index - 1]->_time > now) {
+  while (_next_event_index > begin_index) {
     _next_event_index--;
     PlaybackEvent *event = _events[_next_event_index];
     
@@ -623,7 +623,7 @@ priv_reverse_instant() {
 
   check_stopped(get_class_type(), "priv_reverse_instant");
   recompute();
-  _active.clear();
+  clear_active();
 
   // Apply all of the events.  This just means we invoke "instant" for
   // any end or instant event, ignoring the begin events.
@@ -851,6 +851,69 @@ clear_events() {
   _active.clear();
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: CMetaInterval::find_event_index
+//       Access: Private
+//  Description: Returns the index of the first event in _events
+//               whose time is later than now, or _events.size() if
+//               there is none.  Since _events is sorted by time,
+//               this is a binary search; the events between this
+//               index and _next_event_index are exactly the ones a
+//               step to now must visit.
+////////////////////////////////////////////////////////////////////
+size_t CMetaInterval::
+find_event_index(int now) const {
+  size_t begin = 0;
+  size_t end = _events.size();
+  while (begin < end) {
+    size_t mid = begin + (end - begin) / 2;
+    if (_events[mid]->_time <= now) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  return begin;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CMetaInterval::clear_active
+//       Access: Private
+//  Description: Empties the _active list, resetting the list
+//               position recorded on each of its events.
+////////////////////////////////////////////////////////////////////
+void CMetaInterval::
+clear_active() {
+  ActiveEvents::iterator ai;
+  for (ai = _active.begin(); ai != _active.end(); ++ai) {
+    (*ai)->_active_list = (ActiveEvents *)NULL;
+  }
+  _active.clear();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CMetaInterval::splice_active
+//       Access: Private
+//  Description: Moves all of the events from new_active onto the
+//               back of _active (or onto the front, in reverse
+//               order, if at_front is true).  The recorded list
+//               iterators remain valid, since the list nodes
+//               themselves are moved, not copied.
+////////////////////////////////////////////////////////////////////
+void CMetaInterval::
+splice_active(CMetaInterval::ActiveEvents &new_active, bool at_front) {
+  ActiveEvents::iterator ai;
+  for (ai = new_active.begin(); ai != new_active.end(); ++ai) {
+    (*ai)->_active_list = &_active;
+  }
+  if (at_front) {
+    new_active.reverse();
+    _active.splice(_active.begin(), new_active);
+  } else {
+    _active.splice(_active.end(), new_active);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: CMetaInterval::do_event_forward
 //       Access: Private
@@ -869,34 +932,30 @@ do_event_forward(CMetaInterval::PlaybackEvent *event,
   switch (event->_type) {
   case PET_begin:
     nassertv(event->_begin_event == event);
-    new_active.push_back(event);
+    add_active(new_active, event, false);
     break;
     
   case PET_end:
     {
       // Erase the event from either the new active or the current
       // active lists.
-      ActiveEvents::iterator ai;
-      ai = find(new_active.begin(), new_active.end(), event->_begin_event);
-      if (ai != new_active.end()) {
-        new_active.erase(ai);
+      PlaybackEvent *begin_event = event->_begin_event;
+      if (begin_event->_active_list == &new_active) {
+        remove_active(begin_event);
         // This interval was new this frame; we must invoke it as
         // an instant event.
         enqueue_event(event->_n, ET_instant, is_initial);
 
-      } else {
-        ai = find(_active.begin(), _active.end(), event->_begin_event);
-        if (ai != _active.end()) {
-          _active.erase(ai);
-          enqueue_event(event->_n, ET_finalize, is_initial);
+      } else if (begin_event->_active_list == &_active) {
+        remove_active(begin_event);
+        enqueue_event(event->_n, ET_finalize, is_initial);
 
-        } else {
-          // Hmm, this event wasn't on either list.  Maybe there was a
-          // start event on the list whose time was less than 0.
-          interval_cat.error()
-            << "Event " << event->_begin_event->_n << " not on active list.\n";
-          nassertv(false);
-        }
+      } else {
+        // Hmm, this event wasn't on either list.  Maybe there was a
+        // start event on the list whose time was less than 0.
+        interval_cat.error()
+          << "Event " << event->_begin_event->_n << " not on active list.\n";
+        nassertv(false);
       }
     }
     break;
@@ -930,8 +989,8 @@ finish_events_forward(int now, CMetaInterval::ActiveEvents &new_active) {
   for (ai = new_active.begin(); ai != new_active.end(); ++ai) {
     PlaybackEvent *event = (*ai);
     enqueue_event(event->_n, ET_initialize, false, now - event->_time);
-    _active.push_back(event);
   }
+  splice_active(new_active, false);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -957,34 +1016,29 @@ do_event_reverse(CMetaInterval::PlaybackEvent *event,
       nassertv(event->_begin_event == event);
       // Erase the event from either the new active or the current
       // active lists.
-      ActiveEvents::iterator ai;
-      ai = find(new_active.begin(), new_active.end(), event);
-      if (ai != new_active.end()) {
-        new_active.erase(ai);
+      if (event->_active_list == &new_active) {
+        remove_active(event);
         // This interval was new this frame; we invoke it as an
         // instant event.
         enqueue_event(event->_n, ET_reverse_instant, is_initial);
 
-      } else {
-        ai = find(_active.begin(), _active.end(), event);
-        if (ai != _active.end()) {
-          _active.erase(ai);
-          enqueue_event(event->_n, ET_reverse_finalize, is_initial);
+      } else if (event->_active_list == &_active) {
+        remove_active(event);
+        enqueue_event(event->_n, ET_reverse_finalize, is_initial);
 
-        } else {
-          // Hmm, this event wasn't on either list.  Maybe there was a
-          // stop event on the list whose time was greater than the
-          // total, somehow. 
-          interval_cat.error()
-            << "Event " << event->_n << " not on active list.\n";
-          nassertv(false);
-        }
+      } else {
+        // Hmm, this event wasn't on either list.  Maybe there was a
+        // stop event on the list whose time was greater than the
+        // total, somehow. 
+        interval_cat.error()
+          << "Event " << event->_n << " not on active list.\n";
+        nassertv(false);
       }
     }
     break;
     
   case PET_end:
-    new_active.push_front(event->_begin_event);
+    add_active(new_active, event->_begin_event, true);
     break;
     
   case PET_instant:
@@ -1017,8 +1071,8 @@ finish_events_reverse(int now, CMetaInterval::ActiveEvents &new_active) {
   for (ai = new_active.begin(); ai != new_active.end(); ++ai) {
     PlaybackEvent *event = (*ai);
     enqueue_event(event->_n, ET_reverse_initialize, false, now - event->_time);
-    _active.push_front(event);
   }
+  splice_active(new_active, true);
 }
   
 ////////////////////////////////////////////////////////////////////
@@ -114,6 +114,13 @@ private:
     PET_instant
   };
 
+  class PlaybackEvent;
+
+  // ActiveEvents must be either a list or a vector--something that
+  // preserves order--so we can call priv_step() on the currently
+  // active intervals in the order they were encountered.
+  typedef plist<PlaybackEvent *> ActiveEvents;
+
   class PlaybackEvent {
   public:
     INLINE PlaybackEvent(int time, int n, PlaybackEventType type);
@@ -122,6 +129,12 @@ private:
     int _n;
     PlaybackEventType _type;
     PlaybackEvent *_begin_event;
+
+    // While a begin event is on one of the active lists, these
+    // record which list and where, so that it can be removed again
+    // without searching the list.
+    ActiveEvents *_active_list;
+    ActiveEvents::iterator _active_iter;
   };
 
   class EventQueueEntry {
@@ -134,16 +147,18 @@ private:
 
   typedef pvector<IntervalDef> Defs;
   typedef pvector<PlaybackEvent *> PlaybackEvents;
-  // ActiveEvents must be either a list or a vector--something that
-  // preserves order--so we can call priv_step() on the currently
-  // active intervals in the order they were encountered.
-  typedef plist<PlaybackEvent *> ActiveEvents;
   typedef pdeque<EventQueueEntry> EventQueue;
 
   INLINE int double_to_int_time(double t) const;
   INLINE double int_to_double_time(int time) const;
 
   void clear_events();
+  size_t find_event_index(int now) const;
+  void clear_active();
+  INLINE void add_active(ActiveEvents &list, PlaybackEvent *event,
+                         bool at_front);
+  INLINE void remove_active(PlaybackEvent *event);
+  void splice_active(ActiveEvents &new_active, bool at_front);
   void do_event_forward(PlaybackEvent *event, ActiveEvents &new_active,
                         bool is_initial);
   void finish_events_forward(int now, ActiveEvents &new_active);
@@ -21,6 +21,7 @@
 #include "cConstrainPosHprInterval.h"
 #include "cLerpInterval.h"
 #include "cLerpNodePathInterval.h"
+#include "cLerpNodePathBatch.h"
 #include "cLerpAnimEffectInterval.h"
 #include "cMetaInterval.h"
 #include "showInterval.h"
@@ -46,6 +47,20 @@ ConfigVariableBool verify_intervals
  PRC_DESC("Set this true to generate an assertion failure if interval "
           "functions are called out-of-order."));
 
+ConfigVariableBool interval_batch_lerps
+("interval-batch-lerps", false,
+ PRC_DESC("Set this true to have the CIntervalManager collect the results "
+          "of all of the lerp intervals it advances each frame, and apply "
+          "them to each node just once at the end of the frame.  This "
+          "avoids building an intermediate TransformState for every lerp "
+          "on every node.  Note that the lerped values are not stored on "
+          "the nodes until the end of CIntervalManager::step(): a Func "
+          "interval, event hook, or non-lerp interval that reads a lerped "
+          "node's transform or state during the step sees the value from "
+          "the previous frame.  Lerps relative to another node and the "
+          "constraint intervals do see the new values.  The default, "
+          "false, has each lerp apply its result to the node immediately."));
+
 
 ////////////////////////////////////////////////////////////////////
 //     Function: init_libinterval
@@ -71,6 +86,7 @@ init_libinterval() {
   CConstrainPosHprInterval::init_type();
   CLerpInterval::init_type();
   CLerpNodePathInterval::init_type();
+  CLerpNodePathBatch::init_current();
   CLerpAnimEffectInterval::init_type();
   CMetaInterval::init_type();
   ShowInterval::init_type();
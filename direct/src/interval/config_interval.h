@@ -25,6 +25,7 @@ NotifyCategoryDecl(interval, EXPCL_DIRECT, EXPTP_DIRECT);
 
 extern ConfigVariableDouble interval_precision;
 extern EXPCL_DIRECT ConfigVariableBool verify_intervals;
+extern EXPCL_DIRECT ConfigVariableBool interval_batch_lerps;
 
 extern EXPCL_DIRECT void init_libinterval();
 
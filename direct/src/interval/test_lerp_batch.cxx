@@ -0,0 +1,89 @@
+// Filename: test_lerp_batch.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "cIntervalManager.h"
+#include "cLerpNodePathInterval.h"
+#include "clockObject.h"
+#include "trueClock.h"
+#include "nodePath.h"
+
+// This program times CIntervalManager::step() with a number of
+// nodes, each driven by a separate pos lerp and hpr lerp, as a
+// crowd of walking avatars would be.  It runs once with lerp
+// batching and once without.
+
+static const int num_frames = 600;
+
+static double
+run(int num_nodes, bool batch_lerps) {
+  ClockObject *clock = ClockObject::get_global_clock();
+  clock->set_mode(ClockObject::M_non_real_time);
+  clock->set_frame_rate(60.0);
+  clock->reset();
+
+  CIntervalManager *mgr = CIntervalManager::get_global_ptr();
+  mgr->set_batch_lerps(batch_lerps);
+
+  NodePath render("render");
+  pvector<PT(CLerpNodePathInterval) > ivals;
+  for (int i = 0; i < num_nodes; ++i) {
+    ostringstream strm;
+    strm << "node" << i;
+    NodePath np = render.attach_new_node(strm.str());
+
+    PT(CLerpNodePathInterval) pos_ival = new CLerpNodePathInterval
+      (strm.str() + "-pos", 10.0, CLerpInterval::BT_no_blend,
+       false, false, np, NodePath());
+    pos_ival->set_end_pos(LVecBase3f(i, 100.0f, 0.0f));
+    ivals.push_back(pos_ival);
+
+    PT(CLerpNodePathInterval) hpr_ival = new CLerpNodePathInterval
+      (strm.str() + "-hpr", 10.0, CLerpInterval::BT_no_blend,
+       false, false, np, NodePath());
+    hpr_ival->set_end_hpr(LVecBase3f(360.0f, 0.0f, 0.0f));
+    ivals.push_back(hpr_ival);
+  }
+
+  pvector<PT(CLerpNodePathInterval) >::iterator ii;
+  for (ii = ivals.begin(); ii != ivals.end(); ++ii) {
+    (*ii)->start();
+  }
+
+  TrueClock *true_clock = TrueClock::get_global_ptr();
+  double start = true_clock->get_short_time();
+  for (int f = 0; f < num_frames; ++f) {
+    clock->tick();
+    mgr->step();
+  }
+  double elapsed = true_clock->get_short_time() - start;
+
+  for (ii = ivals.begin(); ii != ivals.end(); ++ii) {
+    (*ii)->finish();
+  }
+
+  return elapsed * 1000000.0 / num_frames;
+}
+
+int
+main(int argc, char *argv[]) {
+  static const int counts[] = { 100, 1000 };
+  for (int i = 0; i < 2; ++i) {
+    int num_nodes = counts[i];
+    double direct = run(num_nodes, false);
+    double batched = run(num_nodes, true);
+    nout << num_nodes << " nodes: " << direct << " us/frame direct, "
+         << batched << " us/frame batched\n";
+  }
+  return 0;
+}
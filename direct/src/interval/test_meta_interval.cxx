@@ -0,0 +1,254 @@
+// Filename: test_meta_interval.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "cMetaInterval.h"
+#include "waitInterval.h"
+#include "trueClock.h"
+#include "randomizer.h"
+
+// This program checks the state and time of the intervals nested
+// within a CMetaInterval after seeking, reverse playback and
+// interruption, and then times playback and seeking on a synthetic
+// CMetaInterval with a large number of overlapping child intervals,
+// similar to a long cutscene with many parallel tracks.
+
+// Each child contributes a begin and an end event.
+static const int num_children = 5000;
+
+// The children are staggered this far apart, and each lasts this
+// long, so that several hundred are active at any one time.
+static const double child_stagger = 0.01;
+static const double child_duration = 5.0;
+
+static const double frame_time = 1.0 / 60.0;
+static const int num_seeks = 1000;
+
+static int num_errors = 0;
+
+////////////////////////////////////////////////////////////////////
+//     Function: check
+//  Description: Reports an error if the interval is not in the
+//               indicated state, or (unless t is negative) not at
+//               the indicated time.
+////////////////////////////////////////////////////////////////////
+static void
+check(const string &step, CInterval *ival, CInterval::State state,
+      double t = -1.0) {
+  if (ival->get_state() != state) {
+    nout << "*** after " << step << ", " << ival->get_name()
+         << " is in state " << (int)ival->get_state() << ", expected "
+         << (int)state << "\n";
+    ++num_errors;
+  }
+  if (t >= 0.0 && fabs(ival->get_t() - t) > 0.0001) {
+    nout << "*** after " << step << ", " << ival->get_name()
+         << " is at t = " << ival->get_t() << ", expected " << t << "\n";
+    ++num_errors;
+  }
+}
+
+// The nested test interval: a runs from 0 to 2, inner from 1 to 3,
+// and d from 3.5 to 4.5.  Within inner, b runs from 0 to 1 and c from
+// 1 to 2.
+class Nested {
+public:
+  Nested() {
+    a = new CInterval("a", 2.0, true);
+    b = new CInterval("b", 1.0, true);
+    c = new CInterval("c", 1.0, true);
+    d = new CInterval("d", 1.0, true);
+
+    inner = new CMetaInterval("inner");
+    inner->add_c_interval(b, 0.0, CMetaInterval::RS_level_begin);
+    inner->add_c_interval(c, 1.0, CMetaInterval::RS_level_begin);
+
+    outer = new CMetaInterval("outer");
+    outer->add_c_interval(a, 0.0, CMetaInterval::RS_level_begin);
+    outer->add_c_interval(inner, 1.0, CMetaInterval::RS_level_begin);
+    outer->add_c_interval(d, 3.5, CMetaInterval::RS_level_begin);
+  }
+
+  PT(CMetaInterval) outer;
+  PT(CMetaInterval) inner;
+  PT(CInterval) a, b, c, d;
+};
+
+////////////////////////////////////////////////////////////////////
+//     Function: test_set_t
+//  Description: Seeks a paused interval forwards and backwards with
+//               set_t().
+////////////////////////////////////////////////////////////////////
+static void
+test_set_t() {
+  Nested n;
+
+  n.outer->set_t(1.5);
+  check("set_t(1.5)", n.outer, CInterval::S_paused, 1.5);
+  check("set_t(1.5)", n.a, CInterval::S_paused, 1.5);
+  check("set_t(1.5)", n.inner, CInterval::S_paused, 0.5);
+  check("set_t(1.5)", n.b, CInterval::S_paused, 0.5);
+  check("set_t(1.5)", n.c, CInterval::S_initial);
+  check("set_t(1.5)", n.d, CInterval::S_initial);
+
+  // Jumping past the end of inner finishes it, and c, which was
+  // never started, along with it.
+  n.outer->set_t(3.7);
+  check("set_t(3.7)", n.outer, CInterval::S_paused, 3.7);
+  check("set_t(3.7)", n.a, CInterval::S_final, 2.0);
+  check("set_t(3.7)", n.inner, CInterval::S_final, 2.0);
+  check("set_t(3.7)", n.b, CInterval::S_final, 1.0);
+  check("set_t(3.7)", n.c, CInterval::S_final, 1.0);
+  check("set_t(3.7)", n.d, CInterval::S_paused, 0.2);
+
+  // Jumping back undoes everything after the new time.
+  n.outer->set_t(0.5);
+  check("set_t(0.5)", n.outer, CInterval::S_paused, 0.5);
+  check("set_t(0.5)", n.a, CInterval::S_paused, 0.5);
+  check("set_t(0.5)", n.inner, CInterval::S_initial, 0.0);
+  check("set_t(0.5)", n.b, CInterval::S_initial, 0.0);
+  check("set_t(0.5)", n.c, CInterval::S_initial, 0.0);
+  check("set_t(0.5)", n.d, CInterval::S_initial, 0.0);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: test_reverse
+//  Description: Plays the interval backwards from the end.
+////////////////////////////////////////////////////////////////////
+static void
+test_reverse() {
+  Nested n;
+
+  n.outer->priv_reverse_initialize(n.outer->get_duration());
+  n.outer->priv_step(4.0);
+  check("reverse step(4.0)", n.outer, CInterval::S_started, 4.0);
+  check("reverse step(4.0)", n.d, CInterval::S_started, 0.5);
+
+  n.outer->priv_step(2.5);
+  check("reverse step(2.5)", n.outer, CInterval::S_started, 2.5);
+  check("reverse step(2.5)", n.d, CInterval::S_initial, 0.0);
+  check("reverse step(2.5)", n.inner, CInterval::S_started, 1.5);
+  check("reverse step(2.5)", n.c, CInterval::S_started, 0.5);
+  check("reverse step(2.5)", n.b, CInterval::S_initial);
+
+  n.outer->priv_step(0.5);
+  check("reverse step(0.5)", n.outer, CInterval::S_started, 0.5);
+  check("reverse step(0.5)", n.a, CInterval::S_started, 0.5);
+  check("reverse step(0.5)", n.inner, CInterval::S_initial, 0.0);
+  check("reverse step(0.5)", n.b, CInterval::S_initial, 0.0);
+  check("reverse step(0.5)", n.c, CInterval::S_initial, 0.0);
+
+  n.outer->priv_reverse_finalize();
+  check("reverse_finalize", n.outer, CInterval::S_initial, 0.0);
+  check("reverse_finalize", n.a, CInterval::S_initial, 0.0);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: test_interrupt
+//  Description: Interrupts the interval while it is playing, then
+//               resumes it and plays it to the end.
+////////////////////////////////////////////////////////////////////
+static void
+test_interrupt() {
+  Nested n;
+
+  n.outer->priv_initialize(0.0);
+  n.outer->priv_step(1.2);
+  n.outer->priv_interrupt();
+  check("interrupt", n.outer, CInterval::S_paused, 1.2);
+  check("interrupt", n.a, CInterval::S_paused, 1.2);
+  check("interrupt", n.inner, CInterval::S_paused, 0.2);
+  check("interrupt", n.b, CInterval::S_paused, 0.2);
+  check("interrupt", n.c, CInterval::S_initial);
+
+  n.outer->priv_step(1.4);
+  check("resume", n.outer, CInterval::S_started, 1.4);
+  check("resume", n.a, CInterval::S_started, 1.4);
+  check("resume", n.inner, CInterval::S_started, 0.4);
+  check("resume", n.b, CInterval::S_started, 0.4);
+
+  n.outer->priv_finalize();
+  check("finalize", n.outer, CInterval::S_final, 4.5);
+  check("finalize", n.a, CInterval::S_final, 2.0);
+  check("finalize", n.inner, CInterval::S_final, 2.0);
+  check("finalize", n.b, CInterval::S_final, 1.0);
+  check("finalize", n.c, CInterval::S_final, 1.0);
+  check("finalize", n.d, CInterval::S_final, 1.0);
+}
+
+int
+main(int argc, char *argv[]) {
+  test_set_t();
+  test_reverse();
+  test_interrupt();
+
+  pvector< PT(CInterval) > children;
+  PT(CMetaInterval) meta = new CMetaInterval("synthetic");
+  for (int i = 0; i < num_children; ++i) {
+    PT(CInterval) child = new WaitInterval(child_duration);
+    children.push_back(child);
+    meta->add_c_interval(child, i * child_stagger,
+                         CMetaInterval::RS_level_begin);
+  }
+  double duration = meta->get_duration();
+  nout << num_children * 2 << " events, duration " << duration << " s\n";
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  // Play straight through, one frame at a time.
+  double start = clock->get_short_time();
+  int num_frames = 0;
+  meta->priv_initialize(0.0);
+  for (double t = frame_time; t < duration; t += frame_time) {
+    meta->priv_step(t);
+    ++num_frames;
+  }
+  meta->priv_finalize();
+  double elapsed = clock->get_short_time() - start;
+  nout << "play:  " << num_frames << " frames in " << elapsed
+       << " s (" << elapsed * 1000000.0 / num_frames << " us/frame)\n";
+
+  // Seek back and forth to random times, as a slider would.
+  Randomizer random(1);
+  start = clock->get_short_time();
+  meta->priv_initialize(0.0);
+  for (int i = 0; i < num_seeks; ++i) {
+    meta->priv_step(random.random_real(duration));
+  }
+  elapsed = clock->get_short_time() - start;
+  nout << "seek:  " << num_seeks << " seeks in " << elapsed
+       << " s (" << elapsed * 1000000.0 / num_seeks << " us/seek)\n";
+
+  // After all that, each child must be in the state implied by the
+  // last seek alone.  This time falls between event times, so no
+  // child begins or ends exactly on it.
+  double seek_t = duration * 0.5 + child_stagger * 0.3;
+  meta->priv_step(seek_t);
+  for (int i = 0; i < num_children; ++i) {
+    double begin = i * child_stagger;
+    CInterval::State state = CInterval::S_initial;
+    if (seek_t >= begin + child_duration) {
+      state = CInterval::S_final;
+    } else if (seek_t >= begin) {
+      state = CInterval::S_started;
+    }
+    check("seek", children[i], state);
+  }
+  meta->priv_finalize();
+
+  if (num_errors != 0) {
+    nout << num_errors << " errors.\n";
+    return 1;
+  }
+  return 0;
+}
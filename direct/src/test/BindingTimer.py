@@ -0,0 +1,101 @@
+"""Times some common calls through the interrogate-generated Python
+bindings, to measure the cost of argument parsing and overload
+dispatch.
+
+Usage: python BindingTimer.py [numCalls]
+"""
+
+__all__ = ['timeCalls', 'runAll']
+
+import sys
+import time
+from pandac.PandaModules import NodePath, Point3, Vec3, VBase4, \
+     Datagram, DatagramIterator
+
+def timeCalls(name, func, numCalls):
+    """Calls func(numCalls), which should make numCalls calls of the
+    sort to be measured, and prints the time taken per call."""
+    start = time.clock()
+    func(numCalls)
+    elapsed = time.clock() - start
+    print '%-36s %8.3f us/call' % (name, elapsed * 1000000.0 / numCalls)
+
+def runAll(numCalls = 200000):
+    np = NodePath('np')
+    other = NodePath('other')
+    pos = Point3(1, 2, 3)
+    r = range(numCalls)
+
+    # No arguments.
+    def getPos(n):
+        for i in r:
+            np.getPos()
+    timeCalls('NodePath.getPos()', getPos, numCalls)
+
+    # The first of several overloads with the same number of
+    # arguments, and the last.
+    def setPosPoint(n):
+        for i in r:
+            np.setPos(pos)
+    timeCalls('NodePath.setPos(Point3)', setPosPoint, numCalls)
+
+    def setPosFloats(n):
+        for i in r:
+            np.setPos(1, 2, 3)
+    timeCalls('NodePath.setPos(x, y, z)', setPosFloats, numCalls)
+
+    def setPosOther(n):
+        for i in r:
+            np.setPos(other, 1, 2, 3)
+    timeCalls('NodePath.setPos(other, x, y, z)', setPosOther, numCalls)
+
+    # Parameter coercion from a tuple.
+    def setPosTuple(n):
+        for i in r:
+            np.setPos((1, 2, 3))
+    timeCalls('NodePath.setPos((x, y, z))', setPosTuple, numCalls)
+
+    # Keyword arguments still take the slow path.
+    def setColorKeywords(n):
+        for i in r:
+            np.setColor(r = 1, g = 1, b = 1, a = 1)
+    timeCalls('NodePath.setColor(r=, g=, b=, a=)', setColorKeywords, numCalls)
+
+    # Constructors and operators.
+    def makeVec3(n):
+        for i in r:
+            Vec3(1, 2, 3)
+    timeCalls('Vec3(x, y, z)', makeVec3, numCalls)
+
+    def addVec3(n):
+        v = Vec3(1, 2, 3)
+        for i in r:
+            v + v
+    timeCalls('Vec3 + Vec3', addVec3, numCalls)
+
+    def makeVBase4(n):
+        for i in r:
+            VBase4(pos, 1)
+    timeCalls('VBase4(Point3, w)', makeVBase4, numCalls)
+
+    # Networking calls, which are made many times per frame.
+    def addUint16(n):
+        dg = Datagram()
+        for i in r:
+            dg.addUint16(i & 0xffff)
+    timeCalls('Datagram.addUint16()', addUint16, numCalls)
+
+    dg = Datagram()
+    for i in r:
+        dg.addUint16(i & 0xffff)
+    def getUint16(n):
+        dgi = DatagramIterator(dg)
+        for i in r:
+            dgi.getUint16()
+    timeCalls('DatagramIterator.getUint16()', getUint16, numCalls)
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        runAll(int(sys.argv[1]))
+    else:
+        runAll()
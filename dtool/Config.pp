@@ -402,6 +402,13 @@
 // suspect a bug in Panda's memory management code.
 #define USE_DELETED_CHAIN 1
 
+// Define this true to give each thread a small cache of deleted
+// blocks for each DELETED_CHAIN, so that threads that allocate and
+// free the same kinds of objects don't contend on the chain's lock.
+// This has no effect unless USE_DELETED_CHAIN and HAVE_THREADS are
+// also defined, and SIMPLE_THREADS is not.
+#define USE_DELETED_CHAIN_MAGAZINES 1
+
 // Define this true to build the low-level native network
 // implementation.  Normally this should be set true.
 #define WANT_NATIVE_NET 1
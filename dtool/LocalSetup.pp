@@ -676,6 +676,7 @@ $[cdefine USE_MEMORY_NOWRAPPERS]
 
 // To activate the DELETED_CHAIN macros.
 $[cdefine USE_DELETED_CHAIN]
+$[cdefine USE_DELETED_CHAIN_MAGAZINES]
 
 // If we are to build the native net interfaces.
 $[cdefine WANT_NATIVE_NET]
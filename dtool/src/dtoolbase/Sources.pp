@@ -22,6 +22,7 @@
     indent.I indent.h indent.cxx \
     memoryBase.h \
     memoryHook.h memoryHook.I \
+    memoryProfiler.h memoryProfiler.I \
     mutexImpl.h \
     mutexDummyImpl.h mutexDummyImpl.I \
     mutexPosixImpl.h mutexPosixImpl.I \
@@ -53,6 +54,7 @@
     dtoolbase.cxx \
     memoryBase.cxx \
     memoryHook.cxx \
+    memoryProfiler.cxx \
     mutexDummyImpl.cxx \
     mutexPosixImpl.cxx \
     mutexWin32Impl.cxx \
@@ -80,6 +82,7 @@
     indent.I indent.h \
     memoryBase.h \
     memoryHook.h memoryHook.I \
+    memoryProfiler.h memoryProfiler.I \
     mutexImpl.h \
     mutexDummyImpl.h mutexDummyImpl.I \
     mutexPosixImpl.h mutexPosixImpl.I \
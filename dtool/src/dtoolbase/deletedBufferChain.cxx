@@ -14,6 +14,31 @@
 
 #include "deletedBufferChain.h"
 
+#ifdef DELETED_CHAIN_MAGAZINES
+#ifdef THREAD_POSIX_IMPL
+#include <pthread.h>
+
+// The per-thread pointer to each thread's ThreadMagazines.  Posix
+// calls free_thread_magazines() for us when each thread exits.
+static pthread_key_t magazines_key;
+#define GET_THREAD_MAGAZINES() pthread_getspecific(magazines_key)
+#define SET_THREAD_MAGAZINES(ptr) pthread_setspecific(magazines_key, ptr)
+
+#else  // THREAD_POSIX_IMPL
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+// Windows gives us no callback when a thread exits; ThreadWin32Impl
+// calls flush_thread() instead.
+static DWORD magazines_key;
+#define GET_THREAD_MAGAZINES() TlsGetValue(magazines_key)
+#define SET_THREAD_MAGAZINES(ptr) TlsSetValue(magazines_key, ptr)
+
+#endif  // THREAD_POSIX_IMPL
+
+int DeletedBufferChain::_num_chains = 0;
+#endif  // DELETED_CHAIN_MAGAZINES
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DeletedBufferChain::Constructor
 //       Access: Protected
@@ -25,6 +50,9 @@ DeletedBufferChain(size_t buffer_size) {
   _deleted_chain = NULL;
   _buffer_size = buffer_size;
   _alloc_size = _buffer_size;
+  _num_requests = 0;
+  _num_hits = 0;
+  _num_locks = 0;
 
 #ifdef USE_DELETEDCHAINFLAG
   // In development mode, we also need to reserve space for _flag.
@@ -35,6 +63,18 @@ DeletedBufferChain(size_t buffer_size) {
   // reasons.
   _buffer_size = max(_buffer_size, sizeof(ObjectNode));
   _alloc_size = max(_alloc_size, sizeof(ObjectNode));
+
+#ifdef DELETED_CHAIN_MAGAZINES
+  // We are constructed only by MemoryHook::get_deleted_chain(), which
+  // holds its lock, so there's no need to protect _num_chains.
+  init_magazines();
+  _index = _num_chains;
+  ++_num_chains;
+
+  // Each thread holds on to no more than about 4K of buffers per
+  // chain.
+  _magazine_size = (int)max(min((size_t)4096 / _alloc_size, (size_t)64), (size_t)4);
+#endif  // DELETED_CHAIN_MAGAZINES
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -52,12 +92,32 @@ allocate(size_t size, TypeHandle type_handle) {
 
   ObjectNode *obj;
 
+#ifdef DELETED_CHAIN_MAGAZINES
+  Magazine *mag = get_magazine();
+  if (mag->_head != (ObjectNode *)NULL) {
+    ++mag->_hits;
+  } else {
+    ++mag->_misses;
+    refill(mag);
+  }
+  obj = mag->_head;
+  if (obj != (ObjectNode *)NULL) {
+    mag->_head = obj->_next;
+    --mag->_count;
+  }
+
+#else  // DELETED_CHAIN_MAGAZINES
   _lock.acquire();
-  if (_deleted_chain != (ObjectNode *)NULL) {
-    obj = _deleted_chain;
-    _deleted_chain = _deleted_chain->_next;
-    _lock.release();
+  ++_num_requests;
+  ++_num_locks;
+  obj = _deleted_chain;
+  if (obj != (ObjectNode *)NULL) {
+    _deleted_chain = obj->_next;
+  }
+  _lock.release();
+#endif  // DELETED_CHAIN_MAGAZINES
 
+  if (obj != (ObjectNode *)NULL) {
 #ifdef USE_DELETEDCHAINFLAG
     assert(obj->_flag == (AtomicAdjust::Integer)DCF_deleted);
     obj->_flag = DCF_alive;
@@ -72,7 +132,6 @@ allocate(size_t size, TypeHandle type_handle) {
 
     return ptr;
   }
-  _lock.release();
 
   // If we get here, the deleted_chain is empty; we have to allocate a
   // new object from the system pool.
@@ -127,14 +186,289 @@ deallocate(void *ptr, TypeHandle type_handle) {
   assert(orig_flag == (AtomicAdjust::Integer)DCF_alive);
 #endif  // NDEBUG
 
+#ifdef DELETED_CHAIN_MAGAZINES
+  Magazine *mag = get_magazine();
+  obj->_next = mag->_head;
+  mag->_head = obj;
+  ++mag->_count;
+  if (mag->_count <= _magazine_size) {
+    ++mag->_hits;
+  } else {
+    // The magazine is full; give half of it back to the chain.
+    ++mag->_misses;
+    drain(mag, _magazine_size / 2);
+  }
+
+#else  // DELETED_CHAIN_MAGAZINES
   _lock.acquire();
+  ++_num_requests;
+  ++_num_locks;
 
   obj->_next = _deleted_chain;
   _deleted_chain = obj;
 
   _lock.release();
+#endif  // DELETED_CHAIN_MAGAZINES
 
 #else  // USE_DELETED_CHAIN
   PANDA_FREE_SINGLE(ptr);
 #endif  // USE_DELETED_CHAIN
 }
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::get_num_requests
+//       Access: Public
+//  Description: Returns the total number of calls to allocate() and
+//               deallocate() on this chain so far.  Requests answered
+//               from a thread's magazine are only added to this count
+//               when the thread next takes the chain's lock, so this
+//               may lag behind a little.
+////////////////////////////////////////////////////////////////////
+size_t DeletedBufferChain::
+get_num_requests() const {
+  return _num_requests;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::get_num_hits
+//       Access: Public
+//  Description: Returns the number of calls to allocate() and
+//               deallocate() that were answered from the calling
+//               thread's magazine, without taking the chain's lock.
+//               This is always 0 if the magazines are not compiled
+//               in.
+////////////////////////////////////////////////////////////////////
+size_t DeletedBufferChain::
+get_num_hits() const {
+  return _num_hits;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::get_num_locks
+//       Access: Public
+//  Description: Returns the number of times the chain's lock has
+//               been acquired to allocate or free a buffer.
+////////////////////////////////////////////////////////////////////
+size_t DeletedBufferChain::
+get_num_locks() const {
+  return _num_locks;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::output
+//       Access: Public
+//  Description: 
+////////////////////////////////////////////////////////////////////
+void DeletedBufferChain::
+output(ostream &out) const {
+  out << "DeletedBufferChain(" << _buffer_size << "): "
+      << get_num_requests() << " requests, "
+      << get_hit_rate() * 100.0 << "% hits, "
+      << get_num_locks() << " locks";
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::flush_thread
+//       Access: Public, Static
+//  Description: Returns the buffers held in the current thread's
+//               magazines to their chains.  This should be called by
+//               a thread that is about to exit, on platforms that
+//               don't do this automatically.  It is harmless to call
+//               it at other times.
+////////////////////////////////////////////////////////////////////
+void DeletedBufferChain::
+flush_thread() {
+#ifdef DELETED_CHAIN_MAGAZINES
+  void *data = GET_THREAD_MAGAZINES();
+  if (data != NULL) {
+    SET_THREAD_MAGAZINES(NULL);
+    free_thread_magazines(data);
+  }
+#endif  // DELETED_CHAIN_MAGAZINES
+}
+
+#ifdef DELETED_CHAIN_MAGAZINES
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::get_magazine
+//       Access: Private
+//  Description: Returns the current thread's Magazine for this
+//               chain, creating it if necessary.
+////////////////////////////////////////////////////////////////////
+DeletedBufferChain::Magazine *DeletedBufferChain::
+get_magazine() {
+  ThreadMagazines *tm = (ThreadMagazines *)GET_THREAD_MAGAZINES();
+  if (tm != (ThreadMagazines *)NULL && _index < tm->_num_magazines) {
+    Magazine *mag = &tm->_magazines[_index];
+    if (mag->_chain == this) {
+      return mag;
+    }
+  }
+  return make_magazine();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::make_magazine
+//       Access: Private
+//  Description: The slow path of get_magazine(): creates the current
+//               thread's ThreadMagazines, or enlarges it, as needed
+//               to hold a Magazine for this chain.
+////////////////////////////////////////////////////////////////////
+DeletedBufferChain::Magazine *DeletedBufferChain::
+make_magazine() {
+  ThreadMagazines *tm = (ThreadMagazines *)GET_THREAD_MAGAZINES();
+  if (tm == (ThreadMagazines *)NULL) {
+    tm = (ThreadMagazines *)PANDA_MALLOC_SINGLE(sizeof(ThreadMagazines));
+    tm->_num_magazines = 0;
+    tm->_magazines = NULL;
+    SET_THREAD_MAGAZINES(tm);
+  }
+
+  if (_index >= tm->_num_magazines) {
+    // Make room for all of the chains so far, and then some.
+    int num_magazines = max(max(_num_chains, _index + 1) * 2, 16);
+    Magazine *magazines = (Magazine *)PANDA_MALLOC_ARRAY(num_magazines * sizeof(Magazine));
+    if (tm->_num_magazines != 0) {
+      memcpy(magazines, tm->_magazines, tm->_num_magazines * sizeof(Magazine));
+      PANDA_FREE_ARRAY(tm->_magazines);
+    }
+    memset(magazines + tm->_num_magazines, 0,
+           (num_magazines - tm->_num_magazines) * sizeof(Magazine));
+    tm->_magazines = magazines;
+    tm->_num_magazines = num_magazines;
+  }
+
+  Magazine *mag = &tm->_magazines[_index];
+  mag->_chain = this;
+  return mag;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::refill
+//       Access: Private
+//  Description: Moves up to half a magazine's worth of buffers from
+//               the chain into the indicated empty Magazine.  If the
+//               chain is empty, the magazine is left empty.
+////////////////////////////////////////////////////////////////////
+void DeletedBufferChain::
+refill(DeletedBufferChain::Magazine *mag) {
+  assert(mag->_head == (ObjectNode *)NULL);
+  int want = _magazine_size / 2;
+
+  _lock.acquire();
+  _num_requests += mag->_hits + mag->_misses;
+  _num_hits += mag->_hits;
+  ++_num_locks;
+
+  ObjectNode *first = _deleted_chain;
+  ObjectNode *last = (ObjectNode *)NULL;
+  ObjectNode *node = first;
+  int count = 0;
+  while (node != (ObjectNode *)NULL && count < want) {
+    last = node;
+    node = node->_next;
+    ++count;
+  }
+  _deleted_chain = node;
+  _lock.release();
+
+  mag->_hits = 0;
+  mag->_misses = 0;
+  if (last != (ObjectNode *)NULL) {
+    last->_next = (ObjectNode *)NULL;
+    mag->_head = first;
+    mag->_count = count;
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::drain
+//       Access: Private
+//  Description: Returns all but the first keep buffers in the
+//               indicated Magazine to the chain.
+////////////////////////////////////////////////////////////////////
+void DeletedBufferChain::
+drain(DeletedBufferChain::Magazine *mag, int keep) {
+  assert(keep <= mag->_count);
+
+  // Find the buffers to give back, and the end of them, before we
+  // take the lock.
+  ObjectNode *keep_last = (ObjectNode *)NULL;
+  ObjectNode *first = mag->_head;
+  for (int i = 0; i < keep; ++i) {
+    keep_last = first;
+    first = first->_next;
+  }
+  ObjectNode *last = first;
+  if (last != (ObjectNode *)NULL) {
+    while (last->_next != (ObjectNode *)NULL) {
+      last = last->_next;
+    }
+  }
+
+  if (keep_last != (ObjectNode *)NULL) {
+    keep_last->_next = (ObjectNode *)NULL;
+  } else {
+    mag->_head = (ObjectNode *)NULL;
+  }
+  mag->_count = keep;
+
+  _lock.acquire();
+  _num_requests += mag->_hits + mag->_misses;
+  _num_hits += mag->_hits;
+  ++_num_locks;
+
+  if (first != (ObjectNode *)NULL) {
+    last->_next = _deleted_chain;
+    _deleted_chain = first;
+  }
+  _lock.release();
+
+  mag->_hits = 0;
+  mag->_misses = 0;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::init_magazines
+//       Access: Private, Static
+//  Description: Allocates the per-thread index used to find each
+//               thread's ThreadMagazines, the first time it is called.
+////////////////////////////////////////////////////////////////////
+void DeletedBufferChain::
+init_magazines() {
+  static bool initialized = false;
+  if (initialized) {
+    return;
+  }
+  initialized = true;
+
+#ifdef THREAD_POSIX_IMPL
+  int result = pthread_key_create(&magazines_key, &free_thread_magazines);
+  assert(result == 0);
+#else
+  magazines_key = TlsAlloc();
+  assert(magazines_key != TLS_OUT_OF_INDEXES);
+#endif  // THREAD_POSIX_IMPL
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DeletedBufferChain::free_thread_magazines
+//       Access: Private, Static
+//  Description: Returns the buffers in the indicated ThreadMagazines
+//               to their chains, and frees it.  This is called when
+//               a thread exits.
+////////////////////////////////////////////////////////////////////
+void DeletedBufferChain::
+free_thread_magazines(void *data) {
+  ThreadMagazines *tm = (ThreadMagazines *)data;
+  for (int i = 0; i < tm->_num_magazines; ++i) {
+    Magazine *mag = &tm->_magazines[i];
+    if (mag->_chain != (DeletedBufferChain *)NULL) {
+      mag->_chain->drain(mag, 0);
+    }
+  }
+  if (tm->_magazines != (Magazine *)NULL) {
+    PANDA_FREE_ARRAY(tm->_magazines);
+  }
+  PANDA_FREE_SINGLE(tm);
+}
+#endif  // DELETED_CHAIN_MAGAZINES
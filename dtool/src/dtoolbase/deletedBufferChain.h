@@ -38,6 +38,13 @@
 #define USE_DELETEDCHAINFLAG 1
 #endif // NDEBUG
 
+// With real threads, each thread keeps a small "magazine" of
+// deleted buffers for each DeletedBufferChain, and only takes the
+// chain's lock to refill or empty it a batch at a time.
+#if defined(USE_DELETED_CHAIN) && defined(USE_DELETED_CHAIN_MAGAZINES) && (defined(THREAD_POSIX_IMPL) || defined(THREAD_WIN32_IMPL))
+#define DELETED_CHAIN_MAGAZINES 1
+#endif
+
 #ifdef USE_DELETEDCHAINFLAG
 enum DeletedChainFlag {
   DCF_deleted = 0xfeedba0f,
@@ -73,6 +80,14 @@ public:
   INLINE bool validate(void *ptr);
   INLINE size_t get_buffer_size() const;
 
+  size_t get_num_requests() const;
+  size_t get_num_hits() const;
+  size_t get_num_locks() const;
+  INLINE double get_hit_rate() const;
+  void output(ostream &out) const;
+
+  static void flush_thread();
+
 private:
   class ObjectNode {
   public:
@@ -94,15 +109,61 @@ private:
   static INLINE void *node_to_buffer(ObjectNode *node);
   static INLINE ObjectNode *buffer_to_node(void *buffer);
 
+#ifdef DELETED_CHAIN_MAGAZINES
+  // One of these is kept by each thread for each DeletedBufferChain.
+  // It is only ever touched by its own thread.
+  class Magazine {
+  public:
+    DeletedBufferChain *_chain;
+    ObjectNode *_head;
+    int _count;
+
+    // The number of requests answered with and without the chain's
+    // lock since the chain's statistics were last updated.
+    size_t _hits;
+    size_t _misses;
+  };
+
+  // Each thread's array of Magazines, indexed by _index.
+  class ThreadMagazines {
+  public:
+    int _num_magazines;
+    Magazine *_magazines;
+  };
+
+  Magazine *get_magazine();
+  Magazine *make_magazine();
+  void refill(Magazine *mag);
+  void drain(Magazine *mag, int keep);
+
+  // The index of this chain's Magazine within each thread's array.
+  int _index;
+  int _magazine_size;
+  static int _num_chains;
+
+  static void init_magazines();
+  static void free_thread_magazines(void *data);
+#endif  // DELETED_CHAIN_MAGAZINES
+
   ObjectNode *_deleted_chain;
   
   MutexImpl _lock;
   size_t _buffer_size;
   size_t _alloc_size;
 
+  // These are protected by _lock.
+  size_t _num_requests;
+  size_t _num_hits;
+  size_t _num_locks;
+
   friend class MemoryHook;
 };
 
+INLINE ostream &operator << (ostream &out, const DeletedBufferChain &chain) {
+  chain.output(out);
+  return out;
+}
+
 #include "deletedBufferChain.I"
 
 #endif
@@ -7,4 +7,5 @@
 #include "dtoolbase.cxx"
 #include "memoryBase.cxx"
 #include "memoryHook.cxx"
+#include "memoryProfiler.cxx"
 #include "mutexDummyImpl.cxx"
@@ -14,6 +14,7 @@
 
 #include "memoryHook.h"
 #include "deletedBufferChain.h"
+#include "memoryProfiler.h"
 #include <stdlib.h>
 
 #ifdef WIN32
@@ -209,9 +210,17 @@ heap_alloc_single(size_t size) {
       _max_heap_size) {
     overflow_heap_size();
   }
-#endif  // DO_MEMORY_USAGE
 
+  void *ptr = alloc_to_ptr(alloc, size);
+  if (MemoryProfiler::should_sample(size)) {
+    set_sampled(ptr);
+    MemoryProfiler::record_alloc(ptr, size);
+  }
+  return ptr;
+
+#else
   return alloc_to_ptr(alloc, size);
+#endif  // DO_MEMORY_USAGE
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -228,6 +237,9 @@ heap_free_single(void *ptr) {
 #ifdef DO_MEMORY_USAGE
   assert((int)size <= _total_heap_single_size);
   AtomicAdjust::add(_total_heap_single_size, -(AtomicAdjust::Integer)size);
+  if (is_sampled(ptr)) {
+    MemoryProfiler::record_free(ptr);
+  }
 #endif  // DO_MEMORY_USAGE
 
 #ifdef MEMORY_HOOK_MALLOC_LOCK
@@ -281,9 +293,17 @@ heap_alloc_array(size_t size) {
       _max_heap_size) {
     overflow_heap_size();
   }
-#endif  // DO_MEMORY_USAGE
 
+  void *ptr = alloc_to_ptr(alloc, size);
+  if (MemoryProfiler::should_sample(size)) {
+    set_sampled(ptr);
+    MemoryProfiler::record_alloc(ptr, size);
+  }
+  return ptr;
+
+#else
   return alloc_to_ptr(alloc, size);
+#endif  // DO_MEMORY_USAGE
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -300,6 +320,12 @@ heap_realloc_array(void *ptr, size_t size) {
 #ifdef DO_MEMORY_USAGE
   assert((AtomicAdjust::Integer)orig_size <= _total_heap_array_size);
   AtomicAdjust::add(_total_heap_array_size, (AtomicAdjust::Integer)size-(AtomicAdjust::Integer)orig_size);
+
+  // The block may move, so we treat this as a free and a new
+  // allocation as far as the profiler is concerned.
+  if (is_sampled(ptr)) {
+    MemoryProfiler::record_free(ptr);
+  }
 #endif  // DO_MEMORY_USAGE
 
 #ifdef MEMORY_HOOK_MALLOC_LOCK
@@ -325,7 +351,17 @@ heap_realloc_array(void *ptr, size_t size) {
 #endif
   }
 
+#ifdef DO_MEMORY_USAGE
+  void *new_ptr = alloc_to_ptr(alloc, size);
+  if (MemoryProfiler::should_sample(size)) {
+    set_sampled(new_ptr);
+    MemoryProfiler::record_alloc(new_ptr, size);
+  }
+  return new_ptr;
+
+#else
   return alloc_to_ptr(alloc, size);
+#endif  // DO_MEMORY_USAGE
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -342,6 +378,9 @@ heap_free_array(void *ptr) {
 #ifdef DO_MEMORY_USAGE
   assert((int)size <= _total_heap_array_size);
   AtomicAdjust::add(_total_heap_array_size, -(AtomicAdjust::Integer)size);
+  if (is_sampled(ptr)) {
+    MemoryProfiler::record_free(ptr);
+  }
 #endif  // DO_MEMORY_USAGE
 
 #ifdef MEMORY_HOOK_MALLOC_LOCK
@@ -521,6 +560,23 @@ get_deleted_chain(size_t buffer_size) {
   return chain;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryHook::write_deleted_chains
+//       Access: Public
+//  Description: Writes the statistics of each DeletedBufferChain
+//               returned by get_deleted_chain(), one per line, in
+//               order by size.
+////////////////////////////////////////////////////////////////////
+void MemoryHook::
+write_deleted_chains(ostream &out) {
+  _lock.acquire();
+  DeletedChains::const_iterator dci;
+  for (dci = _deleted_chains.begin(); dci != _deleted_chains.end(); ++dci) {
+    out << *(*dci).second << "\n";
+  }
+  _lock.release();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: MemoryHook::alloc_fail
 //       Access: Protected, Virtual
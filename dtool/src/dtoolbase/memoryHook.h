@@ -66,6 +66,7 @@ public:
   virtual void mark_pointer(void *ptr, size_t orig_size, ReferenceCount *ref_ptr);
 
   DeletedBufferChain *get_deleted_chain(size_t buffer_size);
+  void write_deleted_chains(ostream &out);
 
   virtual void alloc_fail();
 
@@ -74,6 +75,15 @@ private:
   INLINE static void *alloc_to_ptr(void *alloc, size_t size);
   INLINE static void *ptr_to_alloc(void *ptr, size_t &size);
 
+#ifdef DO_MEMORY_USAGE
+  INLINE static void set_sampled(void *ptr);
+  INLINE static bool is_sampled(void *ptr);
+
+  // The top bit of the size we store with each allocation marks the
+  // ones sampled by MemoryProfiler.
+  static const size_t sampled_bit = ~(~(size_t)0 >> 1);
+#endif  // DO_MEMORY_USAGE
+
 #ifdef DO_MEMORY_USAGE
 protected:
   TVOLATILE AtomicAdjust::Integer _total_heap_single_size;
@@ -0,0 +1,508 @@
+// Filename: memoryProfiler.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "memoryProfiler.h"
+
+#ifdef DO_MEMORY_USAGE
+
+#include "typeHandle.h"
+#include "typeRegistry.h"
+#include "addHash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/time.h>
+#if defined(__GLIBC__) || defined(IS_OSX)
+#include <execinfo.h>
+#define HAVE_BACKTRACE 1
+#endif
+#endif  // WIN32
+
+bool MemoryProfiler::_active = false;
+size_t MemoryProfiler::_sample_interval = 0;
+TVOLATILE AtomicAdjust::Integer MemoryProfiler::_countdown = 0;
+TVOLATILE AtomicAdjust::Integer MemoryProfiler::_type_countdown = 0;
+unsigned int MemoryProfiler::_random_seed = 1;
+MutexImpl *MemoryProfiler::_lock = NULL;
+MemoryProfiler::CallSite *MemoryProfiler::_call_sites = NULL;
+int MemoryProfiler::_num_call_sites = 0;
+int *MemoryProfiler::_call_site_index = NULL;
+MemoryProfiler::Sample *MemoryProfiler::_samples = NULL;
+size_t MemoryProfiler::_samples_size = 0;
+size_t MemoryProfiler::_num_samples = 0;
+MemoryProfiler::TypeRecord *MemoryProfiler::_types = NULL;
+int MemoryProfiler::_num_types = 0;
+double MemoryProfiler::_start_time = 0.0;
+double MemoryProfiler::_last_report_time = 0.0;
+
+// The number of frames at the top of each captured stack that belong
+// to record_alloc() and to MemoryHook itself.
+static const int num_skip_frames = 2;
+
+// The number of slots in _call_site_index.  This must be a power of
+// two, comfortably larger than max_call_sites.
+static const int call_site_index_size = 8192;
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::start
+//       Access: Public, Static
+//  Description: Begins taking samples, about one for every
+//               sample_interval bytes allocated.  If the profiler is
+//               already active, this just changes the interval.
+//
+//               This should not be called from more than one thread
+//               at a time.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+start(size_t sample_interval) {
+  if (_lock == (MutexImpl *)NULL) {
+    _lock = new MutexImpl;
+  }
+
+  // The countdown must fit comfortably in an AtomicAdjust::Integer.
+  sample_interval = max(sample_interval, (size_t)1);
+  sample_interval = min(sample_interval, (size_t)0x10000000);
+
+  _lock->acquire();
+  if (_call_sites == (CallSite *)NULL) {
+    _call_sites = (CallSite *)calloc(max_call_sites, sizeof(CallSite));
+    _call_site_index = (int *)malloc(call_site_index_size * sizeof(int));
+    for (int i = 0; i < call_site_index_size; ++i) {
+      _call_site_index[i] = -1;
+    }
+    // The first call site, with no frames, is reserved for the
+    // overflow.
+    _num_call_sites = 1;
+
+    _samples_size = 1024;
+    _samples = (Sample *)calloc(_samples_size, sizeof(Sample));
+    _num_samples = 0;
+  }
+
+  _sample_interval = sample_interval;
+  AtomicAdjust::set(_countdown, next_countdown());
+  AtomicAdjust::set(_type_countdown, next_countdown());
+
+  if (!_active) {
+    _start_time = get_time();
+    _last_report_time = _start_time;
+    _active = true;
+  }
+  _lock->release();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::stop
+//       Access: Public, Static
+//  Description: Stops taking new samples.  The samples taken so far
+//               are kept, and are still removed as their allocations
+//               are freed.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+stop() {
+  _active = false;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::record_alloc
+//       Access: Public, Static
+//  Description: Records a sample for the allocation at the indicated
+//               pointer, which should_sample() has chosen.  MemoryHook
+//               remembers which allocations were sampled, and calls
+//               record_free() only for those.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+record_alloc(void *ptr, size_t size) {
+  // The stack is captured right here, rather than in a helper
+  // function that might or might not be inlined, so that we know how
+  // many frames to skip.
+  void *frames[max_frames];
+  int num_frames = 0;
+#if defined(WIN32)
+  num_frames = (int)RtlCaptureStackBackTrace(num_skip_frames, max_frames, frames, NULL);
+#elif defined(HAVE_BACKTRACE)
+  void *buffer[max_frames + num_skip_frames];
+  num_frames = backtrace(buffer, max_frames + num_skip_frames) - num_skip_frames;
+  if (num_frames > 0) {
+    memcpy(frames, buffer + num_skip_frames, num_frames * sizeof(void *));
+  } else {
+    num_frames = 0;
+  }
+#endif
+
+  size_t weight = get_weight(size);
+
+  _lock->acquire();
+  int site = find_call_site(frames, num_frames);
+  CallSite &call_site = _call_sites[site];
+  call_site._live_bytes += weight;
+  call_site._total_bytes += weight;
+  ++call_site._live_samples;
+  ++call_site._total_samples;
+
+  insert_sample(ptr, site, weight);
+  _lock->release();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::record_free
+//       Access: Public, Static
+//  Description: Removes the sample previously recorded for the
+//               indicated pointer, which is about to be freed.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+record_free(void *ptr) {
+  if (_lock == (MutexImpl *)NULL) {
+    return;
+  }
+
+  _lock->acquire();
+  int site;
+  size_t weight;
+  if (remove_sample(ptr, site, weight)) {
+    CallSite &call_site = _call_sites[site];
+    call_site._live_bytes -= weight;
+    --call_site._live_samples;
+  }
+  _lock->release();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::record_type_alloc
+//       Access: Public, Static
+//  Description: Records a sample for an allocation of the indicated
+//               type, which should_sample_type() has chosen.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+record_type_alloc(TypeHandle type, size_t size) {
+  int index = type.get_index();
+  if (index <= 0) {
+    return;
+  }
+
+  _lock->acquire();
+  if (index >= _num_types) {
+    int new_num_types = max(index + 1, _num_types * 2);
+    TypeRecord *new_types = (TypeRecord *)realloc(_types, new_num_types * sizeof(TypeRecord));
+    if (new_types == (TypeRecord *)NULL) {
+      _lock->release();
+      return;
+    }
+    memset(new_types + _num_types, 0, (new_num_types - _num_types) * sizeof(TypeRecord));
+    _types = new_types;
+    _num_types = new_num_types;
+  }
+  _types[index]._total_bytes += get_weight(size);
+  _lock->release();
+}
+
+// Used to sort the call sites and types in a report, largest first.
+class SortIndicesByValue {
+public:
+  SortIndicesByValue(const size_t *values) : _values(values) { }
+  bool operator () (int a, int b) const {
+    return _values[a] > _values[b];
+  }
+  const size_t *_values;
+};
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::write
+//       Access: Public, Static
+//  Description: Writes a report of the max_sites call sites with the
+//               most live bytes, and the max_types types with the
+//               highest allocation rate since the last report.
+//
+//               The byte counts for call sites are estimates, and are
+//               only meaningful when they are several times the
+//               sample interval.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+write(ostream &out, int max_sites, int max_types) {
+  if (_lock == (MutexImpl *)NULL) {
+    out << "Memory profiler has not been started.\n";
+    return;
+  }
+
+  // Copy out what we need while we hold the lock, so that we don't
+  // re-enter the profiler through the ostream while holding it.
+  _lock->acquire();
+  int num_sites = _num_call_sites;
+  CallSite *sites = (CallSite *)malloc(num_sites * sizeof(CallSite));
+  memcpy(sites, _call_sites, num_sites * sizeof(CallSite));
+  int i;
+  for (i = 0; i < num_sites; ++i) {
+    _call_sites[i]._reported_bytes = _call_sites[i]._total_bytes;
+  }
+
+  int num_types = _num_types;
+  TypeRecord *types = (TypeRecord *)malloc(max(num_types, 1) * sizeof(TypeRecord));
+  if (num_types != 0) {
+    memcpy(types, _types, num_types * sizeof(TypeRecord));
+  }
+  for (i = 0; i < num_types; ++i) {
+    _types[i]._reported_bytes = _types[i]._total_bytes;
+  }
+
+  size_t num_samples = _num_samples;
+  double now = get_time();
+  double total_time = now - _start_time;
+  double report_time = now - _last_report_time;
+  _last_report_time = now;
+  _lock->release();
+
+  report_time = max(report_time, 0.001);
+
+  out << "Memory profile, " << num_samples << " live samples of every "
+      << _sample_interval << " bytes, " << total_time << " s since start, "
+      << report_time << " s since last report:\n";
+
+  // Call sites, by live bytes.
+  size_t *live_bytes = (size_t *)malloc(num_sites * sizeof(size_t));
+  int *order = (int *)malloc(num_sites * sizeof(int));
+  int num_used = 0;
+  for (i = 0; i < num_sites; ++i) {
+    live_bytes[i] = sites[i]._live_bytes;
+    if (sites[i]._total_samples != 0) {
+      order[num_used] = i;
+      ++num_used;
+    }
+  }
+  sort(order, order + num_used, SortIndicesByValue(live_bytes));
+
+  int num_shown = min(max_sites, num_used);
+  for (int n = 0; n < num_shown; ++n) {
+    const CallSite &site = sites[order[n]];
+    double rate = (double)(site._total_bytes - site._reported_bytes) / report_time;
+    out << "  " << site._live_bytes << " bytes live in "
+        << site._live_samples << " samples, " << site._total_bytes
+        << " allocated, " << (size_t)rate << " bytes/s";
+    if (order[n] == 0) {
+      out << " (other call sites)";
+    }
+    out << "\n";
+
+#ifdef HAVE_BACKTRACE
+    char **symbols = backtrace_symbols((void *const *)site._frames, site._num_frames);
+    for (int f = 0; f < site._num_frames; ++f) {
+      out << "    " << (symbols != NULL ? symbols[f] : "?") << "\n";
+    }
+    free(symbols);
+#else
+    for (int f = 0; f < site._num_frames; ++f) {
+      out << "    " << site._frames[f] << "\n";
+    }
+#endif
+  }
+
+  free(order);
+  free(live_bytes);
+  free(sites);
+
+  // Types, by allocation rate.  The live bytes for these are exact.
+  if (num_types != 0) {
+    size_t *rate_bytes = (size_t *)malloc(num_types * sizeof(size_t));
+    order = (int *)malloc(num_types * sizeof(int));
+    num_used = 0;
+    for (i = 0; i < num_types; ++i) {
+      rate_bytes[i] = types[i]._total_bytes - types[i]._reported_bytes;
+      if (types[i]._total_bytes != 0) {
+        order[num_used] = i;
+        ++num_used;
+      }
+    }
+    sort(order, order + num_used, SortIndicesByValue(rate_bytes));
+
+    TypeRegistry *registry = TypeRegistry::ptr();
+    int num_handles = registry->get_num_typehandles();
+    num_shown = min(max_types, num_used);
+    for (int n = 0; n < num_shown; ++n) {
+      int index = order[n];
+      if (index >= num_handles) {
+        continue;
+      }
+      TypeHandle type = registry->get_typehandle(index);
+      size_t live =
+        (size_t)type.get_memory_usage(TypeHandle::MC_singleton) +
+        (size_t)type.get_memory_usage(TypeHandle::MC_array) +
+        (size_t)type.get_memory_usage(TypeHandle::MC_deleted_chain_active);
+      out << "  " << type << ": " << live << " bytes live, "
+          << types[index]._total_bytes << " allocated, "
+          << (size_t)((double)rate_bytes[index] / report_time) << " bytes/s\n";
+    }
+
+    free(order);
+    free(rate_bytes);
+  }
+  free(types);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::get_time
+//       Access: Private, Static
+//  Description: Returns the current time in seconds, from some
+//               arbitrary starting point.  We can't use TrueClock
+//               down here in dtoolbase.
+////////////////////////////////////////////////////////////////////
+double MemoryProfiler::
+get_time() {
+#ifdef WIN32
+  return (double)GetTickCount() / 1000.0;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, (struct timezone *)NULL);
+  return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::find_call_site
+//       Access: Private, Static
+//  Description: Returns the index of the call site with the
+//               indicated stack, adding a new one if necessary.
+//               Returns 0, the overflow site, if the table is full.
+//               Assumes the lock is held.
+////////////////////////////////////////////////////////////////////
+int MemoryProfiler::
+find_call_site(void **frames, int num_frames) {
+  if (num_frames == 0) {
+    return 0;
+  }
+
+  size_t hash = AddHash::add_hash(0, (const PN_uint8 *)frames,
+                                  num_frames * sizeof(void *));
+  size_t slot = hash & (call_site_index_size - 1);
+  while (_call_site_index[slot] != -1) {
+    CallSite &site = _call_sites[_call_site_index[slot]];
+    if (site._hash == hash && site._num_frames == num_frames &&
+        memcmp(site._frames, frames, num_frames * sizeof(void *)) == 0) {
+      return _call_site_index[slot];
+    }
+    slot = (slot + 1) & (call_site_index_size - 1);
+  }
+
+  if (_num_call_sites >= max_call_sites) {
+    return 0;
+  }
+
+  int index = _num_call_sites;
+  ++_num_call_sites;
+  CallSite &site = _call_sites[index];
+  site._hash = hash;
+  site._num_frames = num_frames;
+  memcpy(site._frames, frames, num_frames * sizeof(void *));
+  _call_site_index[slot] = index;
+  return index;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::insert_sample
+//       Access: Private, Static
+//  Description: Adds the indicated pointer to the table of live
+//               samples.  Assumes the lock is held.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+insert_sample(void *ptr, int site, size_t weight) {
+  if ((_num_samples + 1) * 2 > _samples_size) {
+    grow_samples();
+  }
+
+  size_t mask = _samples_size - 1;
+  size_t slot = hash_pointer(ptr) & mask;
+  while (_samples[slot]._ptr != NULL) {
+    slot = (slot + 1) & mask;
+  }
+  _samples[slot]._ptr = ptr;
+  _samples[slot]._site = site;
+  _samples[slot]._weight = weight;
+  ++_num_samples;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::remove_sample
+//       Access: Private, Static
+//  Description: Removes the indicated pointer from the table of live
+//               samples, filling in the site and weight it was
+//               recorded with.  Returns false if it was not there.
+//               Assumes the lock is held.
+////////////////////////////////////////////////////////////////////
+bool MemoryProfiler::
+remove_sample(void *ptr, int &site, size_t &weight) {
+  size_t mask = _samples_size - 1;
+  size_t slot = hash_pointer(ptr) & mask;
+  while (_samples[slot]._ptr != ptr) {
+    if (_samples[slot]._ptr == NULL) {
+      return false;
+    }
+    slot = (slot + 1) & mask;
+  }
+  site = _samples[slot]._site;
+  weight = _samples[slot]._weight;
+  --_num_samples;
+
+  // Close up the gap, so that the entries after it can still be
+  // found without tombstones.
+  size_t gap = slot;
+  size_t next = (slot + 1) & mask;
+  while (_samples[next]._ptr != NULL) {
+    size_t home = hash_pointer(_samples[next]._ptr) & mask;
+    // Move this entry into the gap unless its home lies cyclically
+    // within (gap, next].
+    bool stays = (gap <= next) ? (gap < home && home <= next)
+                               : (gap < home || home <= next);
+    if (!stays) {
+      _samples[gap] = _samples[next];
+      gap = next;
+    }
+    next = (next + 1) & mask;
+  }
+  _samples[gap]._ptr = NULL;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryProfiler::grow_samples
+//       Access: Private, Static
+//  Description: Doubles the size of the table of live samples.
+//               Assumes the lock is held.
+////////////////////////////////////////////////////////////////////
+void MemoryProfiler::
+grow_samples() {
+  Sample *old_samples = _samples;
+  size_t old_size = _samples_size;
+
+  _samples_size = old_size * 2;
+  _samples = (Sample *)calloc(_samples_size, sizeof(Sample));
+  _num_samples = 0;
+
+  size_t mask = _samples_size - 1;
+  for (size_t i = 0; i < old_size; ++i) {
+    if (old_samples[i]._ptr != NULL) {
+      size_t slot = hash_pointer(old_samples[i]._ptr) & mask;
+      while (_samples[slot]._ptr != NULL) {
+        slot = (slot + 1) & mask;
+      }
+      _samples[slot] = old_samples[i];
+      ++_num_samples;
+    }
+  }
+  free(old_samples);
+}
+
+#endif  // DO_MEMORY_USAGE
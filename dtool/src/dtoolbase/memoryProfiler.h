@@ -0,0 +1,139 @@
+// Filename: memoryProfiler.h
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef MEMORYPROFILER_H
+#define MEMORYPROFILER_H
+
+#include "dtoolbase.h"
+
+#ifdef DO_MEMORY_USAGE
+
+#include "atomicAdjust.h"
+#include "mutexImpl.h"
+
+class TypeHandle;
+
+////////////////////////////////////////////////////////////////////
+//       Class : MemoryProfiler
+// Description : A sampling allocation profiler.  While it is active,
+//               MemoryHook hands it roughly one allocation for every
+//               sample_interval bytes allocated from the heap, and it
+//               records the call stack of each one.  The samples are
+//               totalled by call site, giving an estimate of the live
+//               bytes and the allocation rate of each site at a small
+//               fraction of the cost of track-memory-usage.
+//
+//               Allocations reported to TypeHandle::inc_memory_usage()
+//               are sampled in the same way, to estimate the
+//               allocation rate of each type; the live bytes of each
+//               type are already known exactly by the TypeHandle.
+//
+//               This is normally started by the profile-memory-usage
+//               config variable, and reported with
+//               MemoryUsage::show_profile().
+////////////////////////////////////////////////////////////////////
+class EXPCL_DTOOL MemoryProfiler {
+public:
+  static void start(size_t sample_interval);
+  static void stop();
+  INLINE static bool is_active();
+  INLINE static size_t get_sample_interval();
+
+  INLINE static bool should_sample(size_t size);
+  static void record_alloc(void *ptr, size_t size);
+  static void record_free(void *ptr);
+
+  INLINE static bool should_sample_type(size_t size);
+  static void record_type_alloc(TypeHandle type, size_t size);
+
+  static void write(ostream &out, int max_sites = 20, int max_types = 20);
+
+private:
+  INLINE static bool check_countdown(TVOLATILE AtomicAdjust::Integer &countdown,
+                                     size_t size);
+  INLINE static AtomicAdjust::Integer next_countdown();
+  INLINE static size_t get_weight(size_t size);
+  static double get_time();
+
+  enum {
+    max_frames = 16,
+
+    // The first call site collects all the samples that don't fit in
+    // the table.
+    max_call_sites = 4096,
+  };
+
+  class CallSite {
+  public:
+    size_t _hash;
+    int _num_frames;
+    void *_frames[max_frames];
+
+    size_t _live_bytes;
+    size_t _total_bytes;
+    size_t _reported_bytes;
+    int _live_samples;
+    int _total_samples;
+  };
+
+  class Sample {
+  public:
+    void *_ptr;
+    int _site;
+    size_t _weight;
+  };
+
+  class TypeRecord {
+  public:
+    size_t _total_bytes;
+    size_t _reported_bytes;
+  };
+
+  static int find_call_site(void **frames, int num_frames);
+  static void insert_sample(void *ptr, int site, size_t weight);
+  static bool remove_sample(void *ptr, int &site, size_t &weight);
+  static void grow_samples();
+  INLINE static size_t hash_pointer(void *ptr);
+
+  static bool _active;
+  static size_t _sample_interval;
+  static TVOLATILE AtomicAdjust::Integer _countdown;
+  static TVOLATILE AtomicAdjust::Integer _type_countdown;
+  static unsigned int _random_seed;
+
+  // All of the following are protected by _lock.  They are allocated
+  // with the system malloc(), since they are used from within
+  // MemoryHook.
+  static MutexImpl *_lock;
+
+  static CallSite *_call_sites;
+  static int _num_call_sites;
+  static int *_call_site_index;
+
+  static Sample *_samples;
+  static size_t _samples_size;
+  static size_t _num_samples;
+
+  static TypeRecord *_types;
+  static int _num_types;
+
+  static double _start_time;
+  static double _last_report_time;
+};
+
+#include "memoryProfiler.I"
+
+#endif  // DO_MEMORY_USAGE
+
+#endif
@@ -15,6 +15,7 @@
 #include "typeHandle.h"
 #include "typeRegistryNode.h"
 #include "atomicAdjust.h"
+#include "memoryProfiler.h"
 
 // This is initialized to zero by static initialization.
 TypeHandle TypeHandle::_none;
@@ -75,6 +76,9 @@ inc_memory_usage(MemoryClass memory_class, int size) {
     TypeRegistryNode *rnode = TypeRegistry::ptr()->look_up(*this, NULL);
     assert(rnode != (TypeRegistryNode *)NULL);
     AtomicAdjust::add(rnode->_memory_usage[memory_class], (AtomicAdjust::Integer)size);
+    if (size > 0 && MemoryProfiler::should_sample_type((size_t)size)) {
+      MemoryProfiler::record_type_alloc(*this, (size_t)size);
+    }
     //    cerr << *this << ".inc(" << memory_class << ", " << size << ") -> " << rnode->_memory_usage[memory_class] << "\n";
     assert(rnode->_memory_usage[memory_class] >= 0);
   }
@@ -65,6 +65,7 @@ register_type(TypeHandle &type_handle, const string &name) {
     _handle_registry.push_back(rnode);
     _name_registry[name] = rnode;
     _derivations_fresh = false;
+    publish_node(rnode);
 
     type_handle = new_handle;
     _lock->release();
@@ -143,6 +144,7 @@ register_dynamic_type(const string &name) {
     _handle_registry.push_back(rnode);
     _name_registry[name] = rnode;
     _derivations_fresh = false;
+    publish_node(rnode);
 
     _lock->release();
     return *new_handle;
@@ -182,6 +184,7 @@ record_derivation(TypeHandle child, TypeHandle parent) {
     cnode->_parent_classes.push_back(pnode);
     pnode->_child_classes.push_back(cnode);
     _derivations_fresh = false;
+    clear_ancestors(cnode);
   }
 
   _lock->release();
@@ -299,15 +302,34 @@ get_name(TypeHandle type, TypedObject *object) const {
 bool TypeRegistry::
 is_derived_from(TypeHandle child, TypeHandle base,
                 TypedObject *child_object) {
+  // Usually, the child's ancestors have already been computed, and we
+  // can answer without the lock.
+  if (base._index > 0) {
+    const TypeRegistryNode *child_node = look_up_published(child);
+    if (child_node != (TypeRegistryNode *)NULL) {
+      const TypeRegistryNode::Ancestors *ancestors = child_node->get_ancestors();
+      if (ancestors != (TypeRegistryNode::Ancestors *)NULL) {
+        return TypeRegistryNode::has_ancestor(ancestors, base._index);
+      }
+    }
+  }
+
   _lock->acquire();
 
-  const TypeRegistryNode *child_node = look_up(child, child_object);
+  TypeRegistryNode *child_node = look_up(child, child_object);
   const TypeRegistryNode *base_node = look_up(base, (TypedObject *)NULL);
   assert(child_node != (TypeRegistryNode *)NULL &&
          base_node != (TypeRegistryNode *)NULL);
   freshen_derivations();
 
   bool result = TypeRegistryNode::is_derived_from(child_node, base_node);
+
+  // Compute the child's ancestors now, so that the next query can
+  // skip the lock.
+  if (child_node->get_ancestors() == (TypeRegistryNode::Ancestors *)NULL) {
+    child_node->set_ancestors(child_node->make_ancestors());
+  }
+
   _lock->release();
   return result;
 }
@@ -574,6 +596,7 @@ TypeRegistry() {
   _handle_registry.push_back(NULL);
 
   _derivations_fresh = false;
+  _node_table = NULL;
 
   // Here's a few sanity checks on the sizes of our words.  We have to
   // put it here, at runtime, since there doesn't appear to be a
@@ -681,6 +704,74 @@ write_node(ostream &out, int indent_level, const TypeRegistryNode *node) const {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: TypeRegistry::look_up_published
+//       Access: Private
+//  Description: Returns the TypeRegistryNode associated with the
+//               indicated TypeHandle, as published by
+//               publish_node(), or NULL if it has not been published.
+//               Unlike look_up(), this may be called without holding
+//               the lock.
+////////////////////////////////////////////////////////////////////
+TypeRegistryNode *TypeRegistry::
+look_up_published(TypeHandle handle) const {
+  const NodeTable *table = (const NodeTable *)AtomicAdjust::get_ptr(_node_table);
+  if (table == (NodeTable *)NULL ||
+      handle._index <= 0 || handle._index >= (int)table->size()) {
+    return NULL;
+  }
+  return (TypeRegistryNode *)AtomicAdjust::get_ptr((*table)[handle._index]);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TypeRegistry::publish_node
+//       Access: Private
+//  Description: Makes a newly-registered node visible to
+//               look_up_published().  The lock should be held.
+////////////////////////////////////////////////////////////////////
+void TypeRegistry::
+publish_node(TypeRegistryNode *rnode) {
+  int index = rnode->_handle._index;
+  NodeTable *table = (NodeTable *)_node_table;
+  if (table != (NodeTable *)NULL && index < (int)table->size()) {
+    AtomicAdjust::set_ptr((*table)[index], rnode);
+    return;
+  }
+
+  // The table is full; make a new one, twice the size, with all of
+  // the nodes so far.
+  NodeTable *new_table = new NodeTable(max(index * 2, 256), (void *)NULL);
+  for (size_t i = 0; i < _handle_registry.size(); ++i) {
+    (*new_table)[i] = _handle_registry[i];
+  }
+  AtomicAdjust::set_ptr(_node_table, new_table);
+  if (table != (NodeTable *)NULL) {
+    _retired_tables.push_back(table);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TypeRegistry::clear_ancestors
+//       Access: Private
+//  Description: Discards the computed ancestors of the indicated node
+//               and all of its descendants, after a derivation has
+//               been recorded for it.  The lock should be held.
+////////////////////////////////////////////////////////////////////
+void TypeRegistry::
+clear_ancestors(TypeRegistryNode *rnode) {
+  TypeRegistryNode::Ancestors *ancestors = rnode->set_ancestors(NULL);
+  if (ancestors != (TypeRegistryNode::Ancestors *)NULL) {
+    _retired_ancestors.push_back(ancestors);
+  }
+
+  TypeRegistryNode::Classes::iterator ci;
+  for (ci = rnode->_child_classes.begin();
+       ci != rnode->_child_classes.end();
+       ++ci) {
+    clear_ancestors(*ci);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: TypeRegistry::look_up
 //       Access: Private
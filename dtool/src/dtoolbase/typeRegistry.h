@@ -87,6 +87,9 @@ private:
 
   static void init_global_pointer();
   TypeRegistryNode *look_up(TypeHandle type, TypedObject *object) const;
+  TypeRegistryNode *look_up_published(TypeHandle type) const;
+  void publish_node(TypeRegistryNode *rnode);
+  void clear_ancestors(TypeRegistryNode *rnode);
 
   INLINE void freshen_derivations();
   void rebuild_derivations();
@@ -108,6 +111,18 @@ private:
 
   bool _derivations_fresh;
 
+  // This is a copy of _handle_registry that may be read without
+  // holding the lock, so that is_derived_from() can find a type's
+  // ancestors without it.  It is replaced with a table twice the size
+  // when it fills up.  Replaced tables, and replaced ancestor lists,
+  // are kept in _retired rather than deleted, since another thread
+  // may still be reading them; there are few of them, since types
+  // are all registered early on.
+  typedef vector<void *> NodeTable;
+  void * TVOLATILE _node_table;
+  vector<NodeTable *> _retired_tables;
+  vector<void *> _retired_ancestors;
+
   static MutexImpl *_lock;
   static TypeRegistry *_global_pointer;
 
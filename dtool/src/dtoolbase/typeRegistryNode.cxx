@@ -28,6 +28,7 @@ TypeRegistryNode::
 TypeRegistryNode(TypeHandle handle, const string &name, TypeHandle &ref) :
   _handle(handle), _name(name), _ref(ref) 
 {
+  _ancestors = NULL;
   clear_subtree();
 #ifdef DO_MEMORY_USAGE
   memset(_memory_usage, 0, sizeof(_memory_usage));
@@ -219,6 +220,50 @@ define_subtree() {
   r_build_subtrees(this, 0, 0);
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: TypeRegistryNode::make_ancestors
+//       Access: Public
+//  Description: Allocates and returns a new list of the indices of
+//               this type and all of its ancestors, suitable for
+//               passing to set_ancestors().  The TypeRegistry's lock
+//               should be held.
+////////////////////////////////////////////////////////////////////
+TypeRegistryNode::Ancestors *TypeRegistryNode::
+make_ancestors() const {
+  Ancestors *ancestors = new Ancestors;
+
+  vector<const TypeRegistryNode *> stack;
+  stack.push_back(this);
+  while (!stack.empty()) {
+    const TypeRegistryNode *node = stack.back();
+    stack.pop_back();
+    ancestors->push_back(node->_handle.get_index());
+    stack.insert(stack.end(), node->_parent_classes.begin(),
+                 node->_parent_classes.end());
+  }
+
+  // A class reached by more than one path of multiple inheritance
+  // appears more than once.
+  sort(ancestors->begin(), ancestors->end());
+  ancestors->erase(unique(ancestors->begin(), ancestors->end()),
+                   ancestors->end());
+  return ancestors;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TypeRegistryNode::set_ancestors
+//       Access: Public
+//  Description: Replaces the list returned by get_ancestors() with
+//               the indicated list, which may be NULL, and returns
+//               the previous list.  The previous list must not be
+//               deleted, since another thread may still be reading
+//               it.  The TypeRegistry's lock should be held.
+////////////////////////////////////////////////////////////////////
+TypeRegistryNode::Ancestors *TypeRegistryNode::
+set_ancestors(TypeRegistryNode::Ancestors *ancestors) {
+  return (Ancestors *)AtomicAdjust::set_ptr(_ancestors, ancestors);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: TypeRegistryNode::r_build_subtrees
 //       Access: Public
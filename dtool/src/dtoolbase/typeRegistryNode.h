@@ -19,9 +19,11 @@
 
 #include "typeHandle.h"
 #include "numeric_types.h"
+#include "atomicAdjust.h"
 
 #include <assert.h>
 #include <vector>
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////
 //       Class : TypeRegistryNode
@@ -43,6 +45,15 @@ public:
   void clear_subtree();
   void define_subtree();
 
+  // The sorted indices of this type and all of the types it inherits
+  // from, directly or indirectly.  These may be read without holding
+  // the TypeRegistry's lock.
+  typedef vector<int> Ancestors;
+  INLINE const Ancestors *get_ancestors() const;
+  INLINE static bool has_ancestor(const Ancestors *ancestors, int index);
+  Ancestors *make_ancestors() const;
+  Ancestors *set_ancestors(Ancestors *ancestors);
+
   TypeHandle _handle;
   string _name;
   TypeHandle &_ref;
@@ -95,6 +106,11 @@ private:
 
   // _visit_count is only used during r_build_subtree().
   int _visit_count;
+
+  // This is NULL until TypeRegistry::is_derived_from() first needs
+  // it, and is set back to NULL whenever a derivation is recorded for
+  // this type or one of its ancestors.
+  void * TVOLATILE _ancestors;
 };
 
 #include "typeRegistryNode.I"
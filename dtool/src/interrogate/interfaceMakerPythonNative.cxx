@@ -2211,11 +2211,28 @@ write_function_forset(ostream &out, InterfaceMaker::Object *obj,
     for (sii = remaps.begin(); sii != remaps.end(); sii ++) {
       FunctionRemap *remap = (*sii);
       if(isRemapLegal(*remap)) {
+        // Before parsing the arguments, which raises an exception
+        // that we would have to clear again if they don't match,
+        // check that the positional arguments are at least of the
+        // right sort for this overload.
+        string type_check;
+        if (!func->_ifunc.is_unary_op()) {
+          type_check = get_parameter_type_check(remap, coercion_possible);
+        }
         if (remap->_has_this && !remap->_const_method) {
           // If it's a non-const method, we only allow a
           // non-const this.
           indent(out,indent_level) 
-            << "if (!((Dtool_PyInstDef *)self)->_is_const) {\n";
+            << "if (!((Dtool_PyInstDef *)self)->_is_const";
+          if (!type_check.empty()) {
+            out << " &&\n";
+            indent(out, indent_level + 4)
+              << "(" << type_check << ")";
+          }
+          out << ") {\n";
+        } else if (!type_check.empty()) {
+          indent(out, indent_level)
+            << "if (" << type_check << ") {\n";
         } else {
           indent(out, indent_level)
             << "{\n";
@@ -2317,6 +2334,102 @@ write_function_forset(ostream &out, InterfaceMaker::Object *obj,
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: InterfaceMakerPythonNative::get_parameter_type_check
+//       Access: Private
+//  Description: Returns a C++ expression that is false if the
+//               arguments passed to the wrapper function certainly
+//               cannot be parsed for the indicated overload, or the
+//               empty string if there is nothing worth checking.
+//               This only looks at the length of the argument tuple
+//               and the Python type of each argument, so it is much
+//               cheaper than attempting the parse and clearing the
+//               resulting exception.
+//
+//               The check is conservative: it passes any arguments
+//               that the parse might accept, and it always passes
+//               when there are keyword arguments.
+////////////////////////////////////////////////////////////////////
+string InterfaceMakerPythonNative::
+get_parameter_type_check(FunctionRemap *remap, bool coercion_possible) {
+  if (remap->_type == FunctionRemap::T_constructor &&
+      (remap->_flags & FunctionRemap::F_explicit_self) != 0) {
+    return string();
+  }
+
+  string type_check;
+  int num_args = 0;
+
+  int pn;
+  for (pn = 0; pn < (int)remap->_parameters.size(); pn++) {
+    if (remap->_has_this && pn == 0) {
+      // The "this" pointer isn't in the argument tuple.
+      continue;
+    }
+
+    CPPType *orig_type = remap->_parameters[pn]._remap->get_orig_type();
+    CPPType *type = remap->_parameters[pn]._remap->get_new_type();
+
+    ostringstream arg;
+    arg << "PyTuple_GET_ITEM(args, " << num_args << ")";
+    ++num_args;
+
+    // Each case here must match the way write_function_instance()
+    // parses the same parameter.
+    if (remap->_parameters[pn]._remap->new_type_is_atomic_string()) {
+      if (TypeManager::is_char_pointer(orig_type)) {
+        // The "s" format takes a string or a unicode.
+        type_check += " && (PyString_Check(" + arg.str() + ") || PyUnicode_Check(" + arg.str() + "))";
+      } else if (TypeManager::is_wstring(orig_type) ||
+                 TypeManager::is_const_ptr_to_basic_string_wchar(orig_type)) {
+        // The "U" format takes only a unicode.
+        type_check += " && PyUnicode_Check(" + arg.str() + ")";
+      } else {
+        // The "s#" format also takes any object with a read buffer,
+        // which is too much to check for here.
+      }
+
+    } else if (TypeManager::is_bool(type)) {
+      // Anything can be a bool.
+
+    } else if (TypeManager::is_unsigned_longlong(type) ||
+               TypeManager::is_longlong(type) ||
+               TypeManager::is_unsigned_integer(type)) {
+      // These are converted with PyNumber_Long(), which also takes
+      // strings and buffers that spell a number.
+
+    } else if (TypeManager::is_integer(type) || TypeManager::is_float(type)) {
+      // The "i" and "d" formats need an object that can become an int
+      // or a float, which is what PyNumber_Check() looks for.
+      type_check += " && PyNumber_Check(" + arg.str() + ")";
+
+    } else if (TypeManager::is_char_pointer(type)) {
+      type_check += " && (PyString_Check(" + arg.str() + ") || PyUnicode_Check(" + arg.str() + "))";
+
+    } else if (TypeManager::is_pointer_to_PyObject(type)) {
+      // Anything is a PyObject.
+
+    } else if (TypeManager::is_pointer(type)) {
+      // Only a Panda object can be converted to a class pointer,
+      // unless we are trying parameter coercion.
+      type_check += " && (DtoolCanThisBeAPandaInstance(" + arg.str() + ")";
+      if (coercion_possible) {
+        type_check += " || coerced_ptr != NULL";
+      }
+      type_check += ")";
+    }
+  }
+
+  if (type_check.empty() && num_args == 0) {
+    return string();
+  }
+
+  ostringstream result;
+  result << "kwds != NULL || !PyTuple_Check(args) || (PyTuple_GET_SIZE(args) == "
+         << num_args << type_check << ")";
+  return result.str();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: InterfaceMakerPythonNative::write_function_instance
 //       Access: Private
@@ -2619,7 +2732,12 @@ write_function_instance(ostream &out, InterfaceMaker::Object *obj,
       indent(out,indent_level)
         << "// Special Case to Make operator work \n";
       indent(out,indent_level)
-        << "if(PyTuple_Check(args) || (kwds != NULL && PyDict_Check(kwds)))\n";
+        << "if(PyTuple_Check(args) && kwds == NULL)\n";
+      indent(out,indent_level)
+        << "    (PyArg_ParseTuple(args, \"" 
+        << format_specifiers1 << "\"" << parameter_list << "));\n";
+      indent(out,indent_level)
+        << "else if(PyTuple_Check(args) || (kwds != NULL && PyDict_Check(kwds)))\n";
       indent(out,indent_level)
         << "    (PyArg_ParseTupleAndKeywords(args,kwds, \"" 
         << format_specifiers1 << "\", key_word_list" << parameter_list
@@ -2633,8 +2751,15 @@ write_function_instance(ostream &out, InterfaceMaker::Object *obj,
         << "if(!PyErr_Occurred())\n";
 
     } else {
+      // Most calls have no keyword arguments, and PyArg_ParseTuple()
+      // is a good deal cheaper than matching up the keyword list.
+      indent(out,indent_level)
+        << "if (kwds == NULL ?\n";
+      indent(out,indent_level)
+        << "    PyArg_ParseTuple(args, \""
+        << format_specifiers1 << "\"" << parameter_list << ") :\n";
       indent(out,indent_level)
-        << "if (PyArg_ParseTupleAndKeywords(args,kwds, \"" 
+        << "    PyArg_ParseTupleAndKeywords(args,kwds, \"" 
         << format_specifiers1 << "\", key_word_list"
         << parameter_list << "))\n";
     }
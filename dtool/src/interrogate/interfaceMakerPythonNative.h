@@ -96,6 +96,7 @@ private:
   
   void write_function_forset(ostream &out, Object *obj, Function *func,
                              std::set< FunctionRemap *> &remaps, string &expected_params, int indent_level , ostream &forwarddecl,const std::string &functionname, bool inplace) ;
+  string get_parameter_type_check(FunctionRemap *remap, bool coercion_possible);
   
   void pack_return_value(ostream &out, int indent_level,
                          FunctionRemap *remap, std::string return_expr ,  ostream &forwarddecl, bool in_place);
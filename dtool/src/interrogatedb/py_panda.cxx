@@ -47,13 +47,23 @@ bool DtoolCanThisBeAPandaInstance(PyObject *self)
 //  These are the wrappers that allow for down and upcast from type .. 
 //      needed by the Dtool py interface.. Be very careful if you muck with these
 //      as the generated code depends on how this is set up..
+//
+//      This is called for the "this" pointer of every method call, and
+//      nearly always on an object of exactly the class that defines the
+//      method, so we check for that before walking the upcast chain.
 ////////////////////////////////////////////////////////////////////////
 void DTOOL_Call_ExtractThisPointerForType(PyObject *self, Dtool_PyTypedObject * classdef, void ** answer)
 {
     if(DtoolCanThisBeAPandaInstance(self))
-        *answer = ((Dtool_PyInstDef *)self)->_My_Type->_Dtool_UpcastInterface(self,classdef);
+    {
+        Dtool_PyInstDef * pyself = (Dtool_PyInstDef *) self;
+        if(pyself->_My_Type == classdef)
+            *answer = pyself->_ptr_to_object;
+        else
+            *answer = pyself->_My_Type->_Dtool_UpcastInterface(self,classdef);
+    }
     else
-        answer = NULL;
+        *answer = NULL;
 };
 
 ////////////////////////////////////////////////////////////////////
@@ -171,7 +181,13 @@ DTOOL_Call_GetPointerThisClass(PyObject *self, Dtool_PyTypedObject *classdef,
   if (self != NULL) {
     if (DtoolCanThisBeAPandaInstance(self)) {
       Dtool_PyTypedObject *my_type = ((Dtool_PyInstDef *)self)->_My_Type;
-      void *result = my_type->_Dtool_UpcastInterface(self, classdef);
+      void *result;
+      if (my_type == classdef) {
+        // The common case: no upcast is needed.
+        result = ((Dtool_PyInstDef *)self)->_ptr_to_object;
+      } else {
+        result = my_type->_Dtool_UpcastInterface(self, classdef);
+      }
       if (result != NULL) {
         if (const_ok || !((Dtool_PyInstDef *)self)->_is_const) {
           return result;
@@ -1319,6 +1319,7 @@ DTOOL_CONFIG=[
     ("REPORT_OPENSSL_ERRORS",          '1',                      '1'),
     ("USE_PANDAFILESTREAM",            '1',                      '1'),
     ("USE_DELETED_CHAIN",              '1',                      '1'),
+    ("USE_DELETED_CHAIN_MAGAZINES",    '1',                      '1'),
     ("HAVE_GL",                        '1',                      'UNDEF'),
     ("HAVE_GLES",                      'UNDEF',                  'UNDEF'),
     ("HAVE_GLES2",                     'UNDEF',                  'UNDEF'),
@@ -3583,6 +3584,7 @@ if (PkgSkip("PYTHON")==0 and PkgSkip("DIRECT")==0):
   TargetAdd('distributed_cConnectionRepository.obj', opts=OPTS, input='cConnectionRepository.cxx')
   TargetAdd('distributed_cDistributedSmoothNodeBase.obj', opts=OPTS, input='cDistributedSmoothNodeBase.cxx')
   IGATEFILES=GetDirectoryContents('direct/src/distributed', ["*.h", "*.cxx"])
+  IGATEFILES.remove("test_smooth_delta.cxx")
   TargetAdd('libdistributed.in', opts=OPTS, input=IGATEFILES)
   TargetAdd('libdistributed.in', opts=['IMOD:p3direct', 'ILIB:libdistributed', 'SRCDIR:direct/src/distributed'])
   TargetAdd('libdistributed_igate.obj', input='libdistributed.in', opts=["DEPENDENCYONLY"])
@@ -4013,6 +4015,14 @@ if (PkgSkip("PANDATOOL")==0):
   TargetAdd('bam-info.exe', input=COMMON_PANDA_LIBS_PYSTUB)
   TargetAdd('bam-info.exe', opts=['ADVAPI',  'FFTW'])
 
+  TargetAdd('bam-vertex-cache_bamVertexCache.obj', opts=OPTS, input='bamVertexCache.cxx')
+  TargetAdd('bam-vertex-cache.exe', input='bam-vertex-cache_bamVertexCache.obj')
+  TargetAdd('bam-vertex-cache.exe', input='libprogbase.lib')
+  TargetAdd('bam-vertex-cache.exe', input='libpandatoolbase.lib')
+  TargetAdd('bam-vertex-cache.exe', input='libpandaegg.dll')
+  TargetAdd('bam-vertex-cache.exe', input=COMMON_PANDA_LIBS_PYSTUB)
+  TargetAdd('bam-vertex-cache.exe', opts=['ADVAPI',  'FFTW'])
+
   TargetAdd('bam2egg_bamToEgg.obj', opts=OPTS, input='bamToEgg.cxx')
   TargetAdd('bam2egg.exe', input='bam2egg_bamToEgg.obj')
   TargetAdd('bam2egg.exe', input=COMMON_EGG2X_LIBS_PYSTUB)
@@ -62,6 +62,8 @@ private:
   typedef pmap<string, PT(CImpulse) > ImpulseMap;
   ImpulseMap _impulses;
 
+  friend class CMoverGroup;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -8,8 +8,13 @@
 
 TypeHandle CMoverGroup::_type_handle;
 
+// Below this many movers per thread, it's not worth waking up the
+// threads.
+static const int min_slots_per_thread = 16;
+
 CMoverGroup::
-CMoverGroup()
+CMoverGroup() :
+  _num_threads(mover_group_threads)
 {
   _dt = 1;
   _last_ft = ClockObject::get_global_clock()->get_frame_time();
@@ -17,36 +22,211 @@ CMoverGroup()
 
 CMoverGroup::
 ~CMoverGroup() {
-  while (!_movers.empty()) {
-    cerr << "removing C++ movers: " << (*_movers.begin()).first << endl;
-    remove_c_mover((*_movers.begin()).first);
+  while (!_handles.empty()) {
+    cerr << "removing C++ movers: " << (*_handles.begin()).first << endl;
+    remove_c_mover((*_handles.begin()).first);
   }
 }
 
-void CMoverGroup::
+int CMoverGroup::
 add_c_mover(const string &name, CMover *mover) {
   // if there is already a mover of this name, make sure it's removed
   // first
   remove_c_mover(name);
-  _movers[name] = mover;
+
+  int handle;
+  if (!_free_handles.empty()) {
+    handle = _free_handles.back();
+    _free_handles.pop_back();
+  } else {
+    handle = _handle_slots.size();
+    _handle_slots.push_back(-1);
+  }
+
+  int slot = _movers.size();
+  _handle_slots[handle] = slot;
+  _handles[name] = handle;
+  _movers.push_back(mover);
+  _slot_handles.push_back(handle);
+
+  for (int q = 0; q < num_quantities; ++q) {
+    for (int c = 0; c < num_components; ++c) {
+      _state[q][c].push_back(0.0f);
+    }
+  }
+
+  // The mover's velocity is kept here while it is in the group.
+  set_state(Q_vel, slot, mover->_vel);
+  set_state(Q_rot_vel, slot, mover->_rot_vel);
+
+  return handle;
 }
 
 bool CMoverGroup::
 remove_c_mover(const string &name) {
-  MoverMap::iterator mi = _movers.find(name);
-  if (mi != _movers.end()) {
-    _movers.erase(mi);
+  HandleMap::iterator hi = _handles.find(name);
+  if (hi != _handles.end()) {
+    int handle = (*hi).second;
+    _handles.erase(hi);
+    remove_slot(_handle_slots[handle]);
+    _handle_slots[handle] = -1;
+    _free_handles.push_back(handle);
     return true;
   }
   return false;
 }
 
+// find_c_mover: returns the handle of the named mover, or -1 if
+// there is no such mover in the group
+int CMoverGroup::
+find_c_mover(const string &name) const {
+  HandleMap::const_iterator hi = _handles.find(name);
+  if (hi != _handles.end()) {
+    return (*hi).second;
+  }
+  return -1;
+}
+
+// get_c_mover: returns the mover with the given handle, or NULL
+CMover *CMoverGroup::
+get_c_mover(int handle) const {
+  if (handle < 0 || handle >= (int)_handle_slots.size() ||
+      _handle_slots[handle] < 0) {
+    return (CMover *)NULL;
+  }
+  return _movers[_handle_slots[handle]];
+}
+
 void CMoverGroup::
 process_c_impulses_and_integrate() {
-  for (MoverMap::iterator mi = _movers.begin();
-       mi != _movers.end();
-       ++mi) {
-    (*mi).second->process_c_impulses(_dt);
-    (*mi).second->integrate();
+  int num_slots = _movers.size();
+
+  int num_threads = _num_threads;
+  if (num_threads > num_slots / min_slots_per_thread) {
+    num_threads = num_slots / min_slots_per_thread;
+  }
+
+  if (num_threads > 1 && Thread::is_true_threads()) {
+    // The impulses may do anything, so they are all processed here,
+    // in this thread, before any mover is integrated.  This means a
+    // mover's impulses see the other movers' nodes as they were at
+    // the start of the frame.  The integration math is then split
+    // among the threads, but the nodes are all moved here, since
+    // moving a node touches its ancestors too.
+    for (int slot = 0; slot < num_slots; ++slot) {
+      process_slot_impulses(slot);
+    }
+    IntegrateBody body(this);
+    ParallelFor::run(body, num_slots, num_threads, min_slots_per_thread);
+    move_nodes(0, num_slots);
+
+  } else {
+    // Otherwise, each mover is integrated and moved before the next
+    // mover's impulses are processed, as CMover::integrate() does.
+    for (int slot = 0; slot < num_slots; ++slot) {
+      process_slot_impulses(slot);
+      integrate_slots(slot, slot + 1);
+      move_nodes(slot, slot + 1);
+    }
+  }
+}
+
+// process_slot_impulses: processes the impulses of the mover in the
+// given slot, and gathers the forces and shoves they leave on it into
+// our arrays.
+void CMoverGroup::
+process_slot_impulses(int slot) {
+  CMover *mover = _movers[slot];
+  mover->process_c_impulses(_dt);
+
+  // As in CMover::integrate(); don't overwrite _acc etc. until the
+  // impulses have run, they might want to use last frame's data.
+  mover->_acc = mover->_acc_accum;
+  mover->_rot_acc = mover->_rot_acc_accum;
+  set_state(Q_acc, slot, mover->_acc);
+  set_state(Q_rot_acc, slot, mover->_rot_acc);
+  set_state(Q_shove, slot, mover->_shove);
+  set_state(Q_rot_shove, slot, mover->_rot_shove);
+
+  mover->_acc_accum = 0;
+  mover->_rot_acc_accum = 0;
+  mover->_shove = 0;
+  mover->_rot_shove = 0;
+}
+
+// remove_slot: removes the mover in the given slot, moving the last
+// mover into its place
+void CMoverGroup::
+remove_slot(int slot) {
+  CMover *mover = _movers[slot];
+  mover->_vel = get_state(Q_vel, slot);
+  mover->_rot_vel = get_state(Q_rot_vel, slot);
+
+  int last = _movers.size() - 1;
+  if (slot != last) {
+    _movers[slot] = _movers[last];
+    _slot_handles[slot] = _slot_handles[last];
+    _handle_slots[_slot_handles[slot]] = slot;
+    for (int q = 0; q < num_quantities; ++q) {
+      for (int c = 0; c < num_components; ++c) {
+        _state[q][c][slot] = _state[q][c][last];
+      }
+    }
+  }
+
+  _movers.pop_back();
+  _slot_handles.pop_back();
+  for (int q = 0; q < num_quantities; ++q) {
+    for (int c = 0; c < num_components; ++c) {
+      _state[q][c].pop_back();
+    }
+  }
+}
+
+// integrate_slots: integrates the movers in slots begin .. end-1,
+// computing the amount each node should move.  This touches only our
+// arrays, so it may be called from several threads at once, for
+// different slots.
+void CMoverGroup::
+integrate_slots(int begin, int end) {
+  float dt = _dt;
+  float dt2 = dt*dt;
+
+  // integreat!  Each component is done in its own loop over the
+  // slots, which the compiler can vectorize.
+  for (int c = 0; c < num_components; ++c) {
+    float *vel = &_state[Q_vel][c][0];
+    const float *acc = &_state[Q_acc][c][0];
+    const float *shove = &_state[Q_shove][c][0];
+    float *pos_delta = &_state[Q_pos_delta][c][0];
+    for (int i = begin; i < end; ++i) {
+      vel[i] += acc[i] * dt;
+      // (self.vel * dt) + (self.acc * dt2 * .5) + (self._shove * dt)
+      pos_delta[i] = (vel[i] * dt) + (acc[i] * dt2 * .5f) + (shove[i] * dt);
+    }
+
+    float *rot_vel = &_state[Q_rot_vel][c][0];
+    const float *rot_acc = &_state[Q_rot_acc][c][0];
+    const float *rot_shove = &_state[Q_rot_shove][c][0];
+    float *hpr_delta = &_state[Q_hpr_delta][c][0];
+    for (int i = begin; i < end; ++i) {
+      rot_vel[i] += rot_acc[i] * dt;
+      // (self.rotVel * dt) + (self.rotAcc * dt2 * .5) + (self._rotShove * dt)
+      hpr_delta[i] = (rot_vel[i] * dt) + (rot_acc[i] * dt2 * .5f) + (rot_shove[i] * dt);
+    }
+  }
+}
+
+// move_nodes: moves the nodes of the movers in slots begin .. end-1
+// by the amounts computed by integrate_slots().  Moving a node marks
+// the bounds of its ancestors stale, which is not safe to do from
+// several threads at once, so this is only called from the thread
+// that called process_c_impulses_and_integrate().
+void CMoverGroup::
+move_nodes(int begin, int end) {
+  for (int i = begin; i < end; ++i) {
+    NodePath &node_path = _movers[i]->_node_path;
+    node_path.set_fluid_pos(node_path, get_state(Q_pos_delta, i));
+    node_path.set_hpr(node_path, get_state(Q_hpr_delta, i));
   }
 }
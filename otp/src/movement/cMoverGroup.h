@@ -12,13 +12,24 @@
 #include "nodePath.h"
 #include "luse.h"
 #include "pmap.h"
+#include "pvector.h"
 #include "cMover.h"
 #include "clockObject.h"
+#include "parallelFor.h"
 
 /* 
 This class allows multiple CMovers to be moved in one efficient pass.
 MoverGroup.py derives from this and allows multiple Python Movers to
 be moved in one pass.
+
+Each mover is also given an integer handle when it is added.  The
+velocities of the movers, and the forces and shoves gathered from
+their impulses each frame, are kept here in parallel arrays, one
+entry per mover, so that they can be integrated together in tight
+loops.  If set_num_threads() is more than 1, the integration is
+split among that many threads of the shared ParallelFor pool.  The
+impulses are always processed, and the nodes always moved, in the
+calling thread.
 */
 
 class EXPCL_OTP CMoverGroup : public TypedReferenceCount {
@@ -26,9 +37,16 @@ PUBLISHED:
   CMoverGroup();
   ~CMoverGroup();
 
-  void add_c_mover(const string &name, CMover *mover);
+  int add_c_mover(const string &name, CMover *mover);
   bool remove_c_mover(const string &name);
 
+  INLINE int get_num_c_movers() const;
+  int find_c_mover(const string &name) const;
+  CMover *get_c_mover(int handle) const;
+
+  INLINE void set_num_threads(int num_threads);
+  INLINE int get_num_threads() const;
+
   INLINE float set_dt(float dt = -1);
   INLINE float get_dt() const;
 
@@ -38,11 +56,59 @@ PUBLISHED:
   void process_c_impulses_and_integrate();
 
 private:
+  void remove_slot(int slot);
+  void process_slot_impulses(int slot);
+  void integrate_slots(int begin, int end);
+  void move_nodes(int begin, int end);
+
   float _dt;
   float _last_ft;
 
-  typedef pmap<string, PT(CMover) > MoverMap;
-  MoverMap _movers;
+  // The movers are packed into slots 0 .. n-1; removing one moves
+  // the last mover into its slot.  Handles stay the same for the
+  // life of the mover, and are mapped to and from slots here.
+  typedef pmap<string, int> HandleMap;
+  HandleMap _handles;
+  pvector<int> _handle_slots;
+  pvector<int> _free_handles;
+
+  typedef pvector<PT(CMover) > Movers;
+  Movers _movers;
+  pvector<int> _slot_handles;
+
+  // Per-slot state, one array for each component of each vector.
+  // Q_vel and Q_rot_vel are the movers' velocities while they are in
+  // the group; the others are filled in each frame.
+  enum Quantity {
+    Q_vel,
+    Q_rot_vel,
+    Q_acc,
+    Q_rot_acc,
+    Q_shove,
+    Q_rot_shove,
+    Q_pos_delta,
+    Q_hpr_delta,
+    num_quantities
+  };
+  enum { num_components = 3 };
+  pvector<float> _state[num_quantities][num_components];
+
+  INLINE void set_state(Quantity q, int slot, const LVecBase3f &value);
+  INLINE LVector3f get_state(Quantity q, int slot) const;
+
+  int _num_threads;
+
+  // Hands the slots to ParallelFor::run() for integrate_slots().
+  class IntegrateBody : public ParallelFor::Body {
+  public:
+    IntegrateBody(CMoverGroup *group) : _group(group) { }
+    virtual void do_range(int begin, int end) {
+      _group->integrate_slots(begin, end);
+    }
+
+  private:
+    CMoverGroup *_group;
+  };
 
 public:
   static TypeHandle get_class_type() {
@@ -13,6 +13,19 @@
 Configure(config_movement);
 NotifyCategoryDef(movement, "");
 
+ConfigVariableInt mover_group_threads
+("mover-group-threads", 0,
+ PRC_DESC("The default number of threads, counting the calling thread, "
+          "that a CMoverGroup uses to integrate the velocities of its "
+          "movers; a group with fewer than 16 movers per thread uses "
+          "fewer threads.  The impulses are always processed, and the "
+          "nodes always moved, in the calling thread.  Note that this "
+          "changes the order of the work: with more than one thread, "
+          "every mover's impulses are processed before any mover is "
+          "moved, so an impulse sees the other movers where they were "
+          "at the start of the frame, rather than where they have "
+          "already been moved to this frame."));
+
 ConfigureFn(config_movement) {
   init_libmovement();
 }
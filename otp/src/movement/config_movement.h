@@ -9,9 +9,12 @@
 #include "otpbase.h"
 #include "notifyCategoryProxy.h"
 #include "dconfig.h"
+#include "configVariableInt.h"
 
 NotifyCategoryDecl(movement, EXPCL_OTP, EXPTP_OTP);
 
+extern ConfigVariableInt mover_group_threads;
+
 extern EXPCL_OTP void init_libmovement();
 
 #endif
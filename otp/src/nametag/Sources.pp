@@ -56,3 +56,24 @@
   #define IGATESCAN all
 
 #end lib_target
+
+#begin test_bin_target
+  #define TARGET test_margin_manager
+  #define LOCAL_LIBS nametag otpbase
+  #define OTHER_LIBS \
+    panda pandaexpress \
+    interval:c direct:m \
+    interrogatedb:c dconfig:c dtoolconfig:m \
+    dtoolutil:c dtoolbase:c dtool:m \
+    express:c prc:c event:c pgraph:c pgraphnodes:c linmath:c gobj:c lerp:c \
+    char:c putil:c mathutil:c downloader:c mathutil:c  chan:c \
+    pandabase:c recorder:c grutil:c chan:c  collide:c device:c \
+    dgraph:c display:c gsgbase:c parametrics:c text:c pnmimage:c \
+    pipeline:c pstatclient:c cull:c pnmimagetypes:c tform:c \
+    audio:c pgui:c directbase:c movies:c pystub \
+    $[if $[HAVE_NET],net:c] $[if $[WANT_NATIVE_NET],nativenet:c]
+
+  #define SOURCES \
+    test_margin_manager.cxx
+
+#end test_bin_target
@@ -27,6 +27,8 @@ MarginManager() : PandaNode("popups") {
   set_cull_callback();
 
   _num_available_cells = 0;
+  _num_wants_visible = 0;
+  _num_shown = 0;
 
   // A MarginManager has an infinite bounding volume, so it never gets
   // culled.
@@ -267,8 +269,19 @@ unmanage_popup(MarginPopup *popup) {
 
   popup->set_managed(false);
 
+  if (info._wants_visible) {
+    _num_wants_visible--;
+  }
   if (info._code != 0) {
-    _popups_by_code[info._code].erase(popup);
+    // Another popup with the same code may get its turn now.
+    PopupsByCode::iterator ci = _popups_by_code.find(info._code);
+    if (ci != _popups_by_code.end()) {
+      (*ci).second.erase(popup);
+      if ((*ci).second.empty()) {
+        _popups_by_code.erase(ci);
+      }
+    }
+    _dirty_codes.push_back(info._code);
   }
   _popups.erase(pi);
 }
@@ -276,12 +289,24 @@ unmanage_popup(MarginPopup *popup) {
 ////////////////////////////////////////////////////////////////////
 //     Function: MarginManager::update
 //       Access: Public
-//  Description:
+//  Description: Called once per frame to query each popup and
+//               assign cells to the popups that want them.
+//
+//               Every popup is asked each frame whether it wants to
+//               remain managed and visible, but the cell assignment
+//               is only revisited for the popups whose answer (or,
+//               where it matters, whose score) has changed since the
+//               last frame.  When nothing has changed, no cells are
+//               reassigned at all.
 ////////////////////////////////////////////////////////////////////
 void MarginManager::
 update() {
+  // The popups whose _wants_visible flag changes this frame.
+  DirtyPopups dirty;
+
   // First, query all of our managed popups to see if they should
-  // change their managed/unmanaged state.
+  // change their managed/unmanaged state, and whether they'd like to
+  // be visible.
   Popups::iterator pi;
   pi = _popups.begin();
   while (pi != _popups.end()) {
@@ -292,94 +317,66 @@ update() {
 
     if (!popup->consider_manage()) {
       // This popup wants to unmanage itself.
-      int cell_index = info._cell_index;
-      if (cell_index >= 0) {
-        // It's already visible; make it invisible.
-        nassertv(cell_index < (int)_cells.size());
-        nassertv(_cells[cell_index]._popup == popup);
-        hide(cell_index);
-      }
-
-      popup->set_managed(false);
-      if (info._code != 0) {
-        _popups_by_code[info._code].erase(popup);
-      }
-      _popups.erase(pi);
+      unmanage_popup(popup);
 
     } else {
       // This popup wants to continue being managed.
-      info._wants_visible = popup->consider_visible();
-      if (info._wants_visible && info._code != 0) {
-        info._score = popup->get_score();
+      bool requests_visible = popup->consider_visible();
+      bool changed = (requests_visible != info._requests_visible);
+      if (requests_visible) {
+        // We keep the score current for all the popups that want to
+        // be visible, since we may need it to resolve a conflict.
+        float score = popup->get_score();
+        if (score != info._score) {
+          info._score = score;
+          if (info._code != 0) {
+            // The winner among popups sharing this code may change.
+            changed = true;
+          }
+        }
+      }
+      info._requests_visible = requests_visible;
+
+      if (changed) {
+        if (info._code != 0) {
+          // Of all the popups that share this code, only the one
+          // with the highest score actually gets to be visible.  We
+          // decide that below, once all the scores are in.
+          _dirty_codes.push_back(info._code);
+        } else {
+          set_wants_visible(pi, requests_visible, dirty);
+        }
       }
     }
 
     pi = next_pi;
   }
 
-  // Now go back and consider which popups should be made visible.
-  int num_visible = 0;
-  bool any_new_visible = false;
-
-  for (pi = _popups.begin(); pi != _popups.end(); ++pi) {
-    MarginPopup *popup = (*pi).first;
-    PopupInfo &info = (*pi).second;
-
-    if (info._wants_visible && info._code != 0) {
-      // This popup thinks it wants to be visible, but it has a
-      // uniquifying code.  Of all the popups that share this code,
-      // only the one with the highest score actually wants to be
-      // visible.
-      PopupSet &popup_set = _popups_by_code[info._code];
-
-      if (popup_set.size() > 1) {
-        // Find the one with the highest score.
-        float best_score = info._score;
-        MarginPopup *best_popup = popup;
-        PopupSet::iterator psi;
-        for (psi = popup_set.begin(); psi != popup_set.end(); ++psi) {
-          MarginPopup *try_popup = (*psi);
-          PopupInfo &try_info = _popups[try_popup];
-          if (try_info._wants_visible && try_info._score > best_score) {
-            best_score = try_info._score;
-            best_popup = try_popup;
-          }
-        }
-
-        // Now set all the other ones invisible.
-        for (psi = popup_set.begin(); psi != popup_set.end(); ++psi) {
-          MarginPopup *try_popup = (*psi);
-          PopupInfo &try_info = _popups[try_popup];
-          if (try_popup != best_popup) {
-            try_info._wants_visible = false;
-          }
-        }
-      }
-    }
+  resolve_codes(dirty);
 
-    // Okay, does this popup still want to be visible?
-    if (info._wants_visible) {
-      num_visible++;
-    }
+  // Any popup that no longer wants to be visible can be hidden right
+  // away.  Those that have just decided they want to be visible will
+  // be placed below.
+  DirtyPopups::const_iterator di;
+  for (di = dirty.begin(); di != dirty.end(); ++di) {
+    MarginPopup *popup = (*(*di)).first;
+    PopupInfo &info = (*(*di)).second;
     if (!info._wants_visible && popup->is_visible()) {
-      // If the popup wants to hide itself, we can oblige it right
-      // away.
       hide(info._cell_index);
-      
-    } else if (info._wants_visible && !popup->is_visible()) {
-      // This popup wants to reveal itself; we'll have to defer that
-      // request for a bit until we've looked at all the popups.
-      any_new_visible = true;
     }
   }
 
-  if (any_new_visible) {
-    // Now, can we satisfy all the popups that want visibility?
-    if (num_visible <= _num_available_cells) {
+  // Now, if any popups still want to be visible but aren't, see if we
+  // can find room for them.
+  if (_num_shown < _num_wants_visible) {
+    if (_num_wants_visible <= _num_available_cells) {
       // Hooray, no conflict!
       show_visible_no_conflict();
-    } else {
-      // Too bad, we can only show some of them.
+
+    } else if (_num_shown < _num_available_cells || !is_conflict_resolved()) {
+      // Too bad, we can only show some of them.  We only need to
+      // shuffle them around if there's an empty cell, or if one of
+      // the hidden popups now outscores one of the visible ones.
       show_visible_resolve_conflict();
     }
   }
@@ -478,6 +475,125 @@ write(ostream &out, int indent_level) const {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: MarginManager::resolve_codes
+//       Access: Private
+//  Description: For each object code named in _dirty_codes, chooses
+//               the popup with the highest score among those sharing
+//               that code which would like to be visible, and makes
+//               it the only one of the group that wants to be
+//               visible.  Popups whose _wants_visible flag changes as
+//               a result are added to dirty.
+////////////////////////////////////////////////////////////////////
+void MarginManager::
+resolve_codes(DirtyPopups &dirty) {
+  if (_dirty_codes.empty()) {
+    return;
+  }
+
+  sort(_dirty_codes.begin(), _dirty_codes.end());
+  _dirty_codes.erase(unique(_dirty_codes.begin(), _dirty_codes.end()),
+                     _dirty_codes.end());
+
+  DirtyPopups members;
+  vector_int::const_iterator ci;
+  for (ci = _dirty_codes.begin(); ci != _dirty_codes.end(); ++ci) {
+    PopupsByCode::const_iterator gi = _popups_by_code.find(*ci);
+    if (gi == _popups_by_code.end()) {
+      // All the popups with this code have since been unmanaged.
+      continue;
+    }
+    const PopupSet &popup_set = (*gi).second;
+
+    // Find the one with the highest score.  Ties go to the first in
+    // the set.
+    members.clear();
+    Popups::iterator best_pi = _popups.end();
+    PopupSet::const_iterator psi;
+    for (psi = popup_set.begin(); psi != popup_set.end(); ++psi) {
+      Popups::iterator pi = _popups.find(*psi);
+      nassertd(pi != _popups.end()) continue;
+      members.push_back(pi);
+
+      const PopupInfo &info = (*pi).second;
+      if (info._requests_visible &&
+          (best_pi == _popups.end() || info._score > (*best_pi).second._score)) {
+        best_pi = pi;
+      }
+    }
+
+    // Now set all the other ones invisible.
+    DirtyPopups::const_iterator mi;
+    for (mi = members.begin(); mi != members.end(); ++mi) {
+      set_wants_visible(*mi, (*mi) == best_pi, dirty);
+    }
+  }
+
+  _dirty_codes.clear();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MarginManager::set_wants_visible
+//       Access: Private
+//  Description: Changes the _wants_visible flag on the indicated
+//               popup, keeping _num_wants_visible current, and adds
+//               the popup to dirty if the flag has changed.
+////////////////////////////////////////////////////////////////////
+void MarginManager::
+set_wants_visible(Popups::iterator pi, bool wants_visible,
+                  DirtyPopups &dirty) {
+  PopupInfo &info = (*pi).second;
+  if (info._wants_visible != wants_visible) {
+    info._wants_visible = wants_visible;
+    if (wants_visible) {
+      _num_wants_visible++;
+    } else {
+      _num_wants_visible--;
+    }
+    dirty.push_back(pi);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: MarginManager::is_conflict_resolved
+//       Access: Private
+//  Description: Returns true if the popups currently visible are
+//               the ones with the highest scores of all the popups
+//               that want to be visible; that is, if
+//               show_visible_resolve_conflict() would leave things
+//               exactly as they are.
+////////////////////////////////////////////////////////////////////
+bool MarginManager::
+is_conflict_resolved() const {
+  bool any_shown = false;
+  bool any_hidden = false;
+  float min_shown_score = 0.0f;
+  float max_hidden_score = 0.0f;
+
+  Popups::const_iterator pi;
+  for (pi = _popups.begin(); pi != _popups.end(); ++pi) {
+    MarginPopup *popup = (*pi).first;
+    const PopupInfo &info = (*pi).second;
+    if (!info._wants_visible) {
+      continue;
+    }
+
+    if (popup->is_visible()) {
+      if (!any_shown || info._score < min_shown_score) {
+        min_shown_score = info._score;
+        any_shown = true;
+      }
+    } else {
+      if (!any_hidden || info._score > max_hidden_score) {
+        max_hidden_score = info._score;
+        any_hidden = true;
+      }
+    }
+  }
+
+  return !(any_shown && any_hidden && max_hidden_score > min_shown_score);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: MarginManager::show_visible_no_conflict
 //       Access: Private
@@ -537,7 +653,7 @@ show_visible_resolve_conflict() {
     PopupInfo &info = (*pi).second;
 
     if (info._wants_visible) {
-      info._score = popup->get_score();
+      // The score was refreshed by update() this frame.
       by_score.push_back(pi);
     }
   }
@@ -659,6 +775,7 @@ show(MarginPopup *popup, int cell_index) {
   _popups[popup]._cell_index = cell_index;
   popup->_cell_width = _cells[cell_index]._width;
   popup->set_visible(true);
+  _num_shown++;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -681,4 +798,5 @@ hide(int cell_index) {
 
   _popups[popup]._cell_index = -1;
   popup->set_visible(false);
+  _num_shown--;
 }
@@ -53,31 +53,50 @@ public:
 
   virtual void write(ostream &out, int indent_level) const;
 
-private:
-  void show_visible_no_conflict();
-  void show_visible_resolve_conflict();
-  int choose_cell(MarginPopup *popup, vector_int &empty_cells);
-
-  void show(MarginPopup *popup, int cell_index);
-  void hide(int cell_index);
-
 private:
   class PopupInfo {
   public:
     INLINE PopupInfo();
 
     int _cell_index;
+    bool _requests_visible;
     bool _wants_visible;
     float _score;
     int _code;
   };
   typedef pmap<PT(MarginPopup), PopupInfo> Popups;
+  typedef pvector<Popups::iterator> DirtyPopups;
+
+  void resolve_codes(DirtyPopups &dirty);
+  void set_wants_visible(Popups::iterator pi, bool wants_visible,
+                         DirtyPopups &dirty);
+  bool is_conflict_resolved() const;
+
+  void show_visible_no_conflict();
+  void show_visible_resolve_conflict();
+  int choose_cell(MarginPopup *popup, vector_int &empty_cells);
+
+  void show(MarginPopup *popup, int cell_index);
+  void hide(int cell_index);
+
+private:
   Popups _popups;
 
   typedef pset<MarginPopup *> PopupSet;
   typedef pmap<int, PopupSet> PopupsByCode;
   PopupsByCode _popups_by_code;
 
+  // The object codes whose popups have changed their visibility
+  // request or score since the last update(); only these groups need
+  // to choose their winner again.
+  vector_int _dirty_codes;
+
+  // The number of popups with _wants_visible set, and the number
+  // currently occupying a cell.  Whenever these are equal after
+  // update(), every popup that wants to be seen is being seen.
+  int _num_wants_visible;
+  int _num_shown;
+
   class Cell {
   public:
     LMatrix4f _mat;
@@ -0,0 +1,103 @@
+// Filename: test_margin_manager.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "marginManager.h"
+#include "marginPopup.h"
+#include "config_nametag.h"
+#include "clockObject.h"
+#include "trueClock.h"
+#include "randomizer.h"
+
+// This program times MarginManager::update() with a number of
+// popups, a given fraction of which change their visibility request
+// or their score each frame.
+//
+// Usage: test_margin_manager [num_popups [churn_percent]]
+
+class TestPopup : public MarginPopup {
+public:
+  TestPopup(int code) : _code(code), _want(false), _score(0.0f) { }
+
+  virtual float get_score() { return _score; }
+  virtual int get_object_code() { return _code; }
+
+protected:
+  virtual bool consider_visible() { return _want; }
+
+public:
+  int _code;
+  bool _want;
+  float _score;
+};
+
+static const int num_frames = 1000;
+
+int
+main(int argc, char *argv[]) {
+  init_libnametag();
+
+  int num_popups = 200;
+  double churn = 5.0;
+  if (argc > 1) {
+    num_popups = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    churn = atof(argv[2]);
+  }
+
+  ClockObject *clock = ClockObject::get_global_clock();
+  clock->set_mode(ClockObject::M_non_real_time);
+  clock->set_frame_rate(60.0);
+
+  // The usual grid of cells around the edge of the screen.
+  PT(MarginManager) mgr = new MarginManager;
+  for (int x = 0; x < 6; ++x) {
+    mgr->add_grid_cell(x, 0, -1.33f, 1.33f, -1.0f, 1.0f);
+    mgr->add_grid_cell(x, 5, -1.33f, 1.33f, -1.0f, 1.0f);
+  }
+  for (int y = 1; y < 5; ++y) {
+    mgr->add_grid_cell(0, y, -1.33f, 1.33f, -1.0f, 1.0f);
+    mgr->add_grid_cell(5, y, -1.33f, 1.33f, -1.0f, 1.0f);
+  }
+
+  // Every popup has an object code, shared in pairs, as a Nametag2d
+  // and its chat balloon would.
+  Randomizer random(1);
+  pvector<PT(TestPopup) > popups;
+  for (int i = 0; i < num_popups; ++i) {
+    PT(TestPopup) popup = new TestPopup(i / 2 + 1);
+    popup->_want = (random.random_real(1.0) < 0.5);
+    popup->_score = random.random_real(1000.0);
+    mgr->manage_popup(popup);
+    popups.push_back(popup);
+  }
+
+  TrueClock *true_clock = TrueClock::get_global_ptr();
+  double start = true_clock->get_short_time();
+  for (int f = 0; f < num_frames; ++f) {
+    clock->tick();
+    for (int i = 0; i < num_popups; ++i) {
+      if (random.random_real(100.0) < churn) {
+        TestPopup *popup = popups[i];
+        if (random.random_int(2) == 0) {
+          popup->_want = !popup->_want;
+        } else {
+          popup->_score = random.random_real(1000.0);
+        }
+      }
+    }
+    mgr->update();
+  }
+  double elapsed = true_clock->get_short_time() - start;
+
+  nout << num_popups << " popups, " << churn << "% churn: "
+       << elapsed * 1000000.0 / num_frames << " us/frame\n";
+
+  pvector<PT(TestPopup) >::iterator pi;
+  for (pi = popups.begin(); pi != popups.end(); ++pi) {
+    mgr->unmanage_popup(*pi);
+  }
+  return 0;
+}
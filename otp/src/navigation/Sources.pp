@@ -23,3 +23,12 @@
 
 #end lib_target
 
+
+#begin test_bin_target
+  #define TARGET test_path_table
+  #define LOCAL_LIBS navigation otpbase
+
+  #define SOURCES \
+    test_path_table.cxx
+
+#end test_bin_target
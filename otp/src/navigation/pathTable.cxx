@@ -5,7 +5,9 @@
 
 
 PathTable::
-PathTable() {
+PathTable() :
+  _dense(true),
+  _numNodes(0) {
 }
 
 PathTable::
@@ -13,13 +15,17 @@ PathTable::
 }
 
 PathTable::
-PathTable(PyObject* pathData, PyObject* connections) {
+PathTable(PyObject* pathData, PyObject* connections) :
+  _dense(true),
+  _numNodes(0) {
   initTable(pathData, connections);
 }
 
 
 void PathTable::
 initTable(PyObject* pathData, PyObject* connections) {
+  std::vector<StringUC> rows;
+  std::vector<VectorUS> neighborLists;
   StringUC str;
   int strlen;
   int len;
@@ -29,8 +35,7 @@ initTable(PyObject* pathData, PyObject* connections) {
   PyObject *obj2 = NULL;
   unsigned short num;
 
-  // Init _pathData from received values (list of strings)
-  _pathData.clear();
+  // Read the rows from received values (list of strings)
 
   if(!PyList_Check(pathData)) {
     PyErr_SetString(PyExc_TypeError, "pathData: Expected a list!");
@@ -51,11 +56,10 @@ initTable(PyObject* pathData, PyObject* connections) {
 
     str.assign((unsigned char*)PyString_AsString(obj),strlen);
 
-    _pathData.push_back(str);
+    rows.push_back(str);
   }
 
-  // Init _connectionData from received values (list of list of int/None)
-  _connectionData.clear();
+  // Read the connections from received values (list of list of int/None)
 
   if(!PyList_Check(connections)) {
     PyErr_SetString(PyExc_TypeError, "connections: Expected a list!");
@@ -93,6 +97,216 @@ initTable(PyObject* pathData, PyObject* connections) {
       neighbors.push_back(num);
     }
 
-    _connectionData.push_back(neighbors);
+    neighborLists.push_back(neighbors);
   }
+
+  setTable(rows, neighborLists);
+}
+
+
+// setTable: Builds the table from rows run-length encoded by
+// NavMesh.createPathTable() (three bytes per run: the first goal node
+// of the run, high byte first, then the connection index) and the
+// list of each node's neighbors.  If allowDense is true and the mesh
+// is small enough, the rows are expanded into a full matrix.
+void PathTable::
+setTable(const std::vector<StringUC> &pathData,
+         const std::vector<VectorUS> &connections,
+         bool allowDense) {
+  assert(pathData.size() == connections.size());
+  assert(pathData.size() < 65536);
+
+  _numNodes = (unsigned short)pathData.size();
+
+  _neighbors.clear();
+  _neighborStart.clear();
+  _neighborStart.reserve(_numNodes + 1);
+  for (unsigned int i = 0; i < _numNodes; ++i) {
+    _neighborStart.push_back(_neighbors.size());
+    _neighbors.insert(_neighbors.end(), connections[i].begin(), connections[i].end());
+  }
+  _neighborStart.push_back(_neighbors.size());
+
+  _denseTable.clear();
+  _runGoals.clear();
+  _runEdges.clear();
+  _rowStart.clear();
+
+  _dense = allowDense && ((unsigned int)_numNodes * _numNodes <= maxDenseSize);
+
+  if (_dense) {
+    _denseTable.resize((unsigned int)_numNodes * _numNodes);
+    for (unsigned int i = 0; i < _numNodes; ++i) {
+      const StringUC &row = pathData[i];
+      assert(row.size() % 3 == 0);
+      unsigned char *out = &_denseTable[i * _numNodes];
+      for (size_t pos = 0; pos < row.size(); pos += 3) {
+        unsigned int goal = 256 * (unsigned int)row[pos] + row[pos + 1];
+        unsigned int end = _numNodes;
+        if (pos + 3 < row.size()) {
+          end = 256 * (unsigned int)row[pos + 3] + row[pos + 4];
+        }
+        assert(goal <= end && end <= _numNodes);
+        for (unsigned int goalNode = goal; goalNode < end; ++goalNode) {
+          out[goalNode] = row[pos + 2];
+        }
+      }
+    }
+
+  } else {
+    _rowStart.reserve(_numNodes + 1);
+    for (unsigned int i = 0; i < _numNodes; ++i) {
+      _rowStart.push_back(_runGoals.size());
+      const StringUC &row = pathData[i];
+      assert(row.size() % 3 == 0);
+      for (size_t pos = 0; pos < row.size(); pos += 3) {
+        _runGoals.push_back(256 * (unsigned short)row[pos] + row[pos + 1]);
+        _runEdges.push_back(row[pos + 2]);
+      }
+    }
+    _rowStart.push_back(_runGoals.size());
+  }
+}
+
+
+// getMemoryUsage: Returns the number of bytes used by the table.
+size_t PathTable::
+getMemoryUsage() const {
+  return sizeof(*this) +
+    _neighbors.capacity() * sizeof(unsigned short) +
+    _neighborStart.capacity() * sizeof(unsigned int) +
+    _denseTable.capacity() +
+    _runGoals.capacity() * sizeof(unsigned short) +
+    _runEdges.capacity() +
+    _rowStart.capacity() * sizeof(unsigned int);
+}
+
+
+// lookupNextNodes: Finds the next node from each of count start nodes
+// toward the corresponding goal node.
+void PathTable::
+lookupNextNodes(const unsigned short *startNodes,
+                const unsigned short *goalNodes,
+                unsigned short *nextNodes, size_t count) const {
+  for (size_t i = 0; i < count; ++i) {
+    nextNodes[i] = nextNode(startNodes[i], goalNodes[i]);
+  }
+}
+
+
+// lookupRoutes: Finds the route for each of count (start, goal) pairs.
+// The routes are appended one after another to routes, and the index
+// at which each begins is appended to routeStarts, followed by the
+// final length of routes.
+void PathTable::
+lookupRoutes(const unsigned short *startNodes,
+             const unsigned short *goalNodes, size_t count,
+             VectorUS &routes, VectorUI &routeStarts) const {
+  routeStarts.reserve(routeStarts.size() + count + 1);
+  for (size_t i = 0; i < count; ++i) {
+    routeStarts.push_back(routes.size());
+
+    unsigned short currNode = startNodes[i];
+    unsigned short goalNode = goalNodes[i];
+    routes.push_back(currNode);
+    while (currNode != goalNode) {
+      currNode = nextNode(currNode, goalNode);
+      assert(currNode != 65535);
+      routes.push_back(currNode);
+    }
+  }
+  routeStarts.push_back(routes.size());
+}
+
+
+// parseQueries: Reads a list of (startNode, goalNode) pairs.  Sets a
+// Python exception and returns false if the list is malformed.
+bool PathTable::
+parseQueries(PyObject* queries, VectorUS &startNodes, VectorUS &goalNodes) {
+  if(!PyList_Check(queries)) {
+    PyErr_SetString(PyExc_TypeError, "queries: Expected a list!");
+    return false;
+  }
+
+  int len = PyList_Size(queries);
+  startNodes.reserve(len);
+  goalNodes.reserve(len);
+
+  for(int i=0; i<len; ++i) {
+    PyObject *obj = PyList_GetItem(queries,i);
+
+    if(!PyTuple_Check(obj) || PyTuple_Size(obj) != 2) {
+      PyErr_SetString(PyExc_TypeError, "queries: Expected (startNode, goalNode) tuples!");
+      return false;
+    }
+
+    PyObject *start = PyTuple_GetItem(obj,0);
+    PyObject *goal = PyTuple_GetItem(obj,1);
+
+    if(!PyInt_Check(start) || !PyInt_Check(goal)) {
+      PyErr_SetString(PyExc_TypeError, "queries: Non-integer node encountered!");
+      return false;
+    }
+
+    startNodes.push_back((unsigned short)PyInt_AsUnsignedLongMask(start));
+    goalNodes.push_back((unsigned short)PyInt_AsUnsignedLongMask(goal));
+  }
+
+  return true;
+}
+
+
+// findNextNodes: Returns a list of the next node from each start node
+// toward its goal node.
+PyObject* PathTable::
+findNextNodes(PyObject* queries) {
+  VectorUS startNodes, goalNodes;
+  if(!parseQueries(queries, startNodes, goalNodes)) {
+    return NULL;
+  }
+
+  size_t count = startNodes.size();
+  VectorUS nextNodes(count);
+  if (count != 0) {
+    lookupNextNodes(&startNodes[0], &goalNodes[0], &nextNodes[0], count);
+  }
+
+  PyObject *result = PyList_New(count);
+  for(size_t i=0; i<count; ++i) {
+    // PyList_SetItem steals the reference.
+    PyList_SetItem(result, i, PyInt_FromLong((long)nextNodes[i]));
+  }
+
+  return result;
+}
+
+
+// findRoutes: Returns a list of the routes, as findRoute() would
+// return them, for each (startNode, goalNode) pair.
+PyObject* PathTable::
+findRoutes(PyObject* queries) {
+  VectorUS startNodes, goalNodes;
+  if(!parseQueries(queries, startNodes, goalNodes)) {
+    return NULL;
+  }
+
+  size_t count = startNodes.size();
+  VectorUS routes;
+  VectorUI routeStarts;
+  if (count != 0) {
+    lookupRoutes(&startNodes[0], &goalNodes[0], count, routes, routeStarts);
+  }
+
+  PyObject *result = PyList_New(count);
+  for(size_t i=0; i<count; ++i) {
+    unsigned int begin = routeStarts[i];
+    unsigned int end = routeStarts[i + 1];
+    PyObject *route = PyList_New(end - begin);
+    for(unsigned int j=begin; j<end; ++j) {
+      PyList_SetItem(route, j - begin, PyInt_FromLong((long)routes[j]));
+    }
+    PyList_SetItem(result, i, route);
+  }
+
+  return result;
 }
@@ -11,10 +11,20 @@
 #include "Python.h"
 
 typedef std::vector<unsigned short> VectorUS;
+typedef std::vector<unsigned int> VectorUI;
 typedef std::basic_string<unsigned char> StringUC;
 
 ////////////////////////////////////////////////////////////////////
 //       Class : PathTable
+// Description : All-pairs shortest path lookup for a NavMesh.  For
+//               each start and goal node, the table stores which of
+//               the start node's connections is the first step
+//               toward the goal.
+//
+//               Small meshes keep this as a full matrix of one byte
+//               per pair.  Larger meshes keep each row run-length
+//               encoded, as it arrives from NavMesh.createPathTable(),
+//               and search the runs with a binary search.
 ////////////////////////////////////////////////////////////////////
 class EXPCL_OTP PathTable {
 PUBLISHED:
@@ -26,14 +36,53 @@ PUBLISHED:
 
   INLINE PyObject* findRoute(unsigned short startNode, unsigned short goalNode);
 
+  // Batched queries: each takes a list of (startNode, goalNode)
+  // pairs.
+  PyObject* findRoutes(PyObject* queries);
+  PyObject* findNextNodes(PyObject* queries);
+
+  INLINE unsigned short getNumNodes() const;
+  INLINE bool isDense() const;
+  size_t getMemoryUsage() const;
+
+public:
+  // The largest mesh that is stored as a full matrix, in bytes.
+  static const unsigned int maxDenseSize = 1 << 20;
+
+  void setTable(const std::vector<StringUC> &pathData,
+                const std::vector<VectorUS> &connections,
+                bool allowDense = true);
+
+  INLINE unsigned short nextNode(unsigned short startNode, unsigned short goalNode) const;
+
+  void lookupNextNodes(const unsigned short *startNodes,
+                       const unsigned short *goalNodes,
+                       unsigned short *nextNodes, size_t count) const;
+  void lookupRoutes(const unsigned short *startNodes,
+                    const unsigned short *goalNodes, size_t count,
+                    VectorUS &routes, VectorUI &routeStarts) const;
+
 private:
-  std::vector<StringUC> _pathData;
-  std::vector<VectorUS> _connectionData;
+  // The neighbors of node i are _neighbors[_neighborStart[i]] up to
+  // _neighbors[_neighborStart[i+1]].  Missing connections are 65535.
+  VectorUS _neighbors;
+  VectorUI _neighborStart;
 
-  INLINE unsigned char nextStepLookup(unsigned short startNode, unsigned short goalNode);
+  // When _dense is true, the edge from start toward goal is
+  // _denseTable[start * _numNodes + goal].  Otherwise, row start is
+  // the runs _rowStart[start] up to _rowStart[start+1]; each run
+  // gives the first goal it covers and the edge for all of its goals.
+  bool _dense;
+  unsigned short _numNodes;
+  StringUC _denseTable;
+  VectorUS _runGoals;
+  StringUC _runEdges;
+  VectorUI _rowStart;
+
+  INLINE unsigned char nextStepLookup(unsigned short startNode, unsigned short goalNode) const;
+  static bool parseQueries(PyObject* queries, VectorUS &startNodes, VectorUS &goalNodes);
 };
 
 #include "pathTable.I"
 
 #endif
-
@@ -0,0 +1,195 @@
+// Filename: test_path_table.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pathTable.h"
+#include "trueClock.h"
+#include "randomizer.h"
+
+// This program builds a PathTable for a square grid mesh of the given
+// size, with some of the squares knocked out to make it irregular,
+// and reports the memory used by the full-matrix and run-length
+// encoded forms of the table and the time taken to answer random
+// queries one at a time and in batches.
+//
+// Usage: test_path_table [grid_size [num_queries]]
+//
+// A grid_size of 32 gives 1024 nodes, about the size of the larger
+// Pirates meshes; the full matrix is only used up to 1024 nodes.
+
+static const unsigned short no_node = 65535;
+
+// Builds a grid mesh.  Each node has four connections, north, east,
+// south, and west, as NavMesh squares do; missing neighbors are
+// no_node.
+static void
+make_mesh(int grid_size, std::vector<VectorUS> &connections) {
+  Randomizer random(1);
+
+  // Knock out about a tenth of the squares, but never the first one.
+  std::vector<int> node_of_square(grid_size * grid_size, -1);
+  int num_nodes = 0;
+  for (int i = 0; i < grid_size * grid_size; ++i) {
+    if (i == 0 || random.random_real(1.0) >= 0.1) {
+      node_of_square[i] = num_nodes++;
+    }
+  }
+
+  static const int dx[4] = { 0, 1, 0, -1 };
+  static const int dy[4] = { 1, 0, -1, 0 };
+
+  connections.assign(num_nodes, VectorUS(4, no_node));
+  for (int y = 0; y < grid_size; ++y) {
+    for (int x = 0; x < grid_size; ++x) {
+      int node = node_of_square[y * grid_size + x];
+      if (node < 0) {
+        continue;
+      }
+      for (int d = 0; d < 4; ++d) {
+        int nx = x + dx[d];
+        int ny = y + dy[d];
+        if (nx >= 0 && nx < grid_size && ny >= 0 && ny < grid_size &&
+            node_of_square[ny * grid_size + nx] >= 0) {
+          connections[node][d] = node_of_square[ny * grid_size + nx];
+        }
+      }
+    }
+  }
+}
+
+// Solves all pairs shortest path by searching back from each goal,
+// and run-length encodes the rows as NavMesh.createPathTable() does.
+// Nodes that cannot reach a goal are given connection 0 toward it;
+// the queries below only ask for reachable goals.
+static void
+make_rows(const std::vector<VectorUS> &connections,
+          std::vector<StringUC> &rows, std::vector<int> &component) {
+  int num_nodes = connections.size();
+  std::vector<VectorUS> edge_to(num_nodes, VectorUS(num_nodes, 0));
+
+  component.assign(num_nodes, -1);
+  std::vector<int> queue;
+  for (int goal = 0; goal < num_nodes; ++goal) {
+    std::vector<bool> visited(num_nodes, false);
+    visited[goal] = true;
+    queue.clear();
+    queue.push_back(goal);
+    for (size_t q = 0; q < queue.size(); ++q) {
+      int node = queue[q];
+      if (component[node] < 0) {
+        component[node] = goal;
+      }
+      // The grid is symmetric, so the neighbors of node are also the
+      // nodes that can step to it.
+      for (int d = 0; d < 4; ++d) {
+        int from = connections[node][d];
+        if (from != no_node && !visited[from]) {
+          visited[from] = true;
+          edge_to[from][goal] = (d + 2) % 4;
+          queue.push_back(from);
+        }
+      }
+    }
+  }
+
+  rows.assign(num_nodes, StringUC());
+  for (int start = 0; start < num_nodes; ++start) {
+    int last = -1;
+    for (int goal = 0; goal < num_nodes; ++goal) {
+      int edge = edge_to[start][goal];
+      if (edge != last) {
+        rows[start] += (unsigned char)(goal / 256);
+        rows[start] += (unsigned char)(goal % 256);
+        rows[start] += (unsigned char)edge;
+        last = edge;
+      }
+    }
+  }
+}
+
+static void
+time_table(const PathTable &table, const VectorUS &starts,
+           const VectorUS &goals) {
+  TrueClock *clock = TrueClock::get_global_ptr();
+  size_t count = starts.size();
+
+  VectorUS single(count);
+  double start = clock->get_short_time();
+  for (size_t i = 0; i < count; ++i) {
+    single[i] = table.nextNode(starts[i], goals[i]);
+  }
+  double single_time = clock->get_short_time() - start;
+
+  VectorUS batched(count);
+  start = clock->get_short_time();
+  table.lookupNextNodes(&starts[0], &goals[0], &batched[0], count);
+  double batched_time = clock->get_short_time() - start;
+  assert(single == batched);
+
+  VectorUS routes;
+  VectorUI route_starts;
+  start = clock->get_short_time();
+  table.lookupRoutes(&starts[0], &goals[0], count, routes, route_starts);
+  double route_time = clock->get_short_time() - start;
+
+  std::cerr
+    << "  " << (table.isDense() ? "matrix" : "runs  ") << ": "
+    << table.getMemoryUsage() << " bytes, "
+    << single_time * 1.0e9 / count << " ns/step single, "
+    << batched_time * 1.0e9 / count << " ns/step batched, "
+    << route_time * 1.0e9 / count << " ns/route ("
+    << (double)routes.size() / count << " nodes)\n";
+}
+
+int
+main(int argc, char *argv[]) {
+  int grid_size = 32;
+  int num_queries = 100000;
+  if (argc > 1) {
+    grid_size = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_queries = atoi(argv[2]);
+  }
+
+  std::vector<VectorUS> connections;
+  make_mesh(grid_size, connections);
+
+  std::vector<StringUC> rows;
+  std::vector<int> component;
+  make_rows(connections, rows, component);
+
+  size_t encoded_size = 0;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    encoded_size += rows[i].size();
+  }
+  std::cerr
+    << connections.size() << " nodes, " << encoded_size
+    << " bytes run-length encoded\n";
+
+  // Choose queries between nodes that can reach each other.
+  Randomizer random(2);
+  VectorUS starts, goals;
+  int num_nodes = connections.size();
+  while ((int)starts.size() < num_queries) {
+    int a = random.random_int(num_nodes);
+    int b = random.random_int(num_nodes);
+    if (component[a] == component[b]) {
+      starts.push_back(a);
+      goals.push_back(b);
+    }
+  }
+
+  PathTable runs;
+  runs.setTable(rows, connections, false);
+  time_table(runs, starts, goals);
+
+  PathTable matrix;
+  matrix.setTable(rows, connections, true);
+  if (matrix.isDense()) {
+    time_table(matrix, starts, goals);
+  }
+
+  return 0;
+}
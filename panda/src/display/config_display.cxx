@@ -262,6 +262,51 @@ ConfigVariableBool allow_incomplete_render
           "geometry is always paged in immediately when needed, holding up "
           "the frame render if necessary."));
 
+ConfigVariableBool progressive_textures
+("progressive-textures", false,
+ PRC_DESC("When this is true, and allow-incomplete-render is also true, a "
+          "mipmapped texture is sent to the graphics card a few mipmap "
+          "levels at a time, beginning with the small levels at the tail "
+          "of its mipmap chain.  The texture can then be drawn, at a "
+          "reduced resolution, in the same frame its image becomes "
+          "available; the larger levels follow over the next few frames, "
+          "as texture-upload-budget allows.  This staggers only the upload "
+          "to the graphics card: the whole image, with all of its mipmap "
+          "levels, is still read from disk before the first levels are "
+          "sent, and stays in memory until the last levels have been sent.  "
+          "See also texture-drop-distance.  This is presently only "
+          "implemented by the OpenGL renderer."));
+
+ConfigVariableInt progressive_texture_tail_size
+("progressive-texture-tail-size", 32,
+ PRC_DESC("When progressive-textures is true, this is the largest size, in "
+          "pixels on a side, of the first mipmap level of a texture to be "
+          "sent to the graphics card."));
+
+ConfigVariableInt texture_upload_budget
+("texture-upload-budget", 0,
+ PRC_DESC("When progressive-textures is true, this is the number of bytes "
+          "of texture image that may be sent to the graphics card in each "
+          "frame to bring textures up to their full resolution.  The first, "
+          "smallest levels of each texture are always sent, and at least "
+          "one texture advances each frame, so every texture eventually "
+          "reaches full resolution.  0 means no limit, in which case each "
+          "texture is sent at full resolution in the frame after its first "
+          "levels."));
+
+ConfigVariableDouble texture_drop_distance
+("texture-drop-distance", 0.0,
+ PRC_DESC("When progressive-textures is true, a texture that was drawn no "
+          "nearer than this distance from the camera in the previous frame "
+          "has its largest mipmap level dropped from graphics memory, and "
+          "one more level each time the distance doubles, down to "
+          "progressive-texture-tail-size.  The levels are sent again, "
+          "within texture-upload-budget, when the texture comes nearer.  "
+          "The distance is measured to the bounding volume of each Geom, "
+          "in the camera's coordinate space.  The texture keeps its RAM "
+          "image while any levels are dropped.  Textures applied by a "
+          "shader are not affected.  0 means never to drop levels."));
+
 ConfigVariableInt win_size
 ("win-size", "640 480",
  PRC_DESC("This is the default size at which to open a new window.  This "
@@ -63,6 +63,10 @@ extern EXPCL_PANDA_DISPLAY ConfigVariableBool default_stereo_camera;
 extern EXPCL_PANDA_DISPLAY ConfigVariableBool color_scale_via_lighting;
 extern EXPCL_PANDA_DISPLAY ConfigVariableBool alpha_scale_via_texture;
 extern EXPCL_PANDA_DISPLAY ConfigVariableBool allow_incomplete_render;
+extern EXPCL_PANDA_DISPLAY ConfigVariableBool progressive_textures;
+extern EXPCL_PANDA_DISPLAY ConfigVariableInt progressive_texture_tail_size;
+extern EXPCL_PANDA_DISPLAY ConfigVariableInt texture_upload_budget;
+extern EXPCL_PANDA_DISPLAY ConfigVariableDouble texture_drop_distance;
 
 extern EXPCL_PANDA_DISPLAY ConfigVariableInt win_size;
 extern EXPCL_PANDA_DISPLAY ConfigVariableInt win_origin;
@@ -765,6 +765,7 @@ render_frame() {
     RenderState::flush_level();
     TransformState::flush_level();
     CullableObject::flush_level();
+    CullArena::flush_level();
     
     // Now cycle the pipeline and officially begin the next frame.
 #ifdef THREADED_PIPELINE
@@ -41,7 +41,8 @@
      eggPolygon.h eggPolysetMaker.h eggPoolUniquifier.h \
      eggPrimitive.I eggPrimitive.h \
      eggRenderMode.I eggRenderMode.h  \
-     eggSAnimData.I eggSAnimData.h eggSurface.I eggSurface.h  \
+     eggSAnimData.I eggSAnimData.h eggScanner.h \
+     eggSurface.I eggSurface.h  \
      eggSwitchCondition.h eggTable.I eggTable.h eggTexture.I  \
      eggTexture.h eggTextureCollection.I eggTextureCollection.h  \
      eggTriangleFan.I eggTriangleFan.h \
@@ -77,7 +78,8 @@
      eggNurbsCurve.cxx eggNurbsSurface.cxx eggObject.cxx  \
      eggParameters.cxx eggPoint.cxx eggPolygon.cxx eggPolysetMaker.cxx  \
      eggPoolUniquifier.cxx eggPrimitive.cxx eggRenderMode.cxx  \
-     eggSAnimData.cxx eggSurface.cxx eggSwitchCondition.cxx  \
+     eggSAnimData.cxx eggScanner.cxx \
+     eggSurface.cxx eggSwitchCondition.cxx  \
      eggTable.cxx eggTexture.cxx eggTextureCollection.cxx  \
      eggTransform.cxx \
      eggTriangleFan.cxx \
@@ -139,3 +141,13 @@
 
 #end test_bin_target
 
+#begin test_bin_target
+  #define TARGET test_egg_parse
+  #define LOCAL_LIBS \
+    egg putil mathutil express
+
+  #define SOURCES \
+    test_egg_parse.cxx
+
+#end test_bin_target
+
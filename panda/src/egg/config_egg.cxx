@@ -144,6 +144,22 @@ ConfigVariableDouble egg_coplanar_threshold
  PRC_DESC("The numerical threshold below which polygons are considered "
           "to be coplanar.  Determined empirically."));
 
+ConfigVariableBool egg_fast_lexer
+("egg-fast-lexer", false,
+ PRC_DESC("Set this true to read egg files with the hand-written scanner, "
+          "which reads the file a block at a time and is two to three "
+          "times faster than the flex-generated scanner.  The two should "
+          "return exactly the same tokens; the default remains the flex "
+          "scanner until the new one has seen wider use."));
+
+ConfigVariableBool egg_optimize_vertex_cache
+("egg-optimize-vertex-cache", false,
+ PRC_DESC("Set this true to have the egg mesher make independent triangles, "
+          "sorted for good use of the graphics card's vertex cache, instead "
+          "of triangle strips.  This is usually faster to render on modern "
+          "hardware.  The egg loader also reorders the vertices of each "
+          "Geom to match, if egg-flatten is true."));
+
 ////////////////////////////////////////////////////////////////////
 //     Function: init_libegg
 //  Description: Initializes the library.  This must be called at
@@ -30,6 +30,7 @@
 extern int eggyyparse();
 #include "parserDefs.h"
 #include "lexerDefs.h"
+#include "eggScanner.h"
 
 TypeHandle EggData::_type_handle;
 
@@ -124,7 +125,7 @@ read(istream &in) {
     egg_init_parser(in, get_egg_filename(), data, data);
     eggyyparse();
     egg_cleanup_parser();
-    error_count = egg_error_count();
+    error_count = egg_scanner_error_count();
   }
 
   data->post_read();
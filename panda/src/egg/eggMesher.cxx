@@ -22,6 +22,7 @@
 #include "config_egg.h"
 #include "eggGroupNode.h"
 #include "dcast.h"
+#include "vertexCacheOptimizer.h"
 #include "thread.h"
 
 #include <stdlib.h>
@@ -51,6 +52,11 @@ EggMesher() {
 //               permitted (because these can't be rotated when
 //               required to move the colored vertex of each triangle
 //               to the first or last position).
+//
+//               If egg-optimize-vertex-cache is true, no strips are
+//               made; instead, the primitives are triangulated and
+//               the triangles are sorted for good use of the vertex
+//               cache.
 ////////////////////////////////////////////////////////////////////
 void EggMesher::
 mesh(EggGroupNode *group, bool flat_shaded) {
@@ -66,6 +72,8 @@ mesh(EggGroupNode *group, bool flat_shaded) {
   PT(EggGroupNode) next_children = new EggGroupNode;
   PT(EggGroupNode) this_children = group;
 
+  bool optimize_cache = egg_optimize_vertex_cache;
+
   // Only primitives that share a common vertex pool can be meshed
   // together.  Thus, pull out the primitives with the same vertex
   // pool in groups.
@@ -82,10 +90,18 @@ mesh(EggGroupNode *group, bool flat_shaded) {
 
         if (_vertex_pool == (EggVertexPool *)NULL) {
           _vertex_pool = poly->get_pool();
-          add_polygon(poly, EggMesherStrip::MO_user);
+          if (optimize_cache) {
+            add_triangles(poly);
+          } else {
+            add_polygon(poly, EggMesherStrip::MO_user);
+          }
 
         } else if (_vertex_pool == poly->get_pool()) {
-          add_polygon(poly, EggMesherStrip::MO_user);
+          if (optimize_cache) {
+            add_triangles(poly);
+          } else {
+            add_polygon(poly, EggMesherStrip::MO_user);
+          }
 
         } else {
           // A different vertex pool; save this one for the next pass.
@@ -99,13 +115,18 @@ mesh(EggGroupNode *group, bool flat_shaded) {
       }
     }
     
-    do_mesh();
+    if (optimize_cache) {
+      order_triangles(output_children);
+
+    } else {
+      do_mesh();
     
-    Strips::iterator si;
-    for (si = _done.begin(); si != _done.end(); ++si) {
-      PT(EggPrimitive) egg_prim = get_prim(*si);
-      if (egg_prim != (EggPrimitive *)NULL) {
-        output_children->add_child(egg_prim);
+      Strips::iterator si;
+      for (si = _done.begin(); si != _done.end(); ++si) {
+        PT(EggPrimitive) egg_prim = get_prim(*si);
+        if (egg_prim != (EggPrimitive *)NULL) {
+          output_children->add_child(egg_prim);
+        }
       }
     }
 
@@ -177,6 +198,7 @@ clear() {
   _strips.clear();
   _dead.clear();
   _done.clear();
+  _triangles.clear();
   _verts.clear();
   _edges.clear();
   _strip_index = 0;
@@ -491,6 +513,80 @@ get_prim(EggMesherStrip &strip) {
   return egg_prim;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: EggMesher::add_triangles
+//       Access: Private
+//  Description: Adds a polygon to the list of triangles to be sorted
+//               by order_triangles(), triangulating it first if
+//               necessary.
+////////////////////////////////////////////////////////////////////
+void EggMesher::
+add_triangles(EggPolygon *egg_poly) {
+  if (egg_poly->size() == 3) {
+    _triangles.push_back(egg_poly);
+    return;
+  }
+
+  PT(EggGroupNode) temp_group = new EggGroupNode;
+  if (!egg_poly->triangulate_into(temp_group, true)) {
+    // A degenerate polygon; leave it alone.
+    _triangles.push_back(egg_poly);
+    return;
+  }
+
+  EggGroupNode::iterator ci;
+  for (ci = temp_group->begin(); ci != temp_group->end(); ++ci) {
+    _triangles.push_back(DCAST(EggPolygon, *ci));
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggMesher::order_triangles
+//       Access: Private
+//  Description: Adds the triangles collected by add_triangles() to
+//               the output group, in the order chosen by the
+//               VertexCacheOptimizer.  Each triangle keeps its own
+//               vertices in their original order, so this is safe
+//               for flat-shaded geometry.
+////////////////////////////////////////////////////////////////////
+void EggMesher::
+order_triangles(EggGroupNode *output) {
+  VertexCacheOptimizer opt;
+  Polygons others;
+
+  Polygons::const_iterator pi;
+  for (pi = _triangles.begin(); pi != _triangles.end(); ++pi) {
+    EggPolygon *poly = (*pi);
+    if (poly->size() == 3) {
+      opt.add_triangle(poly->get_vertex(0)->get_index(),
+                       poly->get_vertex(1)->get_index(),
+                       poly->get_vertex(2)->get_index());
+    } else {
+      others.push_back(poly);
+    }
+  }
+
+  opt.optimize();
+
+  // The optimizer numbers the triangles in the order they were added,
+  // which skipped the polygons that aren't triangles.
+  Polygons triangles;
+  triangles.reserve(_triangles.size() - others.size());
+  for (pi = _triangles.begin(); pi != _triangles.end(); ++pi) {
+    if ((*pi)->size() == 3) {
+      triangles.push_back(*pi);
+    }
+  }
+
+  int num_triangles = opt.get_num_triangles();
+  for (int i = 0; i < num_triangles; ++i) {
+    output->add_child(triangles[opt.get_triangle_index(i)]);
+  }
+  for (pi = others.begin(); pi != others.end(); ++pi) {
+    output->add_child(*pi);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: EggMesher::count_vert_edges
 //       Access: Private
@@ -52,10 +52,14 @@ private:
   void do_mesh();
   PT(EggPrimitive) get_prim(EggMesherStrip &strip);
 
+  void add_triangles(EggPolygon *egg_poly);
+  void order_triangles(EggGroupNode *output);
+
   typedef plist<EggMesherStrip> Strips;
   typedef pset<EggMesherEdge> Edges;
   typedef pset<EggMesherEdge *> EdgePtrs;
   typedef pmap<int, EdgePtrs> Verts;
+  typedef pvector< PT(EggPolygon) > Polygons;
 
   // This is used for show-qsheets.
   typedef pmap<int, Colorf> ColorSheetMap;
@@ -72,6 +76,7 @@ private:
   bool _flat_shaded;
   Strips _tris, _quads, _strips;
   Strips _dead, _done;
+  Polygons _triangles;
   Verts _verts;
   Edges _edges;
   int _strip_index;
@@ -23,6 +23,7 @@
 extern int eggyyparse();
 #include "parserDefs.h"
 #include "lexerDefs.h"
+#include "eggScanner.h"
 
 TypeHandle EggNode::_type_handle;
 
@@ -284,7 +285,7 @@ parse_egg(const string &egg_syntax) {
   eggyyparse();
   egg_cleanup_parser();
 
-  return (egg_error_count() == 0);
+  return (egg_scanner_error_count() == 0);
 }
 
 #ifndef NDEBUG
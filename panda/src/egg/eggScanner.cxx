@@ -0,0 +1,753 @@
+// Filename: eggScanner.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "eggScanner.h"
+#include "lexerDefs.h"
+#include "parserDefs.h"
+#include "config_egg.h"
+#include "parser.h"
+#include "indent.h"
+#include "pnotify.h"
+#include "thread.h"
+#include "pstrtod.h"
+
+#include <math.h>
+#include <ctype.h>
+
+////////////////////////////////////////////////////////////////////
+// Static variables
+////////////////////////////////////////////////////////////////////
+
+// These are all protected by egg_lock, like the lexer's own.
+
+// This is true while the hand-written scanner is reading the file,
+// and false while the flex lexer is.
+static bool use_fast_lexer = false;
+
+// This is true once the hand-written scanner has returned the initial
+// token, which selects the part of the grammar to start from.
+static bool fast_started = false;
+
+// The rest of these are used only by the hand-written scanner, and
+// mirror those of the same name in lexer.lxx.
+static int line_number = 0;
+static int col_number = 0;
+
+static const int max_error_width = 1024;
+static char current_line[max_error_width + 1];
+
+static int error_count = 0;
+static int warning_count = 0;
+
+static istream *inp = NULL;
+static string egg_filename;
+
+// The scanner reads the input into fast_buffer a block at a time;
+// fast_pos is the next character to be scanned, and fast_len is the
+// number of characters in the buffer.
+static char *fast_buffer = NULL;
+static size_t fast_buffer_size = 0;
+static size_t fast_pos = 0;
+static size_t fast_len = 0;
+static bool fast_eof = false;
+static const size_t fast_block_size = 65536;
+
+////////////////////////////////////////////////////////////////////
+// Defining the interface to the scanner.
+////////////////////////////////////////////////////////////////////
+
+void
+egg_init_scanner(istream &in, const string &filename) {
+  // The flex lexer is always initialized, even when it won't be
+  // reading the file, since it keeps track of the initial token.
+  egg_init_lexer(in, filename);
+
+  use_fast_lexer = egg_fast_lexer;
+  fast_started = false;
+  inp = &in;
+  egg_filename = filename;
+  line_number = 0;
+  col_number = 0;
+  error_count = 0;
+  warning_count = 0;
+  fast_pos = 0;
+  fast_len = 0;
+  fast_eof = false;
+}
+
+int
+egg_scanner_error_count() {
+  return use_fast_lexer ? error_count : egg_error_count();
+}
+
+int
+egg_scanner_warning_count() {
+  return use_fast_lexer ? warning_count : egg_warning_count();
+}
+
+void
+egg_scanner_error(const string &msg) {
+  if (!use_fast_lexer) {
+    eggyyerror(msg);
+    return;
+  }
+
+  if (egg_cat.is_error()) {
+    ostream &out = egg_cat.error(false);
+
+    out << "\nError";
+    if (!egg_filename.empty()) {
+      out << " in " << egg_filename;
+    }
+    out 
+      << " at line " << line_number << ", column " << col_number << ":\n"
+      << setiosflags(Notify::get_literal_flag())
+      << current_line << "\n";
+    indent(out, col_number-1) 
+      << "^\n" << msg << "\n\n" 
+      << resetiosflags(Notify::get_literal_flag()) << flush;
+  }
+  error_count++;
+}
+
+void
+egg_scanner_error(ostringstream &strm) {
+  string s = strm.str();
+  egg_scanner_error(s);
+}
+
+void
+egg_scanner_warning(const string &msg) {
+  if (!use_fast_lexer) {
+    eggyywarning(msg);
+    return;
+  }
+
+  if (egg_cat.is_warning()) {
+    ostream &out = egg_cat.warning(false);
+
+    out << "\nWarning";
+    if (!egg_filename.empty()) {
+      out << " in " << egg_filename;
+    }
+    out 
+      << " at line " << line_number << ", column " << col_number << ":\n"
+      << setiosflags(Notify::get_literal_flag())
+      << current_line << "\n";
+    indent(out, col_number-1) 
+      << "^\n" << msg << "\n\n" 
+      << resetiosflags(Notify::get_literal_flag()) << flush;
+  }
+  warning_count++;
+}
+
+void
+egg_scanner_warning(ostringstream &strm) {
+  string s = strm.str();
+  egg_scanner_warning(s);
+}
+
+////////////////////////////////////////////////////////////////////
+// Internal support functions.
+////////////////////////////////////////////////////////////////////
+
+// input_chars reads up to max_size characters from the input stream,
+// and returns the number read.  It is the equivalent of the function
+// of the same name in lexer.lxx.
+static size_t
+input_chars(char *buffer, size_t max_size) {
+  nassertr(inp != NULL, 0);
+  size_t result = 0;
+  if (*inp) {
+    inp->read(buffer, max_size);
+    result = inp->gcount();
+
+    if (line_number == 0) {
+      // This is a special case.  If we are reading the very first bit
+      // from the stream, copy it into the current_line array, since
+      // fast_newline(), which fills current_line normally, doesn't
+      // catch the first line.
+      size_t length = min((size_t)max_error_width, result);
+      strncpy(current_line, buffer, length);
+      current_line[length] = '\0';
+      line_number++;
+      col_number = 0;
+
+      // Truncate it at the newline.
+      char *end = strchr(current_line, '\n');
+      if (end != NULL) {
+        *end = '\0';
+      }
+    }
+  }
+  Thread::consider_yield();
+  return result;
+}
+
+// fast_fill makes sure that at least min_chars characters beyond
+// fast_pos are in fast_buffer, by reading more of the input, unless
+// the input ends first.  It returns the number of characters that
+// are available.  The characters before fast_pos are discarded.
+static size_t
+fast_fill(size_t min_chars) {
+  size_t avail = fast_len - fast_pos;
+  if (avail >= min_chars || fast_eof) {
+    return avail;
+  }
+
+  if (min_chars > fast_buffer_size) {
+    // Grow the buffer.  After the first block, this only happens for
+    // a very long word.
+    size_t want_size = max(max(min_chars, fast_block_size), fast_buffer_size * 2);
+    char *new_buffer = (char *)PANDA_MALLOC_ARRAY(want_size);
+    if (fast_buffer != NULL) {
+      memcpy(new_buffer, fast_buffer + fast_pos, avail);
+      PANDA_FREE_ARRAY(fast_buffer);
+    }
+    fast_buffer = new_buffer;
+    fast_buffer_size = want_size;
+  } else {
+    memmove(fast_buffer, fast_buffer + fast_pos, avail);
+  }
+  fast_pos = 0;
+  fast_len = avail;
+
+  while (fast_len < min_chars && !fast_eof) {
+    size_t result = input_chars(fast_buffer + fast_len,
+                                fast_buffer_size - fast_len);
+    if (result == 0) {
+      fast_eof = true;
+    } else {
+      fast_len += result;
+    }
+  }
+
+  return fast_len;
+}
+
+// read_char reads and returns a single character, incrementing the
+// supplied line and column numbers as appropriate.  A convenience
+// function for the scanning functions below.
+static int
+read_char(int &line, int &col) {
+  int c = EOF;
+  if (fast_pos < fast_len || fast_fill(1) != 0) {
+    c = (unsigned char)fast_buffer[fast_pos++];
+  }
+  if (c == '\n') {
+    line++;
+    col = 0;
+  } else {
+    col++;
+  }
+  return c;
+}
+
+// scan_quoted_string reads a string delimited by quotation marks and
+// returns it.
+static string
+scan_quoted_string() {
+  string result;
+
+  // As in lexer.lxx, the error for an unterminated string is
+  // reported at the start of the string, so we scan with our own
+  // copies of line_number and col_number.
+  int line = line_number;
+  int col = col_number;
+
+  int c;
+  c = read_char(line, col);
+  while (c != '"' && c != EOF) {
+    result += c;
+    c = read_char(line, col);
+  }
+
+  if (c == EOF) {
+    egg_scanner_error("This quotation mark is unterminated.");
+  }
+
+  line_number = line;
+  col_number = col;
+
+  return result;
+}
+
+// eat_c_comment scans past all characters up until the first */
+// encountered.
+static void
+eat_c_comment() {
+  int line = line_number;
+  int col = col_number;
+
+  int c, last_c;
+  
+  last_c = '\0';
+  c = read_char(line, col);
+  while (c != EOF && !(last_c == '*' && c == '/')) {
+    if (last_c == '/' && c == '*') {
+      ostringstream errmsg;
+      errmsg << "This comment contains a nested /* symbol at line "
+             << line << ", column " << col-1 << "--possibly unclosed?"
+             << ends;
+      egg_scanner_warning(errmsg);
+    }
+    last_c = c;
+    c = read_char(line, col);
+  }
+
+  if (c == EOF) {
+    egg_scanner_error("This comment marker is unclosed.");
+  }
+
+  line_number = line;
+  col_number = col;
+}
+
+////////////////////////////////////////////////////////////////////
+// The hand-written scanner.
+//
+// This returns exactly the same tokens as the flex scanner in
+// lexer.lxx,
+// but it reads the input a block at a time, and it picks out each
+// token directly instead of running each character through the
+// tables, and then running each line through them again after
+// copying it for the error messages.
+//
+// Since flex chooses the longest match, and the unquoted string rule
+// matches everything up to the next space, brace or quotation mark,
+// the other rules only apply when they match all of that "word";
+// the exception is a // comment, which runs to the end of the line.
+////////////////////////////////////////////////////////////////////
+
+// The keywords, in order, for a binary search.
+struct FastKeyword {
+  const char *_name;
+  int _token;
+};
+static const FastKeyword fast_keywords[] = {
+  { "<ANIMPRELOAD>", ANIMPRELOAD },
+  { "<BEZIERCURVE>", BEZIERCURVE },
+  { "<BFACE>", BFACE },
+  { "<BILLBOARD>", BILLBOARD },
+  { "<BILLBOARDCENTER>", BILLBOARDCENTER },
+  { "<BINORMAL>", BINORMAL },
+  { "<BUNDLE>", BUNDLE },
+  { "<CHAR*>", SCALAR },
+  { "<CLOSED>", CLOSED },
+  { "<COLLIDE>", COLLIDE },
+  { "<COMMENT>", COMMENT },
+  { "<COMPONENT>", COMPONENT },
+  { "<COORDINATESYSTEM>", COORDSYSTEM },
+  { "<CV>", CV },
+  { "<DART>", DART },
+  { "<DCS>", DCS },
+  { "<DEFAULTPOSE>", DEFAULTPOSE },
+  { "<DISTANCE>", DISTANCE },
+  { "<DNORMAL>", DNORMAL },
+  { "<DRGBA>", DRGBA },
+  { "<DTREF>", DTREF },
+  { "<DUV>", DUV },
+  { "<DXYZ>", DXYZ },
+  { "<DYNAMICVERTEXPOOL>", DYNAMICVERTEXPOOL },
+  { "<FILE>", EXTERNAL_FILE },
+  { "<GROUP>", GROUP },
+  { "<INCLUDE>", INCLUDE },
+  { "<INSTANCE>", INSTANCE },
+  { "<JOINT>", JOINT },
+  { "<KNOTS>", KNOTS },
+  { "<LINE>", LINE },
+  { "<LOOP>", LOOP },
+  { "<MATERIAL>", MATERIAL },
+  { "<MATRIX3>", MATRIX3 },
+  { "<MATRIX4>", MATRIX4 },
+  { "<MODEL>", MODEL },
+  { "<MREF>", MREF },
+  { "<NORMAL>", NORMAL },
+  { "<NURBSCURVE>", NURBSCURVE },
+  { "<NURBSSURFACE>", NURBSSURFACE },
+  { "<OBJECTTYPE>", OBJECTTYPE },
+  { "<ORDER>", ORDER },
+  { "<OUTTANGENT>", OUTTANGENT },
+  { "<POINTLIGHT>", POINTLIGHT },
+  { "<POLYGON>", POLYGON },
+  { "<REF>", REF },
+  { "<RGBA>", RGBA },
+  { "<ROTATE>", ROTATE },
+  { "<ROTX>", ROTX },
+  { "<ROTY>", ROTY },
+  { "<ROTZ>", ROTZ },
+  { "<S$ANIM>", SANIM },
+  { "<SCALAR>", SCALAR },
+  { "<SCALE>", SCALE },
+  { "<SEQUENCE>", SEQUENCE },
+  { "<SHADING>", SHADING },
+  { "<SWITCH>", SWITCH },
+  { "<SWITCHCONDITION>", SWITCHCONDITION },
+  { "<TABLE>", TABLE },
+  { "<TAG>", TAG },
+  { "<TANGENT>", TANGENT },
+  { "<TEXLIST>", TEXLIST },
+  { "<TEXTURE>", TEXTURE },
+  { "<TLENGTHS>", TLENGTHS },
+  { "<TRANSFORM>", TRANSFORM },
+  { "<TRANSLATE>", TRANSLATE },
+  { "<TREF>", TREF },
+  { "<TRIANGLEFAN>", TRIANGLEFAN },
+  { "<TRIANGLESTRIP>", TRIANGLESTRIP },
+  { "<TRIM>", TRIM },
+  { "<TXT>", TXT },
+  { "<U-KNOTS>", UKNOTS },
+  { "<UV>", UV },
+  { "<U_KNOTS>", UKNOTS },
+  { "<V-KNOTS>", VKNOTS },
+  { "<V>", TABLE_V },
+  { "<VERTEX>", VERTEX },
+  { "<VERTEXANIM>", VERTEXANIM },
+  { "<VERTEXPOOL>", VERTEXPOOL },
+  { "<VERTEXREF>", VERTEXREF },
+  { "<V_KNOTS>", VKNOTS },
+  { "<XFM$ANIM>", XFMANIM },
+  { "<XFM$ANIM_S$>", XFMSANIM },
+};
+static const int num_fast_keywords = sizeof(fast_keywords) / sizeof(FastKeyword);
+static const size_t max_fast_keyword_length = 19;
+
+// Returns true if the character ends an unquoted string.
+static INLINE bool
+is_fast_word_break(char c) {
+  switch (c) {
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\r':
+  case '{':
+  case '}':
+  case '"':
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+static INLINE bool
+is_fast_digit(char c) {
+  return (c >= '0' && c <= '9');
+}
+
+static INLINE bool
+is_fast_hex_digit(char c) {
+  return ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+          (c >= 'A' && c <= 'F'));
+}
+
+// Returns true if the word matches the indicated lowercase string,
+// ignoring case, as flex does with -i.
+static bool
+fast_word_is(const char *word, size_t length, const char *str) {
+  for (size_t i = 0; i < length; ++i) {
+    if (str[i] == '\0' || tolower((unsigned char)word[i]) != str[i]) {
+      return false;
+    }
+  }
+  return (str[length] == '\0');
+}
+
+// Returns the keyword token for the word, or 0 if it is not a
+// keyword.
+static int
+fast_find_keyword(const char *word, size_t length) {
+  if (length < 3 || length > max_fast_keyword_length ||
+      word[0] != '<' || word[length - 1] != '>') {
+    return 0;
+  }
+
+  char key[max_fast_keyword_length + 1];
+  for (size_t i = 0; i < length; ++i) {
+    key[i] = (char)toupper((unsigned char)word[i]);
+  }
+  key[length] = '\0';
+
+  int lo = 0;
+  int hi = num_fast_keywords;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    int cmp = strcmp(key, fast_keywords[mid]._name);
+    if (cmp == 0) {
+      return fast_keywords[mid]._token;
+    } else if (cmp < 0) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return 0;
+}
+
+// Returns true if all of the word matches {NUMERIC}.
+static bool
+is_fast_numeric(const char *p, const char *end) {
+  if (p < end && (*p == '+' || *p == '-')) {
+    ++p;
+  }
+  int num_digits = 0;
+  while (p < end && is_fast_digit(*p)) {
+    ++p;
+    ++num_digits;
+  }
+  if (p < end && *p == '.') {
+    ++p;
+    while (p < end && is_fast_digit(*p)) {
+      ++p;
+      ++num_digits;
+    }
+  }
+  if (num_digits == 0) {
+    return false;
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p < end && (*p == '+' || *p == '-')) {
+      ++p;
+    }
+    if (p == end || !is_fast_digit(*p)) {
+      return false;
+    }
+    while (p < end && is_fast_digit(*p)) {
+      ++p;
+    }
+  }
+  return (p == end);
+}
+
+// Returns true if all of the word matches {HEX}.
+static bool
+is_fast_hex(const char *p, const char *end) {
+  if (end - p < 2 || p[0] != '0' || (p[1] != 'x' && p[1] != 'X')) {
+    return false;
+  }
+  for (p += 2; p < end; ++p) {
+    if (!is_fast_hex_digit(*p)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if all of the word matches {BINARY}.
+static bool
+is_fast_binary(const char *p, const char *end) {
+  if (end - p < 2 || p[0] != '0' || (p[1] != 'b' && p[1] != 'B')) {
+    return false;
+  }
+  for (p += 2; p < end; ++p) {
+    if (*p != '0' && *p != '1') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// If the word is one of the forms of number, fills in eggyylval and
+// returns the token; otherwise returns 0.
+static int
+fast_number(const char *word, size_t length) {
+  switch (word[0]) {
+  case '0': case '1': case '2': case '3': case '4':
+  case '5': case '6': case '7': case '8': case '9':
+  case '+': case '-': case '.':
+  case 'n': case 'N': case 'i': case 'I':
+    break;
+
+  default:
+    return 0;
+  }
+
+  const char *end = word + length;
+  if (is_fast_numeric(word, end)) {
+    eggyylval._string.assign(word, length);
+    eggyylval._number = patof(eggyylval._string.c_str());
+    return EGG_NUMBER;
+  }
+
+  if (is_fast_hex(word, end)) {
+    eggyylval._string.assign(word, length);
+    eggyylval._ulong = strtoul(eggyylval._string.c_str() + 2, NULL, 16);
+    return EGG_ULONG;
+  }
+
+  if (is_fast_binary(word, end)) {
+    eggyylval._string.assign(word, length);
+    eggyylval._ulong = strtoul(eggyylval._string.c_str() + 2, NULL, 2);
+    return EGG_ULONG;
+  }
+
+  if (length >= 3 && fast_word_is(word, 3, "nan") && 
+      is_fast_hex(word + 3, end)) {
+    eggyylval._string.assign(word, length);
+    memset(&eggyylval._number, 0, sizeof(eggyylval._number));
+    *(unsigned long *)&eggyylval._number = strtoul(eggyylval._string.c_str() + 3, NULL, 0);
+    return EGG_NUMBER;
+  }
+
+  if (fast_word_is(word, length, "inf") || 
+      fast_word_is(word, length, "1.#inf")) {
+    eggyylval._number = HUGE_VAL;
+    eggyylval._string.assign(word, length);
+    return EGG_NUMBER;
+  }
+
+  if (fast_word_is(word, length, "-inf") || 
+      fast_word_is(word, length, "-1.#inf")) {
+    eggyylval._number = -HUGE_VAL;
+    eggyylval._string.assign(word, length);
+    return EGG_NUMBER;
+  }
+
+  return 0;
+}
+
+// Handles a newline at fast_pos, as the \n.* rule does.
+static void
+fast_newline() {
+  ++fast_pos;
+
+  // Save a copy of the new line so we can print it out for the
+  // benefit of the user in case we get an error.
+  size_t length = min(fast_fill(max_error_width), (size_t)max_error_width);
+  const char *line = fast_buffer + fast_pos;
+  const char *end = (const char *)memchr(line, '\n', length);
+  if (end != NULL) {
+    length = end - line;
+  }
+  memcpy(current_line, line, length);
+  current_line[length] = '\0';
+  line_number++;
+  col_number = 0;
+}
+
+// Skips the rest of the line, for a // comment.
+static void
+fast_eat_line() {
+  while (fast_pos < fast_len || fast_fill(1) != 0) {
+    const char *start = fast_buffer + fast_pos;
+    size_t avail = fast_len - fast_pos;
+    const char *end = (const char *)memchr(start, '\n', avail);
+    if (end != NULL) {
+      col_number += end - start;
+      fast_pos += end - start;
+      return;
+    }
+    col_number += avail;
+    fast_pos = fast_len;
+  }
+}
+
+int
+egg_scanner_lex() {
+  if (!use_fast_lexer) {
+    return eggyylex();
+  }
+
+  if (!fast_started) {
+    // The initial token is set in the flex lexer, by egg_init_lexer()
+    // or egg_start_group_body() and the like, and it returns it
+    // without reading any input; so we get it from there.
+    fast_started = true;
+    return eggyylex();
+  }
+
+  while (true) {
+    if (fast_pos == fast_len && fast_fill(1) == 0) {
+      // End of file.
+      return 0;
+    }
+
+    char c = fast_buffer[fast_pos];
+    switch (c) {
+    case '\n':
+      fast_newline();
+      continue;
+
+    case ' ':
+    case '\t':
+    case '\r':
+      // Eat whitespace.
+      ++fast_pos;
+      ++col_number;
+      continue;
+
+    case '{':
+    case '}':
+      // Send curly braces as themselves.
+      ++fast_pos;
+      ++col_number;
+      return c;
+
+    case '"':
+      // Quoted string.
+      ++fast_pos;
+      ++col_number;
+      eggyylval._string = scan_quoted_string();
+      return EGG_STRING;
+    }
+
+    // Anything else is a word, up to the next space, brace or
+    // quotation mark.  Make sure all of it is in the buffer.
+    size_t length = 0;
+    while (true) {
+      const char *p = fast_buffer + fast_pos + length;
+      const char *end = fast_buffer + fast_len;
+      while (p < end && !is_fast_word_break(*p)) {
+        ++p;
+      }
+      length = p - (fast_buffer + fast_pos);
+      if (p < end || fast_eof) {
+        break;
+      }
+      fast_fill(length + 1);
+    }
+
+    const char *word = fast_buffer + fast_pos;
+
+    if (length >= 2 && word[0] == '/' && word[1] == '/') {
+      // Eat C++-style comments.
+      fast_eat_line();
+      continue;
+    }
+
+    fast_pos += length;
+    col_number += length;
+
+    if (length == 2 && word[0] == '/' && word[1] == '*') {
+      // Eat C-style comments.
+      eat_c_comment();
+      continue;
+    }
+
+    int token = fast_find_keyword(word, length);
+    if (token != 0) {
+      return token;
+    }
+
+    token = fast_number(word, length);
+    if (token != 0) {
+      return token;
+    }
+
+    // Unquoted string.
+    eggyylval._string.assign(word, length);
+    return EGG_STRING;
+  }
+}
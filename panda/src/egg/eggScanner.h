@@ -0,0 +1,39 @@
+// Filename: eggScanner.h
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef EGGSCANNER_H
+#define EGGSCANNER_H
+
+#include "pandabase.h"
+
+#include <string>
+
+// The egg parser reads its tokens through these functions, and
+// reports its errors and warnings through them.  They pass each call
+// on to the flex lexer defined in lexer.lxx, unless egg-fast-lexer is
+// true, in which case the file is read instead by the hand-written
+// scanner in eggScanner.cxx.
+
+void egg_init_scanner(istream &in, const string &filename);
+int egg_scanner_lex();
+int egg_scanner_error_count();
+int egg_scanner_warning_count();
+
+void egg_scanner_error(const string &msg);
+void egg_scanner_error(ostringstream &strm);
+
+void egg_scanner_warning(const string &msg);
+void egg_scanner_warning(ostringstream &strm);
+
+#endif
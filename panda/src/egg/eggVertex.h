@@ -26,6 +26,7 @@
 #include "luse.h"
 #include "pset.h"
 #include "iterator_types.h"
+#include "deletedChain.h"
 
 class EggVertexPool;
 class EggGroup;
@@ -47,6 +48,10 @@ public:
   typedef uv_iterator const_uv_iterator;
   typedef UVMap::size_type uv_size_type;
 
+  // Vertices are allocated and freed by the thousand when an egg
+  // file is read.
+  ALLOC_DELETED_CHAIN(EggVertex);
+
 PUBLISHED:
   EggVertex();
   EggVertex(const EggVertex &copy);
@@ -27,6 +27,7 @@ TypeHandle EggVertexPool::_type_handle;
 ////////////////////////////////////////////////////////////////////
 EggVertexPool::
 EggVertexPool(const string &name) : EggNode(name) {
+  _has_unique_vertices = false;
   _highest_index = -1;
 }
 
@@ -40,6 +41,7 @@ EggVertexPool(const string &name) : EggNode(name) {
 ////////////////////////////////////////////////////////////////////
 EggVertexPool::
 EggVertexPool(const EggVertexPool &copy) : EggNode(copy) {
+  _has_unique_vertices = false;
   iterator i;
   for (i = copy.begin(); i != copy.end(); ++i) {
     add_vertex(new EggVertex(*(*i)), (*i)->get_index());
@@ -57,7 +59,8 @@ EggVertexPool::
   // Remove all vertices from the pool when it destructs.
 
   // Sanity check.
-  nassertv(_index_vertices.size() == _unique_vertices.size());
+  nassertv(!_has_unique_vertices || 
+           _index_vertices.size() == _unique_vertices.size());
 
   IndexVertices::iterator ivi;
   for (ivi = _index_vertices.begin(); ivi != _index_vertices.end(); ++ivi) {
@@ -375,7 +378,8 @@ get_uv_names(vector_string &uv_names, vector_string &uvw_names,
 ////////////////////////////////////////////////////////////////////
 EggVertexPool::iterator EggVertexPool::
 begin() const {
-  nassertr(_index_vertices.size() == _unique_vertices.size(),
+  nassertr(!_has_unique_vertices || 
+           _index_vertices.size() == _unique_vertices.size(),
            iterator(_index_vertices.begin()));
   return iterator(_index_vertices.begin());
 }
@@ -408,7 +412,8 @@ empty() const {
 ////////////////////////////////////////////////////////////////////
 EggVertexPool::size_type EggVertexPool::
 size() const {
-  nassertr(_index_vertices.size() == _unique_vertices.size(), 0);
+  nassertr(!_has_unique_vertices || 
+           _index_vertices.size() == _unique_vertices.size(), 0);
   return _index_vertices.size();
 }
 
@@ -447,10 +452,14 @@ add_vertex(EggVertex *vertex, int index) {
   // Always supply an index number >= 0.
   nassertr(index >= 0, NULL);
 
-  // Check for a forward reference.
-  IndexVertices::const_iterator ivi = _index_vertices.find(index);
+  // Check for a forward reference.  Vertices are usually added in
+  // order of index, in which case there's no need to search.
+  IndexVertices::iterator ivi = _index_vertices.end();
+  if (!_index_vertices.empty() && (*_index_vertices.rbegin()).first >= index) {
+    ivi = _index_vertices.lower_bound(index);
+  }
 
-  if (ivi != _index_vertices.end()) {
+  if (ivi != _index_vertices.end() && (*ivi).first == index) {
     EggVertex *orig_vertex = (*ivi).second;
     if (orig_vertex->is_forward_reference() &&
         !vertex->is_forward_reference()) {
@@ -464,8 +473,10 @@ add_vertex(EggVertex *vertex, int index) {
     nassertr(false, NULL);
   }
   
-  _unique_vertices.insert(vertex);
-  _index_vertices[index] = vertex;
+  if (_has_unique_vertices) {
+    _unique_vertices.insert(vertex);
+  }
+  _index_vertices.insert(ivi, IndexVertices::value_type(index, vertex));
 
   if (!vertex->is_forward_reference()) {
     _highest_index = max(_highest_index, index);
@@ -488,6 +499,8 @@ add_vertex(EggVertex *vertex, int index) {
 ////////////////////////////////////////////////////////////////////
 EggVertex *EggVertexPool::
 create_unique_vertex(const EggVertex &copy) {
+  fill_unique_vertices();
+
   UniqueVertices::iterator uvi;
   uvi = _unique_vertices.find((EggVertex *)&copy);
 
@@ -510,6 +523,8 @@ create_unique_vertex(const EggVertex &copy) {
 ////////////////////////////////////////////////////////////////////
 EggVertex *EggVertexPool::
 find_matching_vertex(const EggVertex &copy) {
+  fill_unique_vertices();
+
   UniqueVertices::iterator uvi;
   uvi = _unique_vertices.find((EggVertex *)&copy);
 
@@ -558,23 +573,25 @@ remove_vertex(EggVertex *vertex) {
     }
   }
 
-  // Removing the vertex from the unique list is a bit trickier--there
-  // might be several other vertices that are considered identical to
-  // this one, and so we have to walk through all the identical
-  // vertices until we find the right one.
-  UniqueVertices::iterator uvi;
-  uvi = _unique_vertices.find(vertex);
-
-  // Sanity check.  Is the vertex actually in the pool?
-  nassertv(uvi != _unique_vertices.end());
+  if (_has_unique_vertices) {
+    // Removing the vertex from the unique list is a bit
+    // trickier--there might be several other vertices that are
+    // considered identical to this one, and so we have to walk
+    // through all the identical vertices until we find the right one.
+    UniqueVertices::iterator uvi;
+    uvi = _unique_vertices.find(vertex);
 
-  while ((*uvi) != vertex) {
-    ++uvi;
     // Sanity check.  Is the vertex actually in the pool?
     nassertv(uvi != _unique_vertices.end());
-  }
 
-  _unique_vertices.erase(uvi);
+    while ((*uvi) != vertex) {
+      ++uvi;
+      // Sanity check.  Is the vertex actually in the pool?
+      nassertv(uvi != _unique_vertices.end());
+    }
+
+    _unique_vertices.erase(uvi);
+  }
 
   vertex->_pool = NULL;
 }
@@ -643,6 +660,7 @@ remove_unused_vertices() {
 
   // All done.  Lose the old lists.
   _unique_vertices.swap(new_unique_vertices);
+  _has_unique_vertices = true;
   _index_vertices.swap(new_index_vertices);
   _highest_index = (int)_index_vertices.size() - 1;
 
@@ -651,6 +669,25 @@ remove_unused_vertices() {
   return num_removed;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: EggVertexPool::fill_unique_vertices
+//       Access: Private
+//  Description: Fills in _unique_vertices from the vertices in the
+//               pool, if it has not already been filled in.
+////////////////////////////////////////////////////////////////////
+void EggVertexPool::
+fill_unique_vertices() {
+  if (_has_unique_vertices) {
+    return;
+  }
+
+  IndexVertices::const_iterator ivi;
+  for (ivi = _index_vertices.begin(); ivi != _index_vertices.end(); ++ivi) {
+    _unique_vertices.insert((*ivi).second);
+  }
+  _has_unique_vertices = true;
+}
+
 // A function object for split_vertex(), used in transform(), below.
 class IsLocalVertexSplitter {
 public:
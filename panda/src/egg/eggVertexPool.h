@@ -60,6 +60,8 @@ private:
   // are not reference-counted), this time ordered by vertex
   // properties.  This makes it easy to determine when one or more
   // vertices already exist in the pool with identical properties.
+  // It isn't filled in until it is first needed, since most pools,
+  // such as the ones read from an egg file, never need it.
   typedef pmultiset<EggVertex *, UniqueEggVertices> UniqueVertices;
 
 public:
@@ -139,7 +141,10 @@ protected:
   virtual void r_transform_vertices(const LMatrix4d &mat);
 
 private:
+  void fill_unique_vertices();
+
   UniqueVertices _unique_vertices;
+  bool _has_unique_vertices;
   IndexVertices _index_vertices;
   int _highest_index;
 
@@ -21,6 +21,7 @@
 #include "eggNamedObject.h"
 
 #include "luse.h"
+#include "deletedChain.h"
 
 ////////////////////////////////////////////////////////////////////
 //       Class : EggVertexUV
@@ -30,6 +31,9 @@
 //               with its own name.
 ////////////////////////////////////////////////////////////////////
 class EXPCL_PANDAEGG EggVertexUV : public EggNamedObject {
+public:
+  ALLOC_DELETED_CHAIN(EggVertexUV);
+
 PUBLISHED:
   EggVertexUV(const string &name, const TexCoordd &uv);
   EggVertexUV(const string &name, const TexCoord3d &uvw);
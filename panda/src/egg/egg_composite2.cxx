@@ -7,6 +7,7 @@
 #include "eggPrimitive.cxx"
 #include "eggRenderMode.cxx"
 #include "eggSAnimData.cxx"
+#include "eggScanner.cxx"
 #include "eggSurface.cxx"
 #include "eggSwitchCondition.cxx"
 #include "eggTable.cxx"
@@ -0,0 +1,212 @@
+// Filename: test_egg_parse.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "eggData.h"
+#include "config_egg.h"
+#include "trueClock.h"
+#include "pnotify.h"
+
+// This program checks the hand-written egg scanner, selected by
+// egg-fast-lexer, against the flex-generated one.  It parses a few
+// pieces of egg text with each scanner: one that uses each kind of
+// token, including keywords in mixed case, numbers in each notation,
+// quoted strings with escapes, and both kinds of comment; one with a
+// word longer than the scanner's block; and some with errors or
+// warnings.  Both scanners must produce the same egg data and the same
+// messages.
+//
+// The well-formed text is also parsed at each offset from the end of
+// the scanner's first block, so that every token in it is split
+// across two reads at some point.  Finally, it reports the rate at
+// which each scanner reads a large vertex pool.
+//
+// Usage: test_egg_parse
+
+// This must match fast_block_size in eggScanner.cxx.
+static const size_t block_size = 65536;
+
+static const char *const all_tokens_egg =
+  "<CoordinateSystem> { Z-Up }\n"
+  "\n"
+  "<Comment> {\n"
+  "  \"A quoted string with \\\"escapes\\\", // not a comment, \"\n"
+  "  \"and /* not one either */\"\n"
+  "}\n"
+  "\n"
+  "/* A C-style comment,\n"
+  "   over two lines. */\n"
+  "<Texture> tex {\n"
+  "  \"maps/some texture.rgb\"\n"
+  "  <Scalar> wrap { repeat }\n"
+  "  <SCALAR> alpha-file-channel { 4 }\n"
+  "}\n"
+  "\n"
+  "<VertexPool> pool {\n"
+  "  <Vertex> 0 { 1 -2.5 +3e2 <Normal> { .5 0 -1. } }  // To the end.\n"
+  "  <Vertex> 1 { 0x10 0b101 1E-3 <RGBA> { 1 1 1 1 } }\n"
+  "  <vertex> 2 { -0 00.25 -.75\n"
+  "    <UV> { 0 1 } }\n"
+  "  <Vertex> 3 { inf -inf 1.#inf }\n"
+  "  <Vertex> 4 { -1.#inf nan0x7fc00000 0 }\n"
+  "}\n"
+  "\n"
+  "<Group> \"a group\" {\n"
+  "  <Polygon> {\n"
+  "    <TRef> { tex }\n"
+  "    <VertexRef> { 0 1 2 <Ref> { pool } }\n"
+  "  }\n"
+  "}\n";
+
+static const char *const problem_eggs[] = {
+  "<Group> { <Unknown> { } }\n",
+  "<Group> g {\n  <Polygon> { <VertexRef> { 0 1 2 <Ref> { nowhere } } }\n}\n",
+  "<Comment> { \"unterminated string\n}\n",
+  "<Group> g { }\n/* unterminated comment\n",
+  "<Group> g { /* nested /* comment */ }\n",
+  "<Group> g { \n",
+};
+static const int num_problem_eggs = sizeof(problem_eggs) / sizeof(const char *);
+
+////////////////////////////////////////////////////////////////////
+//     Function: parse
+//  Description: Parses the egg text with the indicated scanner, and
+//               fills result with the egg data written back out,
+//               followed by any messages printed while parsing.
+////////////////////////////////////////////////////////////////////
+static bool
+parse(const string &text, bool fast_lexer, string &result) {
+  egg_fast_lexer.set_value(fast_lexer);
+
+  Notify *notify = Notify::ptr();
+  ostream *orig_ostream = notify->get_ostream_ptr();
+  ostringstream messages;
+  notify->set_ostream_ptr(&messages, false);
+
+  istringstream in(text);
+  EggData data;
+  bool okflag = data.read(in);
+
+  notify->set_ostream_ptr(orig_ostream, false);
+
+  ostringstream out;
+  if (okflag) {
+    data.write_egg(out);
+  }
+  out << messages.str();
+  result = out.str();
+  return okflag;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: scanners_agree
+//  Description: Parses the text with both scanners, and returns true
+//               if they produce the same result.
+////////////////////////////////////////////////////////////////////
+static bool
+scanners_agree(const string &text, bool &okflag) {
+  string flex_result, fast_result;
+  okflag = parse(text, false, flex_result);
+  bool fast_ok = parse(text, true, fast_result);
+  return (okflag == fast_ok && flex_result == fast_result);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: time_scanner
+//  Description: Returns the rate, in MB per second, at which the
+//               indicated scanner parses the text.
+////////////////////////////////////////////////////////////////////
+static double
+time_scanner(const string &text, bool fast_lexer) {
+  egg_fast_lexer.set_value(fast_lexer);
+  istringstream in(text);
+  EggData data;
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double start = clock->get_short_time();
+  data.read(in);
+  double elapsed = clock->get_short_time() - start;
+  if (elapsed <= 0.0) {
+    return 0.0;
+  }
+  return (double)text.size() / (1024.0 * 1024.0) / elapsed;
+}
+
+int
+main(int argc, char *argv[]) {
+  int num_errors = 0;
+  bool okflag;
+
+  string all_tokens = all_tokens_egg;
+  if (!scanners_agree(all_tokens, okflag)) {
+    nout << "*** scanners differ on the token sample\n";
+    ++num_errors;
+  } else if (!okflag) {
+    nout << "*** could not parse the token sample\n";
+    ++num_errors;
+  }
+
+  // Move the sample along so that each of its characters, in turn,
+  // is the first one in the scanner's second block.  The padding is
+  // blank lines, which only change the line numbers.
+  size_t offset;
+  for (offset = 0; offset < all_tokens.size(); ++offset) {
+    size_t pad_length = block_size - offset;
+    string text = string(pad_length, '\n') + all_tokens;
+    if (!scanners_agree(text, okflag)) {
+      nout << "*** scanners differ with the block boundary at character "
+           << offset << " of the token sample\n";
+      ++num_errors;
+      break;
+    }
+  }
+
+  string long_word =
+    "<Comment> { " + string(block_size * 2 + 17, 'x') + " }\n";
+  if (!scanners_agree(long_word, okflag) || !okflag) {
+    nout << "*** scanners differ on a word longer than a block\n";
+    ++num_errors;
+  }
+
+  for (int i = 0; i < num_problem_eggs; ++i) {
+    if (!scanners_agree(problem_eggs[i], okflag)) {
+      nout << "*** scanners differ on problem sample " << i << "\n";
+      ++num_errors;
+    }
+  }
+
+  // Now time both scanners on a vertex pool, which is most of the
+  // text of a typical egg file.
+  ostringstream pool;
+  pool << "<VertexPool> pool {\n";
+  for (int v = 0; v < 100000; ++v) {
+    pool << "  <Vertex> " << v << " {\n"
+         << "    " << v * 0.25 << " " << -v * 0.5 << " 1.0625\n"
+         << "    <Normal> { 0 0.707107 -0.707107 }\n"
+         << "    <UV> { " << (v % 256) / 256.0 << " 0.5 }\n"
+         << "  }\n";
+  }
+  pool << "}\n";
+  string pool_text = pool.str();
+
+  double flex_rate = time_scanner(pool_text, false);
+  double fast_rate = time_scanner(pool_text, true);
+  nout << pool_text.size() << " bytes of vertices: " << flex_rate
+       << " MB/s flex, " << fast_rate << " MB/s fast\n";
+
+  if (num_errors != 0) {
+    return 1;
+  }
+  nout << "Scanners agree.\n";
+  return 0;
+}
@@ -48,3 +48,13 @@
   #define IGATESCAN load_egg_file.h 
 
 #end lib_target
+
+#begin test_bin_target
+  #define TARGET test_egg_load
+  #define LOCAL_LIBS \
+    egg2pg egg pgraph gobj putil
+
+  #define SOURCES \
+    test_egg_load.cxx
+
+#end test_bin_target
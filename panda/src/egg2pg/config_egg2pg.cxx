@@ -157,6 +157,18 @@ ConfigVariableBool egg_preload_simple_textures
           "fact, the egg loader will generate simple texture images if "
           "either this or preload-simple-textures is true."));
 
+ConfigVariableInt egg_load_threads
+("egg-load-threads", 0,
+ PRC_DESC("Specifies the number of threads, counting the loading thread, "
+          "that may share the reading of an egg file's textures and the "
+          "building of its polysets' vertex data.  The helpers are "
+          "tasks on the egg_load task chain, whose egg-load-threads - 1 "
+          "threads are started the first time they are needed; "
+          "changing this variable afterwards changes how many tasks a "
+          "load uses, but not the size of the chain.  The polysets are "
+          "still added to the scene graph in order, so the model is "
+          "the same with any number of threads."));
+
 ConfigureFn(config_egg2pg) {
   init_libegg2pg();
 }
@@ -90,6 +90,13 @@
 #include "sparseArray.h"
 #include "bitArray.h"
 #include "thread.h"
+#include "pmutex.h"
+#include "mutexHolder.h"
+#include "conditionVarFull.h"
+#include "referenceCount.h"
+#include "asyncTaskManager.h"
+#include "genericAsyncTask.h"
+#include "lightMutexHolder.h"
 #include "uvScrollNode.h"
 
 #include <ctype.h>
@@ -124,6 +131,151 @@ LODInstance(EggNode *egg_node) {
   _d = DCAST(EggSwitchConditionDistance, &sw);
 }
 
+////////////////////////////////////////////////////////////////////
+//       Class : EggLoader::LoadWork
+// Description : The textures to be read, or the polysets to be
+//               built, that remain to be handed out.  Only one of
+//               _textures and _polysets is filled in.
+//
+//               The loading thread works through the items itself,
+//               and the tasks it adds to the egg_load task chain help
+//               it.  A task may not start until after the loading
+//               thread has finished, so each task keeps a reference
+//               to the work, and touches the loader's data only while
+//               it holds an item.
+////////////////////////////////////////////////////////////////////
+class EggLoader::LoadWork : public ReferenceCount {
+public:
+  LoadWork(EggLoader *loader);
+
+  void do_work();
+  void wait_for_helpers();
+
+  static AsyncTask::DoneStatus task_func(GenericAsyncTask *task, void *user_data);
+  static void task_birth(GenericAsyncTask *task, void *user_data);
+  static void task_death(GenericAsyncTask *task, bool clean_exit, void *user_data);
+
+  EggLoader *_loader;
+  const pvector<PT_EggTexture> *_egg_textures;
+  pvector<PT(Texture) > *_textures;
+  EggLoader::PolysetDefs *_polysets;
+  int _num_items;
+
+private:
+  int _next_item;
+  int _num_helpers;
+  Mutex _lock;
+  ConditionVarFull _cvar;
+};
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::LoadWork::Constructor
+//       Access: Public
+//  Description: 
+////////////////////////////////////////////////////////////////////
+EggLoader::LoadWork::
+LoadWork(EggLoader *loader) :
+  _loader(loader),
+  _egg_textures(NULL),
+  _textures(NULL),
+  _polysets(NULL),
+  _num_items(0),
+  _next_item(0),
+  _num_helpers(0),
+  _cvar(_lock)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::LoadWork::do_work
+//       Access: Public
+//  Description: Takes textures or polysets from the work, one at a
+//               time, until there are none left.
+////////////////////////////////////////////////////////////////////
+void EggLoader::LoadWork::
+do_work() {
+  while (true) {
+    int n;
+    {
+      MutexHolder holder(_lock);
+      if (_next_item >= _num_items) {
+        return;
+      }
+      n = _next_item;
+      ++_next_item;
+    }
+    if (_polysets != (PolysetDefs *)NULL) {
+      _loader->build_polyset(*(*_polysets)[n]);
+    } else {
+      (*_textures)[n] = read_texture((*_egg_textures)[n]);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::LoadWork::wait_for_helpers
+//       Access: Public
+//  Description: Waits for any task that is still working on an item
+//               to finish it.  Once do_work() has returned in the
+//               loading thread, no task can take another item.
+////////////////////////////////////////////////////////////////////
+void EggLoader::LoadWork::
+wait_for_helpers() {
+  MutexHolder holder(_lock);
+  while (_num_helpers > 0) {
+    _cvar.wait();
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::LoadWork::task_func
+//       Access: Public, Static
+//  Description: The function of each task added to the egg_load task
+//               chain.
+////////////////////////////////////////////////////////////////////
+AsyncTask::DoneStatus EggLoader::LoadWork::
+task_func(GenericAsyncTask *task, void *user_data) {
+  LoadWork *work = (LoadWork *)user_data;
+  {
+    MutexHolder holder(work->_lock);
+    if (work->_next_item >= work->_num_items) {
+      // We started too late; there's nothing left to do.
+      return AsyncTask::DS_done;
+    }
+    ++work->_num_helpers;
+  }
+
+  work->do_work();
+
+  MutexHolder holder(work->_lock);
+  if (--work->_num_helpers == 0) {
+    work->_cvar.notify_all();
+  }
+  return AsyncTask::DS_done;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::LoadWork::task_birth
+//       Access: Public, Static
+//  Description: Called when a task is added to the task chain.  The
+//               task keeps a reference to the work until it dies.
+////////////////////////////////////////////////////////////////////
+void EggLoader::LoadWork::
+task_birth(GenericAsyncTask *task, void *user_data) {
+  ((LoadWork *)user_data)->ref();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::LoadWork::task_death
+//       Access: Public, Static
+//  Description: Called when a task finishes, or is removed before it
+//               has run.
+////////////////////////////////////////////////////////////////////
+void EggLoader::LoadWork::
+task_death(GenericAsyncTask *task, bool clean_exit, void *user_data) {
+  unref_delete((LoadWork *)user_data);
+}
+
 
 ////////////////////////////////////////////////////////////////////
 //     Function: EggLoader::Constructor
@@ -138,6 +290,7 @@ EggLoader() {
   _error = false;
   _dynamic_override = false;
   _dynamic_override_char_maker = NULL;
+  _defer_polysets = false;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -153,6 +306,7 @@ EggLoader(const EggData *data) :
   _error = false;
   _dynamic_override = false;
   _dynamic_override_char_maker = NULL;
+  _defer_polysets = false;
 }
 
 
@@ -207,7 +361,14 @@ build_graph() {
 
   // Now build up the scene graph.
   _root = new ModelRoot(_data->get_egg_filename().get_basename());
+
+  // With egg-load-threads, the Geoms of the polysets aren't built as
+  // we go; they're built all together, in parallel, once the nodes
+  // are all in place.
+  _defer_polysets = (egg_load_threads > 1 && Thread::is_true_threads());
   make_node(_data, _root);
+  finish_polysets();
+  _defer_polysets = false;
 
   reparent_decals();
   start_sequences();
@@ -306,6 +467,10 @@ start_sequences() {
 //               to apply to the vertices (instead of the default
 //               transform based on the bin's position within the
 //               hierarchy).
+//
+//               If build_graph() is deferring polysets, the Geoms are
+//               not built until finish_polysets() is called, although
+//               the GeomNode that will hold them is created now.
 ////////////////////////////////////////////////////////////////////
 void EggLoader::
 make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
@@ -330,16 +495,24 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
     return;
   }
 
+  PolysetDef *def = new PolysetDef;
+  def->_egg_bin = egg_bin;
+  def->_render_state = render_state;
+  def->_is_dynamic = is_dynamic;
+  def->_character_maker = character_maker;
+  def->_parent = parent;
+
   // Generate an optimal vertex pool (or multiple vertex pools, if we
   // have a lot of vertex) for the polygons within just the bin.  Each
   // EggVertexPool translates directly to an optimal GeomVertexData
   // structure.
-  EggVertexPools vertex_pools;
-  egg_bin->rebuild_vertex_pools(vertex_pools, (unsigned int)egg_max_vertices, 
-                                false);
+  egg_bin->rebuild_vertex_pools(def->_vertex_pools, 
+                                (unsigned int)egg_max_vertices, false);
 
-  if (egg_mesh) {
-    // If we're using the mesher, mesh now.
+  if (egg_mesh || egg_optimize_vertex_cache) {
+    // If we're using the mesher, mesh now.  (When
+    // egg-optimize-vertex-cache is set, the mesher makes sorted
+    // triangles instead of strips.)
     egg_bin->mesh_triangles(render_state->_flat_shaded ? EggGroupNode::T_flat_shaded : 0);
 
   } else {
@@ -355,14 +528,78 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
 
   //  egg_bin->write(cerr, 0);
 
-  PT(GeomNode) geom_node;
+  if (transform != NULL) {
+    def->_transform = (*transform);
+  } else {
+    def->_transform = egg_bin->get_vertex_to_node();
+  }
+
+  // All of the above modifies the egg structures, and must be done
+  // here in order.  From here on, though, the polyset only looks at
+  // its own vertex pools, so it can be built in parallel with the
+  // other polysets--unless it belongs to a character, which is
+  // shared by all of its polysets.
+  if (_defer_polysets && character_maker == (CharacterMaker *)NULL) {
+    // Create the GeomNode now, so that it takes its proper place
+    // among its siblings.
+    make_polyset_node(*def);
+    _pending_polysets.push_back(def);
+    return;
+  }
+
+  build_polyset(*def);
+  attach_polyset(*def);
+  delete def;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::make_polyset_node
+//       Access: Private
+//  Description: Creates the GeomNode that the Geoms of the indicated
+//               polyset will be added to, or uses its parent if that
+//               is already a GeomNode.
+////////////////////////////////////////////////////////////////////
+void EggLoader::
+make_polyset_node(PolysetDef &def) {
+  // Now, is our parent node a GeomNode, or just an ordinary
+  // PandaNode?  If it's a GeomNode, we can add the new Geom directly
+  // to our parent; otherwise, we need to create a new node.
+  if (def._parent->is_geom_node() && !def._render_state->_hidden) {
+    def._geom_node = DCAST(GeomNode, def._parent);
+    
+  } else {
+    def._geom_node = new GeomNode(def._egg_bin->get_name());
+    if (def._render_state->_hidden) {
+      def._parent->add_stashed(def._geom_node);
+    } else {
+      def._parent->add_child(def._geom_node);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::build_polyset
+//       Access: Private
+//  Description: Builds the Geoms for the polyset prepared by
+//               make_polyset(), one for each of its vertex pools that
+//               has any primitives, without adding them to the scene
+//               graph.
+//
+//               Unless the polyset belongs to a character, this may
+//               be called in a separate thread, in parallel with
+//               other polysets.
+////////////////////////////////////////////////////////////////////
+void EggLoader::
+build_polyset(PolysetDef &def) {
+  EggBin *egg_bin = def._egg_bin;
+  const EggRenderState *render_state = def._render_state;
 
   // Now iterate through each EggVertexPool.  Normally, there's only
   // one, but if we have a really big mesh, it might have been split
   // into multiple vertex pools (to keep each one within the
   // egg_max_vertices constraint).
   EggVertexPools::iterator vpi;
-  for (vpi = vertex_pools.begin(); vpi != vertex_pools.end(); ++vpi) {
+  for (vpi = def._vertex_pools.begin(); vpi != def._vertex_pools.end(); ++vpi) {
     EggVertexPool *vertex_pool = (*vpi);
     vertex_pool->remove_unused_vertices();
     //  vertex_pool->write(cerr, 0);
@@ -375,6 +612,7 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
     // types of primitives that reference this vertex pool.
     UniquePrimitives unique_primitives;
     Primitives primitives;
+    EggGroupNode::const_iterator ci;
     for (ci = egg_bin->begin(); ci != egg_bin->end(); ++ci) {
       EggPrimitive *egg_prim;
       DCAST_INTO_V(egg_prim, (*ci));
@@ -385,17 +623,11 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
     }
 
     if (!primitives.empty()) {
-      LMatrix4d mat;
-      if (transform != NULL) {
-        mat = (*transform);
-      } else {
-        mat = egg_bin->get_vertex_to_node();
-      }
-      
       // Now convert this vertex pool to a GeomVertexData.
       PT(GeomVertexData) vertex_data = 
-        make_vertex_data(render_state, vertex_pool, egg_bin, mat,
-                         is_dynamic, character_maker, has_overall_color);
+        make_vertex_data(render_state, vertex_pool, egg_bin, def._transform,
+                         def._is_dynamic, def._character_maker,
+                         has_overall_color);
       nassertv(vertex_data != (GeomVertexData *)NULL);
 
       // And create a Geom to hold the primitives.
@@ -412,24 +644,6 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
         //    geom->write(cerr);
         //    render_state->_state->write(cerr, 0);
 
-      // Create a new GeomNode if we haven't already.
-      if (geom_node == (GeomNode *)NULL) {
-        // Now, is our parent node a GeomNode, or just an ordinary
-        // PandaNode?  If it's a GeomNode, we can add the new Geom directly
-        // to our parent; otherwise, we need to create a new node.
-        if (parent->is_geom_node() && !render_state->_hidden) {
-          geom_node = DCAST(GeomNode, parent);
-          
-        } else {
-          geom_node = new GeomNode(egg_bin->get_name());
-          if (render_state->_hidden) {
-            parent->add_stashed(geom_node);
-          } else {
-            parent->add_child(geom_node);
-          }
-        }
-      }
-
       CPT(RenderState) geom_state = render_state->_state;
       if (has_overall_color) {
         if (!overall_color.almost_equal(Colorf(1.0f, 1.0f, 1.0f, 1.0f))) {
@@ -439,19 +653,83 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
         geom_state = geom_state->add_attrib(ColorAttrib::make_vertex(), -1);
       }
 
-      geom_node->add_geom(geom, geom_state);
+      def._geoms.push_back(geom);
+      def._geom_states.push_back(geom_state);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::attach_polyset
+//       Access: Private
+//  Description: Adds the Geoms made by build_polyset() to the scene
+//               graph, creating a GeomNode for them if one has not
+//               already been created.
+////////////////////////////////////////////////////////////////////
+void EggLoader::
+attach_polyset(PolysetDef &def) {
+  if (def._geoms.empty()) {
+    // No geometry after all.  If we created a GeomNode in advance,
+    // take it out again.
+    if (def._geom_node != (GeomNode *)NULL && 
+        def._geom_node != def._parent) {
+      if (def._render_state->_hidden) {
+        int n = def._parent->find_stashed(def._geom_node);
+        if (n != -1) {
+          def._parent->remove_stashed(n);
+        }
+      } else {
+        def._parent->remove_child(def._geom_node);
+      }
     }
+    return;
+  }
+
+  // Create a new GeomNode if we haven't already.
+  if (def._geom_node == (GeomNode *)NULL) {
+    make_polyset_node(def);
+  }
+
+  for (size_t i = 0; i < def._geoms.size(); ++i) {
+    def._geom_node->add_geom(def._geoms[i], def._geom_states[i]);
   }
    
-  if (geom_node != (GeomNode *)NULL && egg_show_normals) {
+  if (egg_show_normals) {
     // Create some more geometry to visualize each normal.
-    for (vpi = vertex_pools.begin(); vpi != vertex_pools.end(); ++vpi) {
+    EggVertexPools::iterator vpi;
+    for (vpi = def._vertex_pools.begin(); vpi != def._vertex_pools.end(); ++vpi) {
       EggVertexPool *vertex_pool = (*vpi);
-      show_normals(vertex_pool, geom_node);
+      show_normals(vertex_pool, def._geom_node);
     }
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::finish_polysets
+//       Access: Private
+//  Description: Builds the Geoms of all of the polysets deferred by
+//               make_polyset(), dividing them among egg-load-threads
+//               threads, and then adds them to the scene graph in
+//               the order they were made.
+////////////////////////////////////////////////////////////////////
+void EggLoader::
+finish_polysets() {
+  if (_pending_polysets.empty()) {
+    return;
+  }
+
+  PT(LoadWork) work = new LoadWork(this);
+  work->_polysets = &_pending_polysets;
+  run_load_work(work, (int)_pending_polysets.size());
+
+  PolysetDefs::iterator pi;
+  for (pi = _pending_polysets.begin(); pi != _pending_polysets.end(); ++pi) {
+    attach_polyset(*(*pi));
+    delete (*pi);
+  }
+  _pending_polysets.clear();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: EggLoader::make_transform
 //       Access: Public
@@ -857,12 +1135,24 @@ load_textures() {
   EggTextureCollection tc;
   tc.find_used_textures(_data);
 
-  EggTextureCollection::iterator ti;
-  for (ti = tc.begin(); ti != tc.end(); ++ti) {
-    PT_EggTexture egg_tex = (*ti);
+  // Reading the texture files is the slow part, and the reads are
+  // independent of each other, so they may be done in parallel.
+  pvector<PT_EggTexture> egg_textures;
+  egg_textures.insert(egg_textures.end(), tc.begin(), tc.end());
+  pvector<PT(Texture) > textures(egg_textures.size());
+
+  PT(LoadWork) work = new LoadWork(this);
+  work->_egg_textures = &egg_textures;
+  work->_textures = &textures;
+  run_load_work(work, (int)egg_textures.size());
+
+  // The rest is done here, in order, since several EggTextures may
+  // share the same Texture.
+  for (size_t i = 0; i < egg_textures.size(); ++i) {
+    EggTexture *egg_tex = egg_textures[i];
 
     TextureDef def;
-    if (load_texture(def, egg_tex)) {
+    if (load_texture(def, egg_tex, textures[i])) {
       // Now associate the pointers, so we'll be able to look up the
       // Texture pointer given an EggTexture pointer, later.
       _textures[egg_tex] = def;
@@ -870,18 +1160,69 @@ load_textures() {
   }
 }
 
-
 ////////////////////////////////////////////////////////////////////
-//     Function: EggLoader::load_texture
+//     Function: EggLoader::run_load_work
 //       Access: Private
-//  Description:
+//  Description: Reads the textures or builds the polysets of the
+//               indicated work, with the help of up to
+//               egg-load-threads - 1 tasks on the egg_load task
+//               chain.  The chain's threads are started the first
+//               time they are needed, and kept for later loads.
 ////////////////////////////////////////////////////////////////////
-bool EggLoader::
-load_texture(TextureDef &def, EggTexture *egg_tex) {
-  // Check to see if we should reduce the number of channels in
-  // the texture.
-  int wanted_channels = 0;
-  bool wanted_alpha = false;
+void EggLoader::
+run_load_work(LoadWork *work, int num_items) {
+  work->_num_items = num_items;
+
+  int num_threads = min((int)egg_load_threads, num_items);
+  if (num_threads <= 1 || !Thread::is_true_threads()) {
+    work->do_work();
+    return;
+  }
+
+  static const string chain_name = "egg_load";
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  if (task_mgr->find_task_chain(chain_name) == (AsyncTaskChain *)NULL) {
+    AsyncTaskChain *chain = task_mgr->make_task_chain(chain_name);
+    chain->set_num_threads(egg_load_threads - 1);
+  }
+
+  typedef pvector<PT(GenericAsyncTask) > Tasks;
+  Tasks tasks;
+  tasks.reserve(num_threads - 1);
+  for (int i = 0; i < num_threads - 1; ++i) {
+    PT(GenericAsyncTask) task =
+      new GenericAsyncTask(chain_name, &LoadWork::task_func, work);
+    task->set_upon_birth(&LoadWork::task_birth);
+    task->set_upon_death(&LoadWork::task_death);
+    task->set_task_chain(chain_name);
+    task_mgr->add(task);
+    tasks.push_back(task);
+  }
+
+  // This thread does its share too, and takes whatever the tasks
+  // haven't got to, so it never waits for a task that hasn't started.
+  work->do_work();
+
+  // Any task still waiting to start has nothing left to do.
+  for (Tasks::iterator ti = tasks.begin(); ti != tasks.end(); ++ti) {
+    (*ti)->remove();
+  }
+  work->wait_for_helpers();
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::get_wanted_channels
+//       Access: Private, Static
+//  Description: Determines whether we should reduce the number of
+//               channels in the indicated texture, according to its
+//               format.
+////////////////////////////////////////////////////////////////////
+void EggLoader::
+get_wanted_channels(const EggTexture *egg_tex, 
+                    int &wanted_channels, bool &wanted_alpha) {
+  wanted_channels = 0;
+  wanted_alpha = false;
   switch (egg_tex->get_format()) {
   case EggTexture::F_red:
   case EggTexture::F_green:
@@ -920,17 +1261,23 @@ load_texture(TextureDef &def, EggTexture *egg_tex) {
   case EggTexture::F_unspecified:
     wanted_alpha = egg_tex->has_alpha_filename();
   }
+}
 
-  // Since some properties of the textures are inferred from the
-  // texture files themselves (if the properties are not explicitly
-  // specified in the egg file), then we add the textures as
-  // dependents for the egg file.
-  if (_record != (BamCacheRecord *)NULL) {
-    _record->add_dependent_file(egg_tex->get_fullpath());
-    if (egg_tex->has_alpha_filename() && wanted_alpha) {
-      _record->add_dependent_file(egg_tex->get_alpha_fullpath());
-    }
-  }
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::read_texture
+//       Access: Private, Static
+//  Description: Loads the image file(s) for the indicated texture
+//               from the TexturePool.  Returns NULL if the texture
+//               could not be read.
+//
+//               This may be called in a separate thread; it doesn't
+//               touch the EggLoader or modify the EggTexture.
+////////////////////////////////////////////////////////////////////
+PT(Texture) EggLoader::
+read_texture(const EggTexture *egg_tex) {
+  int wanted_channels;
+  bool wanted_alpha;
+  get_wanted_channels(egg_tex, wanted_channels, wanted_alpha);
 
   // By convention, the egg loader will preload the simple texture images.
   LoaderOptions options;
@@ -985,6 +1332,33 @@ load_texture(TextureDef &def, EggTexture *egg_tex) {
     break;
   }
 
+  return tex;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EggLoader::load_texture
+//       Access: Private
+//  Description: Fills in the TextureDef for the indicated texture,
+//               whose image has already been read by read_texture().
+//               Returns false if the image could not be read.
+////////////////////////////////////////////////////////////////////
+bool EggLoader::
+load_texture(TextureDef &def, EggTexture *egg_tex, Texture *tex) {
+  int wanted_channels;
+  bool wanted_alpha;
+  get_wanted_channels(egg_tex, wanted_channels, wanted_alpha);
+
+  // Since some properties of the textures are inferred from the
+  // texture files themselves (if the properties are not explicitly
+  // specified in the egg file), then we add the textures as
+  // dependents for the egg file.
+  if (_record != (BamCacheRecord *)NULL) {
+    _record->add_dependent_file(egg_tex->get_fullpath());
+    if (egg_tex->has_alpha_filename() && wanted_alpha) {
+      _record->add_dependent_file(egg_tex->get_alpha_fullpath());
+    }
+  }
+
   if (tex == (Texture *)NULL) {
     return false;
   }
@@ -1793,6 +2167,11 @@ make_node(EggGroup *egg_group, PandaNode *parent) {
   if (egg_group->get_dart_type() != EggGroup::DT_none) {
     // A group with the <Dart> flag set means to create a character.
     bool structured = (egg_group->get_dart_type() == EggGroup::DT_structured);
+
+    // The character's polysets all share the CharacterMaker, so they
+    // are built as we go, rather than deferred.
+    bool defer_polysets = _defer_polysets;
+    _defer_polysets = false;
    
     CharacterMaker char_maker(egg_group, *this, structured);  
 
@@ -1809,6 +2188,7 @@ make_node(EggGroup *egg_group, PandaNode *parent) {
       _dynamic_override_char_maker = NULL;
       _dynamic_override = false;
     }
+    _defer_polysets = defer_polysets;
 
   } else if (egg_group->get_cs_type() != EggGroup::CST_none) {
     // A collision group: create collision geometry.
@@ -2156,10 +2536,14 @@ make_vertex_data(const EggRenderState *render_state,
   vpt._bake_in_uvs = render_state->_bake_in_uvs;
   vpt._transform = transform;
 
-  VertexPoolData::iterator di;
-  di = _vertex_pool_data.find(vpt);
-  if (di != _vertex_pool_data.end()) {
-    return (*di).second;
+  {
+    // The polysets may be built in several threads at once.
+    LightMutexHolder holder(_vertex_pool_data_lock);
+    VertexPoolData::iterator di;
+    di = _vertex_pool_data.find(vpt);
+    if (di != _vertex_pool_data.end()) {
+      return (*di).second;
+    }
   }
 
   // Decide on the format for the vertices.
@@ -2448,9 +2832,12 @@ make_vertex_data(const EggRenderState *render_state,
     }
   }
 
-  bool inserted = _vertex_pool_data.insert
-    (VertexPoolData::value_type(vpt, vertex_data)).second;
-  nassertr(inserted, vertex_data);
+  {
+    LightMutexHolder holder(_vertex_pool_data_lock);
+    bool inserted = _vertex_pool_data.insert
+      (VertexPoolData::value_type(vpt, vertex_data)).second;
+    nassertr(inserted, vertex_data);
+  }
 
   Thread::consider_yield();
   return vertex_data;
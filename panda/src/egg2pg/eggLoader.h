@@ -38,6 +38,9 @@
 #include "geomVertexData.h"
 #include "geomPrimitive.h"
 #include "bamCacheRecord.h"
+#include "geom.h"
+#include "geomNode.h"
+#include "lightMutex.h"
 
 class EggNode;
 class EggBin;
@@ -109,6 +112,34 @@ private:
   typedef pmap<PrimitiveUnifier, PT(GeomPrimitive) > UniquePrimitives;
   typedef pvector< PT(GeomPrimitive) > Primitives;
 
+  // A polyset that has been prepared by make_polyset(), but whose
+  // Geoms have not yet been built.  The Geoms are built by
+  // build_polyset(), which may be run in a separate thread, and
+  // attached to the scene graph by attach_polyset().
+  class PolysetDef {
+  public:
+    PT(EggBin) _egg_bin;
+    const EggRenderState *_render_state;
+    EggVertexPools _vertex_pools;
+    LMatrix4d _transform;
+    bool _is_dynamic;
+    CharacterMaker *_character_maker;
+    PT(PandaNode) _parent;
+    PT(GeomNode) _geom_node;
+
+    pvector<PT(Geom) > _geoms;
+    pvector<CPT(RenderState) > _geom_states;
+  };
+  typedef pvector<PolysetDef *> PolysetDefs;
+
+  class LoadWork;
+  void run_load_work(LoadWork *work, int num_items);
+
+  void make_polyset_node(PolysetDef &def);
+  void build_polyset(PolysetDef &def);
+  void attach_polyset(PolysetDef &def);
+  void finish_polysets();
+
   void show_normals(EggVertexPool *vertex_pool, GeomNode *geom_node);  
 
   void make_nurbs_curve(EggNurbsCurve *egg_curve, PandaNode *parent,
@@ -119,7 +150,10 @@ private:
                           const LMatrix4d &mat);
 
   void load_textures();
-  bool load_texture(TextureDef &def, EggTexture *egg_tex);
+  static PT(Texture) read_texture(const EggTexture *egg_tex);
+  static void get_wanted_channels(const EggTexture *egg_tex,
+                                  int &wanted_channels, bool &wanted_alpha);
+  bool load_texture(TextureDef &def, EggTexture *egg_tex, Texture *tex);
   void apply_texture_attributes(Texture *tex, const EggTexture *egg_tex);
   Texture::CompressionMode convert_compression_mode(EggTexture::CompressionMode compression_mode) const;
   Texture::WrapMode convert_wrap_mode(EggTexture::WrapMode wrap_mode) const;
@@ -240,6 +274,12 @@ private:
   };
   typedef pmap<VertexPoolTransform, PT(GeomVertexData) > VertexPoolData;
   VertexPoolData _vertex_pool_data;
+  LightMutex _vertex_pool_data_lock;
+
+  // These are only used while build_graph() is running with
+  // egg-load-threads in effect.
+  bool _defer_polysets;
+  PolysetDefs _pending_polysets;
 
   typedef pmap<LMatrix4f, CPT(TransformState) > TransformStates;
   TransformStates _transform_states;
@@ -15,6 +15,7 @@
 #include "load_egg_file.h"
 #include "eggLoader.h"
 #include "config_egg2pg.h"
+#include "config_egg.h"
 #include "sceneGraphReducer.h"
 #include "virtualFileSystem.h"
 #include "config_util.h"
@@ -59,6 +60,12 @@ load_from_loader(EggLoader &loader) {
         egg2pg_cat.debug() << "Unified.\n";
       }
     }
+
+    if (egg_optimize_vertex_cache) {
+      // Unifying may have joined the mesher's triangle lists, so sort
+      // them again, and put the vertices in the same order.
+      gr.optimize_vertex_cache(loader._root);
+    }
   }
 
   return loader._root;
@@ -0,0 +1,152 @@
+// Filename: test_egg_load.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "load_egg_file.h"
+#include "config_egg2pg.h"
+#include "texturePool.h"
+#include "geomNode.h"
+#include "geom.h"
+#include "geomPrimitive.h"
+#include "trueClock.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// This program measures how the load time of a set of egg files
+// scales with egg-load-threads.  It loads all of the named files with
+// no threads, and then again with 1, 2, 4 and so on up to the given
+// number of threads, and reports the total time for each.  Every load
+// must produce the same scene graph as the load without threads.  The
+// TexturePool is emptied before each load, so that the textures are
+// read each time.
+//
+// Usage: test_egg_load [-t max_threads] file.egg [file.egg ...]
+//
+// For instance, to time the models and the phase files:
+//
+//   test_egg_load -t 8 models/*.egg phase_*/models/*/*.egg
+
+typedef pvector<Filename> Filenames;
+typedef pvector<string> Descriptions;
+
+// Writes a description of the scene graph below node that doesn't
+// depend on the order in which its objects were created.
+static void
+describe(PandaNode *node, ostream &out) {
+  out << node->get_type() << " " << node->get_name()
+      << " " << *node->get_state() << "\n";
+  if (node->is_geom_node()) {
+    GeomNode *geom_node = DCAST(GeomNode, node);
+    for (int i = 0; i < geom_node->get_num_geoms(); ++i) {
+      const Geom *geom = geom_node->get_geom(i);
+      out << "  geom " << geom->get_vertex_data()->get_num_rows() << " "
+          << *geom->get_vertex_data()->get_format()
+          << " " << *geom_node->get_geom_state(i) << "\n";
+      for (int p = 0; p < geom->get_num_primitives(); ++p) {
+        const GeomPrimitive *prim = geom->get_primitive(p);
+        out << "    " << prim->get_type() << " "
+            << prim->get_num_vertices() << "\n";
+      }
+    }
+  }
+  int num_children = node->get_num_children();
+  out << num_children << " children\n";
+  for (int i = 0; i < num_children; ++i) {
+    describe(node->get_child(i), out);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: load_all
+//  Description: Loads each of the files with the indicated number of
+//               threads, and fills descriptions with a description
+//               of each scene graph, or the empty string if the file
+//               could not be loaded.  Returns the total time taken.
+////////////////////////////////////////////////////////////////////
+static double
+load_all(const Filenames &filenames, int num_threads,
+         Descriptions &descriptions) {
+  egg_load_threads.set_value(num_threads);
+  descriptions.clear();
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double total = 0.0;
+  Filenames::const_iterator fi;
+  for (fi = filenames.begin(); fi != filenames.end(); ++fi) {
+    TexturePool::release_all_textures();
+    double start = clock->get_short_time();
+    PT(PandaNode) root = load_egg_file(*fi);
+    total += clock->get_short_time() - start;
+
+    ostringstream strm;
+    if (root != (PandaNode *)NULL) {
+      describe(root, strm);
+    }
+    descriptions.push_back(strm.str());
+  }
+  return total;
+}
+
+int
+main(int argc, char *argv[]) {
+  int max_threads = 4;
+  int first_arg = 1;
+  if (argc > 2 && strcmp(argv[1], "-t") == 0) {
+    max_threads = atoi(argv[2]);
+    first_arg = 3;
+  }
+  if (first_arg >= argc) {
+    nout << "Usage: test_egg_load [-t max_threads] file.egg [file.egg ...]\n";
+    return 1;
+  }
+
+  Filenames filenames;
+  for (int i = first_arg; i < argc; ++i) {
+    filenames.push_back(Filename::from_os_specific(argv[i]));
+  }
+
+  bool all_ok = true;
+  Descriptions serial;
+  double serial_time = load_all(filenames, 0, serial);
+  nout << filenames.size() << " files: " << serial_time * 1000.0
+       << " ms with no threads\n";
+  size_t f;
+  for (f = 0; f < filenames.size(); ++f) {
+    if (serial[f].empty()) {
+      nout << "  *** could not load " << filenames[f] << "\n";
+      all_ok = false;
+    }
+  }
+
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    Descriptions threaded;
+    double threaded_time = load_all(filenames, num_threads, threaded);
+    nout << "  " << threaded_time * 1000.0 << " ms with " << num_threads
+         << " threads";
+    if (threaded_time > 0.0) {
+      nout << ", " << serial_time / threaded_time << " times as fast";
+    }
+    nout << "\n";
+
+    for (f = 0; f < filenames.size(); ++f) {
+      if (threaded[f] != serial[f]) {
+        nout << "  *** load of " << filenames[f] << " with " << num_threads
+             << " threads differs\n";
+        all_ok = false;
+      }
+    }
+  }
+
+  return all_ok ? 0 : 1;
+}
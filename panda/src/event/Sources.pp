@@ -76,3 +76,14 @@
     test_task.cxx
 
 #end test_bin_target
+
+#begin test_bin_target
+  #define TARGET test_event_queue
+  #define OTHER_LIBS \
+   interrogatedb:c dconfig:c dtoolbase:c prc:c \
+   dtoolutil:c dtool:m dtoolconfig:m pystub
+
+  #define SOURCES \
+    test_event_queue.cxx
+
+#end test_bin_target
@@ -14,9 +14,16 @@
 
 #include "event.h"
 #include "config_event.h"
+#include "lightMutexHolder.h"
 
 TypeHandle Event::_type_handle;
 
+LightMutex Event::_names_lock;
+Event::NameIndex *Event::_name_index_table = NULL;
+Event::Names *Event::_names = NULL;
+Event::FreeIndices *Event::_free_indices = NULL;
+TVOLATILE AtomicAdjust::Integer Event::_names_seq = 0;
+
 ////////////////////////////////////////////////////////////////////
 //     Function: Event::Constructor
 //       Access: Public
@@ -27,6 +34,7 @@ Event(const string &event_name, EventReceiver *receiver) :
   _name(event_name)
 {
   _receiver = receiver;
+  update_name_index();
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -38,7 +46,9 @@ Event::
 Event(const Event &copy) :
   _parameters(copy._parameters),
   _receiver(copy._receiver),
-  _name(copy._name)
+  _name(copy._name),
+  _name_index(copy._name_index),
+  _name_index_seq(copy._name_index_seq)
 {
 }
 
@@ -52,6 +62,8 @@ operator = (const Event &copy) {
   _parameters = copy._parameters;
   _receiver = copy._receiver;
   _name = copy._name;
+  _name_index = copy._name_index;
+  _name_index_seq = copy._name_index_seq;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -63,6 +75,113 @@ Event::
 ~Event() {
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: Event::find_name
+//       Access: Published, Static
+//  Description: Returns the index assigned to the indicated event
+//               name, or 0 if it has not been assigned one.  This is
+//               the same value returned by get_name_index() for any
+//               Event with this name.
+////////////////////////////////////////////////////////////////////
+int Event::
+find_name(const string &name) {
+  if (name.empty()) {
+    return 0;
+  }
+
+  LightMutexHolder holder(_names_lock);
+  return do_find_name(name);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Event::get_interned_name
+//       Access: Published, Static
+//  Description: Returns the event name that is assigned the
+//               indicated index, or the empty string if the index is
+//               not assigned.
+////////////////////////////////////////////////////////////////////
+string Event::
+get_interned_name(int index) {
+  LightMutexHolder holder(_names_lock);
+  if (_names == (Names *)NULL || index < 0 || index >= (int)_names->size()) {
+    return string();
+  }
+  return (*_names)[index]._name;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Event::intern_name
+//       Access: Public, Static
+//  Description: Returns the index assigned to the indicated event
+//               name, assigning one if it does not already have one,
+//               and adds a reference to it.  The name keeps its index
+//               until each call to intern_name() has been matched by
+//               a call to release_name().
+//
+//               This is intended to be called by an EventHandler when
+//               it adds the first hook on a name.
+////////////////////////////////////////////////////////////////////
+int Event::
+intern_name(const string &name) {
+  nassertr(!name.empty(), 0);
+
+  LightMutexHolder holder(_names_lock);
+  if (_names == (Names *)NULL) {
+    _name_index_table = new NameIndex;
+    _names = new Names;
+    _free_indices = new FreeIndices;
+    _names->push_back(NameEntry());
+    _names->back()._ref_count = 0;
+  }
+
+  NameIndex::iterator ni = _name_index_table->find(name);
+  if (ni != _name_index_table->end()) {
+    ++(*_names)[(*ni).second]._ref_count;
+    return (*ni).second;
+  }
+
+  // Reuse the index of a name that has been released, if there is
+  // one, so that the EventHandler's tables stay as short as the
+  // number of names hooked at once.
+  int index;
+  if (!_free_indices->empty()) {
+    index = _free_indices->back();
+    _free_indices->pop_back();
+  } else {
+    index = _names->size();
+    _names->push_back(NameEntry());
+  }
+
+  NameEntry &entry = (*_names)[index];
+  entry._name = name;
+  entry._ref_count = 1;
+  _name_index_table->insert(NameIndex::value_type(name, index));
+  AtomicAdjust::inc(_names_seq);
+  return index;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Event::release_name
+//       Access: Public, Static
+//  Description: Removes a reference added by intern_name().  When the
+//               last reference is removed, the name gives up its
+//               index, which may later be assigned to another name.
+////////////////////////////////////////////////////////////////////
+void Event::
+release_name(int index) {
+  LightMutexHolder holder(_names_lock);
+  nassertv(_names != (Names *)NULL && index > 0 && index < (int)_names->size());
+
+  NameEntry &entry = (*_names)[index];
+  nassertv(entry._ref_count > 0);
+  if (--entry._ref_count == 0) {
+    _name_index_table->erase(entry._name);
+    entry._name = string();
+    _free_indices->push_back(index);
+    AtomicAdjust::inc(_names_seq);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: Event::add_parameter
 //       Access: Public
@@ -154,3 +273,42 @@ output(ostream &out) const {
   }
   out << ")";
 }
+
+////////////////////////////////////////////////////////////////////
+//     Function: Event::update_name_index
+//       Access: Private
+//  Description: Looks up the index of the Event's name.  This is
+//               called whenever the name is set, so that
+//               get_name_index() need not lock.
+////////////////////////////////////////////////////////////////////
+void Event::
+update_name_index() {
+  if (_name.empty()) {
+    _name_index = 0;
+    _name_index_seq = AtomicAdjust::get(_names_seq);
+    return;
+  }
+
+  LightMutexHolder holder(_names_lock);
+  _name_index_seq = AtomicAdjust::get(_names_seq);
+  _name_index = do_find_name(_name);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Event::do_find_name
+//       Access: Private, Static
+//  Description: The implementation of find_name().  Assumes the lock
+//               is held.
+////////////////////////////////////////////////////////////////////
+int Event::
+do_find_name(const string &name) {
+  if (_name_index_table == (NameIndex *)NULL) {
+    return 0;
+  }
+
+  NameIndex::const_iterator ni = _name_index_table->find(name);
+  if (ni == _name_index_table->end()) {
+    return 0;
+  }
+  return (*ni).second;
+}
@@ -19,6 +19,11 @@
 #include "pandabase.h"
 #include "eventParameter.h"
 #include "typedReferenceCount.h"
+#include "lightMutex.h"
+#include "atomicAdjust.h"
+#include "pvector.h"
+#include "pmap.h"
+#include "stl_compares.h"
 
 class EventReceiver;
 
@@ -32,6 +37,16 @@ class EventReceiver;
 //               This function use to inherit from Namable, but that
 //               makes it too expensive to get its name the Python
 //               code.  Now it just copies the Namable interface in.
+//
+//               Each event name that has a hook on it is also
+//               assigned a small integer index, shared by all events
+//               of that name, so that an EventHandler can look up its
+//               hooks without comparing strings.  Names without hooks
+//               are not assigned an index, so the many events thrown
+//               with unique names don't fill up the table.  The index
+//               is looked up when the Event's name is set, so that
+//               reading it while the event is dispatched takes no
+//               lock.
 ////////////////////////////////////////////////////////////////////
 class EXPCL_PANDA_EVENT Event : public TypedReferenceCount {
 PUBLISHED:
@@ -44,6 +59,10 @@ PUBLISHED:
   INLINE void clear_name();
   INLINE bool has_name() const;
   INLINE const string &get_name() const;
+  INLINE int get_name_index() const;
+
+  static int find_name(const string &name);
+  static string get_interned_name(int index);
 
   void add_parameter(const EventParameter &obj);
 
@@ -58,14 +77,44 @@ PUBLISHED:
 
   void output(ostream &out) const;
 
+public:
+  static int intern_name(const string &name);
+  static void release_name(int index);
+
 protected:
   typedef pvector<EventParameter> ParameterList;
   ParameterList _parameters;
   EventReceiver *_receiver;
 
 private:
+  void update_name_index();
+  static int do_find_name(const string &name);
+
   string _name;
 
+  // The index of _name, as of _names_seq having the value
+  // _name_index_seq.
+  int _name_index;
+  AtomicAdjust::Integer _name_index_seq;
+
+  class NameEntry {
+  public:
+    string _name;
+    int _ref_count;
+  };
+  typedef phash_map<string, int, string_hash> NameIndex;
+  typedef pvector<NameEntry> Names;
+  typedef pvector<int> FreeIndices;
+  static LightMutex _names_lock;
+  static NameIndex *_name_index_table;
+  static Names *_names;
+  static FreeIndices *_free_indices;
+
+  // This is incremented each time a name is assigned or gives up its
+  // index, so that each Event can tell whether its own index is
+  // still current.
+  static TVOLATILE AtomicAdjust::Integer _names_seq;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
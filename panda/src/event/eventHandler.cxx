@@ -30,6 +30,16 @@ EventHandler::
 EventHandler(EventQueue *ev_queue) : _queue(*ev_queue) {
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: EventHandler::Destructor
+//       Access: Published, Virtual
+//  Description:
+////////////////////////////////////////////////////////////////////
+EventHandler::
+~EventHandler() {
+  remove_all_hooks();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: EventHandler::process_events
 //       Access: Public
@@ -40,8 +50,18 @@ EventHandler(EventQueue *ev_queue) : _queue(*ev_queue) {
 ////////////////////////////////////////////////////////////////////
 void EventHandler::
 process_events() {
-  while (!_queue.is_queue_empty()) {
-    dispatch_event(_queue.dequeue_event());
+  // We take all of the pending events from the queue at once; but we
+  // keep going until the queue is empty, since the hooks may throw
+  // more events.
+  EventQueue::Events events;
+  _queue.dequeue_events(events);
+  while (!events.empty()) {
+    EventQueue::Events::const_iterator ei;
+    for (ei = events.begin(); ei != events.end(); ++ei) {
+      dispatch_event(*ei);
+    }
+    events.clear();
+    _queue.dequeue_events(events);
   }
 }
 
@@ -55,15 +75,21 @@ void EventHandler::
 dispatch_event(const Event *event) {
   nassertv(event != (Event *)NULL);
 
-  // Is the event name defined in the hook table?  It will be if
-  // anyone has ever assigned a hook to this particular event name.
-  Hooks::const_iterator hi;
-  hi = _hooks.find(event->get_name());
+  int index = event->get_name_index();
+  if (index < 0) {
+    // Some names have been assigned or given up their indices since
+    // the event's name was set, so we look it up among our own.
+    index = find_hooked_name(event->get_name());
+  }
 
-  if (hi != _hooks.end()) {
-    // Yes, it is!  Now walk through all the functions assigned to
-    // that event name.
-    Functions copy_functions = (*hi).second;
+  // Are there any hooks on this event name?  The hook table is only
+  // as long as the largest index of any name that has ever had a hook
+  // assigned.
+  if (index < (int)_hooks.size() && !_hooks[index].empty()) {
+    // Yes, there are!  Now walk through all the functions assigned to
+    // that event name.  We copy the list first, since a hook might
+    // remove itself.
+    Functions copy_functions = _hooks[index];
 
     Functions::const_iterator fi;
     for (fi = copy_functions.begin(); fi != copy_functions.end(); ++fi) {
@@ -78,12 +104,9 @@ dispatch_event(const Event *event) {
   }
 
   // now for callback hooks
-  CallbackHooks::const_iterator chi;
-  chi = _cbhooks.find(event->get_name());
-
-  if (chi != _cbhooks.end()) {
+  if (index < (int)_cbhooks.size() && !_cbhooks[index].empty()) {
     // found one
-    CallbackFunctions copy_functions = (*chi).second;
+    CallbackFunctions copy_functions = _cbhooks[index];
 
     CallbackFunctions::const_iterator cfi;
     for (cfi = copy_functions.begin(); cfi != copy_functions.end(); ++cfi) {
@@ -100,35 +123,31 @@ dispatch_event(const Event *event) {
 ////////////////////////////////////////////////////////////////////
 void EventHandler::
 write(ostream &out) const {
-  Hooks::const_iterator hi;
-  hi = _hooks.begin();
-
-  CallbackHooks::const_iterator chi;
-  chi = _cbhooks.begin();
-
-  while (hi != _hooks.end() && chi != _cbhooks.end()) {
-    if ((*hi).first < (*chi).first) {
-      write_hook(out, *hi);
-      ++hi;
-    } else if ((*chi).first < (*hi).first) {
-      write_cbhook(out, *chi);
-      ++chi;
-    } else {
-      write_hook(out, *hi);
-      write_cbhook(out, *chi);
-      ++hi;
-      ++chi;
+  // List the hooks in order by event name.
+  typedef pmap<string, int> NamesByIndex;
+  NamesByIndex names;
+
+  int index;
+  for (index = 0; index < (int)_hooks.size(); ++index) {
+    if (!_hooks[index].empty()) {
+      names[Event::get_interned_name(index)] = index;
     }
   }
-
-  while (hi != _hooks.end()) {
-    write_hook(out, *hi);
-    ++hi;
+  for (index = 0; index < (int)_cbhooks.size(); ++index) {
+    if (!_cbhooks[index].empty()) {
+      names[Event::get_interned_name(index)] = index;
+    }
   }
 
-  while (chi != _cbhooks.end()) {
-    write_cbhook(out, *chi);
-    ++chi;
+  NamesByIndex::const_iterator ni;
+  for (ni = names.begin(); ni != names.end(); ++ni) {
+    index = (*ni).second;
+    if (index < (int)_hooks.size()) {
+      write_hook(out, (*ni).first, _hooks[index]);
+    }
+    if (index < (int)_cbhooks.size()) {
+      write_cbhook(out, (*ni).first, _cbhooks[index]);
+    }
   }
 }
 
@@ -152,7 +171,11 @@ add_hook(const string &event_name, EventFunction *function) {
   }
   assert(!event_name.empty());
   assert(function);
-  return _hooks[event_name].insert(function).second;
+  int index = hook_name(event_name);
+  if (index >= (int)_hooks.size()) {
+    _hooks.resize(index + 1);
+  }
+  return _hooks[index].insert(function).second;
 }
 
 
@@ -171,7 +194,11 @@ add_hook(const string &event_name, EventCallbackFunction *function,
          void *data) {
   assert(!event_name.empty());
   assert(function);
-  return _cbhooks[event_name].insert(CallbackFunction(function, data)).second;
+  int index = hook_name(event_name);
+  if (index >= (int)_cbhooks.size()) {
+    _cbhooks.resize(index + 1);
+  }
+  return _cbhooks[index].insert(CallbackFunction(function, data)).second;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -183,23 +210,7 @@ add_hook(const string &event_name, EventCallbackFunction *function,
 bool EventHandler::
 has_hook(const string &event_name) const {
   assert(!event_name.empty());
-  Hooks::const_iterator hi;
-  hi = _hooks.find(event_name);
-  if (hi != _hooks.end()) {
-    if (!(*hi).second.empty()) {
-      return true;
-    }
-  }
-
-  CallbackHooks::const_iterator chi;
-  chi = _cbhooks.find(event_name);
-  if (chi != _cbhooks.end()) {
-    if (!(*chi).second.empty()) {
-      return true;
-    }
-  }
-
-  return false;
+  return has_hooks_at(find_hooked_name(event_name));
 }
 
 
@@ -214,7 +225,14 @@ bool EventHandler::
 remove_hook(const string &event_name, EventFunction *function) {
   assert(!event_name.empty());
   assert(function);
-  return _hooks[event_name].erase(function) != 0;
+  int index = find_hooked_name(event_name);
+  if (index >= (int)_hooks.size() || _hooks[index].erase(function) == 0) {
+    return false;
+  }
+  if (!has_hooks_at(index)) {
+    unhook_name(index);
+  }
+  return true;
 }
 
 
@@ -231,7 +249,15 @@ remove_hook(const string &event_name, EventCallbackFunction *function,
             void *data) {
   assert(!event_name.empty());
   assert(function);
-  return _cbhooks[event_name].erase(CallbackFunction(function, data)) != 0;
+  int index = find_hooked_name(event_name);
+  if (index >= (int)_cbhooks.size() ||
+      _cbhooks[index].erase(CallbackFunction(function, data)) == 0) {
+    return false;
+  }
+  if (!has_hooks_at(index)) {
+    unhook_name(index);
+  }
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -244,25 +270,19 @@ remove_hook(const string &event_name, EventCallbackFunction *function,
 bool EventHandler::
 remove_hooks(const string &event_name) {
   assert(!event_name.empty());
-  bool any_removed = false;
-
-  Hooks::iterator hi = _hooks.find(event_name);
-  if (hi != _hooks.end()) {
-    if (!(*hi).second.empty()) {
-      any_removed = true;
-    }
-    _hooks.erase(hi);
+  int index = find_hooked_name(event_name);
+  if (!has_hooks_at(index)) {
+    return false;
   }
 
-  CallbackHooks::iterator chi = _cbhooks.find(event_name);
-  if (chi != _cbhooks.end()) {
-    if (!(*chi).second.empty()) {
-      any_removed = true;
-    }
-    _cbhooks.erase(chi);
+  if (index < (int)_hooks.size()) {
+    _hooks[index].clear();
   }
-
-  return any_removed;
+  if (index < (int)_cbhooks.size()) {
+    _cbhooks[index].clear();
+  }
+  unhook_name(index);
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -275,9 +295,11 @@ bool EventHandler::
 remove_hooks_with(void *data) {
   bool any_removed = false;
 
-  CallbackHooks::iterator chi;
-  for (chi = _cbhooks.begin(); chi != _cbhooks.end(); ++chi) {
-    CallbackFunctions &funcs = (*chi).second;
+  for (int index = 0; index < (int)_cbhooks.size(); ++index) {
+    CallbackFunctions &funcs = _cbhooks[index];
+    if (funcs.empty()) {
+      continue;
+    }
     CallbackFunctions::iterator cfi;
 
     CallbackFunctions new_funcs;
@@ -289,6 +311,10 @@ remove_hooks_with(void *data) {
       }
     }
     funcs.swap(new_funcs);
+
+    if (!has_hooks_at(index)) {
+      unhook_name(index);
+    }
   }
 
   return any_removed;
@@ -302,10 +328,62 @@ remove_hooks_with(void *data) {
 ////////////////////////////////////////////////////////////////////
 void EventHandler::
 remove_all_hooks() {
+  HookedNames::const_iterator ni;
+  for (ni = _hooked_names.begin(); ni != _hooked_names.end(); ++ni) {
+    Event::release_name((*ni).second);
+  }
+  _hooked_names.clear();
   _hooks.clear();
   _cbhooks.clear();
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: EventHandler::find_hooked_name
+//       Access: Private
+//  Description: Returns the index of the indicated event name, if
+//               this handler has any hooks on it, or 0 otherwise.
+////////////////////////////////////////////////////////////////////
+int EventHandler::
+find_hooked_name(const string &event_name) const {
+  HookedNames::const_iterator ni = _hooked_names.find(event_name);
+  if (ni == _hooked_names.end()) {
+    return 0;
+  }
+  return (*ni).second;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EventHandler::hook_name
+//       Access: Private
+//  Description: Returns the index of the indicated event name, which
+//               is about to be given a hook.  If this is the first
+//               hook on the name, the name is interned and recorded.
+////////////////////////////////////////////////////////////////////
+int EventHandler::
+hook_name(const string &event_name) {
+  HookedNames::const_iterator ni = _hooked_names.find(event_name);
+  if (ni != _hooked_names.end()) {
+    return (*ni).second;
+  }
+
+  int index = Event::intern_name(event_name);
+  _hooked_names.insert(HookedNames::value_type(event_name, index));
+  return index;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: EventHandler::unhook_name
+//       Access: Private
+//  Description: Called when the last hook on the name with the
+//               indicated index has been removed, to give up the
+//               handler's reference on the name.
+////////////////////////////////////////////////////////////////////
+void EventHandler::
+unhook_name(int index) {
+  _hooked_names.erase(Event::get_interned_name(index));
+  Event::release_name(index);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: EventHandler::make_global_event_handler
 //       Access: Protected, Static
@@ -323,9 +401,10 @@ make_global_event_handler() {
 //  Description:
 ////////////////////////////////////////////////////////////////////
 void EventHandler::
-write_hook(ostream &out, const EventHandler::Hooks::value_type &hook) const {
-  if (!hook.second.empty()) {
-    out << hook.first << " has " << hook.second.size() << " functions.\n";
+write_hook(ostream &out, const string &event_name,
+           const EventHandler::Functions &functions) const {
+  if (!functions.empty()) {
+    out << event_name << " has " << functions.size() << " functions.\n";
   }
 }
 
@@ -335,8 +414,9 @@ write_hook(ostream &out, const EventHandler::Hooks::value_type &hook) const {
 //  Description:
 ////////////////////////////////////////////////////////////////////
 void EventHandler::
-write_cbhook(ostream &out, const EventHandler::CallbackHooks::value_type &hook) const {
-  if (!hook.second.empty()) {
-    out << hook.first << " has " << hook.second.size() << " callback functions.\n";
+write_cbhook(ostream &out, const string &event_name,
+             const EventHandler::CallbackFunctions &functions) const {
+  if (!functions.empty()) {
+    out << event_name << " has " << functions.size() << " callback functions.\n";
   }
 }
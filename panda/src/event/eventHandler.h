@@ -22,6 +22,7 @@
 
 #include "pset.h"
 #include "pmap.h"
+#include "pvector.h"
 
 class EventQueue;
 
@@ -46,6 +47,7 @@ public:
 
 PUBLISHED:
   EventHandler(EventQueue *ev_queue);
+  virtual ~EventHandler();
 
   void process_events();
 
@@ -71,22 +73,37 @@ public:
 
 protected:
 
+  // The hooks are indexed by Event::get_name_index(), so that
+  // dispatch_event() needn't look up the event name.  The handler
+  // holds one reference, from Event::intern_name(), on each name
+  // that has any hooks, and keeps its own map of those names to their
+  // indices, for events whose index has gone out of date and for the
+  // methods that take a name.
   typedef pset<EventFunction *> Functions;
-  typedef pmap<string, Functions> Hooks;
+  typedef pvector<Functions> Hooks;
   typedef pair<EventCallbackFunction*, void*> CallbackFunction;
   typedef pset<CallbackFunction> CallbackFunctions;
-  typedef pmap<string, CallbackFunctions> CallbackHooks;
+  typedef pvector<CallbackFunctions> CallbackHooks;
 
   Hooks _hooks;
   CallbackHooks _cbhooks;
+  typedef phash_map<string, int, string_hash> HookedNames;
+  HookedNames _hooked_names;
   EventQueue &_queue;
 
   static EventHandler *_global_event_handler;
   static void make_global_event_handler();
 
 private:
-  void write_hook(ostream &out, const Hooks::value_type &hook) const;
-  void write_cbhook(ostream &out, const CallbackHooks::value_type &hook) const;
+  INLINE bool has_hooks_at(int index) const;
+  int find_hooked_name(const string &event_name) const;
+  int hook_name(const string &event_name);
+  void unhook_name(int index);
+
+  void write_hook(ostream &out, const string &event_name,
+                  const Functions &functions) const;
+  void write_cbhook(ostream &out, const string &event_name,
+                    const CallbackFunctions &functions) const;
 
 
 public:
@@ -118,6 +118,27 @@ dequeue_event() {
   return result;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: EventQueue::dequeue_events
+//       Access: Public
+//  Description: Removes all of the pending events from the queue and
+//               appends them to the indicated list, in the order they
+//               were queued.  This takes the lock only once, rather
+//               than twice for each event as is_queue_empty() and
+//               dequeue_event() do.
+////////////////////////////////////////////////////////////////////
+void EventQueue::
+dequeue_events(Events &events) {
+  LightMutexHolder holder(_lock);
+
+  if (events.empty()) {
+    events.swap(_queue);
+  } else {
+    events.insert(events.end(), _queue.begin(), _queue.end());
+    _queue.clear();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: EventQueue::make_global_event_queue
 //       Access: Protected, Static
@@ -43,11 +43,14 @@ PUBLISHED:
 
   INLINE static EventQueue *get_global_event_queue();
 
+public:
+  typedef pdeque<CPT_Event> Events;
+  void dequeue_events(Events &events);
+
 private:
   static void make_global_event_queue();
   static EventQueue *_global_event_queue;
 
-  typedef pdeque<CPT_Event> Events;
   Events _queue;
 
   LightMutex _lock;
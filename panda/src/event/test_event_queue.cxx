@@ -0,0 +1,127 @@
+// Filename: test_event_queue.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pandabase.h"
+#include "throw_event.h"
+#include "eventHandler.h"
+#include "eventQueue.h"
+#include "trueClock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// This program measures the rate at which events pass through the
+// global EventQueue and EventHandler, much as collision and GUI
+// events do in a running application: each "frame" throws a batch of
+// events with a variety of names, only some of which have hooks, and
+// then processes them.  It checks that each hook is called the
+// expected number of times, and that only the hooked names are given
+// an index, and only while they have hooks.  It also checks that an
+// event thrown before its name is hooked still reaches the hook.
+//
+// Usage: test_event_queue [events_per_frame [num_frames]]
+
+static const int num_names = 200;
+static const int hooked_names = 20;
+
+static int hook_count = 0;
+
+static void
+event_hook(const Event *) {
+  ++hook_count;
+}
+
+int
+main(int argc, char *argv[]) {
+  int events_per_frame = 500;
+  int num_frames = 1000;
+  if (argc > 1) {
+    events_per_frame = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_frames = atoi(argv[2]);
+  }
+
+  pvector<string> names;
+  int i;
+  for (i = 0; i < num_names; ++i) {
+    char buffer[64];
+    sprintf(buffer, "into-collision-%d", i);
+    names.push_back(buffer);
+  }
+
+  EventQueue *queue = EventQueue::get_global_event_queue();
+  EventHandler *handler = EventHandler::get_global_event_handler();
+  for (i = 0; i < hooked_names; ++i) {
+    handler->add_hook(names[i * (num_names / hooked_names)], event_hook);
+  }
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double throw_time = 0.0;
+  double process_time = 0.0;
+  int expected_count = 0;
+
+  for (int f = 0; f < num_frames; ++f) {
+    double start = clock->get_short_time();
+    for (i = 0; i < events_per_frame; ++i) {
+      int n = (f * 7 + i * 13) % num_names;
+      throw_event(names[n], EventParameter(i));
+      if (n % (num_names / hooked_names) == 0) {
+        ++expected_count;
+      }
+    }
+    double thrown = clock->get_short_time();
+    handler->process_events();
+    double processed = clock->get_short_time();
+
+    throw_time += thrown - start;
+    process_time += processed - thrown;
+  }
+
+  nassertr(queue->is_queue_empty(), 1);
+
+  double total_events = (double)events_per_frame * num_frames;
+  cerr << total_events << " events in " << num_frames << " frames: "
+       << total_events / throw_time << " thrown/sec, "
+       << total_events / process_time << " processed/sec, "
+       << total_events / (throw_time + process_time) << " events/sec\n";
+
+  if (hook_count != expected_count) {
+    cerr << "*** hooks called " << hook_count << " times, expected "
+         << expected_count << "\n";
+    return 1;
+  }
+
+  if (Event::find_name(names[0]) == 0 || Event::find_name(names[1]) != 0) {
+    cerr << "*** wrong event names have an index\n";
+    return 1;
+  }
+  // This event's name has no index when it is thrown; by the time it
+  // is dispatched, it has one.
+  hook_count = 0;
+  throw_event(names[1]);
+  handler->add_hook(names[1], event_hook);
+  handler->process_events();
+  if (hook_count != 1) {
+    cerr << "*** event thrown before its hook was added was not dispatched\n";
+    return 1;
+  }
+
+  handler->remove_all_hooks();
+  if (Event::find_name(names[0]) != 0) {
+    cerr << "*** event name still has an index after its hooks are removed\n";
+    return 1;
+  }
+  return 0;
+}
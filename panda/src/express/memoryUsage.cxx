@@ -354,6 +354,19 @@ win32_malloc_hook(int alloc_type, void *ptr,
 
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: MemoryUsage::show_profile
+//       Access: Public, Static
+//  Description: Shows the call sites holding the most memory, and
+//               the types allocated most quickly since the last
+//               report, according to the sampling allocation
+//               profiler.
+////////////////////////////////////////////////////////////////////
+void MemoryUsage::
+show_profile() {
+  write_profile(nout);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: MemoryUsage::Constructor
 //       Access: Private
@@ -402,6 +415,22 @@ MemoryUsage(const MemoryHook &copy) : MemoryHook(copy) {
     _max_heap_size = (size_t)max_heap_size;
   }
 
+  bool profile_memory_usage = ConfigVariableBool
+    ("profile-memory-usage", false,
+     PRC_DESC("Set this true to start the sampling allocation profiler at "
+              "startup.  It records the call stack of about one allocation "
+              "in every memory-profile-interval bytes; use "
+              "MemoryUsage.show_profile() to see where the memory is "
+              "going.  This is much cheaper than track-memory-usage."));
+  PN_int64 memory_profile_interval = ConfigVariableInt64
+    ("memory-profile-interval", 524288,
+     PRC_DESC("The average number of bytes allocated between samples "
+              "taken by the allocation profiler.  Smaller numbers give "
+              "more accurate reports at a higher cost."));
+  if (profile_memory_usage) {
+    MemoryProfiler::start((size_t)max(memory_profile_interval, (PN_int64)1));
+  }
+
 #ifdef USE_MEMORY_NOWRAPPERS
 #error Cannot compile MemoryUsage without malloc wrappers!
 #endif
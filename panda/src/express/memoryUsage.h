@@ -24,6 +24,7 @@
 #include "memoryUsagePointerCounts.h"
 #include "pmap.h"
 #include "memoryHook.h"
+#include "memoryProfiler.h"
 
 class ReferenceCount;
 class MemoryUsagePointers;
@@ -86,6 +87,12 @@ PUBLISHED:
   INLINE static void show_current_ages();
   INLINE static void show_trend_ages();
 
+  INLINE static bool is_profiling();
+  INLINE static void start_profile(size_t sample_interval);
+  INLINE static void stop_profile();
+  static void show_profile();
+  INLINE static void write_profile(ostream &out);
+
 protected:
   virtual void overflow_heap_size();
 
@@ -13,6 +13,9 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "config_util.h"
+#include "config_display.h"
+#include "boundingSphere.h"
+#include "finiteBoundingVolume.h"
 #include "displayRegion.h"
 #include "renderBuffer.h"
 #include "geom.h"
@@ -295,6 +298,8 @@ CLP(GraphicsStateGuardian)(GraphicsEngine *engine, GraphicsPipe *pipe) :
   // calling glGetError() forces a sync, this turns it off if you want to.
   _track_errors = !CLP(force_no_error);
   _allow_flush = !CLP(force_no_flush);
+  _progressive_upload_bytes = 0;
+  _distance_frame = 0;
 
 #ifdef DO_PSTATS
   if (CLP(finish)) {
@@ -1954,6 +1959,10 @@ begin_frame(Thread *current_thread) {
   }
   report_my_gl_errors();
 
+  _progressive_upload_bytes = 0;
+  _distance_textures.clear();
+  ++_distance_frame;
+
 #ifdef DO_PSTATS
   _vertices_display_list_pcollector.clear_level();
   _vertices_immediate_pcollector.clear_level();
@@ -2157,6 +2166,10 @@ begin_draw_primitives(const GeomPipelineReader *geom_reader,
 
   _geom_display_list = 0;
 
+  if (!_distance_textures.empty()) {
+    note_texture_distances(geom_reader);
+  }
+
   if (_auto_antialias_mode) {
     switch (geom_reader->get_primitive_type()) {
     case GeomPrimitive::PT_polygons:
@@ -3276,6 +3289,16 @@ update_texture(TextureContext *tc, bool force) {
       // now.
       gtc->mark_loaded();
     }
+
+  } else if (gtc->_progressive_bias < 0 && gtc->_already_applied &&
+             progressive_textures && _effective_incomplete_render &&
+             choose_drop_levels(gtc) != 0) {
+    // The full texture is loaded, but it is now far enough away to
+    // drop some of its levels.  upload_texture() decides how many.
+    Texture *tex = gtc->get_texture();
+    if (tex->uses_mipmaps() && tex->has_all_ram_mipmap_images()) {
+      upload_texture(gtc, false);
+    }
   }
   gtc->enqueue_lru(&_prepared_objects->_graphics_memory_lru);
 
@@ -3299,6 +3322,12 @@ release_texture(TextureContext *tc) {
   GLP(DeleteTextures)(1, &gtc->_index);
   report_my_gl_errors();
 
+  pvector<CLP(TextureContext) *>::iterator ti =
+    find(_distance_textures.begin(), _distance_textures.end(), gtc);
+  if (ti != _distance_textures.end()) {
+    _distance_textures.erase(ti);
+  }
+
   gtc->_index = 0;
   delete gtc;
 }
@@ -7245,6 +7274,8 @@ void CLP(GraphicsStateGuardian)::
 do_issue_texture() {
   DO_PSTATS_STUFF(_texture_state_pcollector.add_level(1));
 
+  _distance_textures.clear();
+
 #ifdef OPENGLES_1
   update_standard_texture_bindings();
 #else
@@ -7368,6 +7399,10 @@ update_standard_texture_bindings() {
 #endif
       break;
     }
+
+    if (texture_drop_distance > 0.0) {
+      _distance_textures.push_back(DCAST(CLP(TextureContext), tc));
+    }
     
     if (stage->involves_color_scale() && _color_scale_enabled) {
       Colorf color = stage->get_color();
@@ -8307,6 +8342,30 @@ upload_texture(CLP(TextureContext) *gtc, bool force) {
     }
   }
 
+  // With progressive-textures, a mipmapped texture is sent a few
+  // levels at a time, beginning with the tail of its mipmap chain.
+  // Until the last step, the texture is drawn from a smaller GL
+  // texture object, just as when mipmap_bias is used to fit it
+  // within max_dimension.
+  bool partial = false;
+  if (progressive_textures && _effective_incomplete_render && !force &&
+      !image.is_null() && tex->uses_mipmaps() &&
+      tex->has_all_ram_mipmap_images() &&
+      tex->get_num_ram_mipmap_images() > mipmap_bias + 1) {
+    size_t upload_size = 0;
+    int bias = choose_progressive_bias(gtc, mipmap_bias, upload_size);
+    if (bias < 0) {
+      // There is no more budget this frame; keep drawing with the
+      // levels that are already loaded, and come back next frame.
+      return true;
+    }
+    _progressive_upload_bytes += upload_size;
+    if (bias > mipmap_bias) {
+      partial = true;
+      mipmap_bias = bias;
+    }
+  }
+
   if (image_compression != Texture::CM_off) {
     Texture::QualityLevel quality_level = tex->get_effective_quality_level();
 
@@ -8396,17 +8455,30 @@ upload_texture(CLP(TextureContext) *gtc, bool force) {
   maybe_gl_finish();
 
   if (success) {
+    // Record the size of the GL texture object we actually created,
+    // which is smaller than the texture if mipmap_bias is nonzero.
     gtc->_already_applied = true;
     gtc->_uses_mipmaps = uses_mipmaps;
     gtc->_internal_format = internal_format;
-    gtc->_width = width;
-    gtc->_height = height;
-    gtc->_depth = depth;
+    gtc->_width = tex->get_expected_mipmap_x_size(mipmap_bias);
+    gtc->_height = tex->get_expected_mipmap_y_size(mipmap_bias);
+    gtc->_depth = tex->get_expected_mipmap_z_size(mipmap_bias);
 
     if (!image.is_null()) {
       gtc->update_data_size_bytes(get_texture_memory_size(tex));
     }
 
+    if (partial) {
+      // There are more levels to come.  Don't mark the texture
+      // loaded, so that update_texture() will return to it on a later
+      // frame, and don't let the texture drop its RAM image yet.
+      gtc->_progressive_bias = mipmap_bias;
+      gtc->_progressive_image = tex->get_image_modified();
+      report_my_gl_errors();
+      return true;
+    }
+    gtc->_progressive_bias = -1;
+
     if (tex->get_post_load_store_cache()) {
       tex->set_post_load_store_cache(false);
       // OK, get the RAM image, and save it in a BamCache record.
@@ -8436,6 +8508,195 @@ upload_texture(CLP(TextureContext) *gtc, bool force) {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: GLGraphicsStateGuardian::choose_progressive_bias
+//       Access: Protected
+//  Description: Called by upload_texture() when progressive-textures
+//               is in effect, to choose the mipmap level of the
+//               texture to load as level 0 of the GL texture object
+//               this time.  min_bias is the level at which the
+//               texture would be loaded in full.  upload_size is
+//               filled in with the number of bytes that will be
+//               sent.
+//
+//               The first time, this is the tail of the mipmap
+//               chain, the largest level no bigger than
+//               progressive-texture-tail-size, which is always sent.
+//               After that, it is at least one level larger than
+//               what is loaded now, and as many levels larger as
+//               texture-upload-budget allows, but no larger than
+//               texture-drop-distance allows; if the texture has
+//               moved away, it is reloaded at the smaller size at
+//               once.  Returns -1 if there is nothing to send this
+//               frame, either because the texture is already at the
+//               size it should be, or because the budget for this
+//               frame has already been spent.
+////////////////////////////////////////////////////////////////////
+int CLP(GraphicsStateGuardian)::
+choose_progressive_bias(CLP(TextureContext) *gtc, int min_bias,
+                        size_t &upload_size) {
+  Texture *tex = gtc->get_texture();
+  int num_levels = tex->get_num_ram_mipmap_images();
+
+  // upload_sizes[n - min_bias] is the size of levels n and above,
+  // all of which are sent when level n is loaded as level 0.
+  pvector<size_t> upload_sizes(num_levels - min_bias + 1, 0);
+  int n;
+  for (n = num_levels - 1; n >= min_bias; --n) {
+    upload_sizes[n - min_bias] = upload_sizes[n + 1 - min_bias] + tex->get_ram_mipmap_image_size(n);
+  }
+
+  int tail_size = progressive_texture_tail_size;
+  int tail = min_bias;
+  while (tail < num_levels - 1 &&
+         (tex->get_expected_mipmap_x_size(tail) > tail_size ||
+          tex->get_expected_mipmap_y_size(tail) > tail_size)) {
+    ++tail;
+  }
+
+  // This is the largest level we want loaded, according to the
+  // texture's distance from the camera.
+  int want_bias = min(min_bias + choose_drop_levels(gtc), tail);
+
+  int loaded;
+  bool image_changed;
+  if (!gtc->_already_applied) {
+    // Nothing is loaded yet.
+    loaded = num_levels;
+    image_changed = true;
+  } else if (gtc->_progressive_bias >= 0) {
+    loaded = gtc->_progressive_bias;
+    image_changed = (gtc->_progressive_image != tex->get_image_modified());
+  } else {
+    // The full texture is loaded.  Either its image has changed
+    // since, or it has moved far enough away to drop some levels.
+    // Either way, don't drop back to the tail; just send it at the
+    // size it should be.
+    if (want_bias == min_bias && !gtc->was_image_modified()) {
+      return -1;
+    }
+    upload_size = upload_sizes[want_bias - min_bias];
+    return want_bias;
+  }
+
+  if (loaded > tail) {
+    upload_size = upload_sizes[tail - min_bias];
+    return tail;
+  }
+
+  if (loaded <= want_bias) {
+    if (loaded == want_bias && !image_changed) {
+      return -1;
+    }
+    // The texture has moved away, or its image has changed; send it
+    // at the size it should be now.
+    upload_size = upload_sizes[want_bias - min_bias];
+    return want_bias;
+  }
+
+  size_t budget = (size_t)max((int)texture_upload_budget, 0);
+  int bias = max(loaded - 1, want_bias);
+  if (budget == 0) {
+    bias = want_bias;
+
+  } else {
+    if (_progressive_upload_bytes != 0 &&
+        _progressive_upload_bytes + upload_sizes[bias - min_bias] > budget) {
+      // Let the first texture each frame advance by one level, even
+      // if that is over budget, so that none is stuck forever.
+      return -1;
+    }
+    while (bias > want_bias &&
+           _progressive_upload_bytes + upload_sizes[bias - 1 - min_bias] <= budget) {
+      --bias;
+    }
+  }
+
+  upload_size = upload_sizes[bias - min_bias];
+  return bias;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: GLGraphicsStateGuardian::choose_drop_levels
+//       Access: Protected
+//  Description: Returns the number of levels at the top of the
+//               texture's mipmap chain that texture-drop-distance
+//               says need not be loaded, according to the nearest
+//               distance from the camera at which the texture was
+//               drawn in the last frame that has finished.
+////////////////////////////////////////////////////////////////////
+int CLP(GraphicsStateGuardian)::
+choose_drop_levels(CLP(TextureContext) *gtc) const {
+  double drop_distance = texture_drop_distance;
+  if (drop_distance <= 0.0 || gtc->_distance_frame < 0) {
+    return 0;
+  }
+
+  // The frame in progress isn't finished, so if the texture has
+  // already been drawn in it, use the frame before.
+  float distance = (gtc->_distance_frame == _distance_frame) ?
+    gtc->_prev_near_distance : gtc->_near_distance;
+
+  int levels = 0;
+  while (distance >= drop_distance && levels < 32) {
+    ++levels;
+    drop_distance *= 2.0;
+  }
+  return levels;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: GLGraphicsStateGuardian::note_texture_distances
+//       Access: Protected
+//  Description: Called as each Geom is drawn, when
+//               texture-drop-distance is in effect, to record the
+//               distance from the camera to the Geom's bounding
+//               volume against each of the textures it is drawn
+//               with.
+////////////////////////////////////////////////////////////////////
+void CLP(GraphicsStateGuardian)::
+note_texture_distances(const GeomPipelineReader *geom_reader) {
+  CPT(BoundingVolume) bounds =
+    geom_reader->get_object()->get_bounds(geom_reader->get_current_thread());
+  const FiniteBoundingVolume *fbv = bounds->as_finite_bounding_volume();
+  if (fbv == (FiniteBoundingVolume *)NULL || bounds->is_empty()) {
+    return;
+  }
+
+  LPoint3f center;
+  float radius;
+  const BoundingSphere *sphere = bounds->as_bounding_sphere();
+  if (sphere != (BoundingSphere *)NULL) {
+    center = sphere->get_center();
+    radius = sphere->get_radius();
+  } else {
+    LPoint3f min_point = fbv->get_min();
+    LPoint3f max_point = fbv->get_max();
+    center = (min_point + max_point) * 0.5f;
+    radius = (max_point - min_point).length() * 0.5f;
+  }
+
+  // The internal transform takes the Geom into the camera's space.
+  const LMatrix4f &mat = _internal_transform->get_mat();
+  LPoint3f view_center = center * mat;
+  float scale = mat.get_row3(0).length();
+  float distance = max(view_center.length() - radius * scale, 0.0f);
+
+  pvector<CLP(TextureContext) *>::const_iterator ti;
+  for (ti = _distance_textures.begin(); ti != _distance_textures.end(); ++ti) {
+    CLP(TextureContext) *gtc = (*ti);
+    if (gtc->_distance_frame != _distance_frame) {
+      if (gtc->_distance_frame >= 0) {
+        gtc->_prev_near_distance = gtc->_near_distance;
+      }
+      gtc->_near_distance = distance;
+      gtc->_distance_frame = _distance_frame;
+    } else if (distance < gtc->_near_distance) {
+      gtc->_near_distance = distance;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: GLGraphicsStateGuardian::upload_texture_image
 //       Access: Protected
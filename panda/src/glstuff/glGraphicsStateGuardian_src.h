@@ -387,6 +387,10 @@ protected:
   bool specify_texture(CLP(TextureContext) *gtc);
   bool apply_texture(TextureContext *tc);
   bool upload_texture(CLP(TextureContext) *gtc, bool force);
+  int choose_progressive_bias(CLP(TextureContext) *gtc, int min_bias,
+                              size_t &upload_size);
+  int choose_drop_levels(CLP(TextureContext) *gtc) const;
+  void note_texture_distances(const GeomPipelineReader *geom_reader);
   bool upload_texture_image(CLP(TextureContext) *gtc,
                             bool uses_mipmaps, int mipmap_bias,
                             GLenum texture_target, GLenum page_target, 
@@ -651,6 +655,16 @@ public:
   bool _track_errors;
   bool _allow_flush;
 
+  // The number of bytes of progressive texture levels sent so far
+  // this frame, measured against texture-upload-budget.
+  size_t _progressive_upload_bytes;
+
+  // The textures applied by the current state, whose distance from
+  // the camera is noted as each Geom is drawn, and the number of the
+  // current frame, for texture-drop-distance.
+  pvector<CLP(TextureContext) *> _distance_textures;
+  int _distance_frame;
+
 #ifndef NDEBUG
   bool _show_texture_usage;
   int _show_texture_usage_max_size;
@@ -44,6 +44,7 @@ evict_lru() {
   GLP(GenTextures)(1, &_index);
 
   _already_applied = false;
+  _progressive_bias = -1;
   update_data_size_bytes(0);
   mark_unloaded();
 }
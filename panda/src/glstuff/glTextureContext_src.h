@@ -40,6 +40,23 @@ public:
   GLsizei _height;
   GLsizei _depth;
 
+  // While the texture is being sent progressively (see
+  // progressive-textures), or has levels dropped (see
+  // texture-drop-distance), this is the mipmap level of the texture
+  // that is presently loaded as level 0 of the GL texture object.
+  // It is -1 while the full texture is loaded.  _progressive_image
+  // is the texture's image_modified counter when those levels were
+  // sent.
+  int _progressive_bias;
+  UpdateSeq _progressive_image;
+
+  // The nearest distance from the camera at which the texture was
+  // drawn in frame _distance_frame, and in the frame it was drawn
+  // before that, for texture-drop-distance.
+  float _near_distance;
+  float _prev_near_distance;
+  int _distance_frame;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -57,6 +57,7 @@
     sliderTable.I sliderTable.h \
     texture.I texture.h \
     textureCollection.I textureCollection.h \
+    textureCompressRequest.I textureCompressRequest.h \
     textureContext.I textureContext.h \
     texturePeeker.I texturePeeker.h \
     texturePool.I texturePool.h \
@@ -125,6 +126,7 @@
     sliderTable.cxx \
     texture.cxx \
     textureCollection.cxx \
+    textureCompressRequest.cxx \
     textureContext.cxx \
     texturePeeker.cxx \
     texturePool.cxx \
@@ -154,6 +156,7 @@
     bufferResidencyTracker.I bufferResidencyTracker.h \
     config_gobj.h \
     geom.I geom.h \
+    textureCompressRequest.I textureCompressRequest.h \
     textureContext.I textureContext.h \
     geom.h geom.I \
     geomContext.I geomContext.h \
@@ -195,6 +198,7 @@
     sliderTable.I sliderTable.h \
     texture.I texture.h \
     textureCollection.I textureCollection.h \
+    textureCompressRequest.I textureCompressRequest.h \
     textureContext.I textureContext.h \
     texturePeeker.I texturePeeker.h \
     texturePool.I texturePool.h \
@@ -231,3 +235,13 @@
 
 #end test_bin_target
 
+#begin test_bin_target
+  #define TARGET test_mipmap
+  #define LOCAL_LIBS \
+    gobj putil
+
+  #define SOURCES \
+    test_mipmap.cxx
+
+#end test_bin_target
+
@@ -39,6 +39,7 @@
 #include "sliderTable.h"
 #include "texture.h"
 #include "texturePoolFilter.h"
+#include "textureCompressRequest.h"
 #include "textureReloadRequest.h"
 #include "textureStage.h"
 #include "textureContext.h"
@@ -312,6 +313,44 @@ ConfigVariableDouble simple_image_threshold
           "simple images.  Generally the value should be considerably "
           "less than 1."));
 
+ConfigVariableInt generate_mipmap_threads
+("generate-mipmap-threads", 0,
+ PRC_DESC("Specifies the number of threads, counting the calling thread, "
+          "that may share the generation of each RAM mipmap level by "
+          "Texture::generate_ram_mipmap_images().  The rows of a level "
+          "are divided among them; levels with fewer than 32 rows per "
+          "thread use fewer threads, so the small levels are always "
+          "done in the calling thread.  The mipmaps are the same with "
+          "any number of threads."));
+
+ConfigVariableBool async_compress_textures
+("async-compress-textures", false,
+ PRC_DESC("Set this true to compress textures in the background, rather "
+          "than in the thread that loads them, when compressed-textures "
+          "is in effect and the texture is compressed in RAM by squish.  "
+          "The uncompressed image is available immediately; the "
+          "compressed image replaces it when it is ready, and is then "
+          "written to the model-cache, if cache-compressed-textures is "
+          "set.  This has no effect unless Panda was compiled with "
+          "threading support."));
+
+ConfigVariableInt async_compress_threads
+("async-compress-threads", 1,
+ PRC_DESC("The number of threads that will be started to compress "
+          "textures in the background when async-compress-textures is "
+          "true.  Each thread compresses one texture at a time."));
+
+ConfigVariableInt squish_threads
+("squish-threads", 0,
+ PRC_DESC("Specifies the number of threads, counting the calling thread, "
+          "that may share the compression of a RAM image with squish.  "
+          "Each page of each mipmap level is cut into bands of 4x4 "
+          "cells, which are compressed independently, so the result is "
+          "the same with any number of threads; an image with fewer "
+          "than two bands per thread uses fewer threads.  The work is "
+          "done by whichever thread compresses the texture, which is a "
+          "background thread when async-compress-textures is true."));
+
 ConfigVariableEnum<ShaderUtilization> shader_utilization
 ("shader-utilization", SUT_none,
  PRC_DESC("At times, panda may generate shaders.  This variable controls what "
@@ -488,6 +527,7 @@ ConfigureFn(config_gobj) {
   Shader::init_type();
   SliderTable::init_type();
   Texture::init_type();
+  TextureCompressRequest::init_type();
   TextureContext::init_type();
   TexturePoolFilter::init_type();
   TextureReloadRequest::init_type();
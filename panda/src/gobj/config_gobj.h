@@ -77,6 +77,10 @@ extern EXPCL_PANDA_GOBJ ConfigVariableBool textures_auto_power_2;
 extern EXPCL_PANDA_GOBJ ConfigVariableBool textures_header_only;
 extern EXPCL_PANDA_GOBJ ConfigVariableInt simple_image_size;
 extern EXPCL_PANDA_GOBJ ConfigVariableDouble simple_image_threshold;
+extern EXPCL_PANDA_GOBJ ConfigVariableInt generate_mipmap_threads;
+extern EXPCL_PANDA_GOBJ ConfigVariableBool async_compress_textures;
+extern EXPCL_PANDA_GOBJ ConfigVariableInt async_compress_threads;
+extern EXPCL_PANDA_GOBJ ConfigVariableInt squish_threads;
 
 extern EXPCL_PANDA_GOBJ ConfigVariableEnum<ShaderUtilization> shader_utilization;
 extern EXPCL_PANDA_GOBJ ConfigVariableBool shader_auto_utilization;
@@ -28,6 +28,7 @@
 #include "ioPtaDatagramInt.h"
 #include "indent.h"
 #include "pStatTimer.h"
+#include "vertexCacheOptimizer.h"
 
 TypeHandle GeomPrimitive::_type_handle;
 TypeHandle GeomPrimitive::CData::_type_handle;
@@ -37,6 +38,7 @@ PStatCollector GeomPrimitive::_decompose_pcollector("*:Munge:Decompose");
 PStatCollector GeomPrimitive::_doubleside_pcollector("*:Munge:Doubleside");
 PStatCollector GeomPrimitive::_reverse_pcollector("*:Munge:Reverse");
 PStatCollector GeomPrimitive::_rotate_pcollector("*:Munge:Rotate");
+PStatCollector GeomPrimitive::_optimize_vertex_cache_pcollector("*:Munge:Optimize vertex cache");
 
 ////////////////////////////////////////////////////////////////////
 //     Function: GeomPrimitive::Default Constructor
@@ -791,6 +793,34 @@ reverse() const {
   return reverse_impl();
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: GeomPrimitive::optimize_vertex_cache
+//       Access: Published
+//  Description: Returns a new primitive with the same triangles,
+//               drawn in an order that makes better use of the
+//               graphics card's post-transform vertex cache (see
+//               VertexCacheOptimizer).  The vertices of each triangle
+//               are not changed, but the triangles will be drawn in a
+//               different order, which may matter for transparent
+//               geometry.
+//
+//               This only affects indexed GeomTriangles; other kinds
+//               of primitives are returned unchanged.  Also see
+//               SceneGraphReducer::optimize_vertex_cache(), which
+//               also reorders the vertices to match.
+////////////////////////////////////////////////////////////////////
+CPT(GeomPrimitive) GeomPrimitive::
+optimize_vertex_cache() const {
+  if (gobj_cat.is_debug()) {
+    gobj_cat.debug()
+      << "Optimizing vertex cache for " << get_type() << ": "
+      << (void *)this << "\n";
+  }
+
+  PStatTimer timer(_optimize_vertex_cache_pcollector);
+  return optimize_vertex_cache_impl();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: GeomPrimitive::match_shade_model
 //       Access: Published
@@ -885,6 +915,37 @@ make_points() const {
   return points;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: GeomPrimitive::calc_acmr
+//       Access: Published
+//  Description: Returns the average cache miss ratio of the
+//               primitive: the number of vertices that must be
+//               transformed per triangle drawn, assuming a FIFO
+//               post-transform vertex cache with the indicated number
+//               of entries.  This is 3.0 if no vertices are reused,
+//               and can be as low as about 0.5 for a well-ordered
+//               regular mesh.
+//
+//               Primitives that don't decompose into triangles return
+//               0.
+////////////////////////////////////////////////////////////////////
+float GeomPrimitive::
+calc_acmr(int cache_size) const {
+  CPT(GeomPrimitive) triangles = decompose();
+  if (triangles->get_primitive_type() != PT_polygons ||
+      triangles->get_num_vertices_per_primitive() != 3) {
+    return 0.0f;
+  }
+
+  VertexCacheOptimizer opt;
+  int num_vertices = triangles->get_num_vertices();
+  for (int i = 0; i + 2 < num_vertices; i += 3) {
+    opt.add_triangle(triangles->get_vertex(i), triangles->get_vertex(i + 1),
+                     triangles->get_vertex(i + 2));
+  }
+  return opt.calc_acmr(cache_size);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: GeomPrimitive::get_num_bytes
 //       Access: Published
@@ -1583,6 +1644,16 @@ reverse_impl() const {
   return this;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: GeomPrimitive::optimize_vertex_cache_impl
+//       Access: Protected, Virtual
+//  Description: The virtual implementation of optimize_vertex_cache().
+////////////////////////////////////////////////////////////////////
+CPT(GeomPrimitive) GeomPrimitive::
+optimize_vertex_cache_impl() const {
+  return this;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: GeomPrimitive::requires_unused_vertices
 //       Access: Protected, Virtual
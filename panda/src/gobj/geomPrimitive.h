@@ -129,9 +129,12 @@ PUBLISHED:
   CPT(GeomPrimitive) rotate() const;
   CPT(GeomPrimitive) doubleside() const;
   CPT(GeomPrimitive) reverse() const;
+  CPT(GeomPrimitive) optimize_vertex_cache() const;
   CPT(GeomPrimitive) match_shade_model(ShadeModel shade_model) const;
   CPT(GeomPrimitive) make_points() const;
 
+  float calc_acmr(int cache_size) const;
+
   int get_num_bytes() const;
   INLINE int get_data_size_bytes() const;
   INLINE UpdateSeq get_modified() const;
@@ -209,6 +212,7 @@ protected:
   virtual CPT(GeomVertexArrayData) rotate_impl() const;
   virtual CPT(GeomPrimitive) doubleside_impl() const;
   virtual CPT(GeomPrimitive) reverse_impl() const;
+  virtual CPT(GeomPrimitive) optimize_vertex_cache_impl() const;
   virtual bool requires_unused_vertices() const;
   virtual void append_unused_vertices(GeomVertexArrayData *vertices, 
                                       int vertex);
@@ -286,6 +290,7 @@ private:
   static PStatCollector _doubleside_pcollector;
   static PStatCollector _reverse_pcollector;
   static PStatCollector _rotate_pcollector;
+  static PStatCollector _optimize_vertex_cache_pcollector;
 
 public:
   virtual void write_datagram(BamWriter *manager, Datagram &dg);
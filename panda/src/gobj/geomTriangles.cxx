@@ -15,6 +15,7 @@
 #include "geomTriangles.h"
 #include "geomVertexRewriter.h"
 #include "pStatTimer.h"
+#include "vertexCacheOptimizer.h"
 #include "bamReader.h"
 #include "bamWriter.h"
 #include "graphicsStateGuardianBase.h"
@@ -184,6 +185,49 @@ reverse_impl() const {
   return reversed.p();
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: GeomTriangles::optimize_vertex_cache_impl
+//       Access: Protected, Virtual
+//  Description: The virtual implementation of optimize_vertex_cache().
+////////////////////////////////////////////////////////////////////
+CPT(GeomPrimitive) GeomTriangles::
+optimize_vertex_cache_impl() const {
+  Thread *current_thread = Thread::get_current_thread();
+  GeomPrimitivePipelineReader from(this, current_thread);
+  int num_vertices = from.get_num_vertices();
+  if (!from.is_indexed() || num_vertices < 6) {
+    // Nothing to reorder.
+    return this;
+  }
+
+  VertexCacheOptimizer opt;
+  int i;
+  for (i = 0; i + 2 < num_vertices; i += 3) {
+    opt.add_triangle(from.get_vertex(i), from.get_vertex(i + 1),
+                     from.get_vertex(i + 2));
+  }
+  opt.optimize();
+
+  int num_triangles = opt.get_num_triangles();
+  for (i = 0; i < num_triangles && opt.get_triangle_index(i) == i; ++i) {
+  }
+  if (i == num_triangles) {
+    // The triangles are already in the best order.
+    return this;
+  }
+
+  // Each triangle keeps its own vertices in the same order, so its
+  // winding and its flat-shaded vertex are unchanged.
+  PT(GeomTriangles) optimized = new GeomTriangles(*this);
+  optimized->clear_vertices();
+  for (i = 0; i < num_triangles; ++i) {
+    optimized->add_vertices(opt.get_triangle_v0(i), opt.get_triangle_v1(i),
+                            opt.get_triangle_v2(i));
+  }
+
+  return optimized.p();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: GeomTriangles::rotate_impl
 //       Access: Protected, Virtual
@@ -0,0 +1,232 @@
+// Filename: test_mipmap.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "texture.h"
+#include "config_gobj.h"
+#include "trueClock.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// This program generates the RAM mipmap images of a large 2-d texture
+// and a 3-d texture in each of the common formats, first in one thread
+// and then in the given number of threads, and reports the time taken
+// by each.  It checks every level against a simple per-component
+// average of the level above.
+//
+// Usage: test_mipmap [size [num_threads]]
+
+struct TestFormat {
+  const char *_name;
+  Texture::ComponentType _component_type;
+  Texture::Format _format;
+  int _num_components;
+};
+
+static const TestFormat formats[] = {
+  { "luminance8", Texture::T_unsigned_byte, Texture::F_luminance, 1 },
+  { "lum_alpha8", Texture::T_unsigned_byte, Texture::F_luminance_alpha, 2 },
+  { "rgb8", Texture::T_unsigned_byte, Texture::F_rgb, 3 },
+  { "rgba8", Texture::T_unsigned_byte, Texture::F_rgba, 4 },
+  { "rgba16", Texture::T_unsigned_short, Texture::F_rgba16, 4 },
+  { "luminance32f", Texture::T_float, Texture::F_luminance, 1 },
+  { "rgba32f", Texture::T_float, Texture::F_rgba32, 4 },
+};
+static const int num_formats = sizeof(formats) / sizeof(TestFormat);
+
+// Computes the level below from, of size x_size, y_size, z_size, into
+// to, adding up the components of each block in the same order as
+// the Texture does, so that even the float results should match
+// exactly.  A 3-d texture averages 2x2x2 blocks all the way down,
+// even once its levels are only one page deep.
+template<class Type>
+static void
+reference_level(const Type *from, Type *to, int x_size, int y_size,
+                int z_size, bool is_3d, int num_components, bool is_float) {
+  int to_x_size = max(x_size >> 1, 1);
+  int to_y_size = max(y_size >> 1, 1);
+  int to_z_size = max(z_size >> 1, 1);
+  int num_rows = is_3d ? 4 : 2;
+  size_t row = (size_t)x_size * num_components;
+  size_t page = (size_t)y_size * row;
+  size_t x_step = (x_size != 1) ? num_components : 0;
+  size_t y_step = (y_size != 1) ? row : 0;
+  size_t z_step = (z_size != 1) ? page : 0;
+
+  for (int z = 0; z < to_z_size; ++z) {
+    for (int y = 0; y < to_y_size; ++y) {
+      const Type *q = from + (2 * z) * page + (2 * y) * row;
+      const Type *rows[4] = { q, q + y_step, q + z_step, q + z_step + y_step };
+      for (int x = 0; x < to_x_size; ++x) {
+        for (int c = 0; c < num_components; ++c) {
+          size_t i = (size_t)x * 2 * x_step + c;
+          if (is_float) {
+            float sum0 = 0.0f, sum1 = 0.0f;
+            for (int r = 0; r < num_rows; ++r) {
+              sum0 += (float)rows[r][i];
+              sum1 += (float)rows[r][i + x_step];
+            }
+            *to++ = (Type)((sum0 + sum1) * (num_rows == 4 ? 0.125f : 0.25f));
+          } else {
+            unsigned int sum = 0;
+            for (int r = 0; r < num_rows; ++r) {
+              sum += (unsigned int)rows[r][i] + (unsigned int)rows[r][i + x_step];
+            }
+            *to++ = (Type)(sum >> (num_rows == 4 ? 3 : 2));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Checks each mipmap level of the texture against reference_level()
+// of the level above.
+template<class Type>
+static bool
+check_levels(Texture *tex, const TestFormat &format) {
+  int x_size = tex->get_x_size();
+  int y_size = tex->get_y_size();
+  int z_size = tex->get_z_size();
+  bool is_float = (format._component_type == Texture::T_float);
+  bool is_3d = (z_size != 1);
+
+  for (int n = 1; n < tex->get_num_ram_mipmap_images(); ++n) {
+    CPTA_uchar from = tex->get_ram_mipmap_image(n - 1);
+    CPTA_uchar to = tex->get_ram_mipmap_image(n);
+    pvector<Type> expected(to.size() / sizeof(Type));
+    reference_level((const Type *)from.p(), &expected[0], x_size, y_size,
+                    z_size, is_3d, format._num_components, is_float);
+    if (memcmp(&expected[0], to.p(), to.size()) != 0) {
+      nout << "  *** level " << n << " of " << format._name
+           << " differs from the reference\n";
+      return false;
+    }
+    x_size = max(x_size >> 1, 1);
+    y_size = max(y_size >> 1, 1);
+    z_size = max(z_size >> 1, 1);
+  }
+  return true;
+}
+
+static bool
+test_format(const TestFormat &format, int x_size, int y_size, int z_size,
+            int num_threads) {
+  PT(Texture) tex = new Texture("test");
+  if (z_size == 1) {
+    tex->setup_2d_texture(x_size, y_size, format._component_type, format._format);
+  } else {
+    tex->setup_3d_texture(x_size, y_size, z_size, format._component_type, format._format);
+  }
+  tex->set_minfilter(Texture::FT_linear_mipmap_linear);
+
+  // Fill the image with noise.  Float images get values in 0..1.
+  PTA_uchar image = tex->make_ram_image();
+  srand(1);
+  if (format._component_type == Texture::T_float) {
+    float *p = (float *)image.p();
+    for (size_t i = 0; i < image.size() / sizeof(float); ++i) {
+      p[i] = (float)rand() / (float)RAND_MAX;
+    }
+  } else {
+    for (size_t i = 0; i < image.size(); ++i) {
+      image[i] = (unsigned char)rand();
+    }
+  }
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  generate_mipmap_threads.set_value(0);
+  double start = clock->get_short_time();
+  tex->generate_ram_mipmap_images();
+  double single_time = clock->get_short_time() - start;
+
+  bool okflag;
+  switch (format._component_type) {
+  case Texture::T_unsigned_byte:
+    okflag = check_levels<unsigned char>(tex, format);
+    break;
+  case Texture::T_unsigned_short:
+    okflag = check_levels<unsigned short>(tex, format);
+    break;
+  default:
+    okflag = check_levels<float>(tex, format);
+    break;
+  }
+
+  pvector<CPTA_uchar> levels;
+  int n;
+  for (n = 0; n < tex->get_num_ram_mipmap_images(); ++n) {
+    levels.push_back(tex->get_ram_mipmap_image(n));
+  }
+
+  generate_mipmap_threads.set_value(num_threads);
+  start = clock->get_short_time();
+  tex->generate_ram_mipmap_images();
+  double threaded_time = clock->get_short_time() - start;
+
+  for (n = 1; n < tex->get_num_ram_mipmap_images(); ++n) {
+    CPTA_uchar level = tex->get_ram_mipmap_image(n);
+    if (level.size() != levels[n].size() ||
+        memcmp(level.p(), levels[n].p(), level.size()) != 0) {
+      nout << "  *** threaded level " << n << " of " << format._name
+           << " differs\n";
+      okflag = false;
+    }
+  }
+
+  nout << "  " << format._name << ": " << single_time * 1000.0 << " ms, "
+       << threaded_time * 1000.0 << " ms in " << num_threads << " threads\n";
+  return okflag;
+}
+
+int
+main(int argc, char *argv[]) {
+  int size = 2048;
+  int num_threads = 4;
+  if (argc > 1) {
+    size = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_threads = atoi(argv[2]);
+  }
+
+  bool all_ok = true;
+  int f;
+
+  nout << "2-d, " << size << " x " << size << ":\n";
+  for (f = 0; f < num_formats; ++f) {
+    if (!test_format(formats[f], size, size, 1, num_threads)) {
+      all_ok = false;
+    }
+  }
+
+  // An odd size, to exercise the skipped rows and columns.
+  nout << "2-d, " << size - 1 << " x " << size / 2 + 1 << ":\n";
+  for (f = 0; f < num_formats; ++f) {
+    if (!test_format(formats[f], size - 1, size / 2 + 1, 1, num_threads)) {
+      all_ok = false;
+    }
+  }
+
+  int size_3d = max(size / 16, 2);
+  nout << "3-d, " << size_3d << " x " << size_3d << " x " << size_3d << ":\n";
+  for (f = 0; f < num_formats; ++f) {
+    if (!test_format(formats[f], size_3d, size_3d, size_3d, num_threads)) {
+      all_ok = false;
+    }
+  }
+
+  return all_ok ? 0 : 1;
+}
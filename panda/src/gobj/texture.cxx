@@ -38,6 +38,9 @@
 #include "pbitops.h"
 #include "streamReader.h"
 #include "texturePeeker.h"
+#include "textureCompressRequest.h"
+#include "thread.h"
+#include "parallelFor.h"
 
 #ifdef HAVE_SQUISH
 #include <squish.h>
@@ -45,6 +48,12 @@
 
 #include <stddef.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// The mipmap filters use SSE2 to average several pixels at once.
+#define MIPMAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
 ConfigVariableEnum<Texture::QualityLevel> texture_quality_level
 ("texture-quality-level", Texture::QL_normal,
  PRC_DESC("This specifies a global quality level for all textures.  You "
@@ -188,6 +197,8 @@ Texture(const string &name) :
   _match_framebuffer_format = false;
   _post_load_store_cache = false;
   _quality_level = QL_default;
+  _compress_pending = false;
+  _compress_store_cache = false;
 
   _texture_type = TT_2d_texture;
   _x_size = 0;
@@ -230,6 +241,8 @@ Texture(const Texture &copy) :
   _has_read_pages = false;
   _has_read_mipmaps = false;
   _num_mipmap_levels_read = 0;
+  _compress_pending = false;
+  _compress_store_cache = false;
 
   operator = (copy);
 }
@@ -3277,6 +3290,12 @@ do_reload_ram_image(bool allow_compression) {
               // cache now, in its newly compressed form.
               record->set_data(this, this);
               cache->store(record);
+
+            } else if (_compress_pending &&
+                       cache->get_cache_compressed_textures()) {
+              // It is being compressed in the background; rewrite the
+              // cache when that is done.
+              _compress_store_cache = true;
             }
           }
 
@@ -3324,6 +3343,11 @@ do_reload_ram_image(bool allow_compression) {
       record->set_data(this, this);
       cache->store(record);
     }
+    if (_compress_pending && cache->get_cache_compressed_textures()) {
+      // It is being compressed in the background; update the cache
+      // again when that is done.
+      _compress_store_cache = true;
+    }
   }
 }
 
@@ -3449,7 +3473,17 @@ consider_auto_process_ram_image(bool generate_mipmaps, bool allow_compression) {
     }
     if (compression != CM_off && _ram_image_compression == CM_off) {
       GraphicsStateGuardianBase *gsg = GraphicsStateGuardianBase::get_default_gsg();
-      if (do_compress_ram_image(compression, QL_default, gsg)) {
+      if (async_compress_textures && Thread::is_threading_supported()) {
+        // Hand the image off to be compressed in the background; the
+        // uncompressed image serves in the meantime.
+        if (do_queue_compress_ram_image(compression, QL_default, gsg)) {
+          if (gobj_cat.is_debug()) {
+            gobj_cat.debug()
+              << "Queued " << get_name() << " for compression\n";
+          }
+        }
+
+      } else if (do_compress_ram_image(compression, QL_default, gsg)) {
         if (gobj_cat.is_debug()) {
           gobj_cat.debug()
             << "Compressed " << get_name() << " with "
@@ -3474,6 +3508,68 @@ do_compress_ram_image(Texture::CompressionMode compression,
                       GraphicsStateGuardianBase *gsg) {
   nassertr(compression != CM_off, false);
 
+  int squish_flags = do_choose_squish_flags(compression, quality_level, gsg);
+  if (squish_flags != 0 && do_squish(compression, squish_flags)) {
+    return true;
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::do_queue_compress_ram_image
+//       Access: Protected
+//  Description: Like do_compress_ram_image(), but instead of
+//               compressing the RAM image now, queues a
+//               TextureCompressRequest to compress it in a
+//               background thread.  The uncompressed image remains
+//               in place until the compressed one is ready.
+//
+//               Returns true if the request was queued (or one was
+//               already pending), false if the image cannot be
+//               compressed in RAM.
+////////////////////////////////////////////////////////////////////
+bool Texture::
+do_queue_compress_ram_image(Texture::CompressionMode compression,
+                            Texture::QualityLevel quality_level,
+                            GraphicsStateGuardianBase *gsg) {
+  nassertr(compression != CM_off, false);
+
+  if (_compress_pending) {
+    return true;
+  }
+  if (_ram_images.empty() || _ram_image_compression != CM_off) {
+    return false;
+  }
+
+  int squish_flags = do_choose_squish_flags(compression, quality_level, gsg);
+  if (squish_flags == 0) {
+    return false;
+  }
+
+  _compress_pending = true;
+  _compress_store_cache = false;
+
+  PT(TextureCompressRequest) request = 
+    new TextureCompressRequest(string("compress:") + get_name(),
+                               this, compression, squish_flags);
+  TextureCompressRequest::queue_request(request);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::do_choose_squish_flags
+//       Access: Protected
+//  Description: Resolves CM_on to the specific compression mode that
+//               will be used for this texture, and returns the flags
+//               to pass to squish to compress to that mode at the
+//               indicated quality level.  Returns 0 if the image
+//               cannot be compressed by squish.
+////////////////////////////////////////////////////////////////////
+int Texture::
+do_choose_squish_flags(Texture::CompressionMode &compression,
+                       Texture::QualityLevel quality_level,
+                       GraphicsStateGuardianBase *gsg) const {
   if (compression == CM_on) {
     // Select an appropriate compression mode automatically.
     switch (_format) {
@@ -3559,14 +3655,127 @@ do_compress_ram_image(Texture::CompressionMode compression,
         break;
       }
 
-      if (do_squish(compression, squish_flags)) {
-        return true;
-      }
+      return squish_flags;
     }
   }
 #endif  // HAVE_SQUISH
 
-  return false;
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::finish_queued_compress
+//       Access: Protected
+//  Description: Called by a TextureCompressRequest, in its own
+//               thread, to compress the RAM image that was queued by
+//               do_queue_compress_ram_image().  The image is
+//               compressed in a copy of the texture, without holding
+//               the lock, and swapped in when it is done, unless the
+//               image has changed in the meantime.  If
+//               store_cache_when_compressed() was called, the
+//               compressed texture is then written to the BamCache.
+//
+//               Returns true if the image was compressed, filling
+//               in source_bytes and compressed_bytes, or false if it
+//               could not be.
+////////////////////////////////////////////////////////////////////
+bool Texture::
+finish_queued_compress(Texture::CompressionMode compression, int squish_flags,
+                       size_t &source_bytes, size_t &compressed_bytes) {
+  PT(Texture) work = new Texture(get_name());
+  UpdateSeq image_modified;
+  Filename fullpath, alpha_fullpath;
+  {
+    MutexHolder holder(_lock);
+    if (!_compress_pending || _ram_images.empty() ||
+        _ram_image_compression != CM_off) {
+      _compress_pending = false;
+      _compress_store_cache = false;
+      return false;
+    }
+    work->do_assign(*this);
+    image_modified = _image_modified;
+    fullpath = _fullpath;
+    alpha_fullpath = _alpha_fullpath;
+  }
+
+  source_bytes = 0;
+  size_t n;
+  for (n = 0; n < work->_ram_images.size(); ++n) {
+    source_bytes += work->_ram_images[n]._image.size();
+  }
+
+  // The work texture is ours alone, so it can be compressed without
+  // holding any lock.
+  bool success = work->do_squish(compression, squish_flags);
+
+  compressed_bytes = 0;
+  for (n = 0; n < work->_ram_images.size(); ++n) {
+    compressed_bytes += work->_ram_images[n]._image.size();
+  }
+
+  bool store_cache;
+  {
+    MutexHolder holder(_lock);
+    store_cache = _compress_store_cache;
+    _compress_pending = false;
+    _compress_store_cache = false;
+
+    if (!success) {
+      return false;
+    }
+
+    if (_image_modified == image_modified && _ram_image_compression == CM_off) {
+      _ram_images = work->_ram_images;
+      _ram_image_compression = compression;
+      ++_image_modified;
+    } else {
+      // The image was changed or dropped while we were compressing
+      // it (for instance, after it was uploaded to the graphics
+      // card), so our copy can't replace it.  It is still a good
+      // image to write to the cache.
+      if (gobj_cat.is_debug()) {
+        gobj_cat.debug()
+          << "Texture " << get_name()
+          << " changed while it was being compressed\n";
+      }
+    }
+  }
+
+  if (store_cache && !fullpath.empty()) {
+    BamCache *cache = BamCache::get_global_ptr();
+    PT(BamCacheRecord) record = cache->lookup(fullpath, "txo");
+    if (record != (BamCacheRecord *)NULL) {
+      record->add_dependent_file(fullpath);
+      if (!alpha_fullpath.empty()) {
+        record->add_dependent_file(alpha_fullpath);
+      }
+      record->set_data(work, work);
+      cache->store(record);
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::store_cache_when_compressed
+//       Access: Protected
+//  Description: If the RAM image is waiting to be compressed in the
+//               background, arranges for the texture to be written
+//               to the BamCache once it has been compressed, and
+//               returns true.  Returns false if there is no
+//               compression pending, in which case the caller
+//               should store the texture itself if appropriate.
+////////////////////////////////////////////////////////////////////
+bool Texture::
+store_cache_when_compressed() {
+  MutexHolder holder(_lock);
+  if (!_compress_pending) {
+    return false;
+  }
+  _compress_store_cache = true;
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -4514,7 +4723,7 @@ do_clear_ram_mipmap_images() {
 void Texture::
 do_generate_ram_mipmap_images() {
   nassertv(do_has_ram_image());
-  nassertv(_component_type != T_float);
+  nassertv(_component_type != T_unsigned_int_24_8);
   if (do_get_expected_num_mipmap_levels() == 1) {
     // Don't bother.
     return;
@@ -5407,74 +5616,23 @@ filter_2d_mipmap_pages(Texture::RamImage &to, const Texture::RamImage &from,
   to._page_size = (size_t)to_y_size * to_row_size;
   to._image = PTA_uchar::empty_array(to._page_size * _z_size, get_class_type());
 
-  Filter2DComponent *filter_component = (_component_type == T_unsigned_byte ? &filter_2d_unsigned_byte : filter_2d_unsigned_short);
-
-  for (int z = 0; z < _z_size; ++z) {
-    // For each level.
-    unsigned char *p = to._image.p() + z * to._page_size;
-    const unsigned char *q = from._image.p() + z * from._page_size;
-    if (y_size != 1) {
-      int y;
-      for (y = 0; y < y_size - 1; y += 2) {
-        // For each row.
-        nassertv(p == to._image.p() + z * to._page_size + (y / 2) * to_row_size);
-        nassertv(q == from._image.p() + z * from._page_size + y * row_size);
-        if (x_size != 1) {
-          int x;
-          for (x = 0; x < x_size - 1; x += 2) {
-            // For each pixel.
-            for (int c = 0; c < _num_components; ++c) {
-              // For each component.
-              filter_component(p, q, pixel_size, row_size);
-            }
-            q += pixel_size;
-          }
-          if (x < x_size) {
-            // Skip the last odd pixel.
-            q += pixel_size;
-          }
-        } else {
-          // Just one pixel.
-          for (int c = 0; c < _num_components; ++c) {
-            // For each component.
-            filter_component(p, q, 0, row_size);
-          }
-        }
-        q += row_size;
-        Thread::consider_yield();
-      }
-      if (y < y_size) {
-        // Skip the last odd row.
-        q += row_size;
-      }
-    } else {
-      // Just one row.
-      if (x_size != 1) {
-        int x;
-        for (x = 0; x < x_size - 1; x += 2) {
-          // For each pixel.
-          for (int c = 0; c < _num_components; ++c) {
-            // For each component.
-            filter_component(p, q, pixel_size, 0);
-          }
-          q += pixel_size;
-        }
-        if (x < x_size) {
-          // Skip the last odd pixel.
-          q += pixel_size;
-        }
-      } else {
-        // Just one pixel.
-        for (int c = 0; c < _num_components; ++c) {
-          // For each component.
-          filter_component(p, q, 0, 0);
-        }
-      }
-    }
+  MipmapFilter filter;
+  filter._to = to._image.p();
+  filter._from = from._image.p();
+  filter._component_type = _component_type;
+  filter._num_components = _num_components;
+  filter._to_x_size = to_x_size;
+  filter._to_y_size = to_y_size;
+  filter._to_row_size = to_row_size;
+  filter._from_page_step = from._page_size;
+  filter._from_row_step = row_size * 2;
+  filter._y_step = (y_size != 1) ? row_size : 0;
+  filter._z_step = 0;
+  filter._num_rows = 2;
+  filter._x_step = (x_size != 1) ? _num_components : 0;
 
-    nassertv(p == to._image.p() + (z + 1) * to._page_size);
-    nassertv(q == from._image.p() + (z + 1) * from._page_size);
-  }
+  // A last odd row or column of the previous level is skipped.
+  run_mipmap_filter(filter, to_y_size * _z_size);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -5506,227 +5664,418 @@ filter_3d_mipmap_level(Texture::RamImage &to, const Texture::RamImage &from,
   to._page_size = to_page_size;
   to._image = PTA_uchar::empty_array(to_page_size * to_z_size, get_class_type());
 
-  Filter3DComponent *filter_component = (_component_type == T_unsigned_byte ? &filter_3d_unsigned_byte : filter_3d_unsigned_short);
-
-  unsigned char *p = to._image.p();
-  const unsigned char *q = from._image.p();
-  if (z_size != 1) {
-    int z;
-    for (z = 0; z < z_size - 1; z += 2) {
-      // For each level.
-      nassertv(p == to._image.p() + (z / 2) * to_page_size);
-      nassertv(q == from._image.p() + z * page_size);
-      if (y_size != 1) {
-        int y;
-        for (y = 0; y < y_size - 1; y += 2) {
-          // For each row.
-          nassertv(p == to._image.p() + (z / 2) * to_page_size + (y / 2) * to_row_size);
-          nassertv(q == from._image.p() + z * page_size + y * row_size);
-          if (x_size != 1) {
-            int x;
-            for (x = 0; x < x_size - 1; x += 2) {
-              // For each pixel.
-              for (int c = 0; c < _num_components; ++c) {
-                // For each component.
-                filter_component(p, q, pixel_size, row_size, page_size);
-              }
-              q += pixel_size;
-            }
-            if (x < x_size) {
-              // Skip the last odd pixel.
-              q += pixel_size;
-            }
-          } else {
-            // Just one pixel.
-            for (int c = 0; c < _num_components; ++c) {
-              // For each component.
-              filter_component(p, q, 0, row_size, page_size);
-            }
-          }
-          q += row_size;
-          Thread::consider_yield();
-        }
-        if (y < y_size) {
-          // Skip the last odd row.
-          q += row_size;
-        }
-      } else {
-        // Just one row.
-        if (x_size != 1) {
-          int x;
-          for (x = 0; x < x_size - 1; x += 2) {
-            // For each pixel.
-            for (int c = 0; c < _num_components; ++c) {
-              // For each component.
-              filter_component(p, q, pixel_size, 0, page_size);
-            }
-            q += pixel_size;
-          }
-          if (x < x_size) {
-            // Skip the last odd pixel.
-            q += pixel_size;
-          }
-        } else {
-          // Just one pixel.
-          for (int c = 0; c < _num_components; ++c) {
-            // For each component.
-            filter_component(p, q, 0, 0, page_size);
-          }
-        }
+  MipmapFilter filter;
+  filter._to = to._image.p();
+  filter._from = from._image.p();
+  filter._component_type = _component_type;
+  filter._num_components = _num_components;
+  filter._to_x_size = to_x_size;
+  filter._to_y_size = to_y_size;
+  filter._to_row_size = to_row_size;
+  filter._from_page_step = page_size * 2;
+  filter._from_row_step = row_size * 2;
+  filter._y_step = (y_size != 1) ? row_size : 0;
+  filter._z_step = (z_size != 1) ? page_size : 0;
+  filter._num_rows = 4;
+  filter._x_step = (x_size != 1) ? _num_components : 0;
+
+  // A last odd page, row, or column of the previous level is skipped.
+  run_mipmap_filter(filter, to_y_size * to_z_size);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::MipmapFilter::filter_rows
+//       Access: Public
+//  Description: Generates rows begin through end - 1 of the new
+//               level, counting across all of its pages.  This may be
+//               called from several threads at once, for different
+//               rows.
+////////////////////////////////////////////////////////////////////
+void Texture::MipmapFilter::
+filter_rows(int begin, int end) const {
+  for (int i = begin; i < end; ++i) {
+    int z = i / _to_y_size;
+    int y = i % _to_y_size;
+    const unsigned char *q = _from + z * _from_page_step + y * _from_row_step;
+    const unsigned char *rows[4] = {
+      q, q + _y_step, q + _z_step, q + _z_step + _y_step
+    };
+    unsigned char *p = _to + i * _to_row_size;
+
+    switch (_component_type) {
+    case T_unsigned_byte:
+      filter_mipmap_row_unsigned_byte(p, rows, _num_rows, _to_x_size,
+                                      _num_components, _x_step);
+      break;
+
+    case T_float:
+      {
+        const float *float_rows[4] = {
+          (const float *)rows[0], (const float *)rows[1],
+          (const float *)rows[2], (const float *)rows[3]
+        };
+        filter_mipmap_row_float((float *)p, float_rows, _num_rows,
+                                _to_x_size, _num_components, _x_step);
       }
-      q += page_size;
+      break;
+
+    default:
+      {
+        const unsigned short *short_rows[4] = {
+          (const unsigned short *)rows[0], (const unsigned short *)rows[1],
+          (const unsigned short *)rows[2], (const unsigned short *)rows[3]
+        };
+        filter_mipmap_row_unsigned_short((unsigned short *)p, short_rows,
+                                         _num_rows, _to_x_size,
+                                         _num_components, _x_step);
+      }
+      break;
     }
-    if (z < z_size) {
-      // Skip the last odd page.
-      q += page_size;
+    Thread::consider_yield();
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//       Class : Texture::MipmapBody
+// Description : Hands the rows of a mipmap level to ParallelFor.
+////////////////////////////////////////////////////////////////////
+class Texture::MipmapBody : public ParallelFor::Body {
+public:
+  MipmapBody(const MipmapFilter &filter) : _filter(filter) { }
+  virtual void do_range(int begin, int end) {
+    _filter.filter_rows(begin, end);
+  }
+
+private:
+  const MipmapFilter &_filter;
+};
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::run_mipmap_filter
+//       Access: Private, Static
+//  Description: Generates all num_rows rows of the new mipmap level,
+//               dividing them among generate-mipmap-threads threads
+//               if the level is large enough to be worth it.
+////////////////////////////////////////////////////////////////////
+void Texture::
+run_mipmap_filter(const Texture::MipmapFilter &filter, int num_rows) {
+  // Below this many rows per thread, it's not worth involving the
+  // other threads.
+  static const int min_rows_per_thread = 32;
+
+  MipmapBody body(filter);
+  ParallelFor::run(body, num_rows, generate_mipmap_threads,
+                   min_rows_per_thread);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::filter_mipmap_row_unsigned_byte
+//       Access: Private, Static
+//  Description: Averages 2x2 blocks of pixels (2x2x2 blocks, if
+//               num_rows is 4) of the indicated rows into to_x_size
+//               pixels of the next mipmap level.  The second pixel of
+//               each block is x_step components beyond the first.
+////////////////////////////////////////////////////////////////////
+void Texture::
+filter_mipmap_row_unsigned_byte(unsigned char *p,
+                                const unsigned char *const rows[],
+                                int num_rows, int to_x_size,
+                                int num_components, int x_step) {
+  int shift = (num_rows == 4) ? 3 : 2;
+  int x = 0;
+
+#ifdef MIPMAP_SSE2
+  if (x_step == num_components &&
+      (num_components == 1 || num_components == 2 || num_components == 4)) {
+    // Each pass reads 16 components from each row, and writes 8.
+    int x_per_pass = 8 / num_components;
+    __m128i zero = _mm_setzero_si128();
+    __m128i ones = _mm_set1_epi16(1);
+    __m128i count = _mm_cvtsi32_si128(shift);
+
+    for (; x + x_per_pass <= to_x_size; x += x_per_pass) {
+      size_t i = (size_t)x * 2 * num_components;
+      __m128i lo = zero;
+      __m128i hi = zero;
+      for (int r = 0; r < num_rows; ++r) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(rows[r] + i));
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+      }
+
+      // Now add each pixel to its neighbor.
+      __m128i sum;
+      if (num_components == 1) {
+        sum = _mm_packs_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones));
+      } else if (num_components == 2) {
+        __m128 a = _mm_castsi128_ps(lo);
+        __m128 b = _mm_castsi128_ps(hi);
+        sum = _mm_add_epi16(_mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))),
+                            _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+      } else {
+        sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+      }
+
+      sum = _mm_srl_epi16(sum, count);
+      _mm_storel_epi64((__m128i *)p, _mm_packus_epi16(sum, sum));
+      p += 8;
     }
-  } else {
-    // Just one page.
-    if (y_size != 1) {
-      int y;
-      for (y = 0; y < y_size - 1; y += 2) {
-        // For each row.
-        nassertv(p == to._image.p() + (y / 2) * to_row_size);
-        nassertv(q == from._image.p() + y * row_size);
-        if (x_size != 1) {
-          int x;
-          for (x = 0; x < x_size - 1; x += 2) {
-            // For each pixel.
-            for (int c = 0; c < _num_components; ++c) {
-              // For each component.
-              filter_component(p, q, pixel_size, row_size, 0);
-            }
-            q += pixel_size;
-          }
-          if (x < x_size) {
-            // Skip the last odd pixel.
-            q += pixel_size;
-          }
-        } else {
-          // Just one pixel.
-          for (int c = 0; c < _num_components; ++c) {
-            // For each component.
-            filter_component(p, q, 0, row_size, 0);
-          }
-        }
-        q += row_size;
-        Thread::consider_yield();
+  }
+#endif  // MIPMAP_SSE2
+
+  for (; x < to_x_size; ++x) {
+    size_t i = (size_t)x * 2 * x_step;
+    for (int c = 0; c < num_components; ++c) {
+      unsigned int sum = 0;
+      for (int r = 0; r < num_rows; ++r) {
+        sum += (unsigned int)rows[r][i + c] + (unsigned int)rows[r][i + c + x_step];
       }
-      if (y < y_size) {
-        // Skip the last odd row.
-        q += row_size;
+      *p++ = (unsigned char)(sum >> shift);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::filter_mipmap_row_unsigned_short
+//       Access: Private, Static
+//  Description: As filter_mipmap_row_unsigned_byte(), for
+//               T_unsigned_short components.
+////////////////////////////////////////////////////////////////////
+void Texture::
+filter_mipmap_row_unsigned_short(unsigned short *p,
+                                 const unsigned short *const rows[],
+                                 int num_rows, int to_x_size,
+                                 int num_components, int x_step) {
+  int shift = (num_rows == 4) ? 3 : 2;
+  int x = 0;
+
+#ifdef MIPMAP_SSE2
+  if (x_step == num_components &&
+      (num_components == 1 || num_components == 2 || num_components == 4)) {
+    // Each pass reads 8 components from each row, and writes 4.
+    int x_per_pass = 4 / num_components;
+    __m128i zero = _mm_setzero_si128();
+    __m128i count = _mm_cvtsi32_si128(shift);
+    __m128i bias32 = _mm_set1_epi32(0x8000);
+    __m128i bias16 = _mm_set1_epi16((short)0x8000);
+
+    for (; x + x_per_pass <= to_x_size; x += x_per_pass) {
+      size_t i = (size_t)x * 2 * num_components;
+      __m128i lo = zero;
+      __m128i hi = zero;
+      for (int r = 0; r < num_rows; ++r) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(rows[r] + i));
+        lo = _mm_add_epi32(lo, _mm_unpacklo_epi16(v, zero));
+        hi = _mm_add_epi32(hi, _mm_unpackhi_epi16(v, zero));
       }
-    } else {
-      // Just one row.
-      if (x_size != 1) {
-        int x;
-        for (x = 0; x < x_size - 1; x += 2) {
-          // For each pixel.
-          for (int c = 0; c < _num_components; ++c) {
-            // For each component.
-            filter_component(p, q, pixel_size, 0, 0);
-          }
-          q += pixel_size;
-        }
-        if (x < x_size) {
-          // Skip the last odd pixel.
-          q += pixel_size;
-        }
+
+      __m128i sum;
+      if (num_components == 4) {
+        sum = _mm_add_epi32(lo, hi);
       } else {
-        // Just one pixel.
-        for (int c = 0; c < _num_components; ++c) {
-          // For each component.
-          filter_component(p, q, 0, 0, 0);
+        __m128 a = _mm_castsi128_ps(lo);
+        __m128 b = _mm_castsi128_ps(hi);
+        if (num_components == 1) {
+          sum = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))),
+                              _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+        } else {
+          sum = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 1, 0))),
+                              _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 3, 2))));
         }
       }
+
+      // SSE2 can only pack to signed shorts, so shift the range down
+      // and back up again around the pack.
+      sum = _mm_sub_epi32(_mm_srl_epi32(sum, count), bias32);
+      sum = _mm_add_epi16(_mm_packs_epi32(sum, sum), bias16);
+      _mm_storel_epi64((__m128i *)p, sum);
+      p += 4;
     }
   }
+#endif  // MIPMAP_SSE2
 
-  nassertv(p == to._image.p() + to_z_size * to_page_size);
-  nassertv(q == from._image.p() + z_size * page_size);
+  for (; x < to_x_size; ++x) {
+    size_t i = (size_t)x * 2 * x_step;
+    for (int c = 0; c < num_components; ++c) {
+      unsigned int sum = 0;
+      for (int r = 0; r < num_rows; ++r) {
+        sum += (unsigned int)rows[r][i + c] + (unsigned int)rows[r][i + c + x_step];
+      }
+      *p++ = (unsigned short)(sum >> shift);
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////
-//     Function: Texture::filter_2d_unsigned_byte
-//       Access: Public, Static
-//  Description: Averages a 2x2 block of pixel components into a
-//               single pixel component, for producing the next mipmap
-//               level.  Increments p and q to the next component.
+//     Function: Texture::filter_mipmap_row_float
+//       Access: Private, Static
+//  Description: As filter_mipmap_row_unsigned_byte(), for T_float
+//               components.
 ////////////////////////////////////////////////////////////////////
 void Texture::
-filter_2d_unsigned_byte(unsigned char *&p, const unsigned char *&q,
-                        size_t pixel_size, size_t row_size) {
-  unsigned int result = ((unsigned int)q[0] +
-                         (unsigned int)q[pixel_size] +
-                         (unsigned int)q[row_size] +
-                         (unsigned int)q[pixel_size + row_size]) >> 2;
-  *p = (unsigned char)result;
-  ++p;
-  ++q;
+filter_mipmap_row_float(float *p, const float *const rows[],
+                        int num_rows, int to_x_size,
+                        int num_components, int x_step) {
+  float scale = (num_rows == 4) ? 0.125f : 0.25f;
+  int x = 0;
+
+#ifdef MIPMAP_SSE2
+  if (x_step == num_components &&
+      (num_components == 1 || num_components == 2 || num_components == 4)) {
+    // Each pass reads 8 components from each row, and writes 4.  The
+    // sums are made in the same order as the loop below, so the
+    // results are the same either way.
+    int x_per_pass = 4 / num_components;
+    __m128 vscale = _mm_set1_ps(scale);
+
+    for (; x + x_per_pass <= to_x_size; x += x_per_pass) {
+      size_t i = (size_t)x * 2 * num_components;
+      __m128 a = _mm_setzero_ps();
+      __m128 b = _mm_setzero_ps();
+      for (int r = 0; r < num_rows; ++r) {
+        a = _mm_add_ps(a, _mm_loadu_ps(rows[r] + i));
+        b = _mm_add_ps(b, _mm_loadu_ps(rows[r] + i + 4));
+      }
+
+      __m128 sum;
+      if (num_components == 1) {
+        sum = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                         _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      } else if (num_components == 2) {
+        sum = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 1, 0)),
+                         _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 3, 2)));
+      } else {
+        sum = _mm_add_ps(a, b);
+      }
+
+      _mm_storeu_ps(p, _mm_mul_ps(sum, vscale));
+      p += 4;
+    }
+  }
+#endif  // MIPMAP_SSE2
+
+  for (; x < to_x_size; ++x) {
+    size_t i = (size_t)x * 2 * x_step;
+    for (int c = 0; c < num_components; ++c) {
+      float sum0 = 0.0f;
+      float sum1 = 0.0f;
+      for (int r = 0; r < num_rows; ++r) {
+        sum0 += rows[r][i + c];
+        sum1 += rows[r][i + c + x_step];
+      }
+      *p++ = (sum0 + sum1) * scale;
+    }
+  }
 }
 
+#ifdef HAVE_SQUISH
 ////////////////////////////////////////////////////////////////////
-//     Function: Texture::filter_2d_unsigned_short
-//       Access: Public, Static
-//  Description: Averages a 2x2 block of pixel components into a
-//               single pixel component, for producing the next mipmap
-//               level.  Increments p and q to the next component.
+//       Class : Texture::SquishBody
+// Description : Hands the bands of a texture to ParallelFor.
 ////////////////////////////////////////////////////////////////////
-void Texture::
-filter_2d_unsigned_short(unsigned char *&p, const unsigned char *&q,
-                         size_t pixel_size, size_t row_size) {
-  unsigned int result = ((unsigned int)*(unsigned short *)&q[0] +
-                         (unsigned int)*(unsigned short *)&q[pixel_size] +
-                         (unsigned int)*(unsigned short *)&q[row_size] +
-                         (unsigned int)*(unsigned short *)&q[pixel_size + row_size]) >> 2;
-  store_unscaled_short(p, result);
-  q += 2;
-}
+class Texture::SquishBody : public ParallelFor::Body {
+public:
+  SquishBody(const SquishBands &bands, int num_components, int squish_flags) :
+    _bands(bands), _num_components(num_components),
+    _squish_flags(squish_flags) { }
+  virtual void do_range(int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+      squish_band(_bands[b], _num_components, _squish_flags);
+    }
+  }
+
+private:
+  const SquishBands &_bands;
+  int _num_components;
+  int _squish_flags;
+};
+#endif  // HAVE_SQUISH
 
 ////////////////////////////////////////////////////////////////////
-//     Function: Texture::filter_3d_unsigned_byte
-//       Access: Public, Static
-//  Description: Averages a 2x2x2 block of pixel components into a
-//               single pixel component, for producing the next mipmap
-//               level.  Increments p and q to the next component.
+//     Function: Texture::squish_band
+//       Access: Private, Static
+//  Description: Invokes the squish library to compress one band of
+//               4 x 4 cells.
 ////////////////////////////////////////////////////////////////////
 void Texture::
-filter_3d_unsigned_byte(unsigned char *&p, const unsigned char *&q,
-                        size_t pixel_size, size_t row_size, size_t page_size) {
-  unsigned int result = ((unsigned int)q[0] +
-                         (unsigned int)q[pixel_size] +
-                         (unsigned int)q[row_size] +
-                         (unsigned int)q[pixel_size + row_size] +
-                         (unsigned int)q[page_size] +
-                         (unsigned int)q[pixel_size + page_size] +
-                         (unsigned int)q[row_size + page_size] +
-                         (unsigned int)q[pixel_size + row_size + page_size]) >> 3;
-  *p = (unsigned char)result;
-  ++p;
-  ++q;
-}
-
-////////////////////////////////////////////////////////////////////
-//     Function: Texture::filter_3d_unsigned_short
-//       Access: Public, Static
-//  Description: Averages a 2x2x2 block of pixel components into a
-//               single pixel component, for producing the next mipmap
-//               level.  Increments p and q to the next component.
+squish_band(const Texture::SquishBand &band, int num_components,
+            int squish_flags) {
+#ifdef HAVE_SQUISH
+  int cell_size = squish::GetStorageRequirements(4, 4, squish_flags);
+  int x_size = band._x_size;
+
+  // Convert one 4 x 4 cell at a time.
+  unsigned char *d = band._dest;
+  for (int y = band._y_begin; y < band._y_end; y += 4) {
+    for (int x = 0; x < x_size; x += 4) {
+      unsigned char tb[16 * 4];
+      int mask = 0;
+      unsigned char *t = tb;
+      for (int i = 0; i < 16; ++i) {
+        int xi = x + i % 4;
+        int yi = y + i / 4;
+        unsigned const char *s = band._source + (yi * x_size + xi) * num_components;
+        if (s < band._source_end) {
+          switch (num_components) {
+          case 1:
+            t[0] = s[0];   // r
+            t[1] = s[0];   // g
+            t[2] = s[0];   // b
+            t[3] = 255;    // a
+            break;
+
+          case 2:
+            t[0] = s[0];   // r
+            t[1] = s[0];   // g
+            t[2] = s[0];   // b
+            t[3] = s[1];   // a
+            break;
+
+          case 3:
+            t[0] = s[2];   // r
+            t[1] = s[1];   // g
+            t[2] = s[0];   // b
+            t[3] = 255;    // a
+            break;
+
+          case 4:
+            t[0] = s[2];   // r
+            t[1] = s[1];   // g
+            t[2] = s[0];   // b
+            t[3] = s[3];   // a
+            break;
+          }
+          mask |= (1 << i);
+        }
+        t += 4;
+      }
+      squish::CompressMasked(tb, mask, d, squish_flags);
+      d += cell_size;
+      Thread::consider_yield();
+    }
+  }
+#endif  // HAVE_SQUISH
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: Texture::run_squish
+//       Access: Private, Static
+//  Description: Compresses all of the bands, dividing them among
+//               squish-threads threads if there are enough of them
+//               to be worth it.
 ////////////////////////////////////////////////////////////////////
 void Texture::
-filter_3d_unsigned_short(unsigned char *&p, const unsigned char *&q,
-                         size_t pixel_size, size_t row_size,
-                         size_t page_size) {
-  unsigned int result = ((unsigned int)*(unsigned short *)&q[0] +
-                         (unsigned int)*(unsigned short *)&q[pixel_size] +
-                         (unsigned int)*(unsigned short *)&q[row_size] +
-                         (unsigned int)*(unsigned short *)&q[pixel_size + row_size] +
-                         (unsigned int)*(unsigned short *)&q[page_size] +
-                         (unsigned int)*(unsigned short *)&q[pixel_size + page_size] +
-                         (unsigned int)*(unsigned short *)&q[row_size + page_size] +
-                         (unsigned int)*(unsigned short *)&q[pixel_size + row_size + page_size]) >> 3;
-  store_unscaled_short(p, result);
-  q += 2;
+run_squish(const Texture::SquishBands &bands, int num_components,
+           int squish_flags) {
+#ifdef HAVE_SQUISH
+  // Below this many bands per thread, it's not worth involving the
+  // other threads.
+  static const int min_bands_per_thread = 2;
+
+  SquishBody body(bands, num_components, squish_flags);
+  ParallelFor::run(body, (int)bands.size(), squish_threads,
+                   min_bands_per_thread);
+#endif  // HAVE_SQUISH
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -5738,6 +6087,11 @@ filter_3d_unsigned_short(unsigned char *&p, const unsigned char *&q,
 bool Texture::
 do_squish(Texture::CompressionMode compression, int squish_flags) {
 #ifdef HAVE_SQUISH
+  // Each band is this many rows of cells.  The bands are small enough
+  // that a large texture is evenly divided among the threads, but big
+  // enough that handing them out costs nothing.
+  static const int cells_per_band = 16;
+
   if (_ram_images.empty() || _ram_image_compression != CM_off) {
     return false;
   }
@@ -5748,75 +6102,39 @@ do_squish(Texture::CompressionMode compression, int squish_flags) {
     do_generate_ram_mipmap_images();
   }
 
+  // First, allocate all of the compressed images, and divide them
+  // into bands; then compress all of the bands at once.
   RamImages compressed_ram_images;
   compressed_ram_images.reserve(_ram_images.size());
+  SquishBands bands;
   for (size_t n = 0; n < _ram_images.size(); ++n) {
     RamImage compressed_image;
     int x_size = do_get_expected_mipmap_x_size(n);
     int y_size = do_get_expected_mipmap_y_size(n);
     int z_size = do_get_expected_mipmap_z_size(n);
     int page_size = squish::GetStorageRequirements(x_size, y_size, squish_flags);
-    int cell_size = squish::GetStorageRequirements(4, 4, squish_flags);
+    int band_size = squish::GetStorageRequirements(x_size, cells_per_band * 4, squish_flags);
 
     compressed_image._page_size = page_size;
     compressed_image._image = PTA_uchar::empty_array(page_size * z_size);
     for (int z = 0; z < z_size; ++z) {
-      unsigned char *dest_page = compressed_image._image.p() + z * page_size;
-      unsigned const char *source_page = _ram_images[n]._image.p() + z * _ram_images[n]._page_size;
-      unsigned const char *source_page_end = source_page + _ram_images[n]._page_size;
-      // Convert one 4 x 4 cell at a time.
-      unsigned char *d = dest_page;
-      for (int y = 0; y < y_size; y += 4) {
-        for (int x = 0; x < x_size; x += 4) {
-          unsigned char tb[16 * 4];
-          int mask = 0;
-          unsigned char *t = tb;
-          for (int i = 0; i < 16; ++i) {
-            int xi = x + i % 4;
-            int yi = y + i / 4;
-            unsigned const char *s = source_page + (yi * x_size + xi) * _num_components;
-            if (s < source_page_end) {
-              switch (_num_components) {
-              case 1:
-                t[0] = s[0];   // r
-                t[1] = s[0];   // g
-                t[2] = s[0];   // b
-                t[3] = 255;    // a
-                break;
-
-              case 2:
-                t[0] = s[0];   // r
-                t[1] = s[0];   // g
-                t[2] = s[0];   // b
-                t[3] = s[1];   // a
-                break;
-
-              case 3:
-                t[0] = s[2];   // r
-                t[1] = s[1];   // g
-                t[2] = s[0];   // b
-                t[3] = 255;    // a
-                break;
-
-              case 4:
-                t[0] = s[2];   // r
-                t[1] = s[1];   // g
-                t[2] = s[0];   // b
-                t[3] = s[3];   // a
-                break;
-              }
-              mask |= (1 << i);
-            }
-            t += 4;
-          }
-          squish::CompressMasked(tb, mask, d, squish_flags);
-          d += cell_size;
-          Thread::consider_yield();
-        }
+      SquishBand band;
+      band._source = _ram_images[n]._image.p() + z * _ram_images[n]._page_size;
+      band._source_end = band._source + _ram_images[n]._page_size;
+      band._dest = compressed_image._image.p() + z * page_size;
+      band._x_size = x_size;
+      for (int y = 0; y < y_size; y += cells_per_band * 4) {
+        band._y_begin = y;
+        band._y_end = min(y + cells_per_band * 4, y_size);
+        bands.push_back(band);
+        band._dest += band_size;
       }
     }
     compressed_ram_images.push_back(compressed_image);
   }
+
+  run_squish(bands, _num_components, squish_flags);
+
   _ram_images.swap(compressed_ram_images);
   _ram_image_compression = compression;
   return true;
@@ -505,6 +505,15 @@ protected:
   bool do_compress_ram_image(CompressionMode compression,
                              QualityLevel quality_level,
                              GraphicsStateGuardianBase *gsg);
+  bool do_queue_compress_ram_image(CompressionMode compression,
+                                   QualityLevel quality_level,
+                                   GraphicsStateGuardianBase *gsg);
+  int do_choose_squish_flags(CompressionMode &compression,
+                             QualityLevel quality_level,
+                             GraphicsStateGuardianBase *gsg) const;
+  bool finish_queued_compress(CompressionMode compression, int squish_flags,
+                              size_t &source_bytes, size_t &compressed_bytes);
+  bool store_cache_when_compressed();
   bool do_uncompress_ram_image();
   bool do_has_all_ram_mipmap_images() const;
 
@@ -623,31 +632,70 @@ private:
   void filter_3d_mipmap_level(RamImage &to, const RamImage &from,
                               int x_size, int y_size, int z_size);
 
-  typedef void Filter2DComponent(unsigned char *&p, 
-                                 const unsigned char *&q,
-                                 size_t pixel_size, size_t row_size);
-
-  typedef void Filter3DComponent(unsigned char *&p, 
-                                 const unsigned char *&q,
-                                 size_t pixel_size, size_t row_size,
-                                 size_t page_size);
-
-  static void filter_2d_unsigned_byte(unsigned char *&p, 
-                                      const unsigned char *&q,
-                                      size_t pixel_size, size_t row_size);
-  static void filter_2d_unsigned_short(unsigned char *&p, 
-                                       const unsigned char *&q,
-                                       size_t pixel_size, size_t row_size);
-
-  static void filter_3d_unsigned_byte(unsigned char *&p, 
-                                      const unsigned char *&q,
-                                      size_t pixel_size, size_t row_size,
-                                      size_t page_size);
-  static void filter_3d_unsigned_short(unsigned char *&p, 
-                                       const unsigned char *&q,
-                                       size_t pixel_size, size_t row_size,
-                                       size_t page_size);
+  // A MipmapFilter describes the generation of one mipmap level from
+  // the previous one.  Each row of the new level is made from two
+  // rows of the previous level (four, for a 3-d texture), so the rows
+  // may be filtered in any order, or in several threads at once.
+  class MipmapFilter {
+  public:
+    void filter_rows(int begin, int end) const;
+
+    unsigned char *_to;
+    const unsigned char *_from;
+    ComponentType _component_type;
+    int _num_components;
+    int _to_x_size;
+    int _to_y_size;
+    size_t _to_row_size;
+
+    // The first source row of destination row y on page z is _from +
+    // z * _from_page_step + y * _from_row_step.  The other rows are
+    // _y_step, _z_step, and _y_step + _z_step beyond it, and the
+    // second pixel is _x_step components beyond the first.  Each step
+    // is 0 if the previous level has only one pixel in that direction.
+    size_t _from_page_step;
+    size_t _from_row_step;
+    size_t _y_step;
+    size_t _z_step;
+    int _num_rows;
+    int _x_step;
+  };
+  class MipmapBody;
+
+  static void run_mipmap_filter(const MipmapFilter &filter, int num_rows);
+
+  static void filter_mipmap_row_unsigned_byte(unsigned char *p,
+                                              const unsigned char *const rows[],
+                                              int num_rows, int to_x_size,
+                                              int num_components, int x_step);
+  static void filter_mipmap_row_unsigned_short(unsigned short *p,
+                                               const unsigned short *const rows[],
+                                               int num_rows, int to_x_size,
+                                               int num_components, int x_step);
+  static void filter_mipmap_row_float(float *p, const float *const rows[],
+                                      int num_rows, int to_x_size,
+                                      int num_components, int x_step);
   
+  // A SquishBand is a band of rows of 4x4 cells from one page of one
+  // mipmap level.  Each band is compressed separately, so the bands
+  // of a large texture may be compressed in several threads at once.
+  class SquishBand {
+  public:
+    const unsigned char *_source;
+    const unsigned char *_source_end;
+    unsigned char *_dest;
+    int _x_size;
+    int _y_begin;
+    int _y_end;
+  };
+  typedef pvector<SquishBand> SquishBands;
+  class SquishBody;
+
+  static void squish_band(const SquishBand &band, int num_components,
+                          int squish_flags);
+  static void run_squish(const SquishBands &bands, int num_components,
+                         int squish_flags);
+
   bool do_squish(CompressionMode compression, int squish_flags);
   bool do_unsquish(int squish_flags);
 
@@ -702,6 +750,11 @@ protected:
   bool _post_load_store_cache;
   QualityLevel _quality_level;
 
+  // These are set while a TextureCompressRequest is waiting to
+  // compress the RAM image in the background.
+  bool _compress_pending;
+  bool _compress_store_cache;
+
   int _pad_x_size;
   int _pad_y_size;
   int _pad_z_size;
@@ -784,6 +837,7 @@ private:
   friend class PreparedGraphicsObjects;
   friend class TexturePool;
   friend class TexturePeeker;
+  friend class TextureCompressRequest;
 };
 
 extern EXPCL_PANDA_GOBJ ConfigVariableEnum<Texture::QualityLevel> texture_quality_level;
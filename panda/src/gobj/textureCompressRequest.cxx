@@ -0,0 +1,211 @@
+// Filename: textureCompressRequest.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "textureCompressRequest.h"
+#include "asyncTaskManager.h"
+#include "asyncTaskChain.h"
+#include "config_gobj.h"
+#include "mutexHolder.h"
+#include "pStatTimer.h"
+#include "trueClock.h"
+
+TypeHandle TextureCompressRequest::_type_handle;
+
+Mutex TextureCompressRequest::_stats_lock;
+int TextureCompressRequest::_num_compressed = 0;
+int TextureCompressRequest::_num_failed = 0;
+size_t TextureCompressRequest::_total_source_bytes = 0;
+size_t TextureCompressRequest::_total_compressed_bytes = 0;
+double TextureCompressRequest::_total_time = 0.0;
+
+PStatCollector TextureCompressRequest::_compress_pcollector("*:Texture compress");
+
+static const char *const compress_task_chain = "texture_compress";
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::queue_request
+//       Access: Public, Static
+//  Description: Adds the request to the "texture_compress" task
+//               chain of the global AsyncTaskManager, creating the
+//               chain the first time.
+////////////////////////////////////////////////////////////////////
+void TextureCompressRequest::
+queue_request(TextureCompressRequest *request) {
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  if (task_mgr->find_task_chain(compress_task_chain) == NULL) {
+    AsyncTaskChain *chain = task_mgr->make_task_chain(compress_task_chain);
+    chain->set_num_threads(max((int)async_compress_threads, 1));
+    chain->set_thread_priority(TP_low);
+  }
+
+  request->set_task_chain(compress_task_chain);
+  task_mgr->add(request);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::get_num_compressed
+//       Access: Published, Static
+//  Description: Returns the number of textures that have been
+//               compressed by TextureCompressRequests since the
+//               last call to reset_stats().
+////////////////////////////////////////////////////////////////////
+int TextureCompressRequest::
+get_num_compressed() {
+  MutexHolder holder(_stats_lock);
+  return _num_compressed;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::get_num_failed
+//       Access: Published, Static
+//  Description: Returns the number of TextureCompressRequests that
+//               found nothing to compress, for instance because the
+//               texture's RAM image was replaced before they ran.
+////////////////////////////////////////////////////////////////////
+int TextureCompressRequest::
+get_num_failed() {
+  MutexHolder holder(_stats_lock);
+  return _num_failed;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::get_total_source_bytes
+//       Access: Published, Static
+//  Description: Returns the total size of the uncompressed images,
+//               including all of their mipmap levels, that have been
+//               compressed.
+////////////////////////////////////////////////////////////////////
+size_t TextureCompressRequest::
+get_total_source_bytes() {
+  MutexHolder holder(_stats_lock);
+  return _total_source_bytes;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::get_total_compressed_bytes
+//       Access: Published, Static
+//  Description: Returns the total size of the compressed images that
+//               have been produced.
+////////////////////////////////////////////////////////////////////
+size_t TextureCompressRequest::
+get_total_compressed_bytes() {
+  MutexHolder holder(_stats_lock);
+  return _total_compressed_bytes;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::get_total_time
+//       Access: Published, Static
+//  Description: Returns the total number of seconds spent by the
+//               requests in compressing textures, summed over all of
+//               the threads.
+////////////////////////////////////////////////////////////////////
+double TextureCompressRequest::
+get_total_time() {
+  MutexHolder holder(_stats_lock);
+  return _total_time;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::get_throughput
+//       Access: Published, Static
+//  Description: Returns the average number of uncompressed bytes
+//               compressed per second, per thread.
+////////////////////////////////////////////////////////////////////
+double TextureCompressRequest::
+get_throughput() {
+  MutexHolder holder(_stats_lock);
+  if (_total_time == 0.0) {
+    return 0.0;
+  }
+  return (double)_total_source_bytes / _total_time;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::reset_stats
+//       Access: Published, Static
+//  Description: Resets all of the running totals to zero.
+////////////////////////////////////////////////////////////////////
+void TextureCompressRequest::
+reset_stats() {
+  MutexHolder holder(_stats_lock);
+  _num_compressed = 0;
+  _num_failed = 0;
+  _total_source_bytes = 0;
+  _total_compressed_bytes = 0;
+  _total_time = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::write_stats
+//       Access: Published, Static
+//  Description: Writes a one-line summary of the running totals.
+////////////////////////////////////////////////////////////////////
+void TextureCompressRequest::
+write_stats(ostream &out) {
+  MutexHolder holder(_stats_lock);
+  out << _num_compressed << " textures compressed";
+  if (_num_failed != 0) {
+    out << " (" << _num_failed << " failed)";
+  }
+  out << ", " << _total_source_bytes << " bytes to "
+      << _total_compressed_bytes << " bytes in " << _total_time << " s";
+  if (_total_time != 0.0) {
+    out << ", " << (double)_total_source_bytes / (_total_time * 1048576.0)
+        << " MB/s";
+  }
+  out << "\n";
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextureCompressRequest::do_task
+//       Access: Protected, Virtual
+//  Description: Performs the task: that is, compresses the one
+//               texture.
+////////////////////////////////////////////////////////////////////
+AsyncTask::DoneStatus TextureCompressRequest::
+do_task() {
+  PStatTimer timer(_compress_pcollector);
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double start = clock->get_short_time();
+
+  size_t source_bytes = 0;
+  size_t compressed_bytes = 0;
+  bool success = _texture->finish_queued_compress(_compression, _squish_flags,
+                                                  source_bytes, compressed_bytes);
+
+  double elapsed = clock->get_short_time() - start;
+  {
+    MutexHolder holder(_stats_lock);
+    if (success) {
+      ++_num_compressed;
+      _total_source_bytes += source_bytes;
+      _total_compressed_bytes += compressed_bytes;
+      _total_time += elapsed;
+    } else {
+      ++_num_failed;
+    }
+  }
+
+  if (success && gobj_cat.is_debug()) {
+    gobj_cat.debug()
+      << "Compressed " << _texture->get_name() << " with "
+      << _compression << " in " << elapsed * 1000.0 << " ms\n";
+  }
+
+  _is_ready = true;
+
+  // Don't continue the task; we're done.
+  return DS_done;
+}
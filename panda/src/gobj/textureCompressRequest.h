@@ -0,0 +1,102 @@
+// Filename: textureCompressRequest.h
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef TEXTURECOMPRESSREQUEST
+#define TEXTURECOMPRESSREQUEST
+
+#include "pandabase.h"
+
+#include "asyncTask.h"
+#include "texture.h"
+#include "pointerTo.h"
+#include "pmutex.h"
+#include "pStatCollector.h"
+
+////////////////////////////////////////////////////////////////////
+//       Class : TextureCompressRequest
+// Description : This task compresses a texture's RAM image in a
+//               sub-thread.  It is queued by the texture itself when
+//               async-compress-textures is true, so that the texture
+//               may be used, uncompressed, while the compression
+//               goes on.  The requests are serviced by the
+//               "texture_compress" task chain, which runs
+//               async-compress-threads threads.
+//
+//               The class also keeps running totals of the work done
+//               by all of the requests, to measure the throughput of
+//               the compression.
+////////////////////////////////////////////////////////////////////
+class EXPCL_PANDA_GOBJ TextureCompressRequest : public AsyncTask {
+public:
+  ALLOC_DELETED_CHAIN(TextureCompressRequest);
+
+  INLINE TextureCompressRequest(const string &name, Texture *texture,
+                                Texture::CompressionMode compression,
+                                int squish_flags);
+
+  static void queue_request(TextureCompressRequest *request);
+
+PUBLISHED:
+  INLINE Texture *get_texture() const;
+  INLINE Texture::CompressionMode get_compression() const;
+  INLINE bool is_ready() const;
+
+  static int get_num_compressed();
+  static int get_num_failed();
+  static size_t get_total_source_bytes();
+  static size_t get_total_compressed_bytes();
+  static double get_total_time();
+  static double get_throughput();
+  static void reset_stats();
+  static void write_stats(ostream &out);
+
+protected:
+  virtual DoneStatus do_task();
+
+private:
+  PT(Texture) _texture;
+  Texture::CompressionMode _compression;
+  int _squish_flags;
+  bool _is_ready;
+
+  static Mutex _stats_lock;
+  static int _num_compressed;
+  static int _num_failed;
+  static size_t _total_source_bytes;
+  static size_t _total_compressed_bytes;
+  static double _total_time;
+
+  static PStatCollector _compress_pcollector;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    AsyncTask::init_type();
+    register_type(_type_handle, "TextureCompressRequest",
+                  AsyncTask::get_class_type());
+    }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#include "textureCompressRequest.I"
+
+#endif
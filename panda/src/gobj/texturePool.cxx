@@ -291,6 +291,11 @@ ns_load_texture(const Filename &orig_filename, int primary_file_num_channels,
       if (!compressed_cache_record) {
         tex->set_post_load_store_cache(true);
       }
+
+    } else if (tex->store_cache_when_compressed()) {
+      // The texture is still being compressed in the background.  It
+      // will store its compressed form in the cache when it is done.
+      store_record = false;
     }
 
   } else if (!cache->get_cache_textures()) {
@@ -422,6 +427,11 @@ ns_load_texture(const Filename &orig_filename,
       if (!compressed_cache_record) {
         tex->set_post_load_store_cache(true);
       }
+
+    } else if (tex->store_cache_when_compressed()) {
+      // The texture is still being compressed in the background.  It
+      // will store its compressed form in the cache when it is done.
+      store_record = false;
     }
 
   } else if (!cache->get_cache_textures()) {
@@ -534,6 +544,11 @@ ns_load_3d_texture(const Filename &filename_pattern,
       if (!compressed_cache_record) {
         tex->set_post_load_store_cache(true);
       }
+
+    } else if (tex->store_cache_when_compressed()) {
+      // The texture is still being compressed in the background.  It
+      // will store its compressed form in the cache when it is done.
+      store_record = false;
     }
 
   } else if (!cache->get_cache_textures()) {
@@ -633,6 +648,11 @@ ns_load_cube_map(const Filename &filename_pattern, bool read_mipmaps,
       if (!compressed_cache_record) {
         tex->set_post_load_store_cache(true);
       }
+
+    } else if (tex->store_cache_when_compressed()) {
+      // The texture is still being compressed in the background.  It
+      // will store its compressed form in the cache when it is done.
+      store_record = false;
     }
 
   } else if (!cache->get_cache_textures()) {
@@ -1005,6 +1025,12 @@ try_load_cache(PT(Texture) &tex, BamCache *cache, const Filename &filename,
                   record->set_data(tex, tex);
                   cache->store(record);
                   compressed_cache_record = true;
+
+                } else if (!is_compressed &&
+                           cache->get_cache_compressed_textures()) {
+                  // It may still be compressing in the background;
+                  // if so, it will rewrite the cache when it is done.
+                  tex->store_cache_when_compressed();
                 }
               }
             }
@@ -37,7 +37,8 @@
     rotate_to.h rotate_to_src.cxx \
     stackedPerlinNoise2.h stackedPerlinNoise2.I \
     stackedPerlinNoise3.h stackedPerlinNoise3.I \
-    triangulator.h triangulator.I
+    triangulator.h triangulator.I \
+    vertexCacheOptimizer.h vertexCacheOptimizer.I
 
   #define INCLUDED_SOURCES \
     boundingHexahedron.cxx boundingLine.cxx \
@@ -60,7 +61,8 @@
     rotate_to.cxx \
     stackedPerlinNoise2.cxx \
     stackedPerlinNoise3.cxx \
-    triangulator.cxx
+    triangulator.cxx \
+    vertexCacheOptimizer.cxx
 
   #define INSTALL_HEADERS \
     boundingHexahedron.I boundingHexahedron.h boundingLine.I \
@@ -84,7 +86,8 @@
     rotate_to.h rotate_to_src.cxx \
     stackedPerlinNoise2.h stackedPerlinNoise2.I \
     stackedPerlinNoise3.h stackedPerlinNoise3.I \
-    triangulator.h triangulator.I
+    triangulator.h triangulator.I \
+    vertexCacheOptimizer.h vertexCacheOptimizer.I
 
 
 
@@ -115,3 +118,15 @@
 
 #end test_bin_target
 
+
+#begin test_bin_target
+  #define TARGET test_vertex_cache
+  #define LOCAL_LIBS \
+    mathutil pipeline
+  #define OTHER_LIBS $[OTHER_LIBS] pystub
+
+  #define SOURCES \
+    test_vertex_cache.cxx
+
+#end test_bin_target
+
@@ -13,3 +13,4 @@
 #include "stackedPerlinNoise2.cxx"
 #include "stackedPerlinNoise3.cxx"
 #include "triangulator.cxx"
+#include "vertexCacheOptimizer.cxx"
@@ -0,0 +1,91 @@
+// Filename: test_vertex_cache.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pandabase.h"
+
+#include "vertexCacheOptimizer.h"
+#include "randomizer.h"
+
+#include <stdlib.h>
+
+// This program builds a regular grid of triangles, shuffles them,
+// and reports the average cache miss ratio before and after
+// VertexCacheOptimizer reorders them.  It checks that the optimized
+// list holds the same triangles, each with its original winding.
+//
+// Usage: test_vertex_cache [grid_size [cache_size]]
+
+int main(int argc, char *argv[]) {
+  int grid_size = 50;
+  int cache_size = 16;
+  if (argc > 1) {
+    grid_size = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    cache_size = atoi(argv[2]);
+  }
+
+  // Each quad of the grid is two triangles.
+  vector_int grid;
+  int row = grid_size + 1;
+  for (int y = 0; y < grid_size; ++y) {
+    for (int x = 0; x < grid_size; ++x) {
+      int a = y * row + x;
+      grid.push_back(a);
+      grid.push_back(a + 1);
+      grid.push_back(a + row + 1);
+      grid.push_back(a);
+      grid.push_back(a + row + 1);
+      grid.push_back(a + row);
+    }
+  }
+  int num_triangles = (int)grid.size() / 3;
+
+  vector_int order;
+  int i;
+  for (i = 0; i < num_triangles; ++i) {
+    order.push_back(i);
+  }
+  Randomizer random(1);
+  for (i = num_triangles - 1; i > 0; --i) {
+    swap(order[i], order[random.random_int(i + 1)]);
+  }
+
+  VertexCacheOptimizer opt;
+  for (i = 0; i < num_triangles; ++i) {
+    int t = order[i];
+    opt.add_triangle(grid[t * 3], grid[t * 3 + 1], grid[t * 3 + 2]);
+  }
+
+  cerr << num_triangles << " triangles, ACMR " << opt.calc_acmr(cache_size);
+  opt.optimize();
+  cerr << " shuffled, " << opt.calc_acmr(cache_size) << " optimized\n";
+
+  vector_int seen(num_triangles, 0);
+  bool ok = (opt.get_num_triangles() == num_triangles);
+  for (i = 0; i < opt.get_num_triangles() && ok; ++i) {
+    int n = opt.get_triangle_index(i);
+    int t = order[n];
+    ++seen[n];
+    if (seen[n] != 1 ||
+        opt.get_triangle_v0(i) != grid[t * 3] ||
+        opt.get_triangle_v1(i) != grid[t * 3 + 1] ||
+        opt.get_triangle_v2(i) != grid[t * 3 + 2]) {
+      cerr << "*** triangle " << i << " is wrong\n";
+      ok = false;
+    }
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+// Filename: vertexCacheOptimizer.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "vertexCacheOptimizer.h"
+
+#include <math.h>
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::Constructor
+//       Access: Published
+//  Description:
+////////////////////////////////////////////////////////////////////
+VertexCacheOptimizer::
+VertexCacheOptimizer() {
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::clear
+//       Access: Published
+//  Description: Removes all triangles, in preparation for a new
+//               mesh.
+////////////////////////////////////////////////////////////////////
+void VertexCacheOptimizer::
+clear() {
+  _vertices.clear();
+  _indices.clear();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::add_triangle
+//       Access: Published
+//  Description: Adds the next triangle of the mesh, by the indices of
+//               its three vertices.  The vertex indices should be
+//               reasonably compact, since the optimizer allocates
+//               tables as large as the largest index.
+////////////////////////////////////////////////////////////////////
+void VertexCacheOptimizer::
+add_triangle(int v0, int v1, int v2) {
+  nassertv(v0 >= 0 && v1 >= 0 && v2 >= 0);
+  _indices.push_back((int)_indices.size());
+  _vertices.push_back(v0);
+  _vertices.push_back(v1);
+  _vertices.push_back(v2);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::optimize
+//       Access: Published
+//  Description: Reorders the triangles added so far for good use of
+//               the vertex cache.  Afterwards, get_triangle_v0() and
+//               friends return the triangles in the new order.
+////////////////////////////////////////////////////////////////////
+void VertexCacheOptimizer::
+optimize() {
+  int num_triangles = (int)_indices.size();
+  if (num_triangles < 2) {
+    return;
+  }
+  int num_vertices = get_num_vertices();
+
+  // Build the list of triangles that use each vertex.  The triangles
+  // of vertex v are stored in tri_list, beginning at tri_start[v];
+  // the first num_active[v] of them haven't been drawn yet.
+  vector_int num_active(num_vertices, 0);
+  int i;
+  for (i = 0; i < num_triangles * 3; ++i) {
+    ++num_active[_vertices[i]];
+  }
+  vector_int tri_start(num_vertices + 1, 0);
+  int v;
+  for (v = 0; v < num_vertices; ++v) {
+    tri_start[v + 1] = tri_start[v] + num_active[v];
+    num_active[v] = 0;
+  }
+  vector_int tri_list(num_triangles * 3);
+  for (i = 0; i < num_triangles * 3; ++i) {
+    v = _vertices[i];
+    tri_list[tri_start[v] + num_active[v]] = i / 3;
+    ++num_active[v];
+  }
+
+  vector_int cache_pos(num_vertices, -1);
+  pvector<float> vertex_score(num_vertices);
+  for (v = 0; v < num_vertices; ++v) {
+    vertex_score[v] = calc_vertex_score(-1, num_active[v]);
+  }
+
+  pvector<float> tri_score(num_triangles);
+  pvector<bool> tri_added(num_triangles, false);
+  int best = 0;
+  int t;
+  for (t = 0; t < num_triangles; ++t) {
+    tri_score[t] = vertex_score[_vertices[t * 3]] +
+      vertex_score[_vertices[t * 3 + 1]] +
+      vertex_score[_vertices[t * 3 + 2]];
+    if (tri_score[t] > tri_score[best]) {
+      best = t;
+    }
+  }
+
+  vector_int cache, new_cache;
+  cache.reserve(max_cache_size + 3);
+  new_cache.reserve(max_cache_size + 3);
+
+  vector_int new_vertices;
+  vector_int new_indices;
+  new_vertices.reserve(num_triangles * 3);
+  new_indices.reserve(num_triangles);
+
+  int next_unadded = 0;
+  while ((int)new_indices.size() < num_triangles) {
+    if (best < 0) {
+      // Nothing in the cache has any triangles left; start again with
+      // the next triangle in the original order.
+      while (tri_added[next_unadded]) {
+        ++next_unadded;
+      }
+      best = next_unadded;
+    }
+
+    // Draw the best triangle.
+    tri_added[best] = true;
+    new_indices.push_back(_indices[best]);
+    new_cache.clear();
+    for (i = 0; i < 3; ++i) {
+      v = _vertices[best * 3 + i];
+      new_vertices.push_back(v);
+
+      // Remove it from the vertex's list of remaining triangles.
+      int *begin = &tri_list[tri_start[v]];
+      int *end = begin + num_active[v];
+      int *p = begin;
+      while (p < end && *p != best) {
+        ++p;
+      }
+      nassertv(p < end);
+      *p = *(end - 1);
+      *(end - 1) = best;
+      --num_active[v];
+
+      if (find(new_cache.begin(), new_cache.end(), v) == new_cache.end()) {
+        new_cache.push_back(v);
+      }
+    }
+
+    // Its vertices move to the front of the cache.
+    vector_int::const_iterator ci;
+    for (ci = cache.begin(); ci != cache.end(); ++ci) {
+      if (find(new_cache.begin(), new_cache.end(), *ci) == new_cache.end()) {
+        new_cache.push_back(*ci);
+      }
+    }
+    cache.swap(new_cache);
+
+    // Rescore the vertices that moved, including those that fell out
+    // of the cache, and then the triangles that still use them.
+    int num_cache = (int)cache.size();
+    for (i = 0; i < num_cache; ++i) {
+      v = cache[i];
+      cache_pos[v] = (i < max_cache_size) ? i : -1;
+      vertex_score[v] = calc_vertex_score(cache_pos[v], num_active[v]);
+    }
+
+    best = -1;
+    float best_score = -1.0f;
+    for (i = 0; i < num_cache; ++i) {
+      v = cache[i];
+      const int *begin = &tri_list[tri_start[v]];
+      const int *end = begin + num_active[v];
+      for (const int *p = begin; p < end; ++p) {
+        t = *p;
+        float score = vertex_score[_vertices[t * 3]] +
+          vertex_score[_vertices[t * 3 + 1]] +
+          vertex_score[_vertices[t * 3 + 2]];
+        tri_score[t] = score;
+        if (i < max_cache_size && score > best_score) {
+          best = t;
+          best_score = score;
+        }
+      }
+    }
+
+    if (num_cache > max_cache_size) {
+      cache.resize(max_cache_size);
+    }
+  }
+
+  _vertices.swap(new_vertices);
+  _indices.swap(new_indices);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::count_cache_misses
+//       Access: Published
+//  Description: Returns the number of times a vertex would have to be
+//               transformed to draw the triangles, in their current
+//               order, through a FIFO vertex cache of the indicated
+//               size.  Most hardware caches behave like this.
+////////////////////////////////////////////////////////////////////
+int VertexCacheOptimizer::
+count_cache_misses(int cache_size) const {
+  nassertr(cache_size > 0, 0);
+
+  // Each vertex records the miss count at which it last went into the
+  // cache; it is still there if fewer than cache_size vertices have
+  // gone in since.
+  vector_int stamp(get_num_vertices(), -1);
+  int misses = 0;
+  vector_int::const_iterator vi;
+  for (vi = _vertices.begin(); vi != _vertices.end(); ++vi) {
+    int &s = stamp[*vi];
+    if (s < 0 || misses - s > cache_size) {
+      s = misses;
+      ++misses;
+    }
+  }
+  return misses;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::calc_acmr
+//       Access: Published
+//  Description: Returns the average cache miss ratio of the triangles
+//               in their current order: the number of vertices
+//               transformed per triangle drawn, with a FIFO cache of
+//               the indicated size.  This ranges from 3.0, for no
+//               vertex reuse at all, down to about 0.5 for a large,
+//               well-ordered regular mesh.
+////////////////////////////////////////////////////////////////////
+float VertexCacheOptimizer::
+calc_acmr(int cache_size) const {
+  if (_indices.empty()) {
+    return 0.0f;
+  }
+  return (float)count_cache_misses(cache_size) / (float)_indices.size();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::get_num_vertices
+//       Access: Private
+//  Description: Returns one more than the largest vertex index used
+//               by any triangle.
+////////////////////////////////////////////////////////////////////
+int VertexCacheOptimizer::
+get_num_vertices() const {
+  int num_vertices = 0;
+  vector_int::const_iterator vi;
+  for (vi = _vertices.begin(); vi != _vertices.end(); ++vi) {
+    num_vertices = max(num_vertices, (*vi) + 1);
+  }
+  return num_vertices;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: VertexCacheOptimizer::calc_vertex_score
+//       Access: Private, Static
+//  Description: Returns the desirability of drawing a triangle that
+//               uses a vertex at the indicated position in the cache
+//               (or -1 if it is not in the cache), which is still
+//               used by the indicated number of triangles yet to be
+//               drawn.  The score of a triangle is the sum of the
+//               scores of its vertices.
+////////////////////////////////////////////////////////////////////
+float VertexCacheOptimizer::
+calc_vertex_score(int cache_pos, int num_remaining) {
+  if (num_remaining == 0) {
+    // No triangles left to draw; the vertex doesn't matter.
+    return -1.0f;
+  }
+
+  float score = 0.0f;
+  if (cache_pos >= 0) {
+    if (cache_pos < 3) {
+      // The vertices of the last triangle get a fixed, slightly lower
+      // score, so that we don't favor drawing long thin strips.
+      score = 0.75f;
+    } else {
+      float scale = 1.0f - (float)(cache_pos - 3) / (float)(max_cache_size - 3);
+      score = powf(scale, 1.5f);
+    }
+  }
+
+  // Favor vertices with few triangles left, so that we don't leave
+  // lone triangles behind to be picked up later.
+  score += 2.0f * powf((float)num_remaining, -0.5f);
+  return score;
+}
@@ -0,0 +1,77 @@
+// Filename: vertexCacheOptimizer.h
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef VERTEXCACHEOPTIMIZER_H
+#define VERTEXCACHEOPTIMIZER_H
+
+#include "pandabase.h"
+#include "vector_int.h"
+#include "pnotify.h"
+
+////////////////////////////////////////////////////////////////////
+//       Class : VertexCacheOptimizer
+// Description : This class reorders a list of indexed triangles so
+//               that the graphics hardware's post-transform vertex
+//               cache is used well: triangles that share vertices are
+//               drawn close together, so that each vertex needs to be
+//               transformed as few times as possible.  It is adapted
+//               from the algorithm published as:
+//
+//               Tom Forsyth, Linear-Speed Vertex Cache Optimisation,
+//               2006.
+//
+//               http://home.comcast.net/~tom_forsyth/papers/fast_vert_cache_opt.html
+//
+//               It doesn't need to know the size of the actual cache;
+//               the ordering it produces works well with any cache
+//               that isn't too much larger than max_cache_size.
+//               The winding order of each triangle is preserved.
+////////////////////////////////////////////////////////////////////
+class EXPCL_PANDA_MATHUTIL VertexCacheOptimizer {
+PUBLISHED:
+  VertexCacheOptimizer();
+
+  enum {
+    // The size of the LRU cache the triangles are scored against.
+    max_cache_size = 32,
+  };
+
+  void clear();
+  void add_triangle(int v0, int v1, int v2);
+
+  void optimize();
+
+  INLINE int get_num_triangles() const;
+  INLINE int get_triangle_v0(int n) const;
+  INLINE int get_triangle_v1(int n) const;
+  INLINE int get_triangle_v2(int n) const;
+  INLINE int get_triangle_index(int n) const;
+
+  int count_cache_misses(int cache_size) const;
+  float calc_acmr(int cache_size) const;
+
+private:
+  int get_num_vertices() const;
+  static float calc_vertex_score(int cache_pos, int num_remaining);
+
+  // Three vertex indices for each triangle, in the current order.
+  vector_int _vertices;
+
+  // The order in which each triangle was added.
+  vector_int _indices;
+};
+
+#include "vertexCacheOptimizer.I"
+
+#endif
@@ -31,6 +31,7 @@
     colorWriteAttrib.I colorWriteAttrib.h \
     compassEffect.I compassEffect.h \
     config_pgraph.h \
+    cullArena.I cullArena.h \
     cullBin.I cullBin.h \
     cullBinEnums.h \
     cullBinAttrib.I cullBinAttrib.h \
@@ -131,6 +132,7 @@
     colorWriteAttrib.cxx \
     compassEffect.cxx \
     config_pgraph.cxx \
+    cullArena.cxx \
     cullBin.cxx \
     cullBinAttrib.cxx \
     cullBinManager.cxx \
@@ -227,6 +229,7 @@
     colorWriteAttrib.I colorWriteAttrib.h \
     compassEffect.I compassEffect.h \
     config_pgraph.h \
+    cullArena.I cullArena.h \
     cullBin.I cullBin.h \
     cullBinEnums.h \
     cullBinAttrib.I cullBinAttrib.h \
@@ -329,3 +332,14 @@
   #define OTHER_LIBS $[OTHER_LIBS] pystub
 
 #end test_bin_target
+
+#begin test_bin_target
+  #define TARGET test_flatten
+
+  #define SOURCES \
+    test_flatten.cxx
+
+  #define LOCAL_LIBS $[LOCAL_LIBS] pgraph
+  #define OTHER_LIBS $[OTHER_LIBS] pystub
+
+#end test_bin_target
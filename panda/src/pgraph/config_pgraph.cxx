@@ -292,6 +292,19 @@ ConfigVariableBool flatten_geoms
           "only the NodePath interfaces; you may still make the lower-level "
           "SceneGraphReducer calls directly."));
 
+ConfigVariableInt flatten_threads
+("flatten-threads", 0,
+ PRC_DESC("Specifies the default number of threads, counting the calling "
+          "thread, that a SceneGraphReducer may use for flatten(), "
+          "collect_vertex_data() and unify().  Each child of the root "
+          "node is given to one thread, which handles everything below "
+          "it; whatever involves the root itself, such as combining its "
+          "children, is done afterwards in the calling thread.  There "
+          "is no check for instancing: if a node is reachable from two "
+          "children of the root, two threads may modify it at once, so "
+          "leave this at 0 for scene graphs that instance nodes across "
+          "the root's children."));
+
 ConfigVariableInt max_lenses
 ("max-lenses", 100,
  PRC_DESC("Specifies an upper limit on the maximum number of lenses "
@@ -301,6 +314,20 @@ ConfigVariableInt max_lenses
           "this can be used as a simple sanity check.  Set it larger or "
           "smaller to suit your needs."));
 
+ConfigVariableInt cull_arena_block_size
+("cull-arena-block-size", 65536,
+ PRC_DESC("The size in bytes of each block of memory from which the "
+          "CullableObjects of each frame's cull traversal are allocated.  "
+          "These blocks are given back all at once when the frame has "
+          "been drawn."));
+
+ConfigVariableInt cull_arena_max_free_blocks
+("cull-arena-max-free-blocks", 64,
+ PRC_DESC("The maximum number of unused cull-arena-block-size blocks to "
+          "keep around for future frames.  Blocks beyond this are freed, "
+          "so that a single unusually busy frame doesn't hold on to "
+          "memory indefinitely."));
+
 ConfigVariableBool polylight_info
 ("polylight-info", false,
  PRC_DESC("Set this true to view some info statements regarding the polylight. "
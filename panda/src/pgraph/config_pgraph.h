@@ -56,7 +56,10 @@ extern ConfigVariableInt max_collect_indices;
 extern EXPCL_PANDA_PGRAPH ConfigVariableBool premunge_data;
 extern ConfigVariableBool preserve_geom_nodes;
 extern ConfigVariableBool flatten_geoms;
+extern EXPCL_PANDA_PGRAPH ConfigVariableInt flatten_threads;
 extern EXPCL_PANDA_PGRAPH ConfigVariableInt max_lenses;
+extern ConfigVariableInt cull_arena_block_size;
+extern ConfigVariableInt cull_arena_max_free_blocks;
 
 extern ConfigVariableBool polylight_info;
 extern ConfigVariableDouble lod_fade_time;
@@ -0,0 +1,149 @@
+// Filename: cullArena.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "cullArena.h"
+#include "config_pgraph.h"
+#include "lightMutexHolder.h"
+
+LightMutex CullArena::_free_lock;
+CullArena::Block *CullArena::_free_blocks = NULL;
+int CullArena::_num_free_blocks = 0;
+
+PStatCollector CullArena::_bytes_pcollector("Cull arena");
+
+////////////////////////////////////////////////////////////////////
+//     Function: CullArena::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+CullArena::
+CullArena() :
+  _blocks(NULL),
+  _next_byte(NULL),
+  _end(NULL),
+  _prev_bytes_used(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CullArena::Destructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+CullArena::
+~CullArena() {
+  release_blocks(_blocks);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CullArena::reset
+//       Access: Public
+//  Description: Gives back all of the memory handed out by
+//               allocate().  Any objects constructed in it must
+//               already have been destructed.
+////////////////////////////////////////////////////////////////////
+void CullArena::
+reset() {
+  release_blocks(_blocks);
+  _blocks = NULL;
+  _next_byte = NULL;
+  _end = NULL;
+  _prev_bytes_used = 0;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CullArena::alloc_block
+//       Access: Private
+//  Description: The slow path of allocate(): starts a new block, big
+//               enough for at least size bytes, and returns the first
+//               size bytes of it.
+////////////////////////////////////////////////////////////////////
+void *CullArena::
+alloc_block(size_t size) {
+  if (_blocks != (Block *)NULL) {
+    _prev_bytes_used += (size_t)(_next_byte - ((char *)_blocks + get_block_header_size()));
+  }
+
+  Block *block = get_free_block(size);
+  block->_next = _blocks;
+  _blocks = block;
+
+  _next_byte = (char *)block + get_block_header_size();
+  _end = (char *)block + block->_size;
+
+  void *ptr = _next_byte;
+  _next_byte += size;
+  return ptr;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CullArena::get_free_block
+//       Access: Private, Static
+//  Description: Returns a block with room for at least size bytes,
+//               from the global pool if possible.
+////////////////////////////////////////////////////////////////////
+CullArena::Block *CullArena::
+get_free_block(size_t size) {
+  size_t block_size = max((size_t)cull_arena_block_size, (size_t)1024);
+  size_t want_size = size + get_block_header_size();
+
+  if (want_size <= block_size) {
+    LightMutexHolder holder(_free_lock);
+    if (_free_blocks != (Block *)NULL) {
+      Block *block = _free_blocks;
+      _free_blocks = block->_next;
+      --_num_free_blocks;
+      return block;
+    }
+  } else {
+    // This is too big for an ordinary block; it gets one of its own,
+    // which won't go back in the pool.
+    block_size = want_size;
+  }
+
+  Block *block = (Block *)PANDA_MALLOC_ARRAY(block_size);
+  block->_next = NULL;
+  block->_size = block_size;
+  return block;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: CullArena::release_blocks
+//       Access: Private, Static
+//  Description: Returns the indicated list of blocks to the global
+//               pool, or frees them if the pool is full or they are
+//               not the ordinary size.
+////////////////////////////////////////////////////////////////////
+void CullArena::
+release_blocks(CullArena::Block *blocks) {
+  size_t block_size = max((size_t)cull_arena_block_size, (size_t)1024);
+  int max_free_blocks = cull_arena_max_free_blocks;
+
+  while (blocks != (Block *)NULL) {
+    Block *block = blocks;
+    blocks = block->_next;
+
+    if (block->_size == block_size) {
+      LightMutexHolder holder(_free_lock);
+      if (_num_free_blocks < max_free_blocks) {
+        block->_next = _free_blocks;
+        _free_blocks = block;
+        ++_num_free_blocks;
+        continue;
+      }
+    }
+
+    PANDA_FREE_ARRAY(block);
+  }
+}
@@ -0,0 +1,85 @@
+// Filename: cullArena.h
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef CULLARENA_H
+#define CULLARENA_H
+
+#include "pandabase.h"
+#include "lightMutex.h"
+#include "pStatCollector.h"
+
+////////////////////////////////////////////////////////////////////
+//       Class : CullArena
+// Description : A simple bump allocator for the short-lived objects
+//               created by one frame's cull traversal, such as
+//               CullableObjects.  Each CullResult owns one, which is
+//               only used by the thread that fills that CullResult.
+//
+//               Memory handed out by the arena is not freed
+//               individually; it is all given back at once when the
+//               arena is reset or destroyed, which happens when its
+//               CullResult is finished with.  The objects themselves
+//               must still be destructed before then.  The arena's
+//               blocks are kept in a global pool for the next frame's
+//               arenas.
+////////////////////////////////////////////////////////////////////
+class EXPCL_PANDA_PGRAPH CullArena {
+public:
+  CullArena();
+  ~CullArena();
+
+  INLINE void *allocate(size_t size);
+  void reset();
+
+  INLINE size_t get_bytes_used() const;
+  INLINE void report_bytes_used() const;
+
+  INLINE static void flush_level();
+
+private:
+  void *alloc_block(size_t size);
+
+  // Each block of memory begins with one of these.  The allocations
+  // are made from the space following it.
+  class Block {
+  public:
+    Block *_next;
+    size_t _size;
+  };
+
+  static INLINE size_t get_block_header_size();
+  static INLINE size_t align_size(size_t size);
+
+  static Block *get_free_block(size_t size);
+  static void release_blocks(Block *blocks);
+
+  // The blocks used so far, most recent first.  Allocations are made
+  // from _next_byte up to _end in the first block.
+  Block *_blocks;
+  char *_next_byte;
+  char *_end;
+
+  // The bytes handed out from all the blocks except the first.
+  size_t _prev_bytes_used;
+
+  static LightMutex _free_lock;
+  static Block *_free_blocks;
+  static int _num_free_blocks;
+
+  static PStatCollector _bytes_pcollector;
+};
+
+#include "cullArena.I"
+
+#endif
@@ -25,7 +25,9 @@
 //  Description: 
 ////////////////////////////////////////////////////////////////////
 CullHandler::
-CullHandler() {
+CullHandler() :
+  _arena(NULL)
+{
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -37,9 +37,17 @@ public:
                              const CullTraverser *traverser);
   virtual void end_traverse();
 
+  INLINE CullArena *get_arena() const;
+
   INLINE static void draw(CullableObject *object,
                           GraphicsStateGuardianBase *gsg,
                           bool force, Thread *current_thread);
+
+protected:
+  // If this is not NULL, the CullTraverser allocates the
+  // CullableObjects it passes to record_object() from here.  The
+  // handler must then keep each object no longer than the arena.
+  CullArena *_arena;
 };
 
 #include "cullHandler.I"
@@ -172,7 +172,7 @@ add_object(CullableObject *object, const CullTraverser *traverser) {
           if (m_dual_transparent) 
 #endif
             {
-              CullableObject *transparent_part = new CullableObject(*object);
+              CullableObject *transparent_part = new(&_arena) CullableObject(*object);
               CPT(RenderState) transparent_state = object->has_decals() ? 
                 get_dual_transparent_state_decals() : 
                 get_dual_transparent_state();
@@ -254,6 +254,8 @@ finish_cull(SceneSetup *scene_setup, Thread *current_thread) {
       }
     }
   }
+
+  _arena.report_bytes_used();
 }
 
 ////////////////////////////////////////////////////////////////////
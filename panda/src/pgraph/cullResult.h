@@ -19,6 +19,7 @@
 #include "cullBin.h"
 #include "renderState.h"
 #include "cullableObject.h"
+#include "cullArena.h"
 #include "geomMunger.h"
 #include "referenceCount.h"
 #include "pointerTo.h"
@@ -62,6 +63,8 @@ PUBLISHED:
   PT(PandaNode) make_result_graph();
 
 public:
+  INLINE CullArena *get_arena();
+
   static void bin_removed(int bin_index);
 
 private:
@@ -78,6 +81,11 @@ private:
   GraphicsStateGuardianBase *_gsg;
   PStatCollector _draw_region_pcollector;
   
+  // The CullableObjects in the bins are allocated from here.  It is
+  // declared before _bins so that the bins, and the objects in them,
+  // are destroyed first.
+  CullArena _arena;
+
   typedef pvector< PT(CullBin) > Bins;
   Bins _bins;
 };
@@ -318,14 +318,14 @@ draw_bounding_volume(const BoundingVolume *vol,
   
   if (bounds_viz != (Geom *)NULL) {
     _geoms_pcollector.add_level(2);
-    CullableObject *outer_viz = 
-      new CullableObject(bounds_viz, get_bounds_outer_viz_state(), 
-                         net_transform, modelview_transform, get_gsg());
+    CullableObject *outer_viz = new(_cull_handler->get_arena())
+      CullableObject(bounds_viz, get_bounds_outer_viz_state(), 
+                     net_transform, modelview_transform, get_gsg());
     _cull_handler->record_object(outer_viz, this);
     
-    CullableObject *inner_viz = 
-      new CullableObject(bounds_viz, get_bounds_inner_viz_state(), 
-                         net_transform, modelview_transform, get_gsg());
+    CullableObject *inner_viz = new(_cull_handler->get_arena())
+      CullableObject(bounds_viz, get_bounds_inner_viz_state(), 
+                     net_transform, modelview_transform, get_gsg());
     _cull_handler->record_object(inner_viz, this);
   }
 }
@@ -360,10 +360,10 @@ show_bounds(CullTraverserData &data, bool tight) {
 
     if (bounds_viz != (Geom *)NULL) {
       _geoms_pcollector.add_level(1);
-      CullableObject *outer_viz = 
-        new CullableObject(bounds_viz, get_bounds_outer_viz_state(), 
-                           net_transform, modelview_transform,
-                           get_gsg());
+      CullableObject *outer_viz = new(_cull_handler->get_arena())
+        CullableObject(bounds_viz, get_bounds_outer_viz_state(), 
+                       net_transform, modelview_transform,
+                       get_gsg());
       _cull_handler->record_object(outer_viz, this);
     }
     
@@ -664,7 +664,7 @@ start_decal(const CullTraverserData &data) {
 
   // Now create a new, empty CullableObject to separate the decals
   // from the non-decals.
-  CullableObject *separator = new CullableObject;
+  CullableObject *separator = new(_cull_handler->get_arena()) CullableObject;
   separator->set_next(decals);
 
   // And now get the base Geoms, again in reverse order.
@@ -722,9 +722,9 @@ start_decal(const CullTraverserData &data) {
     }
 
     CullableObject *next = object;
-    object =
-      new CullableObject(geom, state, net_transform, 
-                         modelview_transform, internal_transform);
+    object = new(_cull_handler->get_arena())
+      CullableObject(geom, state, net_transform, 
+                     modelview_transform, internal_transform);
     object->set_next(next);
   }
 
@@ -835,9 +835,9 @@ r_get_decals(CullTraverserData &data, CullableObject *decals) {
         }
 
         CullableObject *next = decals;
-        decals =
-          new CullableObject(geom, state, net_transform, 
-                             modelview_transform, internal_transform);
+        decals = new(_cull_handler->get_arena())
+          CullableObject(geom, state, net_transform, 
+                         modelview_transform, internal_transform);
         decals->set_next(next);
       }
     }
@@ -29,6 +29,7 @@
 #include "light.h"
 #include "lightMutexHolder.h"
 #include "geomDrawCallbackData.h"
+#include "memoryHook.h"
 
 CullableObject::FormatMap CullableObject::_format_map;
 LightMutex CullableObject::_format_lock;
@@ -40,6 +41,7 @@ PStatCollector CullableObject::_munge_sprites_prims_pcollector("*:Munge:Sprites:
 PStatCollector CullableObject::_munge_light_vector_pcollector("*:Munge:Light Vector");
 PStatCollector CullableObject::_sw_sprites_pcollector("SW Sprites");
 
+DeletedBufferChain *CullableObject::_deleted_chain = NULL;
 TypeHandle CullableObject::_type_handle;
 
 ////////////////////////////////////////////////////////////////////
@@ -224,6 +226,23 @@ output(ostream &out) const {
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: CullableObject::get_deleted_chain
+//       Access: Private, Static
+//  Description: Returns the DeletedBufferChain used for the
+//               CullableObjects that are not allocated from an arena.
+////////////////////////////////////////////////////////////////////
+DeletedBufferChain *CullableObject::
+get_deleted_chain() {
+  if (_deleted_chain == (DeletedBufferChain *)NULL) {
+    // If two threads get here at once, they'll both get the same
+    // chain.
+    init_memory_hook();
+    _deleted_chain = memory_hook->get_deleted_chain(sizeof(CullableObject) + get_alloc_header_size());
+  }
+  return _deleted_chain;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: CullableObject::munge_points_to_quads
 //       Access: Private
@@ -28,6 +28,7 @@
 #include "cullTraverserData.h"
 #include "pStatCollector.h"
 #include "deletedChain.h"
+#include "cullArena.h"
 #include "graphicsStateGuardianBase.h"
 #include "lightMutex.h"
 #include "callbackObject.h"
@@ -74,7 +75,16 @@ public:
 
 public:
   ~CullableObject();
-  ALLOC_DELETED_CHAIN(CullableObject);
+
+  // CullableObjects may be allocated from a CullArena, with
+  // new(arena), or with a plain new, which uses a DeletedChain.
+  // Either way, they are freed with delete.
+  INLINE void *operator new(size_t size);
+  INLINE void *operator new(size_t size, CullArena *arena);
+  INLINE void *operator new(size_t size, void *ptr);
+  INLINE void operator delete(void *ptr);
+  INLINE void operator delete(void *ptr, CullArena *arena);
+  INLINE void operator delete(void *, void *);
 
   void output(ostream &out) const;
 
@@ -96,6 +106,17 @@ private:
   CullableObject *_next;  // for decals
 
 private:
+  // Each CullableObject is preceded in memory by one of these, which
+  // records the arena it was allocated from, if any.  It is padded
+  // out to keep the object aligned.
+  class AllocHeader {
+  public:
+    CullArena *_arena;
+  };
+  static INLINE size_t get_alloc_header_size();
+  static DeletedBufferChain *get_deleted_chain();
+  static DeletedBufferChain *_deleted_chain;
+
   INLINE void make_fancy();
   bool munge_points_to_quads(const CullTraverser *traverser, bool force);
   bool munge_texcoord_light_vector(const CullTraverser *traverser, bool force);
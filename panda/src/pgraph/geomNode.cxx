@@ -563,9 +563,9 @@ add_for_draw(CullTraverser *trav, CullTraverserData &data) {
       }
     }
     
-    CullableObject *object = 
-      new CullableObject(geom, state, net_transform, 
-                         modelview_transform, internal_transform);
+    CullableObject *object = new(trav->get_cull_handler()->get_arena())
+      CullableObject(geom, state, net_transform, 
+                     modelview_transform, internal_transform);
     trav->get_cull_handler()->record_object(object, trav);
   }
 }
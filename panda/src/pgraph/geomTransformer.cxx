@@ -1004,6 +1004,52 @@ reverse(GeomNode *node) {
   return (num_geoms != 0);
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: GeomTransformer::optimize_vertex_cache
+//       Access: Public
+//  Description: Reorders the triangles of each Geom in this GeomNode
+//               for better use of the post-transform vertex cache
+//               (see GeomPrimitive::optimize_vertex_cache()).  The
+//               vertices themselves will be reordered to match, so
+//               that they are fetched in sequence, when
+//               finish_apply() is called.
+//
+//               Returns true if any Geoms are modified, false
+//               otherwise.
+////////////////////////////////////////////////////////////////////
+bool GeomTransformer::
+optimize_vertex_cache(GeomNode *node) {
+  bool any_changed = false;
+
+  Thread *current_thread = Thread::get_current_thread();
+  OPEN_ITERATE_CURRENT_AND_UPSTREAM(node->_cycler, current_thread) {
+    GeomNode::CDStageWriter cdata(node->_cycler, pipeline_stage, current_thread);
+    GeomNode::GeomList::iterator gi;
+    PT(GeomNode::GeomList) geoms = cdata->modify_geoms();
+    for (gi = geoms->begin(); gi != geoms->end(); ++gi) {
+      GeomNode::GeomEntry &entry = (*gi);
+      PT(Geom) geom = entry._geom.get_write_pointer();
+
+      int num_primitives = geom->get_num_primitives();
+      for (int i = 0; i < num_primitives; ++i) {
+        CPT(GeomPrimitive) prim = geom->get_primitive(i);
+        CPT(GeomPrimitive) new_prim = prim->optimize_vertex_cache();
+        if (new_prim != prim) {
+          geom->set_primitive(i, new_prim);
+          any_changed = true;
+        }
+      }
+
+      VertexDataAssoc &assoc = _vdata_assoc[geom->get_vertex_data()];
+      assoc._geoms.push_back(geom);
+      assoc._reorder_vertices = true;
+    }
+  }
+  CLOSE_ITERATE_CURRENT_AND_UPSTREAM(node->_cycler);
+
+  return any_changed;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: GeomTransformer::finish_apply
 //       Access: Public
@@ -1022,6 +1068,10 @@ finish_apply() {
   for (vi = _vdata_assoc.begin(); vi != _vdata_assoc.end(); ++vi) {
     const GeomVertexData *vdata = (*vi).first;
     VertexDataAssoc &assoc = (*vi).second;
+    if (assoc._reorder_vertices && assoc.reorder_vertices(vdata)) {
+      // Reordering the vertices also removes the unused ones.
+      continue;
+    }
     if (assoc._might_have_unused) {
       assoc.remove_unused_vertices(vdata);
     }
@@ -1702,3 +1752,141 @@ remove_unused_vertices(const GeomVertexData *vdata) {
     geom->set_vertex_data(new_vdata);
   }
 }
+
+////////////////////////////////////////////////////////////////////
+//     Function: GeomTransformer::VertexDataAssoc::reorder_vertices
+//       Access: Public
+//  Description: Renumbers the vertices in the order in which the
+//               associated Geoms first reference them, so that they
+//               are fetched from memory in sequence when the Geoms
+//               are drawn.  If _might_have_unused is true, the
+//               vertices that are not referenced are removed at the
+//               same time; otherwise they are kept at the end.
+//
+//               Returns true if this was done (or was unnecessary),
+//               or false if the vertices could not be reordered,
+//               which happens when the vertex data has a
+//               TransformBlendTable or a SliderTable, since these
+//               assume their rows are grouped in ranges.
+////////////////////////////////////////////////////////////////////
+bool GeomTransformer::VertexDataAssoc::
+reorder_vertices(const GeomVertexData *vdata) {
+  if (_geoms.empty()) {
+    // Trivial case.
+    return true;
+  }
+  if (vdata->get_transform_blend_table() != (TransformBlendTable *)NULL ||
+      vdata->get_slider_table() != (SliderTable *)NULL) {
+    return false;
+  }
+
+  PT(Thread) current_thread = Thread::get_current_thread();
+
+  int num_vertices = vdata->get_num_rows();
+  vector_int old_to_new(num_vertices, -1);
+  vector_int new_to_old;
+  new_to_old.reserve(num_vertices);
+
+  bool any_referenced = false;
+  GeomList::iterator gi;
+  for (gi = _geoms.begin(); gi != _geoms.end(); ++gi) {
+    Geom *geom = (*gi);
+    if (geom->get_vertex_data() != vdata) {
+      continue;
+    }
+
+    any_referenced = true;
+    int num_primitives = geom->get_num_primitives();
+    for (int i = 0; i < num_primitives; ++i) {
+      CPT(GeomPrimitive) prim = geom->get_primitive(i);
+
+      GeomPrimitivePipelineReader reader(prim, current_thread);
+      int num_prim_vertices = reader.get_num_vertices();
+      for (int vi = 0; vi < num_prim_vertices; ++vi) {
+        int index = reader.get_vertex(vi);
+        nassertr(index >= 0 && index < num_vertices, false);
+        if (old_to_new[index] < 0) {
+          old_to_new[index] = (int)new_to_old.size();
+          new_to_old.push_back(index);
+        }
+      }
+    }
+  }
+
+  if (!any_referenced) {
+    return true;
+  }
+
+  if (!_might_have_unused) {
+    for (int index = 0; index < num_vertices; ++index) {
+      if (old_to_new[index] < 0) {
+        old_to_new[index] = (int)new_to_old.size();
+        new_to_old.push_back(index);
+      }
+    }
+  }
+
+  int new_num_vertices = (int)new_to_old.size();
+  if (new_num_vertices == num_vertices) {
+    int index = 0;
+    while (index < num_vertices && new_to_old[index] == index) {
+      ++index;
+    }
+    if (index == num_vertices) {
+      // The vertices are already in order.
+      return true;
+    }
+  }
+
+  // Copy the vertex data in the new order, one array at a time.
+  PT(GeomVertexData) new_vdata = new GeomVertexData(*vdata);
+  new_vdata->unclean_set_num_rows(new_num_vertices);
+
+  int num_arrays = vdata->get_num_arrays();
+  nassertr(num_arrays == new_vdata->get_num_arrays(), false);
+
+  GeomVertexDataPipelineReader reader(vdata, current_thread);
+  reader.check_array_readers();
+  GeomVertexDataPipelineWriter writer(new_vdata, true, current_thread);
+  writer.check_array_writers();
+
+  for (int a = 0; a < num_arrays; ++a) {
+    const GeomVertexArrayDataHandle *array_reader = reader.get_array_reader(a);
+    GeomVertexArrayDataHandle *array_writer = writer.get_array_writer(a);
+
+    int stride = array_reader->get_array_format()->get_stride();
+    nassertr(stride == array_writer->get_array_format()->get_stride(), false);
+
+    for (int new_index = 0; new_index < new_num_vertices; ++new_index) {
+      array_writer->copy_subdata_from(new_index * stride, stride,
+                                      array_reader,
+                                      new_to_old[new_index] * stride, stride);
+    }
+  }
+
+  // Finally, reindex the Geoms.
+  for (gi = _geoms.begin(); gi != _geoms.end(); ++gi) {
+    Geom *geom = (*gi);
+    if (geom->get_vertex_data() != vdata) {
+      continue;
+    }
+
+    int num_primitives = geom->get_num_primitives();
+    for (int i = 0; i < num_primitives; ++i) {
+      PT(GeomPrimitive) prim = geom->modify_primitive(i);
+      prim->make_indexed();
+      PT(GeomVertexArrayData) vertices = prim->modify_vertices();
+      GeomVertexRewriter rewriter(vertices, 0, current_thread);
+
+      while (!rewriter.is_at_end()) {
+        int index = rewriter.get_data1i();
+        nassertr(index >= 0 && index < num_vertices, false);
+        rewriter.set_data1i(old_to_new[index]);
+      }
+    }
+
+    geom->set_vertex_data(new_vdata);
+  }
+
+  return true;
+}
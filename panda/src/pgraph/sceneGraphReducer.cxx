@@ -23,6 +23,7 @@
 #include "geomNode.h"
 #include "config_gobj.h"
 #include "thread.h"
+#include "trueClock.h"
 
 PStatCollector SceneGraphReducer::_flatten_collector("*:Flatten:flatten");
 PStatCollector SceneGraphReducer::_apply_collector("*:Flatten:apply");
@@ -32,6 +33,7 @@ PStatCollector SceneGraphReducer::_collect_collector("*:Flatten:collect");
 PStatCollector SceneGraphReducer::_make_nonindexed_collector("*:Flatten:make nonindexed");
 PStatCollector SceneGraphReducer::_unify_collector("*:Flatten:unify");
 PStatCollector SceneGraphReducer::_remove_unused_collector("*:Flatten:remove unused vertices");
+PStatCollector SceneGraphReducer::_vertex_cache_collector("*:Flatten:optimize vertex cache");
 PStatCollector SceneGraphReducer::_premunge_collector("*:Premunge");
 
 ////////////////////////////////////////////////////////////////////
@@ -106,15 +108,40 @@ flatten(PandaNode *root, int combine_siblings_bits) {
   do {
     num_pass_nodes = 0;
 
-    // Get a copy of the children list, so we don't have to worry
-    // about self-modifications.
-    PandaNode::Children cr = root->get_children();
+    int num_threads = choose_num_threads(root);
+    if (num_threads > 1) {
+      // Flatten everything below each child in parallel, then finish
+      // off each child, which may involve replacing it under root,
+      // in this thread.
+      SubtreeWork work(this);
+      SubtreeJobs jobs;
+      make_subtree_jobs(root, jobs);
+      work._op = SO_flatten;
+      work._jobs = &jobs;
+      for (size_t ji = 0; ji < jobs.size(); ++ji) {
+        jobs[ji]._bits = combine_siblings_bits;
+      }
+      run_subtree_jobs(work, num_threads);
 
-    // Now visit each of the children in turn.
-    int num_children = cr.get_num_children();
-    for (int i = 0; i < num_children; i++) {
-      PT(PandaNode) child_node = cr.get_child(i);
-      num_pass_nodes += r_flatten(root, child_node, combine_siblings_bits);
+      for (size_t ji = 0; ji < jobs.size(); ++ji) {
+        const SubtreeJob &job = jobs[ji];
+        num_pass_nodes += job._result;
+        if (job._node->safe_to_flatten_below()) {
+          num_pass_nodes += flatten_finish(root, job._node, job._bits);
+        }
+      }
+
+    } else {
+      // Get a copy of the children list, so we don't have to worry
+      // about self-modifications.
+      PandaNode::Children cr = root->get_children();
+
+      // Now visit each of the children in turn.
+      int num_children = cr.get_num_children();
+      for (int i = 0; i < num_children; i++) {
+        PT(PandaNode) child_node = cr.get_child(i);
+        num_pass_nodes += r_flatten(root, child_node, combine_siblings_bits);
+      }
     }
 
     if (combine_siblings_bits != 0 && 
@@ -212,7 +239,24 @@ unify(PandaNode *root, bool preserve_order) {
   if (_gsg != (GraphicsStateGuardianBase *)NULL) {
     max_indices = min(max_indices, _gsg->get_max_vertices_per_primitive());
   }
-  r_unify(root, max_indices, preserve_order);
+
+  int num_threads = choose_num_threads(root);
+  if (num_threads > 1) {
+    if (root->is_geom_node()) {
+      DCAST(GeomNode, root)->unify(max_indices, preserve_order);
+    }
+    SubtreeWork work(this);
+    SubtreeJobs jobs;
+    make_subtree_jobs(root, jobs);
+    work._op = SO_unify;
+    work._jobs = &jobs;
+    work._max_indices = max_indices;
+    work._flag = preserve_order;
+    run_subtree_jobs(work, num_threads);
+
+  } else {
+    r_unify(root, max_indices, preserve_order);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -235,6 +279,38 @@ remove_unused_vertices(PandaNode *root) {
   Thread::consider_yield();
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::optimize_vertex_cache
+//       Access: Published
+//  Description: Reorders the triangles of every Geom at this level
+//               and below for better use of the graphics card's
+//               post-transform vertex cache, and then renumbers the
+//               vertices in the order they are first used, so that
+//               they are also fetched in sequence.  See
+//               GeomTransformer::optimize_vertex_cache().
+//
+//               Triangle strips and fans are first decomposed into
+//               triangles, unless preserve-triangle-strips is set.
+//               The triangles within each GeomPrimitive will be
+//               drawn in a different order, which may matter for
+//               transparent geometry.  It is best to call this after
+//               unify(), since that makes larger primitives.
+//
+//               Returns the number of GeomNodes modified.
+////////////////////////////////////////////////////////////////////
+int SceneGraphReducer::
+optimize_vertex_cache(PandaNode *root) {
+  nassertr(check_live_flatten(root), 0);
+  PStatTimer timer(_vertex_cache_collector);
+
+  if (!preserve_triangle_strips) {
+    r_decompose(root);
+  }
+  int count = r_optimize_vertex_cache(root, _transformer);
+  _transformer.finish_apply();
+  return count;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: SceneGraphReducer::check_live_flatten
 //       Access: Published
@@ -430,92 +506,134 @@ r_flatten(PandaNode *grandparent_node, PandaNode *parent_node,
     }
     
   } else {
-    if ((combine_siblings_bits & CS_within_radius) != 0) {
-      CPT(BoundingVolume) bv = parent_node->get_bounds();
-      if (bv->is_of_type(BoundingSphere::get_class_type())) {
-        const BoundingSphere *bs = DCAST(BoundingSphere, bv);
+    num_nodes += flatten_below(parent_node, combine_siblings_bits);
+    num_nodes += flatten_finish(grandparent_node, parent_node,
+                                combine_siblings_bits);
+  }
+
+  return num_nodes;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::flatten_below
+//       Access: Protected
+//  Description: The first half of r_flatten(): flattens everything
+//               below the indicated node, including its children
+//               among themselves when CS_recurse is set, but leaves
+//               the node itself alone.  This never touches anything
+//               above parent_node, so it may be run on disjoint
+//               subgraphs in parallel.
+//
+//               combine_siblings_bits may be adjusted on return, and
+//               should be passed to flatten_finish().
+////////////////////////////////////////////////////////////////////
+int SceneGraphReducer::
+flatten_below(PandaNode *parent_node, int &combine_siblings_bits) {
+  int num_nodes = 0;
+
+  if ((combine_siblings_bits & CS_within_radius) != 0) {
+    CPT(BoundingVolume) bv = parent_node->get_bounds();
+    if (bv->is_of_type(BoundingSphere::get_class_type())) {
+      const BoundingSphere *bs = DCAST(BoundingSphere, bv);
+      if (pgraph_cat.is_spam()) {
+        pgraph_cat.spam()
+          << "considering radius of " << *parent_node
+          << ": " << *bs << " vs. " << _combine_radius << "\n";
+      }
+      if (!bs->is_infinite() && (bs->is_empty() || bs->get_radius() <= _combine_radius)) {
+        // This node fits within the specified radius; from here on
+        // down, we will have CS_other set, instead of
+        // CS_within_radius.
         if (pgraph_cat.is_spam()) {
           pgraph_cat.spam()
-            << "considering radius of " << *parent_node
-            << ": " << *bs << " vs. " << _combine_radius << "\n";
-        }
-        if (!bs->is_infinite() && (bs->is_empty() || bs->get_radius() <= _combine_radius)) {
-          // This node fits within the specified radius; from here on
-          // down, we will have CS_other set, instead of
-          // CS_within_radius.
-          if (pgraph_cat.is_spam()) {
-            pgraph_cat.spam()
-              << "node fits within radius; flattening tighter.\n";
-          }
-          combine_siblings_bits &= ~CS_within_radius;
-          combine_siblings_bits |= (CS_geom_node | CS_other | CS_recurse);
+            << "node fits within radius; flattening tighter.\n";
         }
+        combine_siblings_bits &= ~CS_within_radius;
+        combine_siblings_bits |= (CS_geom_node | CS_other | CS_recurse);
       }
     }
+  }
 
-    // First, recurse on each of the children.
-    {
-      PandaNode::Children cr = parent_node->get_children();
-      int num_children = cr.get_num_children();
-      for (int i = 0; i < num_children; i++) {
-        PT(PandaNode) child_node = cr.get_child(i);
-        num_nodes += r_flatten(parent_node, child_node, combine_siblings_bits);
-      }
+  // First, recurse on each of the children.
+  {
+    PandaNode::Children cr = parent_node->get_children();
+    int num_children = cr.get_num_children();
+    for (int i = 0; i < num_children; i++) {
+      PT(PandaNode) child_node = cr.get_child(i);
+      num_nodes += r_flatten(parent_node, child_node, combine_siblings_bits);
     }
+  }
     
-    // Now that the above loop has removed some children, the child
-    // list saved above is no longer accurate, so hereafter we must
-    // ask the node for its real child list.
+  // Now that the above loop has removed some children, the child
+  // list saved above is no longer accurate, so hereafter we must
+  // ask the node for its real child list.
     
-    // If we have CS_recurse set, then we flatten siblings before
-    // trying to flatten children.  Otherwise, we flatten children
-    // first, and then flatten siblings, which avoids overly
-    // enthusiastic flattening.
-    if ((combine_siblings_bits & CS_recurse) != 0 && 
-        parent_node->get_num_children() >= 2 &&
-        parent_node->safe_to_combine_children()) {
-      num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
-    }
+  // If we have CS_recurse set, then we flatten siblings before
+  // trying to flatten children.  Otherwise, we flatten children
+  // first, and then flatten siblings, which avoids overly
+  // enthusiastic flattening.
+  if ((combine_siblings_bits & CS_recurse) != 0 && 
+      parent_node->get_num_children() >= 2 &&
+      parent_node->safe_to_combine_children()) {
+    num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
+  }
+
+  return num_nodes;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::flatten_finish
+//       Access: Protected
+//  Description: The second half of r_flatten(), called after
+//               flatten_below(): collapses parent_node with its only
+//               child, if it has just one (which replaces
+//               parent_node under grandparent_node), and then
+//               combines its remaining children if CS_recurse is not
+//               set.
+////////////////////////////////////////////////////////////////////
+int SceneGraphReducer::
+flatten_finish(PandaNode *grandparent_node, PandaNode *parent_node,
+               int combine_siblings_bits) {
+  int num_nodes = 0;
 
-    if (parent_node->get_num_children() == 1) {
-      // If we now have exactly one child, consider flattening the node
-      // out.
-      PT(PandaNode) child_node = parent_node->get_child(0);
-      int child_sort = parent_node->get_child_sort(0);
+  if (parent_node->get_num_children() == 1) {
+    // If we now have exactly one child, consider flattening the node
+    // out.
+    PT(PandaNode) child_node = parent_node->get_child(0);
+    int child_sort = parent_node->get_child_sort(0);
       
-      if (consider_child(grandparent_node, parent_node, child_node)) {
-        // Ok, do it.
-        parent_node->remove_child(child_node);
+    if (consider_child(grandparent_node, parent_node, child_node)) {
+      // Ok, do it.
+      parent_node->remove_child(child_node);
         
-        if (do_flatten_child(grandparent_node, parent_node, child_node)) {
-          // Done!
-          num_nodes++;
-        } else {
-          // Chicken out.
-          parent_node->add_child(child_node, child_sort);
-        }
+      if (do_flatten_child(grandparent_node, parent_node, child_node)) {
+        // Done!
+        num_nodes++;
+      } else {
+        // Chicken out.
+        parent_node->add_child(child_node, child_sort);
       }
     }
+  }
 
-    if ((combine_siblings_bits & CS_recurse) == 0 &&
-        (combine_siblings_bits & ~CS_recurse) != 0 && 
-        parent_node->get_num_children() >= 2 &&
-        parent_node->safe_to_combine_children()) {
-      num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
-    }
+  if ((combine_siblings_bits & CS_recurse) == 0 &&
+      (combine_siblings_bits & ~CS_recurse) != 0 && 
+      parent_node->get_num_children() >= 2 &&
+      parent_node->safe_to_combine_children()) {
+    num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
+  }
 
-    // Finally, if any of our remaining children are plain PandaNodes
-    // with no children, just remove them.
-    if (parent_node->safe_to_combine_children()) {
-      for (int i = parent_node->get_num_children() - 1; i >= 0; --i) {
-        PandaNode *child_node = parent_node->get_child(i);
-        if (child_node->is_exact_type(PandaNode::get_class_type()) &&
-            child_node->get_num_children() == 0 &&
-            child_node->get_transform()->is_identity() &&
-            child_node->get_effects()->is_empty()) {
-          parent_node->remove_child(child_node);
-          ++num_nodes;
-        }
+  // Finally, if any of our remaining children are plain PandaNodes
+  // with no children, just remove them.
+  if (parent_node->safe_to_combine_children()) {
+    for (int i = parent_node->get_num_children() - 1; i >= 0; --i) {
+      PandaNode *child_node = parent_node->get_child(i);
+      if (child_node->is_exact_type(PandaNode::get_class_type()) &&
+          child_node->get_num_children() == 0 &&
+          child_node->get_transform()->is_identity() &&
+          child_node->get_effects()->is_empty()) {
+        parent_node->remove_child(child_node);
+        ++num_nodes;
       }
     }
   }
@@ -856,6 +974,55 @@ r_make_compatible_state(PandaNode *node, GeomTransformer &transformer) {
   return num_changed;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::do_collect_vertex_data
+//       Access: Protected
+//  Description: The implementation of collect_vertex_data() and
+//               make_compatible_format().
+////////////////////////////////////////////////////////////////////
+int SceneGraphReducer::
+do_collect_vertex_data(PandaNode *root, int collect_bits, bool format_only) {
+  int count = 0;
+
+  // With CVD_one_node_only, every GeomNode is collected with its own
+  // GeomTransformer, so the subgraphs below root's children share
+  // nothing and may be collected in parallel with the same result.
+  // Otherwise, Geoms under different children might be collected
+  // together, and we have to walk the whole graph in one thread.
+  int num_threads = 0;
+  if ((collect_bits & CVD_one_node_only) != 0) {
+    num_threads = choose_num_threads(root);
+  }
+
+  if (num_threads > 1) {
+    if (root->is_geom_node()) {
+      GeomTransformer transformer(_transformer);
+      count += transformer.collect_vertex_data(DCAST(GeomNode, root), collect_bits, format_only);
+      count += transformer.finish_collect(format_only);
+    }
+    SubtreeWork work(this);
+    SubtreeJobs jobs;
+    make_subtree_jobs(root, jobs);
+    work._op = SO_collect;
+    work._jobs = &jobs;
+    work._flag = format_only;
+    for (size_t ji = 0; ji < jobs.size(); ++ji) {
+      jobs[ji]._bits = collect_bits;
+    }
+    run_subtree_jobs(work, num_threads);
+
+    for (size_t ji = 0; ji < jobs.size(); ++ji) {
+      count += jobs[ji]._result;
+    }
+
+  } else {
+    count += r_collect_vertex_data(root, collect_bits, _transformer, format_only);
+  }
+
+  count += _transformer.finish_collect(format_only);
+  return count;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: SceneGraphReducer::r_collect_vertex_data
 //       Access: Private
@@ -1004,6 +1171,32 @@ r_register_vertices(PandaNode *node, GeomTransformer &transformer) {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::r_optimize_vertex_cache
+//       Access: Private
+//  Description: The recursive implementation of
+//               optimize_vertex_cache().
+////////////////////////////////////////////////////////////////////
+int SceneGraphReducer::
+r_optimize_vertex_cache(PandaNode *node, GeomTransformer &transformer) {
+  int num_changed = 0;
+
+  if (node->is_geom_node()) {
+    GeomNode *geom_node = DCAST(GeomNode, node);
+    if (transformer.optimize_vertex_cache(geom_node)) {
+      ++num_changed;
+    }
+  }
+
+  PandaNode::Children children = node->get_children();
+  int num_children = children.get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    num_changed += r_optimize_vertex_cache(children.get_child(i), transformer);
+  }
+
+  return num_changed;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: SceneGraphReducer::r_decompose
 //       Access: Private
@@ -1050,3 +1243,127 @@ r_premunge(PandaNode *node, const RenderState *state) {
     r_premunge(stashed.get_stashed(i), next_state);
   }
 }
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::choose_num_threads
+//       Access: Private
+//  Description: Returns the number of threads that should be used to
+//               process the children of the indicated root node in
+//               parallel, or 0 or 1 if they should be processed in
+//               the current thread.
+////////////////////////////////////////////////////////////////////
+int SceneGraphReducer::
+choose_num_threads(PandaNode *root) const {
+  if (_num_threads <= 1 || !Thread::is_true_threads()) {
+    return 0;
+  }
+  return min(_num_threads, root->get_num_children());
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::make_subtree_jobs
+//       Access: Private
+//  Description: Fills the list with one job for each child of the
+//               indicated root node.
+////////////////////////////////////////////////////////////////////
+void SceneGraphReducer::
+make_subtree_jobs(PandaNode *root, SubtreeJobs &jobs) {
+  PandaNode::Children cr = root->get_children();
+  int num_children = cr.get_num_children();
+  jobs.reserve(num_children);
+  for (int i = 0; i < num_children; ++i) {
+    SubtreeJob job;
+    job._node = cr.get_child(i);
+    job._bits = 0;
+    job._result = 0;
+    jobs.push_back(job);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::run_subtree_jobs
+//       Access: Private
+//  Description: Performs all of the jobs in the work list, on up to
+//               the indicated number of threads, and waits for them
+//               to finish.
+////////////////////////////////////////////////////////////////////
+void SceneGraphReducer::
+run_subtree_jobs(SubtreeWork &work, int num_threads) {
+  double start = 0.0;
+  if (pgraph_cat.is_debug()) {
+    start = TrueClock::get_global_ptr()->get_short_time();
+  }
+
+  ParallelFor::run(work, (int)work._jobs->size(), num_threads);
+
+  if (pgraph_cat.is_debug()) {
+    static const char *const op_names[] = { "flatten", "collect", "unify" };
+    double elapsed = TrueClock::get_global_ptr()->get_short_time() - start;
+    pgraph_cat.debug()
+      << op_names[work._op] << ": " << work._jobs->size()
+      << " subgraphs on up to " << num_threads << " threads in "
+      << elapsed * 1000.0 << " ms\n";
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::do_subtree_job
+//       Access: Private
+//  Description: Performs the work for one child of the root.  This
+//               is called in a sub-thread, and must touch nothing
+//               outside of the job's own subgraph.
+////////////////////////////////////////////////////////////////////
+void SceneGraphReducer::
+do_subtree_job(SubtreeWork &work, SubtreeJob &job) {
+  PandaNode *node = job._node;
+
+  switch (work._op) {
+  case SO_flatten:
+    if (node->safe_to_flatten_below()) {
+      job._result = flatten_below(node, job._bits);
+    }
+    break;
+
+  case SO_collect:
+    {
+      // Each thread gets its own GeomTransformer, with the same
+      // limits as ours.
+      GeomTransformer transformer(_transformer);
+      job._result = r_collect_vertex_data(node, job._bits, transformer, work._flag);
+      job._result += transformer.finish_collect(work._flag);
+    }
+    break;
+
+  case SO_unify:
+    r_unify(node, work._max_indices, work._flag);
+    break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::SubtreeWork::Constructor
+//       Access: Public
+//  Description: 
+////////////////////////////////////////////////////////////////////
+SceneGraphReducer::SubtreeWork::
+SubtreeWork(SceneGraphReducer *reducer) :
+  _reducer(reducer),
+  _op(SO_flatten),
+  _jobs(NULL),
+  _max_indices(0),
+  _flag(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: SceneGraphReducer::SubtreeWork::do_range
+//       Access: Public, Virtual
+//  Description: Performs jobs begin through end - 1.  This is called
+//               by ParallelFor, possibly in several threads at once.
+////////////////////////////////////////////////////////////////////
+void SceneGraphReducer::SubtreeWork::
+do_range(int begin, int end) {
+  for (int ji = begin; ji < end; ++ji) {
+    _reducer->do_subtree_job(*this, (*_jobs)[ji]);
+  }
+}
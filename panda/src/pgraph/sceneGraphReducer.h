@@ -16,6 +16,7 @@
 #define SCENEGRAPHREDUCER_H
 
 #include "pandabase.h"
+#include "config_pgraph.h"
 #include "transformState.h"
 #include "renderAttrib.h"
 #include "renderState.h"
@@ -26,6 +27,9 @@
 #include "typedObject.h"
 #include "pointerTo.h"
 #include "graphicsStateGuardianBase.h"
+#include "thread.h"
+#include "parallelFor.h"
+#include "pvector.h"
 
 class PandaNode;
 
@@ -127,6 +131,9 @@ PUBLISHED:
   INLINE void set_combine_radius(float combine_radius);
   INLINE float get_combine_radius() const;
 
+  INLINE void set_num_threads(int num_threads);
+  INLINE int get_num_threads() const;
+
   INLINE void apply_attribs(PandaNode *node, int attrib_types = ~(TT_clip_plane | TT_cull_face | TT_apply_texture_color));
   INLINE void apply_attribs(PandaNode *node, const AccumulatedAttribs &attribs,
                             int attrib_types, GeomTransformer &transformer);
@@ -144,6 +151,7 @@ PUBLISHED:
   INLINE int make_nonindexed(PandaNode *root, int nonindexed_bits = ~0);
   void unify(PandaNode *root, bool preserve_order);
   void remove_unused_vertices(PandaNode *root);
+  int optimize_vertex_cache(PandaNode *root);
 
   INLINE void premunge(PandaNode *root, const RenderState *initial_state);
   bool check_live_flatten(PandaNode *node);
@@ -154,6 +162,9 @@ protected:
 
   int r_flatten(PandaNode *grandparent_node, PandaNode *parent_node,
                 int combine_siblings_bits);
+  int flatten_below(PandaNode *parent_node, int &combine_siblings_bits);
+  int flatten_finish(PandaNode *grandparent_node, PandaNode *parent_node,
+                     int combine_siblings_bits);
   int flatten_siblings(PandaNode *parent_node,
                        int combine_siblings_bits);
 
@@ -178,18 +189,57 @@ protected:
 
   int r_make_compatible_state(PandaNode *node, GeomTransformer &transformer);
 
+  int do_collect_vertex_data(PandaNode *root, int collect_bits,
+                             bool format_only);
   int r_collect_vertex_data(PandaNode *node, int collect_bits,
                             GeomTransformer &transformer, bool format_only);
   int r_make_nonindexed(PandaNode *node, int collect_bits);
   void r_unify(PandaNode *node, int max_indices, bool preserve_order);
   void r_register_vertices(PandaNode *node, GeomTransformer &transformer);
   void r_decompose(PandaNode *node);
+  int r_optimize_vertex_cache(PandaNode *node, GeomTransformer &transformer);
 
   void r_premunge(PandaNode *node, const RenderState *state);
 
 private:
+  // These support running flatten(), collect_vertex_data() and
+  // unify() on each child of the root in a separate thread.  Each
+  // child's subgraph is handled entirely by one thread; anything that
+  // touches the root itself is done afterwards in the calling thread.
+  enum SubtreeOp {
+    SO_flatten,
+    SO_collect,
+    SO_unify
+  };
+
+  class SubtreeJob {
+  public:
+    PT(PandaNode) _node;
+    int _bits;
+    int _result;
+  };
+  typedef pvector<SubtreeJob> SubtreeJobs;
+
+  class SubtreeWork : public ParallelFor::Body {
+  public:
+    SubtreeWork(SceneGraphReducer *reducer);
+    virtual void do_range(int begin, int end);
+
+    SceneGraphReducer *_reducer;
+    SubtreeOp _op;
+    SubtreeJobs *_jobs;
+    int _max_indices;
+    bool _flag;
+  };
+
+  int choose_num_threads(PandaNode *root) const;
+  void make_subtree_jobs(PandaNode *root, SubtreeJobs &jobs);
+  void run_subtree_jobs(SubtreeWork &work, int num_threads);
+  void do_subtree_job(SubtreeWork &work, SubtreeJob &job);
+
   PT(GraphicsStateGuardianBase) _gsg;
   float _combine_radius;
+  int _num_threads;
   GeomTransformer _transformer;
 
   static PStatCollector _flatten_collector;
@@ -200,6 +250,7 @@ private:
   static PStatCollector _make_nonindexed_collector;
   static PStatCollector _unify_collector;
   static PStatCollector _remove_unused_collector;
+  static PStatCollector _vertex_cache_collector;
   static PStatCollector _premunge_collector;
 };
 
@@ -0,0 +1,171 @@
+// Filename: test_flatten.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pandaNode.h"
+#include "nodePath.h"
+#include "geomNode.h"
+#include "geom.h"
+#include "geomTriangles.h"
+#include "geomVertexData.h"
+#include "geomVertexWriter.h"
+#include "sceneGraphReducer.h"
+#include "loader.h"
+#include "trueClock.h"
+#include "config_pgraph.h"
+
+// This program times a flatten_strong()-style flatten of a street,
+// with the SceneGraphReducer using different numbers of threads.
+// Each child of the root (normally one vis group each) is flattened
+// independently.
+//
+// Usage: test_flatten [street.bam] [max_threads]
+//
+// If no model is named, a synthetic street is built instead.  The
+// thread counts tried are 1, 2, 4, ... up to max_threads (default 4).
+
+// The synthetic street has this many vis groups, each with this many
+// small props, each made of a few quads.
+static const int num_vis_groups = 40;
+static const int num_props = 150;
+static const int num_quads = 6;
+
+static PT(GeomNode)
+make_prop(const string &name, int seed) {
+  PT(GeomVertexData) vdata = new GeomVertexData
+    (name, GeomVertexFormat::get_v3n3t2(), Geom::UH_static);
+  GeomVertexWriter vertex(vdata, InternalName::get_vertex());
+  GeomVertexWriter normal(vdata, InternalName::get_normal());
+  GeomVertexWriter texcoord(vdata, InternalName::get_texcoord());
+  PT(GeomTriangles) tris = new GeomTriangles(Geom::UH_static);
+
+  for (int q = 0; q < num_quads; ++q) {
+    float z = (float)q + (float)(seed % 7) * 0.1f;
+    int base = q * 4;
+    vertex.add_data3f(0.0f, 0.0f, z);
+    vertex.add_data3f(1.0f, 0.0f, z);
+    vertex.add_data3f(1.0f, 0.0f, z + 1.0f);
+    vertex.add_data3f(0.0f, 0.0f, z + 1.0f);
+    for (int v = 0; v < 4; ++v) {
+      normal.add_data3f(0.0f, -1.0f, 0.0f);
+    }
+    texcoord.add_data2f(0.0f, 0.0f);
+    texcoord.add_data2f(1.0f, 0.0f);
+    texcoord.add_data2f(1.0f, 1.0f);
+    texcoord.add_data2f(0.0f, 1.0f);
+    tris->add_vertices(base, base + 1, base + 2);
+    tris->close_primitive();
+    tris->add_vertices(base, base + 2, base + 3);
+    tris->close_primitive();
+  }
+
+  PT(Geom) geom = new Geom(vdata);
+  geom->add_primitive(tris);
+  PT(GeomNode) geom_node = new GeomNode(name);
+  geom_node->add_geom(geom);
+  return geom_node;
+}
+
+static NodePath
+make_synthetic_street() {
+  NodePath street("street");
+  for (int g = 0; g < num_vis_groups; ++g) {
+    ostringstream gstrm;
+    gstrm << "vis_group_" << g;
+    NodePath vis_group = street.attach_new_node(gstrm.str());
+    for (int p = 0; p < num_props; ++p) {
+      ostringstream pstrm;
+      pstrm << "prop_" << p;
+      NodePath prop = vis_group.attach_new_node(pstrm.str());
+      prop.set_pos((float)g * 100.0f + (float)p, (float)(p % 10), 0.0f);
+      prop.set_h((float)(p * 37 % 360));
+      prop.attach_new_node(make_prop("geom", g * num_props + p));
+    }
+  }
+  return street;
+}
+
+static int
+count_nodes(PandaNode *node) {
+  int count = 1;
+  int num_children = node->get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    count += count_nodes(node->get_child(i));
+  }
+  return count;
+}
+
+static void
+run_flatten(const NodePath &street, int num_threads) {
+  NodePath copy = street.copy_to(NodePath());
+  PandaNode *root = copy.node();
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double start = clock->get_short_time();
+
+  SceneGraphReducer gr;
+  gr.set_num_threads(num_threads);
+  gr.apply_attribs(root);
+  double t_apply = clock->get_short_time();
+
+  gr.flatten(root, ~0);
+  double t_flatten = clock->get_short_time();
+
+  gr.make_compatible_state(root);
+  gr.collect_vertex_data(root, ~(SceneGraphReducer::CVD_format | SceneGraphReducer::CVD_name | SceneGraphReducer::CVD_animation_type));
+  double t_collect = clock->get_short_time();
+
+  gr.unify(root, false);
+  double t_unify = clock->get_short_time();
+
+  nout << num_threads << " threads: "
+       << "apply " << (t_apply - start) * 1000.0 << " ms, "
+       << "flatten " << (t_flatten - t_apply) * 1000.0 << " ms, "
+       << "collect " << (t_collect - t_flatten) * 1000.0 << " ms, "
+       << "unify " << (t_unify - t_collect) * 1000.0 << " ms, "
+       << "total " << (t_unify - start) * 1000.0 << " ms; "
+       << count_nodes(root) << " nodes remain\n";
+}
+
+int
+main(int argc, char *argv[]) {
+  NodePath street;
+  if (argc > 1) {
+    PT(PandaNode) model = Loader::get_global_ptr()->load_sync
+      (Filename::from_os_specific(argv[1]));
+    if (model == (PandaNode *)NULL) {
+      nout << "Unable to load " << argv[1] << "\n";
+      return 1;
+    }
+    street = NodePath(model);
+  } else {
+    street = make_synthetic_street();
+  }
+
+  int max_threads = 4;
+  if (argc > 2) {
+    max_threads = atoi(argv[2]);
+  }
+
+  nout << street.get_num_children() << " subgraphs, "
+       << count_nodes(street.node()) << " nodes\n";
+  if (!Thread::is_true_threads()) {
+    nout << "Panda was not compiled with true threads; all runs will be serial.\n";
+  }
+
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    run_flatten(street, num_threads);
+  }
+
+  return 0;
+}
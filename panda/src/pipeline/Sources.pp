@@ -56,6 +56,7 @@
     pipelineCyclerDummyImpl.h pipelineCyclerDummyImpl.I \
     pipelineCyclerTrivialImpl.h pipelineCyclerTrivialImpl.I \
     pipelineCyclerTrueImpl.h pipelineCyclerTrueImpl.I \
+    parallelFor.h \
     pmutex.h pmutex.I \
     pythonThread.h \
     reMutex.I reMutex.h \
@@ -112,6 +113,7 @@
     pipelineCyclerDummyImpl.cxx \
     pipelineCyclerTrivialImpl.cxx \
     pipelineCyclerTrueImpl.cxx \
+    parallelFor.cxx \
     pmutex.cxx \
     pythonThread.cxx \
     reMutex.cxx \
@@ -172,6 +174,7 @@
     pipelineCyclerDummyImpl.h pipelineCyclerDummyImpl.I \
     pipelineCyclerTrivialImpl.h pipelineCyclerTrivialImpl.I \
     pipelineCyclerTrueImpl.h pipelineCyclerTrueImpl.I \
+    parallelFor.h \
     pmutex.h pmutex.I \
     pythonThread.h \
     reMutex.I reMutex.h \
@@ -281,3 +284,29 @@
     test_setjmp.cxx
 
 #end test_bin_target
+
+
+#begin test_bin_target
+  #define TARGET test_dcast
+  #define LOCAL_LIBS $[LOCAL_LIBS] pipeline
+  #define OTHER_LIBS \
+   interrogatedb:c dconfig:c dtoolbase:c prc:c \
+   dtoolutil:c dtool:m dtoolconfig:m pystub
+
+  #define SOURCES \
+    test_dcast.cxx
+
+#end test_bin_target
+
+
+#begin test_bin_target
+  #define TARGET test_deleted_chain
+  #define LOCAL_LIBS $[LOCAL_LIBS] pipeline
+  #define OTHER_LIBS \
+   interrogatedb:c dconfig:c dtoolbase:c prc:c \
+   dtoolutil:c dtool:m dtoolconfig:m pystub
+
+  #define SOURCES \
+    test_deleted_chain.cxx
+
+#end test_bin_target
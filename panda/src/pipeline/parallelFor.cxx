@@ -0,0 +1,211 @@
+// Filename: parallelFor.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "parallelFor.h"
+#include "mutexHolder.h"
+
+#include <algorithm>
+
+Mutex *ParallelFor::_lock = NULL;
+ConditionVarFull *ParallelFor::_work_cvar = NULL;
+ConditionVarFull *ParallelFor::_done_cvar = NULL;
+ParallelFor::Jobs *ParallelFor::_jobs = NULL;
+ParallelFor::Threads *ParallelFor::_threads = NULL;
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::Body::Destructor
+//       Access: Public, Virtual
+//  Description:
+////////////////////////////////////////////////////////////////////
+ParallelFor::Body::
+~Body() {
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::run
+//       Access: Public, Static
+//  Description: Calls body.do_range() on chunks of the items 0
+//               through num_items - 1, using up to num_threads
+//               threads at once, counting the calling thread, and
+//               returns when all of the items are done.
+//
+//               Fewer threads are used if there would otherwise be
+//               fewer than min_items_per_thread items for each.  If
+//               that leaves only one thread, or num_threads is 0 or
+//               1, all of the items are done in the calling thread
+//               with a single call to do_range().
+////////////////////////////////////////////////////////////////////
+void ParallelFor::
+run(Body &body, int num_items, int num_threads, int min_items_per_thread) {
+  if (num_items <= 0) {
+    return;
+  }
+  min_items_per_thread = max(min_items_per_thread, 1);
+  num_threads = min(num_threads, num_items / min_items_per_thread);
+
+  if (num_threads <= 1 || !Thread::is_true_threads()) {
+    body.do_range(0, num_items);
+    return;
+  }
+
+  if (_lock == (Mutex *)NULL) {
+    // The first call is made before any thread has been started by
+    // us; another thread might be making it too, but we can live with
+    // that small leak more easily than with a static constructor.
+    Mutex *lock = new Mutex("ParallelFor");
+    _work_cvar = new ConditionVarFull(*lock);
+    _done_cvar = new ConditionVarFull(*lock);
+    _jobs = new Jobs;
+    _threads = new Threads;
+    _lock = lock;
+  }
+
+  Job job;
+  job._body = &body;
+  job._num_items = num_items;
+  job._chunk_size = max(num_items / (num_threads * 4), 1);
+  job._next_item = 0;
+  job._max_helpers = num_threads - 1;
+  job._num_helpers = 0;
+
+  {
+    MutexHolder holder(*_lock);
+    start_threads(num_threads - 1);
+    _jobs->push_back(&job);
+    _work_cvar->notify_all();
+  }
+
+  // The calling thread does its share too, until there is nothing
+  // left to take.
+  int begin, end;
+  _lock->acquire();
+  while (claim(&job, begin, end)) {
+    _lock->release();
+    body.do_range(begin, end);
+    _lock->acquire();
+  }
+
+  // Now wait for the helpers that are still working on our items.
+  while (job._num_helpers > 0) {
+    _done_cvar->wait();
+  }
+  _lock->release();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::claim
+//       Access: Private, Static
+//  Description: Takes the next chunk of the job's items, and returns
+//               true, or returns false if there are none left.  When
+//               the last chunk is taken, the job is removed from the
+//               list, so no more helpers will join it.  Assumes the
+//               lock is held.
+////////////////////////////////////////////////////////////////////
+bool ParallelFor::
+claim(Job *job, int &begin, int &end) {
+  if (job->_next_item >= job->_num_items) {
+    return false;
+  }
+  begin = job->_next_item;
+  end = min(begin + job->_chunk_size, job->_num_items);
+  job->_next_item = end;
+
+  if (end >= job->_num_items) {
+    Jobs::iterator ji = find(_jobs->begin(), _jobs->end(), job);
+    if (ji != _jobs->end()) {
+      _jobs->erase(ji);
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::find_job
+//       Access: Private, Static
+//  Description: Returns the oldest job that has items left and room
+//               for another helper, or NULL if there is none.
+//               Assumes the lock is held.
+////////////////////////////////////////////////////////////////////
+ParallelFor::Job *ParallelFor::
+find_job() {
+  Jobs::const_iterator ji;
+  for (ji = _jobs->begin(); ji != _jobs->end(); ++ji) {
+    if ((*ji)->_num_helpers < (*ji)->_max_helpers) {
+      return (*ji);
+    }
+  }
+  return NULL;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::start_threads
+//       Access: Private, Static
+//  Description: Grows the pool to at least the indicated number of
+//               threads.  Threads are never stopped.  Assumes the
+//               lock is held.
+////////////////////////////////////////////////////////////////////
+void ParallelFor::
+start_threads(int num_threads) {
+  while ((int)_threads->size() < num_threads) {
+    ostringstream strm;
+    strm << "parallel_for_" << _threads->size();
+    PT(WorkerThread) thread = new WorkerThread(strm.str());
+    if (!thread->start(TP_normal, false)) {
+      return;
+    }
+    _threads->push_back(thread);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::WorkerThread::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+ParallelFor::WorkerThread::
+WorkerThread(const string &name) :
+  Thread(name, "parallel_for")
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: ParallelFor::WorkerThread::thread_main
+//       Access: Protected, Virtual
+//  Description: Waits for a job to help with, and then takes chunks
+//               of it until there are none left.
+////////////////////////////////////////////////////////////////////
+void ParallelFor::WorkerThread::
+thread_main() {
+  _lock->acquire();
+  while (true) {
+    Job *job = find_job();
+    if (job == (Job *)NULL) {
+      _work_cvar->wait();
+      continue;
+    }
+
+    ++job->_num_helpers;
+    int begin, end;
+    while (claim(job, begin, end)) {
+      _lock->release();
+      job->_body->do_range(begin, end);
+      _lock->acquire();
+    }
+
+    // The job's caller may be waiting for us.
+    if (--job->_num_helpers == 0) {
+      _done_cvar->notify_all();
+    }
+  }
+}
@@ -0,0 +1,88 @@
+// Filename: parallelFor.h
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include "pandabase.h"
+#include "thread.h"
+#include "pmutex.h"
+#include "conditionVarFull.h"
+#include "pvector.h"
+
+////////////////////////////////////////////////////////////////////
+//       Class : ParallelFor
+// Description : Divides a range of independent work items among a
+//               pool of worker threads that is shared by all callers
+//               and kept from one call to the next.
+//
+//               The calling thread always works on its own range, and
+//               the pool threads only help; run() waits just for the
+//               helpers that have actually taken items.  So it may be
+//               called from any thread, including one of the pool
+//               threads itself, and always finishes even if every
+//               pool thread is busy elsewhere.
+//
+//               Without true threads, run() simply does all of the
+//               items in the calling thread.
+////////////////////////////////////////////////////////////////////
+class EXPCL_PANDA_PIPELINE ParallelFor {
+public:
+  class EXPCL_PANDA_PIPELINE Body {
+  public:
+    virtual ~Body();
+
+    // Does items begin through end - 1.  This may be called from
+    // several threads at once, for different items.
+    virtual void do_range(int begin, int end)=0;
+  };
+
+  static void run(Body &body, int num_items, int num_threads,
+                  int min_items_per_thread = 1);
+
+private:
+  class Job {
+  public:
+    Body *_body;
+    int _num_items;
+    int _chunk_size;
+    int _next_item;
+    int _max_helpers;
+    int _num_helpers;
+  };
+
+  class WorkerThread : public Thread {
+  public:
+    WorkerThread(const string &name);
+
+  protected:
+    virtual void thread_main();
+  };
+
+  static bool claim(Job *job, int &begin, int &end);
+  static Job *find_job();
+  static void start_threads(int num_threads);
+
+  typedef pvector<Job *> Jobs;
+  typedef pvector< PT(WorkerThread) > Threads;
+
+  // These are all protected by _lock.
+  static Mutex *_lock;
+  static ConditionVarFull *_work_cvar;
+  static ConditionVarFull *_done_cvar;
+  static Jobs *_jobs;
+  static Threads *_threads;
+};
+
+#endif
@@ -0,0 +1,248 @@
+// Filename: test_dcast.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pandabase.h"
+#include "thread.h"
+#include "typedReferenceCount.h"
+#include "pointerTo.h"
+#include "dcast.h"
+#include "trueClock.h"
+
+#include <stdlib.h>
+
+// This program times DCAST and is_of_type() on a small class
+// hierarchy, first in one thread and then in each of the given number
+// of threads at once, and reports the time taken per call.  Since
+// TypeRegistry::is_derived_from() no longer takes the registry's lock
+// once a type's ancestors are known, the time per call should not go
+// up much as threads are added.
+//
+// Usage: test_dcast [num_threads [num_calls]]
+
+// A few levels of single inheritance, and one class that inherits
+// from two of them.
+class Level1 : public TypedReferenceCount {
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    TypedReferenceCount::init_type();
+    register_type(_type_handle, "Level1",
+                  TypedReferenceCount::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {
+    init_type();
+    return get_class_type();
+  }
+
+private:
+  static TypeHandle _type_handle;
+};
+
+class Level2 : public Level1 {
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    Level1::init_type();
+    register_type(_type_handle, "Level2", Level1::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {
+    init_type();
+    return get_class_type();
+  }
+
+private:
+  static TypeHandle _type_handle;
+};
+
+class Level3 : public Level2 {
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    Level2::init_type();
+    register_type(_type_handle, "Level3", Level2::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {
+    init_type();
+    return get_class_type();
+  }
+
+private:
+  static TypeHandle _type_handle;
+};
+
+class Mixin {
+public:
+  virtual ~Mixin() {
+  }
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    register_type(_type_handle, "Mixin");
+  }
+
+private:
+  static TypeHandle _type_handle;
+};
+
+class Mixed : public Level3, public Mixin {
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    Level3::init_type();
+    Mixin::init_type();
+    register_type(_type_handle, "Mixed",
+                  Level3::get_class_type(), Mixin::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {
+    init_type();
+    return get_class_type();
+  }
+
+private:
+  static TypeHandle _type_handle;
+};
+
+TypeHandle Level1::_type_handle;
+TypeHandle Level2::_type_handle;
+TypeHandle Level3::_type_handle;
+TypeHandle Mixin::_type_handle;
+TypeHandle Mixed::_type_handle;
+
+// Makes num_calls casts and type checks on the objects, and returns
+// the number that succeeded, which should be the same every time.
+static int
+run_casts(TypedReferenceCount *objects[], int num_objects, int num_calls) {
+  int count = 0;
+  for (int i = 0; i < num_calls; ++i) {
+    TypedReferenceCount *object = objects[i % num_objects];
+    if (DCAST(Level2, object) != (Level2 *)NULL) {
+      ++count;
+    }
+    if (object->is_of_type(Mixin::get_class_type())) {
+      ++count;
+    }
+    if (object->is_of_type(Level3::get_class_type())) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+static const int num_objects = 3;
+static TypedReferenceCount *objects[num_objects];
+
+class CastThread : public Thread {
+public:
+  CastThread(const string &name, int num_calls) :
+    Thread(name, name),
+    _num_calls(num_calls),
+    _count(0)
+  {
+  }
+
+  virtual void thread_main() {
+    _count = run_casts(objects, num_objects, _num_calls);
+  }
+
+  int _num_calls;
+  int _count;
+};
+
+int
+main(int argc, char *argv[]) {
+  int num_threads = 4;
+  int num_calls = 1000000;
+  if (argc > 1) {
+    num_threads = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_calls = atoi(argv[2]);
+  }
+
+  Mixed::init_type();
+
+  PT(TypedReferenceCount) level2 = new Level2;
+  PT(TypedReferenceCount) level3 = new Level3;
+  PT(TypedReferenceCount) mixed = new Mixed;
+  objects[0] = level2;
+  objects[1] = level3;
+  objects[2] = mixed;
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  double start = clock->get_short_time();
+  int expected = run_casts(objects, num_objects, num_calls);
+  double single_time = clock->get_short_time() - start;
+
+  typedef pvector< PT(CastThread) > Threads;
+  Threads threads;
+  int i;
+  for (i = 0; i < num_threads; ++i) {
+    ostringstream strm;
+    strm << "cast_" << i;
+    threads.push_back(new CastThread(strm.str(), num_calls));
+  }
+
+  start = clock->get_short_time();
+  for (i = 0; i < num_threads; ++i) {
+    if (!threads[i]->start(TP_normal, true)) {
+      nout << "Unable to start " << threads[i]->get_name() << "\n";
+      return 1;
+    }
+  }
+  for (i = 0; i < num_threads; ++i) {
+    threads[i]->join();
+  }
+  double threaded_time = clock->get_short_time() - start;
+
+  bool okflag = true;
+  for (i = 0; i < num_threads; ++i) {
+    if (threads[i]->_count != expected) {
+      nout << "  *** " << threads[i]->get_name() << " got "
+           << threads[i]->_count << " instead of " << expected << "\n";
+      okflag = false;
+    }
+  }
+
+  // Each call to run_casts() makes three checks per iteration.
+  double calls = (double)num_calls * 3.0;
+  nout << "1 thread: " << single_time * 1.0e9 / calls << " ns per check\n"
+       << num_threads << " threads: "
+       << threaded_time * 1.0e9 / (calls * num_threads)
+       << " ns per check, " << threaded_time * 1.0e9 / calls
+       << " ns per check per thread\n";
+
+  return okflag ? 0 : 1;
+}
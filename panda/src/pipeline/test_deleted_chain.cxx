@@ -0,0 +1,211 @@
+// Filename: test_deleted_chain.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pandabase.h"
+#include "thread.h"
+#include "pmutex.h"
+#include "mutexHolder.h"
+#include "memoryHook.h"
+#include "deletedBufferChain.h"
+#include "pointerTo.h"
+#include "trueClock.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// This program allocates and frees buffers of a few different sizes
+// from their DeletedBufferChains, first in one thread and then in
+// each of the given number of threads at once, and reports the time
+// taken per request and the chains' statistics.  Each round, a thread
+// allocates a batch of buffers and frees them in a scrambled order,
+// then hands another batch on to the next thread and frees the
+// batches handed to it by the previous one, so that some buffers are
+// freed by a different thread than allocated them, as they are
+// between the App, Cull, and Draw threads.
+//
+// Usage: test_deleted_chain [num_threads [num_rounds]]
+
+static const int num_sizes = 4;
+static const size_t sizes[num_sizes] = { 16, 48, 128, 400 };
+static DeletedBufferChain *chains[num_sizes];
+
+static const int batch_size = 256;
+
+// Each thread has an inbox, into which its neighbor puts the batches
+// it hands on.
+class Handoff {
+public:
+  Mutex _lock;
+  pvector<void **> _batches;
+};
+
+static Handoff *handoffs;
+
+static void
+free_batches(pvector<void **> &batches) {
+  pvector<void **>::iterator bi;
+  for (bi = batches.begin(); bi != batches.end(); ++bi) {
+    void **batch = (*bi);
+    for (int i = 0; batch[i] != NULL; ++i) {
+      chains[0]->deallocate(batch[i], TypeHandle::none());
+    }
+    PANDA_FREE_ARRAY(batch);
+  }
+  batches.clear();
+}
+
+static void
+run_rounds(int index, int num_threads, int num_rounds) {
+  void *buffers[batch_size];
+  pvector<void **> theirs;
+  for (int r = 0; r < num_rounds; ++r) {
+    DeletedBufferChain *chain = chains[r % num_sizes];
+    size_t size = sizes[r % num_sizes];
+    TypeHandle type_handle = TypeHandle::none();
+
+    int i;
+    for (i = 0; i < batch_size; ++i) {
+      buffers[i] = chain->allocate(size, type_handle);
+      memset(buffers[i], index, size);
+    }
+    for (i = 0; i < batch_size; ++i) {
+      chain->deallocate(buffers[(i * 37) % batch_size], type_handle);
+    }
+
+    // Now pass a batch of buffers on to the next thread's inbox, and
+    // free whatever the previous thread has left in ours.
+    if (num_threads > 1) {
+      void **mine = (void **)PANDA_MALLOC_ARRAY((batch_size + 1) * sizeof(void *));
+      for (i = 0; i < batch_size; ++i) {
+        mine[i] = chains[0]->allocate(sizes[0], type_handle);
+      }
+      mine[batch_size] = NULL;
+
+      Handoff &next = handoffs[(index + 1) % num_threads];
+      {
+        MutexHolder holder(next._lock);
+        next._batches.push_back(mine);
+      }
+
+      Handoff &inbox = handoffs[index];
+      {
+        MutexHolder holder(inbox._lock);
+        theirs.swap(inbox._batches);
+      }
+      free_batches(theirs);
+    }
+  }
+}
+
+class ChainThread : public Thread {
+public:
+  ChainThread(const string &name, int index, int num_threads, int num_rounds) :
+    Thread(name, name),
+    _index(index),
+    _num_threads(num_threads),
+    _num_rounds(num_rounds)
+  {
+  }
+
+  virtual void thread_main() {
+    run_rounds(_index, _num_threads, _num_rounds);
+  }
+
+  int _index;
+  int _num_threads;
+  int _num_rounds;
+};
+
+static size_t
+count_requests() {
+  size_t count = 0;
+  for (int s = 0; s < num_sizes; ++s) {
+    count += chains[s]->get_num_requests();
+  }
+  return count;
+}
+
+static void
+write_stats() {
+  for (int s = 0; s < num_sizes; ++s) {
+    nout << "  " << *chains[s] << "\n";
+  }
+}
+
+int
+main(int argc, char *argv[]) {
+  int num_threads = 4;
+  int num_rounds = 20000;
+  if (argc > 1) {
+    num_threads = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_rounds = atoi(argv[2]);
+  }
+
+  for (int s = 0; s < num_sizes; ++s) {
+    chains[s] = memory_hook->get_deleted_chain(sizes[s]);
+  }
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  size_t start_requests = count_requests();
+  double start = clock->get_short_time();
+  run_rounds(0, 1, num_rounds);
+  double single_time = clock->get_short_time() - start;
+  DeletedBufferChain::flush_thread();
+  double single_requests = (double)(count_requests() - start_requests);
+
+  nout << "1 thread: " << single_time * 1.0e9 / single_requests
+       << " ns per request\n";
+  write_stats();
+
+  handoffs = new Handoff[num_threads];
+  typedef pvector< PT(ChainThread) > Threads;
+  Threads threads;
+  int i;
+  for (i = 0; i < num_threads; ++i) {
+    ostringstream strm;
+    strm << "chain_" << i;
+    threads.push_back(new ChainThread(strm.str(), i, num_threads, num_rounds));
+  }
+
+  start_requests = count_requests();
+  start = clock->get_short_time();
+  for (i = 0; i < num_threads; ++i) {
+    if (!threads[i]->start(TP_normal, true)) {
+      nout << "Unable to start " << threads[i]->get_name() << "\n";
+      return 1;
+    }
+  }
+  for (i = 0; i < num_threads; ++i) {
+    threads[i]->join();
+  }
+  double threaded_time = clock->get_short_time() - start;
+
+  // Free the batches still waiting in the inboxes.
+  for (i = 0; i < num_threads; ++i) {
+    free_batches(handoffs[i]._batches);
+  }
+  DeletedBufferChain::flush_thread();
+  double threaded_requests = (double)(count_requests() - start_requests);
+
+  nout << num_threads << " threads: "
+       << threaded_time * 1.0e9 / threaded_requests
+       << " ns per request\n";
+  write_stats();
+
+  delete[] handoffs;
+  return 0;
+}
@@ -20,6 +20,7 @@
 #include "thread.h"
 #include "pointerTo.h"
 #include "config_pipeline.h"
+#include "deletedBufferChain.h"
 
 DWORD ThreadWin32Impl::_pt_ptr_index = 0;
 bool ThreadWin32Impl::_got_pt_ptr_index = false;
@@ -196,6 +197,11 @@ root_func(LPVOID data) {
     // This might delete the parent object, and in turn, delete the
     // ThreadWin32Impl object.
     unref_delete(self->_parent_obj);
+
+    // Windows doesn't tell the DeletedBufferChains when a thread
+    // exits, so we have to give back this thread's cached buffers
+    // ourselves.
+    DeletedBufferChain::flush_thread();
   }
 
   return 0;
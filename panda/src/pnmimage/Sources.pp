@@ -44,3 +44,13 @@
 
 #end lib_target
 
+
+#begin test_bin_target
+  #define TARGET test_pnm_filter
+  #define LOCAL_LIBS \
+    pnmimage putil express
+
+  #define SOURCES \
+    test_pnm_filter.cxx
+
+#end test_bin_target
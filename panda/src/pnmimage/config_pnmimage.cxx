@@ -20,6 +20,29 @@
 Configure(config_pnmimage);
 NotifyCategoryDef(pnmimage, "");
 
+ConfigVariableBool pnm_fast_filter
+("pnm-fast-filter", false,
+ PRC_DESC("Set this true to perform PNMImage::box_filter_from(), "
+          "gaussian_filter_from(), and quick_filter_from() with "
+          "precomputed single-precision weights, using SSE or AVX "
+          "where the compiler allows it.  The results are not exactly "
+          "those of the original double-precision implementation: a "
+          "pixel value may differ by one in either direction, which "
+          "changes the output of texture rescaling and of tools such as "
+          "egg-palettize.  The default, false, uses the original "
+          "implementation."));
+
+ConfigVariableInt pnm_filter_threads
+("pnm-filter-threads", 0,
+ PRC_DESC("Specifies the number of threads, counting the calling thread, "
+          "that may share each pass of the fast box_filter_from(), "
+          "gaussian_filter_from() and quick_filter_from().  Each pass "
+          "is split into bands of rows, and an image with fewer than 8 "
+          "bands per thread uses fewer threads.  The result is the same "
+          "with any number of threads.  This has no effect unless "
+          "pnm-fast-filter is true, since the original filters are "
+          "always done in the calling thread."));
+
 ConfigureFn(config_pnmimage) {
   init_libpnmimage();
 }
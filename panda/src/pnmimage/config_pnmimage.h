@@ -17,9 +17,14 @@
 
 #include "pandabase.h"
 #include "notifyCategoryProxy.h"
+#include "configVariableBool.h"
+#include "configVariableInt.h"
 
 NotifyCategoryDecl(pnmimage, EXPCL_PANDA_PNMIMAGE, EXPTP_PANDA_PNMIMAGE);
 
+extern EXPCL_PANDA_PNMIMAGE ConfigVariableBool pnm_fast_filter;
+extern EXPCL_PANDA_PNMIMAGE ConfigVariableInt pnm_filter_threads;
+
 extern EXPCL_PANDA_PNMIMAGE void init_libpnmimage();
 
 #endif
@@ -16,6 +16,10 @@
 // is dominant, and we map get/set functions for the channel in question to
 // GETVAL/SETVAL.
 
+// Each inclusion defines FUNCTION_NAME, the original double-precision
+// filter, and FUNCTION_NAME_fast, which hands the same channel to
+// fast_filter_channel() by way of a FUNCTION_NAME_channel object.
+
 
 static void
 FUNCTION_NAME(PNMImage &dest, const PNMImage &source,
@@ -97,3 +101,46 @@ FUNCTION_NAME(PNMImage &dest, const PNMImage &source,
   PANDA_FREE_ARRAY(matrix);
 }
 
+
+class FILTER_PASTE(FUNCTION_NAME, _channel) : public FilterChannel {
+public:
+  FILTER_PASTE(FUNCTION_NAME, _channel)(PNMImage &dest, const PNMImage &source) :
+    _dest(dest), _source(source) { }
+
+  virtual void get_block(int b, int num_rows, float block[]) const {
+    int a_size = _source.ASIZE();
+    for (int a = 0; a < a_size; a++) {
+      for (int r = 0; r < num_rows; r++) {
+        block[a * filter_lanes + r] = (float)(source_max * _source.GETVAL(a, b + r));
+      }
+    }
+  }
+
+  virtual void set_block(int b, int num_rows, const float block[]) {
+    int a_size = _dest.ASIZE();
+    for (int a = 0; a < a_size; a++) {
+      for (int r = 0; r < num_rows; r++) {
+        _dest.SETVAL(a, b + r, (double)block[r * a_size + a] / (double)source_max);
+      }
+    }
+  }
+
+private:
+  PNMImage &_dest;
+  const PNMImage &_source;
+};
+
+static void
+FILTER_PASTE(FUNCTION_NAME, _fast)(PNMImage &dest, const PNMImage &source,
+                                   double width, FilterFunction *make_filter) {
+  if (!dest.is_valid() || !source.is_valid()) {
+    return;
+  }
+
+  FilterTable a_table, b_table;
+  a_table.make_filter(dest.ASIZE(), source.ASIZE(), width, make_filter);
+  b_table.make_filter(dest.BSIZE(), source.BSIZE(), width, make_filter);
+
+  FILTER_PASTE(FUNCTION_NAME, _channel) channel(dest, source);
+  fast_filter_channel(channel, a_table, b_table, source.ASIZE(), source.BSIZE());
+}
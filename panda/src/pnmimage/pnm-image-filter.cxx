@@ -37,6 +37,10 @@
 #include "cmath.h"
 
 #include "pnmImage.h"
+#include "config_pnmimage.h"
+#include "thread.h"
+#include "parallelFor.h"
+#include "pvector.h"
 
 // WorkType is an abstraction that allows the filtering process to be
 // recompiled to use either floating-point or integer arithmetic.  On SGI
@@ -242,6 +246,430 @@ gaussian_filter_impl(double scale, double width,
 }
 
 
+// The fast filter.
+
+// filter_row() works out the kernel index of every tap of every value
+// it produces, in double precision, once for every row.  But each row
+// along an axis is filtered with the same taps, so the fast filter
+// works them out just once per axis, into a FilterTable: for each
+// destination value, the first source value it reads and the weights
+// of the source values from there on, already divided by their net
+// weight.
+
+// With the taps known in advance, the first pass filters filter_lanes
+// rows at once: the rows are interleaved, so that each tap is a single
+// multiply-add of filter_lanes values.  The second pass filters along
+// the other axis by adding together whole rows of the temporary
+// matrix, filter_lanes values at a time.  The rows of either pass may
+// be divided among several threads.
+
+#if defined(__AVX__)
+// AVX: eight floats at a time.
+#include <immintrin.h>
+
+typedef __m256 FilterVec;
+static const int filter_lanes = 8;
+
+INLINE FilterVec
+fv_zero() {
+  return _mm256_setzero_ps();
+}
+
+INLINE FilterVec
+fv_load(const float *p) {
+  return _mm256_loadu_ps(p);
+}
+
+INLINE FilterVec
+fv_madd(FilterVec sum, float weight, const float *p) {
+  return _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weight), _mm256_loadu_ps(p)));
+}
+
+INLINE void
+fv_store(float *p, FilterVec v) {
+  _mm256_storeu_ps(p, v);
+}
+
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+// SSE: four floats at a time.
+#include <xmmintrin.h>
+
+typedef __m128 FilterVec;
+static const int filter_lanes = 4;
+
+INLINE FilterVec
+fv_zero() {
+  return _mm_setzero_ps();
+}
+
+INLINE FilterVec
+fv_load(const float *p) {
+  return _mm_loadu_ps(p);
+}
+
+INLINE FilterVec
+fv_madd(FilterVec sum, float weight, const float *p) {
+  return _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weight), _mm_loadu_ps(p)));
+}
+
+INLINE void
+fv_store(float *p, FilterVec v) {
+  _mm_storeu_ps(p, v);
+}
+
+#else
+// No vector unit we know how to use; these loops are simple enough
+// that the compiler may vectorize them anyway.
+
+struct FilterVec {
+  float _v[4];
+};
+static const int filter_lanes = 4;
+
+INLINE FilterVec
+fv_zero() {
+  FilterVec v;
+  for (int i = 0; i < filter_lanes; i++) {
+    v._v[i] = 0.0f;
+  }
+  return v;
+}
+
+INLINE FilterVec
+fv_load(const float *p) {
+  FilterVec v;
+  for (int i = 0; i < filter_lanes; i++) {
+    v._v[i] = p[i];
+  }
+  return v;
+}
+
+INLINE FilterVec
+fv_madd(FilterVec sum, float weight, const float *p) {
+  for (int i = 0; i < filter_lanes; i++) {
+    sum._v[i] += weight * p[i];
+  }
+  return sum;
+}
+
+INLINE void
+fv_store(float *p, FilterVec v) {
+  for (int i = 0; i < filter_lanes; i++) {
+    p[i] = v._v[i];
+  }
+}
+
+#endif
+
+// Below this many blocks of filter_lanes rows per thread, it's not
+// worth starting the threads.
+static const int min_rows_per_thread = 8;
+
+
+// A FilterTable holds the taps for each destination value along one
+// axis.  Destination value i is the sum of get_weights(i)[k] *
+// source[get_left(i) + k], for k in 0 .. get_count(i) - 1.
+
+class FilterTable {
+public:
+  void make_filter(int dest_len, int source_len, double width,
+                   FilterFunction *make_filter);
+  void make_box(int first, int last, double scale, int source_len);
+
+  INLINE int get_dest_len() const {
+    return (int)_left.size();
+  }
+  INLINE int get_left(int i) const {
+    return _left[i];
+  }
+  INLINE int get_count(int i) const {
+    return _start[i + 1] - _start[i];
+  }
+  INLINE const float *get_weights(int i) const {
+    return &_weights[0] + _start[i];
+  }
+
+private:
+  void clear();
+  void add_value(int left, const pvector<double> &weights);
+
+  pvector<int> _left;
+  pvector<int> _start;
+  pvector<float> _weights;
+};
+
+void FilterTable::
+clear() {
+  _left.clear();
+  _start.clear();
+  _weights.clear();
+  _start.push_back(0);
+}
+
+// add_value() appends the next destination value to the table, given
+// the unnormalized weights of the source values from left on.
+void FilterTable::
+add_value(int left, const pvector<double> &weights) {
+  double net_weight = 0.0;
+  size_t k;
+  for (k = 0; k < weights.size(); k++) {
+    net_weight += weights[k];
+  }
+
+  _left.push_back(left);
+  if (net_weight > 0.0) {
+    for (k = 0; k < weights.size(); k++) {
+      _weights.push_back((float)(weights[k] / net_weight));
+    }
+  }
+  _start.push_back((int)_weights.size());
+}
+
+// make_filter() computes the same taps that filter_row() would use to
+// filter a row of source_len values into dest_len values.
+void FilterTable::
+make_filter(int dest_len, int source_len, double width,
+            FilterFunction *make_filter) {
+  clear();
+
+  double scale = (double)dest_len / (double)source_len;
+  WorkType *filter;
+  double filter_width;
+  make_filter(scale, width, filter, filter_width);
+
+  double iscale = max(scale, 1.0);
+  int offset = (int)cfloor(iscale*0.5);
+
+  pvector<double> weights;
+  for (int dest_x=0; dest_x<dest_len; dest_x++) {
+    double center = (dest_x-offset)/scale;
+    int left = max((int)cfloor(center - filter_width), 0);
+    int right = min((int)cceil(center + filter_width), source_len-1);
+    int right_center = (int)cceil(center);
+
+    weights.clear();
+    int source_x;
+    for (source_x=left; source_x<right_center; source_x++) {
+      weights.push_back(filter[(int)(iscale*(center-source_x))]);
+    }
+    for (; source_x<=right; source_x++) {
+      weights.push_back(filter[(int)(iscale*(source_x-center))]);
+    }
+    add_value(left, weights);
+  }
+
+  PANDA_FREE_ARRAY(filter);
+}
+
+// make_box() computes the taps that quick_filter_from() uses along
+// one axis: destination value i, for i in first .. last - 1, is the
+// average of the source values from i * scale up to (i + 1) * scale,
+// counting the partial values at either end by the part covered.
+void FilterTable::
+make_box(int first, int last, double scale, int source_len) {
+  clear();
+
+  pvector<double> weights;
+  for (int i = first; i < last; i++) {
+    double x0 = i * scale;
+    double x1 = (i + 1) * scale;
+
+    weights.clear();
+    int x = (int)x0;
+    int left = x;
+    // Get the first (partial) value
+    weights.push_back((double)(x+1)-x0);
+
+    int x_last = (int)x1;
+    if (x < x_last) {
+      x++;
+      while (x < x_last) {
+        // Get each consecutive (complete) value
+        weights.push_back(1.0);
+        x++;
+      }
+
+      // Get the final (partial) value
+      double x_contrib = x1 - (double)x_last;
+      if (x_contrib > 0.0001) {
+        weights.push_back(x_contrib);
+      }
+    }
+
+    // Round-off may carry the last value just past the end.
+    if (left + (int)weights.size() > source_len) {
+      weights.resize(max(source_len - left, 0));
+    }
+    add_value(left, weights);
+  }
+}
+
+
+// A FilterChannel reads and writes one channel of the source and
+// destination images, filter_lanes rows along the first axis at a
+// time.  get_block() stores source value a of row b + r in block[a *
+// filter_lanes + r]; set_block() takes destination value a of row b +
+// r from block[r * a_size + a].  Several threads may call get_block()
+// at once, and several may call set_block() at once for different
+// rows, but not both.
+
+class FilterChannel {
+public:
+  virtual ~FilterChannel() { }
+  virtual void get_block(int b, int num_rows, float block[]) const=0;
+  virtual void set_block(int b, int num_rows, const float block[])=0;
+};
+
+
+// Each pass of the fast filter may be done a range of rows at a time,
+// in any order, so it is a ParallelFor::Body.  run_filter_pass() does
+// all of the rows of the pass, dividing them among pnm-filter-threads
+// threads if there are enough of them.
+static void
+run_filter_pass(ParallelFor::Body &pass, int num_rows) {
+  ParallelFor::run(pass, num_rows, pnm_filter_threads, min_rows_per_thread);
+}
+
+
+// The first pass filters blocks of filter_lanes source rows along the
+// A axis, into the matrix, which has one row of dest_a values for each
+// source row.
+
+class FilterAPass : public ParallelFor::Body {
+public:
+  FilterAPass(const FilterChannel &channel, const FilterTable &table,
+              int source_a, int source_b, float *matrix) :
+    _channel(channel), _table(table),
+    _source_a(source_a), _source_b(source_b), _matrix(matrix) { }
+
+  virtual void do_range(int begin, int end);
+
+private:
+  const FilterChannel &_channel;
+  const FilterTable &_table;
+  int _source_a, _source_b;
+  float *_matrix;
+};
+
+void FilterAPass::
+do_range(int begin, int end) {
+  int dest_a = _table.get_dest_len();
+  pvector<float> block(_source_a * filter_lanes, 0.0f);
+  float result[filter_lanes];
+
+  for (int b = begin * filter_lanes; b < end * filter_lanes; b += filter_lanes) {
+    // The rows of the block are interleaved, so that the values in
+    // the same column are together.  get_block() fills only the rows
+    // it is asked for, so a short last block has its unused rows
+    // zeroed here rather than left with the previous block's values.
+    int num_rows = min(filter_lanes, _source_b - b);
+    if (num_rows < filter_lanes) {
+      fill(block.begin(), block.end(), 0.0f);
+    }
+    _channel.get_block(b, num_rows, &block[0]);
+
+    for (int a = 0; a < dest_a; a++) {
+      const float *weights = _table.get_weights(a);
+      const float *source = &block[0] + _table.get_left(a) * filter_lanes;
+      int count = _table.get_count(a);
+
+      FilterVec sum = fv_zero();
+      for (int k = 0; k < count; k++) {
+        sum = fv_madd(sum, weights[k], source + k * filter_lanes);
+      }
+      fv_store(result, sum);
+
+      for (int r = 0; r < num_rows; r++) {
+        _matrix[(b + r) * dest_a + a] = result[r];
+      }
+    }
+    Thread::consider_yield();
+  }
+}
+
+
+// The second pass filters the matrix along the B axis into blocks of
+// filter_lanes destination rows, and stores them in the destination
+// image.
+
+class FilterBPass : public ParallelFor::Body {
+public:
+  FilterBPass(FilterChannel &channel, const FilterTable &table,
+              int dest_a, const float *matrix) :
+    _channel(channel), _table(table), _dest_a(dest_a), _matrix(matrix) { }
+
+  virtual void do_range(int begin, int end);
+
+private:
+  FilterChannel &_channel;
+  const FilterTable &_table;
+  int _dest_a;
+  const float *_matrix;
+};
+
+void FilterBPass::
+do_range(int begin, int end) {
+  int dest_b = _table.get_dest_len();
+  pvector<float> block(_dest_a * filter_lanes);
+
+  for (int b0 = begin * filter_lanes; b0 < end * filter_lanes; b0 += filter_lanes) {
+    int num_rows = min(filter_lanes, dest_b - b0);
+    for (int r = 0; r < num_rows; r++) {
+      const float *weights = _table.get_weights(b0 + r);
+      int left = _table.get_left(b0 + r);
+      int count = _table.get_count(b0 + r);
+      float *dest = &block[0] + r * _dest_a;
+
+      int a;
+      for (a = 0; a < _dest_a; a++) {
+        dest[a] = 0.0f;
+      }
+
+      for (int k = 0; k < count; k++) {
+        float weight = weights[k];
+        const float *source = _matrix + (left + k) * _dest_a;
+        for (a = 0; a + filter_lanes <= _dest_a; a += filter_lanes) {
+          fv_store(dest + a, fv_madd(fv_load(dest + a), weight, source + a));
+        }
+        for (; a < _dest_a; a++) {
+          dest[a] += weight * source[a];
+        }
+      }
+    }
+
+    _channel.set_block(b0, num_rows, &block[0]);
+    Thread::consider_yield();
+  }
+}
+
+
+// fast_filter_channel() filters one channel of the source image into
+// the destination image, first along A with a_table and then along B
+// with b_table.
+static void
+fast_filter_channel(FilterChannel &channel, const FilterTable &a_table,
+                    const FilterTable &b_table, int source_a, int source_b) {
+  int dest_a = a_table.get_dest_len();
+  int dest_b = b_table.get_dest_len();
+  if (dest_a == 0 || dest_b == 0 || source_a == 0 || source_b == 0) {
+    return;
+  }
+
+  float *matrix = (float *)PANDA_MALLOC_ARRAY(dest_a * source_b * sizeof(float));
+
+  FilterAPass a_pass(channel, a_table, source_a, source_b, matrix);
+  run_filter_pass(a_pass, (source_b + filter_lanes - 1) / filter_lanes);
+
+  // All of the source has been read by now, so the destination may be
+  // the same image.
+  FilterBPass b_pass(channel, b_table, dest_a, matrix);
+  run_filter_pass(b_pass, (dest_b + filter_lanes - 1) / filter_lanes);
+
+  PANDA_FREE_ARRAY(matrix);
+}
+
+
+
 // We have a function, defined in pnm-image-filter-core.cxx, that will scale
 // an image in both X and Y directions for a particular channel, by setting
 // up the temporary matrix appropriately and calling the above functions.
@@ -263,6 +691,9 @@ gaussian_filter_impl(double scale, double width,
 // with each instance of the function to cause each instance to operate on
 // the correct member.
 
+#define FILTER_PASTE2(a, b) a ## b
+#define FILTER_PASTE(a, b) FILTER_PASTE2(a, b)
+
 
 // These instances scale by X first, then by Y.
 
@@ -390,6 +821,34 @@ gaussian_filter_impl(double scale, double width,
 #undef FUNCTION_NAME
 
 
+typedef void ChannelFunction(PNMImage &dest, const PNMImage &source,
+                             double width, FilterFunction *make_filter);
+
+struct ChannelFunctions {
+  ChannelFunction *_red;
+  ChannelFunction *_green;
+  ChannelFunction *_blue;
+  ChannelFunction *_gray;
+  ChannelFunction *_alpha;
+};
+
+static const ChannelFunctions xy_functions = {
+  filter_red_xy, filter_green_xy, filter_blue_xy,
+  filter_gray_xy, filter_alpha_xy
+};
+static const ChannelFunctions yx_functions = {
+  filter_red_yx, filter_green_yx, filter_blue_yx,
+  filter_gray_yx, filter_alpha_yx
+};
+static const ChannelFunctions fast_xy_functions = {
+  filter_red_xy_fast, filter_green_xy_fast, filter_blue_xy_fast,
+  filter_gray_xy_fast, filter_alpha_xy_fast
+};
+static const ChannelFunctions fast_yx_functions = {
+  filter_red_yx_fast, filter_green_yx_fast, filter_blue_yx_fast,
+  filter_gray_yx_fast, filter_alpha_yx_fast
+};
+
 // filter_image pulls everything together, and filters one image into
 // another.  Both images can be the same with no ill effects.
 static void
@@ -399,31 +858,23 @@ filter_image(PNMImage &dest, const PNMImage &source,
   // We want to scale by the smallest destination axis first, for a
   // slight performance gain.
 
+  const ChannelFunctions *functions;
   if (dest.get_x_size() <= dest.get_y_size()) {
-    if (dest.is_grayscale() || source.is_grayscale()) {
-      filter_gray_xy(dest, source, width, make_filter);
-    } else {
-      filter_red_xy(dest, source, width, make_filter);
-      filter_green_xy(dest, source, width, make_filter);
-      filter_blue_xy(dest, source, width, make_filter);
-    }
-
-    if (dest.has_alpha() && source.has_alpha()) {
-      filter_alpha_xy(dest, source, width, make_filter);
-    }
+    functions = pnm_fast_filter ? &fast_xy_functions : &xy_functions;
+  } else {
+    functions = pnm_fast_filter ? &fast_yx_functions : &yx_functions;
+  }
 
+  if (dest.is_grayscale() || source.is_grayscale()) {
+    (*functions->_gray)(dest, source, width, make_filter);
   } else {
-    if (dest.is_grayscale() || source.is_grayscale()) {
-      filter_gray_yx(dest, source, width, make_filter);
-    } else {
-      filter_red_yx(dest, source, width, make_filter);
-      filter_green_yx(dest, source, width, make_filter);
-      filter_blue_yx(dest, source, width, make_filter);
-    }
+    (*functions->_red)(dest, source, width, make_filter);
+    (*functions->_green)(dest, source, width, make_filter);
+    (*functions->_blue)(dest, source, width, make_filter);
+  }
 
-    if (dest.has_alpha() && source.has_alpha()) {
-      filter_alpha_yx(dest, source, width, make_filter);
-    }
+  if (dest.has_alpha() && source.has_alpha()) {
+    (*functions->_alpha)(dest, source, width, make_filter);
   }
 }
 
@@ -548,25 +999,17 @@ box_filter_region(const PNMImage &image,
   alpha_result = (xelval)(alpha / pixel_count + 0.5);
 }
 
-////////////////////////////////////////////////////////////////////
-//     Function: PNMImage::quick_filter_from
-//       Access: Public
-//  Description: Resizes from the given image, with a fixed radius of
-//               0.5. This is a very specialized and simple algorithm
-//               that doesn't handle dropping below the Nyquist rate
-//               very well, but is quite a bit faster than the more
-//               general box_filter(), above.  If borders are
-//               specified, they will further restrict the size of the
-//               resulting image. There's no point in using
-//               quick_box_filter() on a single image.
-////////////////////////////////////////////////////////////////////
-void PNMImage::
-quick_filter_from(const PNMImage &from, int xborder, int yborder) {
+// quick_filter_image() is the original implementation of
+// quick_filter_from(), which finds the box of each destination pixel
+// and adds up the source pixels in it, in double precision.
+static void
+quick_filter_image(PNMImage &dest, const PNMImage &from,
+                   int xborder, int yborder) {
   int from_xs = from.get_x_size();
   int from_ys = from.get_y_size();
 
-  int to_xs = get_x_size() - xborder;
-  int to_ys = get_y_size() - yborder;
+  int to_xs = dest.get_x_size() - xborder;
+  int to_ys = dest.get_y_size() - yborder;
 
   int to_xoff = xborder / 2;
   int to_yoff = yborder / 2;
@@ -579,13 +1022,13 @@ quick_filter_from(const PNMImage &from, int xborder, int yborder) {
 
   from_y0 = max(0, -to_yoff) * y_scale;
   for (to_y = max(0, -to_yoff);
-       to_y < min(to_ys, get_y_size()-to_yoff);
+       to_y < min(to_ys, dest.get_y_size()-to_yoff);
        to_y++) {
     from_y1 = (to_y+1) * y_scale;
 
     from_x0 = max(0, -to_xoff) * x_scale;
     for (to_x = max(0, -to_xoff);
-         to_x < min(to_xs, get_x_size()-to_xoff);
+         to_x < min(to_xs, dest.get_x_size()-to_xoff);
          to_x++) {
       from_x1 = (to_x+1) * x_scale;
 
@@ -594,10 +1037,10 @@ quick_filter_from(const PNMImage &from, int xborder, int yborder) {
       xelval alpha_result;
       box_filter_region(from,
                         from_x0, from_y0, from_x1, from_y1,
-                        (*this)[to_yoff + to_y][to_xoff + to_x],
+                        dest[to_yoff + to_y][to_xoff + to_x],
                         alpha_result);
-      if (has_alpha()) {
-        set_alpha_val(to_xoff+to_x, to_yoff+to_y, alpha_result);
+      if (dest.has_alpha()) {
+        dest.set_alpha_val(to_xoff+to_x, to_yoff+to_y, alpha_result);
       }
 
       from_x0 = from_x1;
@@ -606,3 +1049,139 @@ quick_filter_from(const PNMImage &from, int xborder, int yborder) {
     Thread::consider_yield();
   }
 }
+
+// quick_filter_from() uses FilterTables too, but since each
+// destination pixel covers only the few source pixels under it, it
+// doesn't need the temporary matrix: a QuickFilterPass adds up the
+// source rows under each destination row directly, all of the
+// channels at once.
+class QuickFilterPass : public ParallelFor::Body {
+public:
+  QuickFilterPass(PNMImage &dest, const PNMImage &source,
+                  const FilterTable &x_table, const FilterTable &y_table,
+                  int x_begin, int y_begin) :
+    _dest(dest), _source(source), _x_table(x_table), _y_table(y_table),
+    _x_begin(x_begin), _y_begin(y_begin) { }
+
+  virtual void do_range(int begin, int end);
+
+private:
+  PNMImage &_dest;
+  const PNMImage &_source;
+  const FilterTable &_x_table;
+  const FilterTable &_y_table;
+  int _x_begin, _y_begin;
+};
+
+void QuickFilterPass::
+do_range(int begin, int end) {
+  int x_size = _x_table.get_dest_len();
+  bool has_alpha = _dest.has_alpha() && _source.has_alpha();
+  pvector<float> sums(x_size * 4);
+
+  for (int y = begin; y < end; y++) {
+    int x;
+    for (x = 0; x < x_size * 4; x++) {
+      sums[x] = 0.0f;
+    }
+
+    const float *y_weights = _y_table.get_weights(y);
+    int from_y = _y_table.get_left(y);
+    int y_count = _y_table.get_count(y);
+    for (int j = 0; j < y_count; j++, from_y++) {
+      float y_weight = y_weights[j];
+      for (x = 0; x < x_size; x++) {
+        const float *x_weights = _x_table.get_weights(x);
+        int from_x = _x_table.get_left(x);
+        int x_count = _x_table.get_count(x);
+
+        float red = 0.0f, grn = 0.0f, blu = 0.0f, alpha = 0.0f;
+        for (int k = 0; k < x_count; k++, from_x++) {
+          float weight = x_weights[k];
+          red += weight * _source.get_red_val(from_x, from_y);
+          grn += weight * _source.get_green_val(from_x, from_y);
+          blu += weight * _source.get_blue_val(from_x, from_y);
+          if (has_alpha) {
+            alpha += weight * _source.get_alpha_val(from_x, from_y);
+          }
+        }
+
+        float *sum = &sums[x * 4];
+        sum[0] += y_weight * red;
+        sum[1] += y_weight * grn;
+        sum[2] += y_weight * blu;
+        sum[3] += y_weight * alpha;
+      }
+    }
+
+    int to_y = _y_begin + y;
+    for (x = 0; x < x_size; x++) {
+      const float *sum = &sums[x * 4];
+      _dest.set_xel_val(_x_begin + x, to_y,
+                        (xelval)(sum[0] + 0.5f),
+                        (xelval)(sum[1] + 0.5f),
+                        (xelval)(sum[2] + 0.5f));
+      if (_dest.has_alpha()) {
+        // As in the original, a source without alpha filters to zero.
+        _dest.set_alpha_val(_x_begin + x, to_y, (xelval)(sum[3] + 0.5f));
+      }
+    }
+    Thread::consider_yield();
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: PNMImage::quick_filter_from
+//       Access: Public
+//  Description: Resizes from the given image, with a fixed radius of
+//               0.5. This is a very specialized and simple algorithm
+//               that doesn't handle dropping below the Nyquist rate
+//               very well, but is quite a bit faster than the more
+//               general box_filter(), above.  If borders are
+//               specified, they will further restrict the size of the
+//               resulting image. There's no point in using
+//               quick_box_filter() on a single image.
+////////////////////////////////////////////////////////////////////
+void PNMImage::
+quick_filter_from(const PNMImage &from, int xborder, int yborder) {
+  if (!pnm_fast_filter || &from == this) {
+    // Reading and writing the same image gives results that depend on
+    // the order of the rows, so that is left to the original.
+    quick_filter_image(*this, from, xborder, yborder);
+    return;
+  }
+
+  if (!is_valid() || !from.is_valid()) {
+    return;
+  }
+
+  int from_xs = from.get_x_size();
+  int from_ys = from.get_y_size();
+
+  int to_xs = get_x_size() - xborder;
+  int to_ys = get_y_size() - yborder;
+
+  int to_xoff = xborder / 2;
+  int to_yoff = yborder / 2;
+
+  double x_scale = (double)from_xs / (double)to_xs;
+  double y_scale = (double)from_ys / (double)to_ys;
+
+  int x_begin = max(0, -to_xoff);
+  int x_end = min(to_xs, get_x_size()-to_xoff);
+  int y_begin = max(0, -to_yoff);
+  int y_end = min(to_ys, get_y_size()-to_yoff);
+  if (x_begin >= x_end || y_begin >= y_end) {
+    return;
+  }
+
+  // Each pixel's box is the product of a span of columns and a span
+  // of rows, so its weights are too.
+  FilterTable x_table, y_table;
+  x_table.make_box(x_begin, x_end, x_scale, from_xs);
+  y_table.make_box(y_begin, y_end, y_scale, from_ys);
+
+  QuickFilterPass pass(*this, from, x_table, y_table,
+                       to_xoff + x_begin, to_yoff + y_begin);
+  run_filter_pass(pass, y_end - y_begin);
+}
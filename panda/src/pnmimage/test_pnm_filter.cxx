@@ -0,0 +1,143 @@
+// Filename: test_pnm_filter.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pnmImage.h"
+#include "config_pnmimage.h"
+#include "trueClock.h"
+
+#include <stdlib.h>
+
+// This program filters a large RGBA image into several smaller and
+// larger ones with box_filter_from(), gaussian_filter_from(), and
+// quick_filter_from(), first with the original double-precision
+// filters, then with the fast ones in one thread, and then with the
+// fast ones in the given number of threads.  It reports the time
+// taken by each, and checks that the fast filters come within one
+// unit of the original in every channel of every pixel.
+//
+// Usage: test_pnm_filter [size [num_threads]]
+
+static const int num_methods = 3;
+static const char *const method_names[num_methods] = {
+  "box", "gaussian", "quick"
+};
+
+static void
+filter(PNMImage &dest, const PNMImage &source, int method) {
+  switch (method) {
+  case 0:
+    dest.box_filter_from(0.5, source);
+    break;
+
+  case 1:
+    dest.gaussian_filter_from(1.0, source);
+    break;
+
+  default:
+    dest.quick_filter_from(source);
+    break;
+  }
+}
+
+// Returns the largest difference between the two images in any
+// channel of any pixel.
+static int
+max_difference(const PNMImage &a, const PNMImage &b) {
+  int diff = 0;
+  for (int y = 0; y < a.get_y_size(); y++) {
+    for (int x = 0; x < a.get_x_size(); x++) {
+      diff = max(diff, abs((int)a.get_red_val(x, y) - (int)b.get_red_val(x, y)));
+      diff = max(diff, abs((int)a.get_green_val(x, y) - (int)b.get_green_val(x, y)));
+      diff = max(diff, abs((int)a.get_blue_val(x, y) - (int)b.get_blue_val(x, y)));
+      diff = max(diff, abs((int)a.get_alpha_val(x, y) - (int)b.get_alpha_val(x, y)));
+    }
+  }
+  return diff;
+}
+
+int
+main(int argc, char *argv[]) {
+  int size = 2048;
+  int num_threads = 4;
+  if (argc > 1) {
+    size = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_threads = atoi(argv[2]);
+  }
+
+  // A mix of noise and smooth gradients, so that both the edges and
+  // the flat parts are exercised.
+  PNMImage source(size, size * 3 / 4, 4);
+  srand(1);
+  for (int y = 0; y < source.get_y_size(); y++) {
+    for (int x = 0; x < source.get_x_size(); x++) {
+      source.set_xel_val(x, y, rand() % 256, (x * 255) / size, (x ^ y) & 0xff);
+      source.set_alpha_val(x, y, rand() % 256);
+    }
+  }
+
+  // Each destination size is given as a fraction of the source size.
+  static const int num_scales = 4;
+  static const double scales[num_scales][2] = {
+    { 0.25, 0.25 }, { 0.5, 0.3 }, { 1.0, 1.0 }, { 1.7, 1.3 }
+  };
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+  bool all_ok = true;
+
+  for (int s = 0; s < num_scales; s++) {
+    int x_size = max((int)(source.get_x_size() * scales[s][0]), 1);
+    int y_size = max((int)(source.get_y_size() * scales[s][1]), 1);
+
+    for (int method = 0; method < num_methods; method++) {
+      PNMImage original(x_size, y_size, 4);
+      PNMImage fast(x_size, y_size, 4);
+      PNMImage threaded(x_size, y_size, 4);
+
+      pnm_fast_filter.set_value(false);
+      double start = clock->get_short_time();
+      filter(original, source, method);
+      double original_time = clock->get_short_time() - start;
+
+      pnm_fast_filter.set_value(true);
+      pnm_filter_threads.set_value(0);
+      start = clock->get_short_time();
+      filter(fast, source, method);
+      double fast_time = clock->get_short_time() - start;
+
+      pnm_filter_threads.set_value(num_threads);
+      start = clock->get_short_time();
+      filter(threaded, source, method);
+      double threaded_time = clock->get_short_time() - start;
+
+      int diff = max_difference(original, fast);
+      int thread_diff = max_difference(fast, threaded);
+
+      cerr << method_names[method] << " " << source.get_x_size() << "x"
+           << source.get_y_size() << " -> " << x_size << "x" << y_size
+           << ": " << original_time * 1000.0 << " ms original, "
+           << fast_time * 1000.0 << " ms fast, "
+           << threaded_time * 1000.0 << " ms in " << num_threads
+           << " threads; max difference " << diff << "\n";
+
+      if (diff > 1 || thread_diff != 0) {
+        cerr << "  *** fast filter differs from the original\n";
+        all_ok = false;
+      }
+    }
+  }
+
+  return all_ok ? 0 : 1;
+}
@@ -170,6 +170,7 @@ static LevelCollectorProperties level_properties[] = {
   { 1, "Geom cache operations:erase",      { 0.4, 0.8, 0.2 } },
   { 1, "Geom cache operations:evict",      { 0.8, 0.2, 0.4 } },
   { 1, "Data transferred",                 { 0.0, 0.2, 0.4 },  "MB", 12, 1048576 },
+  { 1, "Cull arena",                       { 0.7, 0.4, 0.9 },  "KB", 256, 1024 },
   { 1, "Primitive batches",                { 0.2, 0.5, 0.9 },  "", 500 },
   { 1, "Primitive batches:Other",          { 0.2, 0.2, 0.2 } },
   { 1, "Primitive batches:Triangles",      { 0.8, 0.8, 0.8 } },
@@ -66,3 +66,17 @@
   #define IGATESCAN all
 
 #end lib_target
+
+#begin test_bin_target
+  #define TARGET test_text_generate
+
+  #define SOURCES \
+    test_text_generate.cxx
+
+  #define LOCAL_LIBS \
+    text putil gobj pgraph linmath \
+    pnmtext pnmimage gsgbase mathutil \
+    parametrics
+  #define OTHER_LIBS $[OTHER_LIBS] pystub
+
+#end test_bin_target
@@ -180,6 +180,15 @@ ConfigVariableDouble text_default_underscore_height
  PRC_DESC("Specifies the default height of the underscore line, relative "
           "to the text baseline, when underscoring is enabled."));
 
+ConfigVariableInt text_assemble_cache_size
+("text-assemble-cache-size", 256,
+ PRC_DESC("The number of recently assembled text strings whose geometry "
+          "TextNode will keep around, so that generating the same text "
+          "with the same properties again (as nametags and chat balloons "
+          "do constantly) can copy the previous result instead of "
+          "wordwrapping and assembling it from scratch.  Set this to 0 "
+          "to disable the cache."));
+
 ConfigVariableEnum<Texture::FilterType> text_minfilter
 ("text-minfilter", Texture::FT_linear_mipmap_linear,
  PRC_DESC("The default texture minfilter type for dynamic text fonts"));
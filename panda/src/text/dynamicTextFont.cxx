@@ -29,6 +29,7 @@
 #endif
 
 #include "config_text.h"
+#include "textAssembler.h"
 #include "config_util.h"
 #include "config_express.h"
 #include "virtualFileSystem.h"
@@ -193,6 +194,9 @@ clear() {
   _cache.clear();
   _pages.clear();
   _empty_glyphs.clear();
+
+  // Any text assembled with the old glyphs must be assembled again.
+  TextAssembler::clear_cache();
 }
 
 ////////////////////////////////////////////////////////////////////
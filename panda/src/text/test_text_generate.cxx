@@ -0,0 +1,68 @@
+// Filename: test_text_generate.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "textNode.h"
+#include "textAssembler.h"
+#include "trueClock.h"
+
+// This program times TextNode::generate() on a small set of strings
+// that are regenerated over and over, as nametags and chat balloons
+// are, with and without the TextAssembler cache.
+
+static const char *const strings[] = {
+  "Flippy",
+  "Toon HQ",
+  "Hi!",
+  "Let's go to the Playground!",
+  "I need more laff points.  Can you give me some of your jellybeans?",
+  "Thanks!",
+  "Goodbye!",
+  "Who wants to ride the trolley?",
+};
+static const int num_strings = sizeof(strings) / sizeof(strings[0]);
+static const int num_generates = 20000;
+
+static double
+run(TextNode *node) {
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double start = clock->get_short_time();
+  for (int i = 0; i < num_generates; ++i) {
+    node->set_text(strings[i % num_strings]);
+    node->generate();
+  }
+  return clock->get_short_time() - start;
+}
+
+int
+main(int argc, char *argv[]) {
+  PT(TextNode) node = new TextNode("test");
+  node->set_wordwrap(8.0f);
+  node->set_align(TextNode::A_center);
+
+  TextAssembler::set_cache_size(0);
+  double uncached = run(node);
+
+  TextAssembler::set_cache_size(-1);
+  TextAssembler::reset_cache_stats();
+  double cached = run(node);
+
+  nout << num_generates << " generates:\n"
+       << "  uncached: " << uncached << " s ("
+       << num_generates / uncached << " per second)\n"
+       << "  cached:   " << cached << " s ("
+       << num_generates / cached << " per second), "
+       << TextAssembler::get_cache_hits() << " hits, "
+       << TextAssembler::get_cache_misses() << " misses\n";
+  return 0;
+}
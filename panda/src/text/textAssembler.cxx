@@ -32,6 +32,7 @@
 #include "geomVertexData.h"
 #include "geom.h"
 #include "modelNode.h"
+#include "lightMutexHolder.h"
 
 #include <ctype.h>
 #include <stdio.h>  // for sprintf
@@ -54,6 +55,14 @@ static const float small_squash_accent_scale_y = 0.3f;
 // character of a two-character ligature.
 static const float ligature_advance_scale = 0.6f;
 
+TextAssembler::Cache *TextAssembler::_cache = NULL;
+TextAssembler::CacheLru *TextAssembler::_cache_lru = NULL;
+UpdateSeq TextAssembler::_cache_properties_seq;
+int TextAssembler::_cache_size = -1;
+int TextAssembler::_cache_hits = 0;
+int TextAssembler::_cache_misses = 0;
+LightMutex &TextAssembler::_cache_lock = *new LightMutex("TextAssembler::_cache_lock");
+
 
 ////////////////////////////////////////////////////////////////////
 //     Function: isspacew
@@ -828,6 +837,198 @@ is_whitespace(wchar_t character, const TextProperties &properties) {
   return glyph->is_whitespace();
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::set_cache_size
+//       Access: Published, Static
+//  Description: Specifies the maximum number of assembled strings
+//               that will be retained for reuse by assemble_wtext().
+//               Set this to 0 to disable the cache, or to -1 to
+//               restore the default from text-assemble-cache-size.
+////////////////////////////////////////////////////////////////////
+void TextAssembler::
+set_cache_size(int cache_size) {
+  LightMutexHolder holder(_cache_lock);
+  _cache_size = cache_size;
+
+  int max_size = get_cache_size();
+  if (_cache_lru != (CacheLru *)NULL) {
+    while ((int)_cache_lru->size() > max_size) {
+      _cache->erase(*_cache_lru->back());
+      _cache_lru->pop_back();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::get_cache_size
+//       Access: Published, Static
+//  Description: Returns the maximum number of assembled strings
+//               that will be retained for reuse by assemble_wtext().
+//               See set_cache_size().
+////////////////////////////////////////////////////////////////////
+int TextAssembler::
+get_cache_size() {
+  if (_cache_size < 0) {
+    return max((int)text_assemble_cache_size, 0);
+  }
+  return _cache_size;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::clear_cache
+//       Access: Published, Static
+//  Description: Empties the cache of assembled strings.  This is
+//               called automatically when a DynamicTextFont is
+//               cleared, or when any of the definitions in the
+//               TextPropertiesManager change.
+////////////////////////////////////////////////////////////////////
+void TextAssembler::
+clear_cache() {
+  LightMutexHolder holder(_cache_lock);
+  do_clear_cache();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::get_cache_hits
+//       Access: Published, Static
+//  Description: Returns the number of times assemble_wtext() has
+//               been able to reuse a previously assembled string
+//               since the last call to reset_cache_stats().
+////////////////////////////////////////////////////////////////////
+int TextAssembler::
+get_cache_hits() {
+  LightMutexHolder holder(_cache_lock);
+  return _cache_hits;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::get_cache_misses
+//       Access: Published, Static
+//  Description: Returns the number of times assemble_wtext() has
+//               had to assemble a string from scratch since the last
+//               call to reset_cache_stats().  Strings that are not
+//               eligible for caching at all are not counted.
+////////////////////////////////////////////////////////////////////
+int TextAssembler::
+get_cache_misses() {
+  LightMutexHolder holder(_cache_lock);
+  return _cache_misses;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::reset_cache_stats
+//       Access: Published, Static
+//  Description: Resets the counts returned by get_cache_hits() and
+//               get_cache_misses() to zero.
+////////////////////////////////////////////////////////////////////
+void TextAssembler::
+reset_cache_stats() {
+  LightMutexHolder holder(_cache_lock);
+  _cache_hits = 0;
+  _cache_misses = 0;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::assemble_wtext
+//       Access: Public
+//  Description: Does the work of set_wtext() and assemble_text()
+//               together, and returns the assembled geometry along
+//               with its layout information.
+//
+//               If the same string has recently been assembled with
+//               the same properties, a copy of the previous result is
+//               returned instead, and the wordwrap and glyph
+//               placement are skipped entirely.  In this case, the
+//               TextAssembler's own per-character information (e.g.
+//               get_num_rows(), get_xpos()) is not filled in; use the
+//               values in the returned AssembledText instead.
+//
+//               Strings with embedded graphics are never cached,
+//               since the graphic models may be changed without
+//               notice.
+////////////////////////////////////////////////////////////////////
+PT(TextAssembler::AssembledText) TextAssembler::
+assemble_wtext(const wstring &wtext) {
+  bool cacheable = (get_cache_size() > 0 &&
+                    wtext.find((wchar_t)text_embed_graphic_key.get_value()) == wstring::npos);
+
+  CacheKey key;
+  if (cacheable) {
+    key._wtext = wtext;
+    key._properties = _initial_cprops->_properties;
+    key._font = key._properties.get_font();
+    key._encoding = (_encoder != (TextEncoder *)NULL) ?
+      _encoder->get_encoding() : TextEncoder::get_default_encoding();
+    key._usage_hint = _usage_hint;
+    key._max_rows = _max_rows;
+    key._dynamic_merge = _dynamic_merge;
+    key._multiline_mode = _multiline_mode;
+
+    LightMutexHolder holder(_cache_lock);
+    if (_cache == (Cache *)NULL) {
+      _cache = new Cache;
+      _cache_lru = new CacheLru;
+    }
+
+    // If any named properties have been redefined since we filled
+    // the cache, the cached strings that reference them may be wrong.
+    UpdateSeq properties_seq = TextPropertiesManager::get_global_ptr()->get_update_seq();
+    if (properties_seq != _cache_properties_seq) {
+      do_clear_cache();
+      _cache_properties_seq = properties_seq;
+    }
+
+    Cache::iterator ci = _cache->find(key);
+    if (ci != _cache->end()) {
+      ++_cache_hits;
+      CacheEntry &entry = (*ci).second;
+      _cache_lru->splice(_cache_lru->begin(), *_cache_lru, entry._lru);
+
+      // The caller will parent and flatten the result, so it gets
+      // its own copy of the nodes.  The Geoms themselves are shared
+      // until they are modified.
+      PT(AssembledText) result = new AssembledText(*entry._text);
+      result->_text_root = entry._text->_text_root->copy_subgraph();
+      return result;
+    }
+    ++_cache_misses;
+  }
+
+  PT(AssembledText) result = new AssembledText;
+  result->_all_set = set_wtext(wtext);
+  result->_text_root = assemble_text();
+  result->_ul = _ul;
+  result->_lr = _lr;
+  result->_num_rows = get_num_rows();
+  result->_wordwrapped_wtext = get_wordwrapped_wtext();
+
+  if (cacheable) {
+    PT(AssembledText) stored = new AssembledText(*result);
+    stored->_text_root = result->_text_root->copy_subgraph();
+
+    LightMutexHolder holder(_cache_lock);
+    int max_size = get_cache_size();
+    pair<Cache::iterator, bool> ir =
+      _cache->insert(Cache::value_type(key, CacheEntry()));
+    CacheEntry &entry = (*ir.first).second;
+    entry._text = stored;
+    if (ir.second) {
+      _cache_lru->push_front(&(*ir.first).first);
+      entry._lru = _cache_lru->begin();
+    } else {
+      // Another thread got here first.
+      _cache_lru->splice(_cache_lru->begin(), *_cache_lru, entry._lru);
+    }
+
+    while ((int)_cache_lru->size() > max_size) {
+      _cache->erase(*_cache_lru->back());
+      _cache_lru->pop_back();
+    }
+  }
+
+  return result;
+}
+
 #ifndef CPPPARSER  // interrogate has a bit of trouble with wstring.
 ////////////////////////////////////////////////////////////////////
 //     Function: TextAssembler::scan_wtext
@@ -2402,3 +2603,48 @@ append_geom(GeomNode *geom_node, const RenderState *state) {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::do_clear_cache
+//       Access: Private, Static
+//  Description: The implementation of clear_cache().  Assumes the
+//               lock is already held.
+////////////////////////////////////////////////////////////////////
+void TextAssembler::
+do_clear_cache() {
+  if (_cache != (Cache *)NULL) {
+    _cache_lru->clear();
+    _cache->clear();
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: TextAssembler::CacheKey::operator <
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+bool TextAssembler::CacheKey::
+operator < (const CacheKey &other) const {
+  if (_font != other._font) {
+    return _font < other._font;
+  }
+  if (_max_rows != other._max_rows) {
+    return _max_rows < other._max_rows;
+  }
+  if (_usage_hint != other._usage_hint) {
+    return _usage_hint < other._usage_hint;
+  }
+  if (_encoding != other._encoding) {
+    return _encoding < other._encoding;
+  }
+  if (_dynamic_merge != other._dynamic_merge) {
+    return (int)_dynamic_merge < (int)other._dynamic_merge;
+  }
+  if (_multiline_mode != other._multiline_mode) {
+    return (int)_multiline_mode < (int)other._multiline_mode;
+  }
+  int compare = _wtext.compare(other._wtext);
+  if (compare != 0) {
+    return compare < 0;
+  }
+  return _properties.compare_to(other._properties) < 0;
+}
@@ -26,8 +26,11 @@
 #include "textPropertiesManager.h"
 #include "textEncoder.h"
 #include "geomVertexRewriter.h"
+#include "updateSeq.h"
+#include "lightMutex.h"
 
 #include "pmap.h"
+#include "plist.h"
 
 
 class TextEncoder;
@@ -107,6 +110,29 @@ PUBLISHED:
   static bool has_character(wchar_t character, const TextProperties &properties);
   static bool is_whitespace(wchar_t character, const TextProperties &properties);
 
+  static void set_cache_size(int cache_size);
+  static int get_cache_size();
+  static void clear_cache();
+  static int get_cache_hits();
+  static int get_cache_misses();
+  static void reset_cache_stats();
+
+public:
+  // This is the result of assemble_wtext(): the assembled geometry,
+  // along with the layout information that would otherwise be
+  // queried from the TextAssembler after assemble_text().
+  class AssembledText : public ReferenceCount {
+  public:
+    PT(PandaNode) _text_root;
+    bool _all_set;
+    LVector2f _ul;
+    LVector2f _lr;
+    int _num_rows;
+    wstring _wordwrapped_wtext;
+  };
+
+  PT(AssembledText) assemble_wtext(const wstring &wtext);
+
 private:
   class ComputedProperties : public ReferenceCount {
   public:
@@ -310,6 +336,42 @@ private:
   bool _dynamic_merge;
   bool _multiline_mode;
 
+  // The cache of recently assembled text, shared by all
+  // TextAssemblers.  It is keyed on everything that affects the
+  // output of set_wtext() and assemble_text().
+  class CacheKey {
+  public:
+    bool operator < (const CacheKey &other) const;
+
+    wstring _wtext;
+    TextProperties _properties;
+    PT(TextFont) _font;
+    TextEncoder::Encoding _encoding;
+    Geom::UsageHint _usage_hint;
+    int _max_rows;
+    bool _dynamic_merge;
+    bool _multiline_mode;
+  };
+
+  // Least-recently-used entries are at the back of the list.
+  typedef plist<const CacheKey *> CacheLru;
+
+  class CacheEntry {
+  public:
+    PT(AssembledText) _text;
+    CacheLru::iterator _lru;
+  };
+  typedef pmap<CacheKey, CacheEntry> Cache;
+
+  static void do_clear_cache();
+
+  static Cache *_cache;
+  static CacheLru *_cache_lru;
+  static UpdateSeq _cache_properties_seq;
+  static int _cache_size;
+  static int _cache_hits;
+  static int _cache_misses;
+  static LightMutex &_cache_lock;
 };
 
 #include "textAssembler.I"
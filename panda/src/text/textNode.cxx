@@ -398,8 +398,8 @@ generate() {
   assembler.set_max_rows(_max_rows);
   assembler.set_usage_hint(_usage_hint);
   assembler.set_dynamic_merge((_flatten_flags & FF_dynamic_merge) != 0);
-  bool all_set = assembler.set_wtext(wtext);
-  if (all_set) {
+  PT(TextAssembler::AssembledText) assembled = assembler.assemble_wtext(wtext);
+  if (assembled->_all_set) {
     // No overflow.
     _flags &= ~F_has_overflow;
   } else {
@@ -407,11 +407,11 @@ generate() {
     _flags |= F_has_overflow;
   }
 
-  PT(PandaNode) text_root = assembler.assemble_text();
-  _text_ul = assembler.get_ul();
-  _text_lr = assembler.get_lr();
-  _num_rows = assembler.get_num_rows();
-  _wordwrapped_wtext = assembler.get_wordwrapped_wtext();
+  PT(PandaNode) text_root = assembled->_text_root;
+  _text_ul = assembled->_ul;
+  _text_lr = assembled->_lr;
+  _num_rows = assembled->_num_rows;
+  _wordwrapped_wtext = assembled->_wordwrapped_wtext;
 
   // Parent the text in.
   PT(PandaNode) text = new PandaNode("text");
@@ -420,8 +420,8 @@ generate() {
 
   // Save the bounding-box information about the text in a form
   // friendly to the user.
-  const LVector2f &ul = assembler.get_ul();
-  const LVector2f &lr = assembler.get_lr();
+  const LVector2f &ul = assembled->_ul;
+  const LVector2f &lr = assembled->_lr;
   _ul3d.set(ul[0], 0.0f, ul[1]);
   _lr3d.set(lr[0], 0.0f, lr[1]);
 
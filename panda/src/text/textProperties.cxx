@@ -167,6 +167,93 @@ operator == (const TextProperties &other) const {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: TextProperties::compare_to
+//       Access: Published
+//  Description: Returns a number less than zero if this
+//               TextProperties sorts before the other one, greater
+//               than zero if it sorts after, or 0 if they are
+//               equivalent.  As in operator ==, only the properties
+//               that have been specified are compared.
+////////////////////////////////////////////////////////////////////
+int TextProperties::
+compare_to(const TextProperties &other) const {
+  if (_specified != other._specified) {
+    return (_specified < other._specified) ? -1 : 1;
+  }
+
+  if ((_specified & F_has_font) && _font != other._font) {
+    return (_font < other._font) ? -1 : 1;
+  }
+  if ((_specified & F_has_small_caps) && _small_caps != other._small_caps) {
+    return (_small_caps < other._small_caps) ? -1 : 1;
+  }
+  if ((_specified & F_has_small_caps_scale) && _small_caps_scale != other._small_caps_scale) {
+    return (_small_caps_scale < other._small_caps_scale) ? -1 : 1;
+  }
+  if ((_specified & F_has_slant) && _slant != other._slant) {
+    return (_slant < other._slant) ? -1 : 1;
+  }
+  if ((_specified & F_has_underscore) && _underscore != other._underscore) {
+    return (_underscore < other._underscore) ? -1 : 1;
+  }
+  if ((_specified & F_has_underscore_height) && _underscore_height != other._underscore_height) {
+    return (_underscore_height < other._underscore_height) ? -1 : 1;
+  }
+  if ((_specified & F_has_align) && _align != other._align) {
+    return (_align < other._align) ? -1 : 1;
+  }
+  if ((_specified & F_has_indent) && _indent_width != other._indent_width) {
+    return (_indent_width < other._indent_width) ? -1 : 1;
+  }
+  if ((_specified & F_has_wordwrap) && _wordwrap_width != other._wordwrap_width) {
+    return (_wordwrap_width < other._wordwrap_width) ? -1 : 1;
+  }
+  if ((_specified & F_has_preserve_trailing_whitespace) && _preserve_trailing_whitespace != other._preserve_trailing_whitespace) {
+    return (_preserve_trailing_whitespace < other._preserve_trailing_whitespace) ? -1 : 1;
+  }
+  if (_specified & F_has_text_color) {
+    int compare = _text_color.compare_to(other._text_color);
+    if (compare != 0) {
+      return compare;
+    }
+  }
+  if (_specified & F_has_shadow_color) {
+    int compare = _shadow_color.compare_to(other._shadow_color);
+    if (compare != 0) {
+      return compare;
+    }
+  }
+  if (_specified & F_has_shadow) {
+    int compare = _shadow_offset.compare_to(other._shadow_offset);
+    if (compare != 0) {
+      return compare;
+    }
+  }
+  if (_specified & F_has_bin) {
+    int compare = _bin.compare(other._bin);
+    if (compare != 0) {
+      return compare;
+    }
+  }
+  if ((_specified & F_has_draw_order) && _draw_order != other._draw_order) {
+    return (_draw_order < other._draw_order) ? -1 : 1;
+  }
+  if ((_specified & F_has_tab_width) && _tab_width != other._tab_width) {
+    return (_tab_width < other._tab_width) ? -1 : 1;
+  }
+  if ((_specified & F_has_glyph_scale) && _glyph_scale != other._glyph_scale) {
+    return (_glyph_scale < other._glyph_scale) ? -1 : 1;
+  }
+  if ((_specified & F_has_glyph_shift) && _glyph_shift != other._glyph_shift) {
+    return (_glyph_shift < other._glyph_shift) ? -1 : 1;
+  }
+  if ((_specified & F_has_text_scale) && _text_scale != other._text_scale) {
+    return (_text_scale < other._text_scale) ? -1 : 1;
+  }
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: TextProperties::clear
 //       Access: Published
@@ -60,6 +60,7 @@ PUBLISHED:
 
   bool operator == (const TextProperties &other) const;
   INLINE bool operator != (const TextProperties &other) const;
+  int compare_to(const TextProperties &other) const;
 
   void clear();
   INLINE bool is_any_specified() const;
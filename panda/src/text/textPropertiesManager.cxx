@@ -54,7 +54,14 @@ TextPropertiesManager::
 ////////////////////////////////////////////////////////////////////
 void TextPropertiesManager::
 set_properties(const string &name, const TextProperties &properties) {
-  _properties[name] = properties;
+  Properties::iterator pi = _properties.find(name);
+  if (pi == _properties.end()) {
+    _properties[name] = properties;
+    ++_update_seq;
+  } else if ((*pi).second.compare_to(properties) != 0) {
+    (*pi).second = properties;
+    ++_update_seq;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -80,6 +87,9 @@ get_properties(const string &name) {
   text_cat.warning()
     << "Creating default TextProperties for name '" << name << "'\n";
 
+  // A default TextProperties changes nothing when it is applied, so
+  // text already assembled with this name is still valid, and the
+  // update sequence need not change.
   TextProperties default_properties;
   _properties[name] = default_properties;
   return default_properties;
@@ -111,7 +121,9 @@ has_properties(const string &name) const {
 ////////////////////////////////////////////////////////////////////
 void TextPropertiesManager::
 clear_properties(const string &name) {
-  _properties.erase(name);
+  if (_properties.erase(name) != 0) {
+    ++_update_seq;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -130,6 +142,7 @@ clear_properties(const string &name) {
 void TextPropertiesManager::
 set_graphic(const string &name, const TextGraphic &graphic) {
   _graphics[name] = graphic;
+  ++_update_seq;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -154,6 +167,7 @@ set_graphic(const string &name, const NodePath &model) {
                       max_point.dot(LVector3f::up()));
 
   _graphics[name] = graphic;
+  ++_update_seq;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -179,6 +193,8 @@ get_graphic(const string &name) {
   text_cat.warning()
     << "Creating default TextGraphic for name '" << name << "'\n";
 
+  // Text with embedded graphics is never cached by TextAssembler, so
+  // there is no need to change the update sequence here.
   TextGraphic default_graphic;
   _graphics[name] = default_graphic;
   return default_graphic;
@@ -210,7 +226,9 @@ has_graphic(const string &name) const {
 ////////////////////////////////////////////////////////////////////
 void TextPropertiesManager::
 clear_graphic(const string &name) {
-  _graphics.erase(name);
+  if (_graphics.erase(name) != 0) {
+    ++_update_seq;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////
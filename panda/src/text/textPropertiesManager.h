@@ -20,6 +20,7 @@
 #include "config_text.h"
 #include "textProperties.h"
 #include "textGraphic.h"
+#include "updateSeq.h"
 
 ////////////////////////////////////////////////////////////////////
 //       Class : TextPropertiesManager
@@ -75,6 +76,8 @@ public:
   const TextProperties *get_properties_ptr(const string &name);
   const TextGraphic *get_graphic_ptr(const string &name);
 
+  INLINE UpdateSeq get_update_seq() const;
+
 private:
   typedef pmap<string, TextProperties> Properties;
   Properties _properties;
@@ -82,6 +85,8 @@ private:
   typedef pmap<string, TextGraphic> Graphics;
   Graphics _graphics;
 
+  UpdateSeq _update_seq;
+
   static TextPropertiesManager *_global_ptr;
 };
 
@@ -26,6 +26,17 @@
   #define INSTALL_HEADERS
 #end bin_target
 
+#begin bin_target
+  #define TARGET bam-vertex-cache
+  #define LOCAL_LIBS \
+    progbase
+
+  #define SOURCES \
+    bamVertexCache.cxx bamVertexCache.h
+
+  #define INSTALL_HEADERS
+#end bin_target
+
 #begin bin_target
   #define TARGET egg2bam
   #define LOCAL_LIBS \
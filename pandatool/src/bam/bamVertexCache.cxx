@@ -0,0 +1,254 @@
+// Filename: bamVertexCache.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "bamVertexCache.h"
+
+#include "bamFile.h"
+#include "geomNode.h"
+#include "geom.h"
+#include "geomPrimitive.h"
+#include "load_egg_file.h"
+#include "sceneGraphReducer.h"
+#include "nodePath.h"
+#include "dcast.h"
+#include "pystub.h"
+
+////////////////////////////////////////////////////////////////////
+//     Function: BamVertexCache::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+BamVertexCache::
+BamVertexCache() {
+  set_program_description
+    ("This program reads one or more bam or egg files and reports how "
+     "well their triangles use the graphics card's post-transform vertex "
+     "cache, as the average cache miss ratio (ACMR): the number of "
+     "vertices transformed per triangle drawn.  This is 3.0 for no "
+     "vertex reuse at all, and around 0.6 to 0.7 for a well-ordered "
+     "mesh.  With -opt, it also reports the ratio after reordering "
+     "the triangles and vertices for the cache.");
+
+  clear_runlines();
+  add_runline("[opts] input.bam [input.egg ... ]");
+  add_runline("[opts] -opt -o output.bam input.bam");
+
+  add_option
+    ("c", "cache_size", 0,
+     "Specify the number of entries in the FIFO vertex cache to simulate.  "
+     "The default is 16, which is typical of older hardware; newer "
+     "hardware may have 24 or 32.",
+     &BamVertexCache::dispatch_int, NULL, &_cache_size);
+
+  add_option
+    ("opt", "", 0,
+     "Reorder the triangles and vertices of each model for the vertex "
+     "cache, and report the ratio afterwards as well.",
+     &BamVertexCache::dispatch_none, &_optimize);
+
+  add_option
+    ("o", "filename", 0,
+     "Write the optimized model to the indicated bam file.  This is only "
+     "allowed with a single input file.",
+     &BamVertexCache::dispatch_filename, &_got_output_filename,
+     &_output_filename);
+
+  _cache_size = 16;
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: BamVertexCache::run
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+void BamVertexCache::
+run() {
+  bool okflag = true;
+
+  double total_misses = 0.0;
+  int total_triangles = 0;
+  double total_opt_misses = 0.0;
+  int total_opt_triangles = 0;
+
+  Filenames::const_iterator fi;
+  for (fi = _filenames.begin(); fi != _filenames.end(); ++fi) {
+    PT(PandaNode) node = read_model(*fi);
+    if (node == (PandaNode *)NULL) {
+      okflag = false;
+      continue;
+    }
+
+    report((*fi).get_basename(), node, total_misses, total_triangles);
+
+    if (_optimize) {
+      SceneGraphReducer gr;
+      int num_changed = gr.optimize_vertex_cache(node);
+      nout << "  optimized " << num_changed << " GeomNodes\n";
+      report("  optimized", node, total_opt_misses, total_opt_triangles);
+
+      if (_got_output_filename) {
+        if (!NodePath(node).write_bam_file(_output_filename)) {
+          nout << "Unable to write " << _output_filename << "\n";
+          okflag = false;
+        }
+      }
+    }
+  }
+
+  if (_filenames.size() > 1) {
+    nout << "\ntotal: " << total_triangles << " triangles";
+    if (total_triangles != 0) {
+      nout << ", ACMR " << total_misses / total_triangles;
+    }
+    if (_optimize && total_opt_triangles != 0) {
+      nout << ", " << total_opt_misses / total_opt_triangles
+           << " optimized";
+    }
+    nout << "\n";
+  }
+
+  if (!okflag) {
+    // Exit with an error if any of the files was unreadable.
+    exit(1);
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: BamVertexCache::handle_args
+//       Access: Protected, Virtual
+//  Description:
+////////////////////////////////////////////////////////////////////
+bool BamVertexCache::
+handle_args(ProgramBase::Args &args) {
+  if (args.empty()) {
+    nout << "You must specify the model file(s) to read on the command line.\n";
+    return false;
+  }
+  if (_cache_size <= 0) {
+    nout << "The cache size must be at least 1.\n";
+    return false;
+  }
+  if (_got_output_filename && (!_optimize || args.size() != 1)) {
+    nout << "-o requires -opt and exactly one input file.\n";
+    return false;
+  }
+
+  ProgramBase::Args::const_iterator ai;
+  for (ai = args.begin(); ai != args.end(); ++ai) {
+    _filenames.push_back(Filename::from_os_specific(*ai));
+  }
+
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: BamVertexCache::read_model
+//       Access: Private
+//  Description: Reads the scene graph from the indicated bam or egg
+//               file.  Returns NULL on error.
+////////////////////////////////////////////////////////////////////
+PT(PandaNode) BamVertexCache::
+read_model(const Filename &filename) {
+  if (filename.get_extension() == "egg") {
+    PT(PandaNode) node = load_egg_file(filename);
+    if (node == (PandaNode *)NULL) {
+      nout << "Unable to read " << filename << "\n";
+    }
+    return node;
+  }
+
+  BamFile bam_file;
+  if (!bam_file.open_read(filename)) {
+    nout << "Unable to read " << filename << "\n";
+    return NULL;
+  }
+
+  PT(PandaNode) node = bam_file.read_node();
+  if (node == (PandaNode *)NULL) {
+    nout << filename << " does not contain a scene graph.\n";
+  }
+  return node;
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: BamVertexCache::r_count_misses
+//       Access: Private
+//  Description: Accumulates the number of vertex cache misses, and
+//               the number of triangles, of all of the Geoms at the
+//               indicated node and below.
+////////////////////////////////////////////////////////////////////
+void BamVertexCache::
+r_count_misses(PandaNode *node, double &num_misses, int &num_triangles) {
+  if (node->is_geom_node()) {
+    GeomNode *geom_node = DCAST(GeomNode, node);
+    int num_geoms = geom_node->get_num_geoms();
+    for (int i = 0; i < num_geoms; ++i) {
+      CPT(Geom) geom = geom_node->get_geom(i);
+      int num_primitives = geom->get_num_primitives();
+      for (int j = 0; j < num_primitives; ++j) {
+        CPT(GeomPrimitive) prim = geom->get_primitive(j)->decompose();
+        if (prim->get_primitive_type() == GeomPrimitive::PT_polygons) {
+          int prim_triangles = prim->get_num_primitives();
+          num_misses += prim->calc_acmr(_cache_size) * prim_triangles;
+          num_triangles += prim_triangles;
+        }
+      }
+    }
+  }
+
+  int num_children = node->get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    r_count_misses(node->get_child(i), num_misses, num_triangles);
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: BamVertexCache::report
+//       Access: Private
+//  Description: Writes the average cache miss ratio of the scene
+//               graph, and adds its misses and triangles to the
+//               indicated totals.
+////////////////////////////////////////////////////////////////////
+void BamVertexCache::
+report(const string &label, PandaNode *node,
+       double &total_misses, int &total_triangles) {
+  double num_misses = 0.0;
+  int num_triangles = 0;
+  r_count_misses(node, num_misses, num_triangles);
+
+  nout << label << ": " << num_triangles << " triangles";
+  if (num_triangles != 0) {
+    nout << ", ACMR " << num_misses / num_triangles;
+  }
+  nout << "\n";
+
+  total_misses += num_misses;
+  total_triangles += num_triangles;
+}
+
+
+int main(int argc, char *argv[]) {
+  // A call to pystub() to force libpystub.so to be linked in.
+  pystub();
+
+  BamVertexCache prog;
+  prog.parse_command_line(argc, argv);
+  prog.run();
+  return 0;
+}
@@ -0,0 +1,58 @@
+// Filename: bamVertexCache.h
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef BAMVERTEXCACHE_H
+#define BAMVERTEXCACHE_H
+
+#include "pandatoolbase.h"
+
+#include "programBase.h"
+#include "filename.h"
+#include "pandaNode.h"
+
+#include "pvector.h"
+
+////////////////////////////////////////////////////////////////////
+//       Class : BamVertexCache
+// Description : Reports the average cache miss ratio of the
+//               triangles in one or more bam or egg files, optionally
+//               after reordering them for the vertex cache with
+//               SceneGraphReducer::optimize_vertex_cache().
+////////////////////////////////////////////////////////////////////
+class BamVertexCache : public ProgramBase {
+public:
+  BamVertexCache();
+
+  void run();
+
+protected:
+  virtual bool handle_args(Args &args);
+
+private:
+  PT(PandaNode) read_model(const Filename &filename);
+  void r_count_misses(PandaNode *node, double &num_misses,
+                      int &num_triangles);
+  void report(const string &label, PandaNode *node,
+              double &total_misses, int &total_triangles);
+
+  typedef pvector<Filename> Filenames;
+  Filenames _filenames;
+
+  int _cache_size;
+  bool _optimize;
+  Filename _output_filename;
+  bool _got_output_filename;
+};
+
+#endif
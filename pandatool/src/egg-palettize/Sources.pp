@@ -23,6 +23,15 @@
 
 #end bin_target
 
+#begin test_bin_target
+  #define TARGET test_palettize
+  #define OTHER_LIBS $[OTHER_LIBS] pystub
+
+  #define SOURCES \
+    test_palettize.cxx
+
+#end test_bin_target
+
 #begin lib_target
   #define TARGET txafile
   #define BUILDING_DLL BUILDING_MISC
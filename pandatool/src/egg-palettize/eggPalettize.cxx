@@ -212,12 +212,20 @@ EggPalettize() : EggMultiFilter(true) {
      &EggPalettize::dispatch_none, &_dont_lock_txa);
   */
 
+  add_option
+    ("threads", "num", 0,
+     "Read, generate, and write the texture images in the indicated "
+     "number of threads.  The images written are the same as with one "
+     "thread, which is the default.",
+     &EggPalettize::dispatch_int, NULL, &_num_threads);
+
   add_option
     ("H", "", 0,
      "Describe the syntax of the attributes file.",
      &EggPalettize::dispatch_none, &_describe_input_file);
 
   _txa_filename = "textures.txa";
+  _num_threads = 1;
 }
 
 
@@ -693,6 +701,7 @@ run() {
   }
 
   pal->set_noabs(_noabs);
+  pal->_num_threads = _num_threads;
 
   if (_report_pi) {
     pal->report_pi();
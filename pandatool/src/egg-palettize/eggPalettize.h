@@ -66,6 +66,7 @@ private:
   bool _redo_all;
   bool _redo_eggs;
   bool _dont_lock_txa;
+  int _num_threads;
 
   bool _describe_input_file;
   bool _remove_eggs;
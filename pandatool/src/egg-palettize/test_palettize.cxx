@@ -0,0 +1,295 @@
+// Filename: test_palettize.cxx
+// Created by:  agent (19Oct26)
+//
+////////////////////////////////////////////////////////////////////
+//
+// PANDA 3D SOFTWARE
+// Copyright (c) Carnegie Mellon University.  All rights reserved.
+//
+// All use of this software is subject to the terms of the revised BSD
+// license.  You should have received a copy of this license along
+// with this source code in a file named "LICENSE."
+//
+////////////////////////////////////////////////////////////////////
+
+#include "pandabase.h"
+#include "pnmImage.h"
+#include "filename.h"
+#include "pnotify.h"
+#include "pystub.h"
+#include "vector_string.h"
+#include "string_utils.h"
+
+#include <stdlib.h>
+#include <algorithm>
+
+// This program checks that egg-palettize -threads writes the same
+// files as a run with one thread.  It generates a set of textures, egg
+// files and a textures.txa in two identical directory trees under a
+// temporary directory, runs egg-palettize in each, once with one
+// thread and once with several, and compares every file written,
+// byte for byte.
+//
+// The textures are shared between two palette groups, so that several
+// palette images read the same source texture, and one egg file
+// repeats its texture, so that the texture is left off the palettes
+// and copied instead.  The only difference allowed in the output is
+// the comment in each egg file that records the command line.
+//
+// Usage: test_palettize [-threads num] [egg-palettize]
+
+static const int num_textures = 24;
+static const int num_eggs = 6;
+
+typedef pvector<Filename> Filenames;
+
+////////////////////////////////////////////////////////////////////
+//     Function: write_texture
+//  Description: Writes a texture with a pattern that depends on its
+//               index, so that each texture is different.
+////////////////////////////////////////////////////////////////////
+static bool
+write_texture(const Filename &filename, int index) {
+  int size = 16 << (index % 4);
+  bool has_alpha = (index % 3 == 0);
+  PNMImage image(size + (index % 5) * 8, size, has_alpha ? 4 : 3);
+  for (int y = 0; y < image.get_y_size(); ++y) {
+    for (int x = 0; x < image.get_x_size(); ++x) {
+      image.set_xel(x, y, (double)((x * (index + 1)) % 17) / 16.0,
+                    (double)((y * (index + 3)) % 13) / 12.0,
+                    (double)((x + y + index) % 7) / 6.0);
+      if (has_alpha) {
+        image.set_alpha(x, y, (double)((x ^ y) % 5) / 4.0);
+      }
+    }
+  }
+  return image.write(filename);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: write_egg
+//  Description: Writes an egg file with one square for each of a
+//               range of the textures.  The last egg file repeats its
+//               textures across each square.
+////////////////////////////////////////////////////////////////////
+static bool
+write_egg(const Filename &filename, int index) {
+  Filename egg_filename = Filename::text_filename(filename);
+  ofstream out;
+  if (!egg_filename.open_write(out)) {
+    return false;
+  }
+
+  double uv_max = (index == num_eggs - 1) ? 3.0 : 1.0;
+  int first = index * num_textures / num_eggs / 2;
+  int last = first + num_textures / 2;
+
+  out << "<CoordinateSystem> { Z-Up }\n\n";
+  int t;
+  for (t = first; t < last; ++t) {
+    out << "<Texture> tex" << t << " {\n"
+        << "  \"tex" << t << ".rgb\"\n"
+        << "}\n";
+  }
+
+  out << "<VertexPool> pool {\n";
+  for (t = first; t < last; ++t) {
+    int v = (t - first) * 4;
+    double x = (double)(t - first);
+    out << "  <Vertex> " << v << " { " << x << " 0 0 <UV> { 0 0 } }\n"
+        << "  <Vertex> " << v + 1 << " { " << x + 1 << " 0 0 <UV> { "
+        << uv_max << " 0 } }\n"
+        << "  <Vertex> " << v + 2 << " { " << x + 1 << " 0 1 <UV> { "
+        << uv_max << " " << uv_max << " } }\n"
+        << "  <Vertex> " << v + 3 << " { " << x << " 0 1 <UV> { 0 "
+        << uv_max << " } }\n";
+  }
+  out << "}\n";
+
+  out << "<Group> model" << index << " {\n";
+  for (t = first; t < last; ++t) {
+    int v = (t - first) * 4;
+    out << "  <Polygon> {\n"
+        << "    <TRef> { tex" << t << " }\n"
+        << "    <VertexRef> { " << v << " " << v + 1 << " " << v + 2
+        << " " << v + 3 << " <Ref> { pool } }\n"
+        << "  }\n";
+  }
+  out << "}\n";
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: write_source
+//  Description: Writes the textures, egg files and textures.txa into
+//               the indicated directory.
+////////////////////////////////////////////////////////////////////
+static bool
+write_source(const Filename &dir) {
+  Filename txa_filename = Filename::text_filename(Filename(dir, "textures.txa"));
+  txa_filename.make_dir();
+  ofstream txa;
+  if (!txa_filename.open_write(txa)) {
+    return false;
+  }
+  txa << ":palette 256 256\n"
+      << ":margin 2\n"
+      << ":group first dir first\n"
+      << ":group second dir second\n";
+
+  int i;
+  for (i = 0; i < num_eggs; ++i) {
+    txa << "model" << i << ".egg : "
+        << ((i % 2 == 0) ? "first" : "second") << "\n";
+  }
+  txa << "tex1.rgb tex5.rgb : 50%\n"
+      << "tex2.rgb : 64 32\n";
+
+  for (i = 0; i < num_textures; ++i) {
+    if (!write_texture(Filename(dir, "tex" + format_string(i) + ".rgb"), i)) {
+      return false;
+    }
+  }
+  for (i = 0; i < num_eggs; ++i) {
+    if (!write_egg(Filename(dir, "model" + format_string(i) + ".egg"), i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: palettize
+//  Description: Runs egg-palettize on the egg files in dir/src,
+//               writing to dir/eggs and dir/maps.  Returns true if it
+//               succeeds.
+////////////////////////////////////////////////////////////////////
+static bool
+palettize(const string &program, const Filename &dir, int num_threads) {
+  ostringstream command;
+  command << "cd \"" << Filename(dir, "src").to_os_specific() << "\" && \""
+          << program << "\" -nodb -af textures.txa -d ../eggs -dm ../maps/%g"
+          << " -threads " << num_threads;
+  for (int i = 0; i < num_eggs; ++i) {
+    command << " model" << i << ".egg";
+  }
+  nout << command.str() << "\n";
+  return system(command.str().c_str()) == 0;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: collect_files
+//  Description: Fills files with the name, relative to dir, of each
+//               file below dir.
+////////////////////////////////////////////////////////////////////
+static void
+collect_files(const Filename &dir, const string &prefix, Filenames &files) {
+  vector_string contents;
+  if (!Filename(dir, prefix).scan_directory(contents)) {
+    return;
+  }
+  vector_string::const_iterator ci;
+  for (ci = contents.begin(); ci != contents.end(); ++ci) {
+    Filename name = prefix.empty() ? Filename(*ci) : Filename(prefix, *ci);
+    if (Filename(dir, name).is_directory()) {
+      collect_files(dir, name, files);
+    } else {
+      files.push_back(name);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: read_file
+//  Description: Reads the whole file into data.  The line of an egg
+//               file that records the egg-palettize command line is
+//               left out.
+////////////////////////////////////////////////////////////////////
+static bool
+read_file(Filename filename, string &data) {
+  filename.set_binary();
+  ifstream in;
+  if (!filename.open_read(in)) {
+    return false;
+  }
+  ostringstream strm;
+  strm << in.rdbuf();
+  data = strm.str();
+
+  if (filename.get_extension() == "egg") {
+    size_t p = data.find("-threads");
+    if (p != string::npos) {
+      size_t begin = data.rfind('\n', p);
+      size_t end = data.find('\n', p);
+      begin = (begin == string::npos) ? 0 : begin;
+      data.erase(begin, (end == string::npos) ? string::npos : end - begin);
+    }
+  }
+  return true;
+}
+
+int
+main(int argc, char *argv[]) {
+  // A call to pystub() to force libpystub.so to be linked in.
+  pystub();
+
+  int num_threads = 4;
+  int ai = 1;
+  if (ai + 1 < argc && strcmp(argv[ai], "-threads") == 0) {
+    num_threads = atoi(argv[ai + 1]);
+    ai += 2;
+  }
+  string program = "egg-palettize";
+  if (ai < argc) {
+    program = argv[ai];
+  }
+
+  Filename root = Filename::temporary("", "palettize");
+  Filename serial_dir(root, "serial");
+  Filename threaded_dir(root, "threaded");
+  if (!write_source(Filename(serial_dir, "src")) ||
+      !write_source(Filename(threaded_dir, "src"))) {
+    nout << "Unable to write the source files in " << root << "\n";
+    return 1;
+  }
+
+  if (!palettize(program, serial_dir, 1) ||
+      !palettize(program, threaded_dir, num_threads)) {
+    nout << "egg-palettize failed.\n";
+    return 1;
+  }
+
+  Filenames serial_files, threaded_files;
+  collect_files(serial_dir, "", serial_files);
+  collect_files(threaded_dir, "", threaded_files);
+  sort(serial_files.begin(), serial_files.end());
+  sort(threaded_files.begin(), threaded_files.end());
+
+  int num_errors = 0;
+  if (serial_files != threaded_files) {
+    nout << "*** the two runs wrote different sets of files\n";
+    ++num_errors;
+  }
+
+  Filenames::const_iterator fi;
+  for (fi = serial_files.begin(); fi != serial_files.end(); ++fi) {
+    string serial_data, threaded_data;
+    if (!read_file(Filename(serial_dir, *fi), serial_data) ||
+        !read_file(Filename(threaded_dir, *fi), threaded_data)) {
+      continue;
+    }
+    if (serial_data != threaded_data) {
+      nout << "*** " << *fi << " differs with " << num_threads
+           << " threads\n";
+      ++num_errors;
+    }
+  }
+
+  if (num_errors != 0) {
+    nout << "Files left in " << root << "\n";
+    return 1;
+  }
+  nout << serial_files.size() << " files are the same with "
+       << num_threads << " threads.\n";
+  return 0;
+}
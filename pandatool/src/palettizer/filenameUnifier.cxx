@@ -15,12 +15,14 @@
 #include "filenameUnifier.h"
 
 #include "executionEnvironment.h"
+#include "mutexHolder.h"
 
 Filename FilenameUnifier::_txa_filename;
 Filename FilenameUnifier::_txa_dir;
 Filename FilenameUnifier::_rel_dirname;
 
 FilenameUnifier::CanonicalFilenames FilenameUnifier::_canonical_filenames;
+Mutex FilenameUnifier::_canonical_lock;
 
 ////////////////////////////////////////////////////////////////////
 //     Function: FilenameUnifier::set_txa_filename
@@ -130,6 +132,8 @@ make_user_filename(Filename filename) {
 //               caches the operation so that repeated calls to
 //               filenames in the same directory will tend to be
 //               faster.
+//
+//               This may be called from several threads at once.
 ////////////////////////////////////////////////////////////////////
 void FilenameUnifier::
 make_canonical(Filename &filename) {
@@ -137,6 +141,7 @@ make_canonical(Filename &filename) {
     return;
   }
 
+  MutexHolder holder(_canonical_lock);
   Filename orig_dirname = filename.get_dirname();
 
   CanonicalFilenames::iterator fi;
@@ -18,6 +18,7 @@
 #include "pandatoolbase.h"
 
 #include "filename.h"
+#include "pmutex.h"
 
 #include "pmap.h"
 
@@ -50,6 +51,7 @@ private:
 
   typedef pmap<string, string> CanonicalFilenames;
   static CanonicalFilenames _canonical_filenames;
+  static Mutex _canonical_lock;
 };
 
 #endif
@@ -640,17 +640,18 @@ setup_shadow_images() {
 }
 
 ////////////////////////////////////////////////////////////////////
-//     Function: PaletteGroup::update_images
+//     Function: PaletteGroup::prepare_images
 //       Access: Public
-//  Description: Regenerates each PaletteImage on this group that needs
-//               it.
+//  Description: Adds each PaletteImage on this group that needs to be
+//               regenerated to the indicated vector.  See
+//               PaletteImage::prepare_image().
 ////////////////////////////////////////////////////////////////////
 void PaletteGroup::
-update_images(bool redo_all) {
+prepare_images(bool redo_all, pvector<PaletteImage *> &images) {
   Pages::iterator pai;
   for (pai = _pages.begin(); pai != _pages.end(); ++pai) {
     PalettePage *page = (*pai).second;
-    page->update_images(redo_all);
+    page->prepare_images(redo_all, images);
   }
 }
 
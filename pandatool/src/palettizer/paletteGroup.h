@@ -30,6 +30,7 @@
 class EggFile;
 class TexturePlacement;
 class PalettePage;
+class PaletteImage;
 class TextureImage;
 class TxaFile;
 
@@ -88,7 +89,7 @@ public:
   void optimal_resize();
   void reset_images();
   void setup_shadow_images();
-  void update_images(bool redo_all);
+  void prepare_images(bool redo_all, pvector<PaletteImage *> &images);
 
   void add_texture_swap_info(const string sourceTextureName, const vector_string &swapTextures);
   bool is_none_texture_swap() const;
@@ -587,20 +587,27 @@ setup_shadow_image() {
 }
 
 ////////////////////////////////////////////////////////////////////
-//     Function: PaletteImage::update_image
+//     Function: PaletteImage::prepare_image
 //       Access: Public
-//  Description: If the palette has changed since it was last written
-//               out, updates the image and writes out a new one.  If
-//               redo_all is true, regenerates the image from scratch
-//               and writes it out again, whether it needed it or not.
+//  Description: Checks whether the palette has changed since it was
+//               last written out.  Returns true if it has, in which
+//               case generate_image() must be called to update the
+//               image and write out a new one.  If redo_all is true,
+//               the image will be regenerated from scratch whether it
+//               needed it or not.
+//
+//               This may rename the image and mark egg files stale,
+//               so it must be called for each PaletteImage in turn;
+//               but generate_image() may then be called for several
+//               PaletteImages at once.
 ////////////////////////////////////////////////////////////////////
-void PaletteImage::
-update_image(bool redo_all) {
+bool PaletteImage::
+prepare_image(bool redo_all) {
   if (is_empty() && pal->_aggressively_clean_mapdir) {
     // If the palette image is 'empty', ensure that it doesn't exist.
     // No need to clutter up the map directory.
     remove_image();
-    return;
+    return false;
   }
 
   if (redo_all) {
@@ -666,9 +673,41 @@ update_image(bool redo_all) {
 
   if (!needs_update) {
     // No sweat; nothing has changed.
-    return;
+    return false;
   }
 
+  // The swapped images will be filled in along with this one, so
+  // their filenames must be brought up to date too.
+  bool any_unfilled = false;
+  for (pi = _placements.begin(); pi != _placements.end(); ++pi) {
+    if (!(*pi)->is_filled()) {
+      any_unfilled = true;
+    }
+  }
+  if (any_unfilled) {
+    SwappedImages::iterator si;
+    for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
+      (*si)->update_filename();
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: PaletteImage::generate_image
+//       Access: Public
+//  Description: Updates the image, and its swapped images, with the
+//               textures placed on it since it was last written out,
+//               and writes out the new images.  prepare_image() must
+//               have returned true first.
+//
+//               This touches only this PaletteImage and its swapped
+//               images, so it may be called for several PaletteImages
+//               in parallel.
+////////////////////////////////////////////////////////////////////
+void PaletteImage::
+generate_image() {
   get_image();
   // [gjeon] get swapped images, too
   get_swapped_images();
@@ -689,6 +728,7 @@ update_image(bool redo_all) {
   _cleared_regions.clear();
 
   // Now add the recent additions to the image.
+  Placements::iterator pi;
   for (pi = _placements.begin(); pi != _placements.end(); ++pi) {
     TexturePlacement *placement = (*pi);
     if (!placement->is_filled()) {
@@ -698,7 +738,6 @@ update_image(bool redo_all) {
       SwappedImages::iterator si;
       for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
         PaletteImage *swappedImage = (*si);
-        swappedImage->update_filename();
         placement->fill_swapped_image(swappedImage->_image, si - _swappedImages.begin());
       }
     }
@@ -58,7 +58,8 @@ public:
   void write_placements(ostream &out, int indent_level = 0) const;
   void reset_image();
   void setup_shadow_image();
-  void update_image(bool redo_all);
+  bool prepare_image(bool redo_all);
+  void generate_image();
 
   bool update_filename();
 
@@ -231,17 +231,20 @@ setup_shadow_images() {
 }
 
 ////////////////////////////////////////////////////////////////////
-//     Function: PalettePage::update_images
+//     Function: PalettePage::prepare_images
 //       Access: Public
-//  Description: Regenerates each PaletteImage on this page that needs
-//               it.
+//  Description: Adds each PaletteImage on this page that needs to be
+//               regenerated to the indicated vector.  See
+//               PaletteImage::prepare_image().
 ////////////////////////////////////////////////////////////////////
 void PalettePage::
-update_images(bool redo_all) {
+prepare_images(bool redo_all, pvector<PaletteImage *> &images) {
   Images::iterator ii;
   for (ii = _images.begin(); ii != _images.end(); ++ii) {
     PaletteImage *image = (*ii);
-    image->update_image(redo_all);
+    if (image->prepare_image(redo_all)) {
+      images.push_back(image);
+    }
   }
 }
 
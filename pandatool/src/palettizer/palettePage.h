@@ -53,7 +53,7 @@ public:
   void optimal_resize();
   void reset_images();
   void setup_shadow_images();
-  void update_images(bool redo_all);
+  void prepare_images(bool redo_all, pvector<PaletteImage *> &images);
 
 private:
   PaletteGroup *_group;
@@ -17,6 +17,7 @@
 #include "textureImage.h"
 #include "pal_string_utils.h"
 #include "paletteGroup.h"
+#include "paletteImage.h"
 #include "filenameUnifier.h"
 #include "textureMemoryCounter.h"
 
@@ -29,6 +30,7 @@
 #include "bamReader.h"
 #include "bamWriter.h"
 #include "indent.h"
+#include "parallelFor.h"
 
 Palettizer *pal = (Palettizer *)NULL;
 
@@ -59,6 +61,56 @@ int Palettizer::_read_pi_version = 0;
 
 TypeHandle Palettizer::_type_handle;
 
+////////////////////////////////////////////////////////////////////
+//       Class : Palettizer::ImageWork
+// Description : The list of source images to read, palette images to
+//               generate, or textures to copy, handed to ParallelFor
+//               when egg-palettize is run with -threads.  Each item
+//               is handled by exactly one thread, and the results
+//               don't depend on which, so the images written are the
+//               same as those written with a single thread.
+////////////////////////////////////////////////////////////////////
+class Palettizer::ImageWork : public ParallelFor::Body {
+public:
+  enum Action {
+    A_read_source,
+    A_generate_palette,
+    A_copy_unplaced
+  };
+
+  virtual void do_range(int begin, int end);
+
+  Action _action;
+  bool _redo_all;
+  pvector<TextureImage *> _textures;
+  pvector<PaletteImage *> _palettes;
+};
+
+////////////////////////////////////////////////////////////////////
+//     Function: Palettizer::ImageWork::do_range
+//       Access: Public, Virtual
+//  Description: Reads, generates, or copies items begin through
+//               end - 1.
+////////////////////////////////////////////////////////////////////
+void Palettizer::ImageWork::
+do_range(int begin, int end) {
+  for (int n = begin; n < end; ++n) {
+    switch (_action) {
+    case A_read_source:
+      _textures[n]->read_source_image();
+      break;
+
+    case A_generate_palette:
+      _palettes[n]->generate_image();
+      break;
+
+    case A_copy_unplaced:
+      _textures[n]->copy_unplaced(_redo_all);
+      break;
+    }
+  }
+}
+
 ostream &operator << (ostream &out, Palettizer::RemapUV remap) {
   switch (remap) {
   case Palettizer::RU_never:
@@ -106,6 +158,7 @@ Palettizer::
 Palettizer() {
   _is_valid = true;
   _noabs = false;
+  _num_threads = 1;
 
   _generated_image_pattern = "%g_palette_%p_%i";
   _map_dirname = "%g";
@@ -467,22 +520,32 @@ process_command_line_eggs(bool force_texture_read, const Filename &state_filenam
     (*efi).second->build_cross_links();
   }
 
-  // Now match each of the textures mentioned in those egg files
-  // against a line in the .txa file.
+  // If we're forcing a redo, or a texture image has changed, re-read
+  // the complete image.  These are read first, in parallel, since
+  // this is the slow part.
+  ImageWork work;
+  work._action = ImageWork::A_read_source;
   CommandLineTextures::iterator ti;
   for (ti = _command_line_textures.begin();
        ti != _command_line_textures.end();
        ++ti) {
     TextureImage *texture = *ti;
-
     if (force_texture_read || texture->is_newer_than(state_filename)) {
-      // If we're forcing a redo, or the texture image has changed,
-      // re-read the complete image.
-      texture->read_source_image();
-    } else {
-      // Otherwise, just the header is sufficient.
-      texture->read_header();
+      work._textures.push_back(texture);
     }
+  }
+  run_image_work(work, (int)work._textures.size());
+
+  // Now match each of the textures mentioned in those egg files
+  // against a line in the .txa file.
+  for (ti = _command_line_textures.begin();
+       ti != _command_line_textures.end();
+       ++ti) {
+    TextureImage *texture = *ti;
+
+    // For the rest, just the header is sufficient.  This does nothing
+    // for the textures that were read above.
+    texture->read_header();
 
     texture->mark_texture_named();
     texture->pre_txa_file();
@@ -579,20 +642,33 @@ process_all(bool force_texture_read, const Filename &state_filename) {
   }
 
   // Now match each of the textures in the world against a line in the
-  // .txa file.
-  for (ti = _textures.begin(); ti != _textures.end(); ++ti) {
-    TextureImage *texture = (*ti).second;
-    if (force_texture_read || texture->is_newer_than(state_filename)) {
-      texture->read_source_image();
+  // .txa file.  The textures that need to be read are read a batch at
+  // a time, in parallel, ahead of the matching.
+  int batch_size = (_num_threads > 1) ? _num_threads * 4 : 1;
+  ti = _textures.begin();
+  while (ti != _textures.end()) {
+    Textures::iterator batch_begin = ti;
+    ImageWork work;
+    work._action = ImageWork::A_read_source;
+    for (int i = 0; i < batch_size && ti != _textures.end(); ++i, ++ti) {
+      TextureImage *texture = (*ti).second;
+      if (force_texture_read || texture->is_newer_than(state_filename)) {
+        work._textures.push_back(texture);
+      }
+    }
+    run_image_work(work, (int)work._textures.size());
+
+    Textures::iterator bi;
+    for (bi = batch_begin; bi != ti; ++bi) {
+      TextureImage *texture = (*bi).second;
+      texture->mark_texture_named();
+      texture->pre_txa_file();
+      _txa_file.match_texture(texture);
+      texture->post_txa_file();
+
+      // We need to do this to avoid bloating memory.
+      texture->release_source_image();
     }
-
-    texture->mark_texture_named();
-    texture->pre_txa_file();
-    _txa_file.match_texture(texture);
-    texture->post_txa_file();
-
-    // We need to do this to avoid bloating memory.
-    texture->release_source_image();
   }
 
   // And now, assign each texture to an appropriate group or groups.
@@ -667,17 +743,29 @@ reset_images() {
 ////////////////////////////////////////////////////////////////////
 void Palettizer::
 generate_images(bool redo_all) {
+  // First, decide which palette images need to be regenerated.  This
+  // may rename images and mark egg files stale, so it is done here,
+  // one image at a time.
+  ImageWork work;
+  work._action = ImageWork::A_generate_palette;
+  work._redo_all = redo_all;
   Groups::iterator gi;
   for (gi = _groups.begin(); gi != _groups.end(); ++gi) {
     PaletteGroup *group = (*gi).second;
-    group->update_images(redo_all);
+    group->prepare_images(redo_all, work._palettes);
   }
 
+  // Then the palette images are composed and written, and the
+  // unplaced textures copied, in parallel.
+  run_image_work(work, (int)work._palettes.size());
+
+  work._action = ImageWork::A_copy_unplaced;
   Textures::iterator ti;
   for (ti = _textures.begin(); ti != _textures.end(); ++ti) {
     TextureImage *texture = (*ti).second;
-    texture->copy_unplaced(redo_all);
+    work._textures.push_back(texture);
   }
+  run_image_work(work, (int)work._textures.size());
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -957,6 +1045,18 @@ string_remap(const string &str) {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: Palettizer::run_image_work
+//       Access: Private
+//  Description: Reads, generates, or copies the images of the
+//               indicated work, dividing them among _num_threads
+//               threads.
+////////////////////////////////////////////////////////////////////
+void Palettizer::
+run_image_work(ImageWork &work, int num_items) {
+  ParallelFor::run(work, num_items, _num_threads);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: Palettizer::compute_statistics
 //       Access: Private
@@ -96,6 +96,7 @@ public:
   string _default_groupname;
   string _default_groupdir;
   bool _noabs;
+  int _num_threads;
 
   // The following parameter values specifically relate to textures
   // and palettes.  These values are stored in the textures.boo file
@@ -124,6 +125,9 @@ public:
   double _cutout_ratio;
 
 private:
+  class ImageWork;
+  void run_image_work(ImageWork &work, int num_items);
+
   typedef pvector<TexturePlacement *> Placements;
   void compute_statistics(ostream &out, int indent_level,
                           const Placements &placements) const;
@@ -27,6 +27,7 @@
 #include "bamReader.h"
 #include "bamWriter.h"
 #include "pnmFileType.h"
+#include "mutexHolder.h"
 #include "indirectCompareNames.h"
 #include "pvector.h"
 
@@ -813,6 +814,38 @@ release_source_image() {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: TextureImage::read_scaled_source_image
+//       Access: Public
+//  Description: Reads in the original image, as read_source_image()
+//               does, and fills the indicated image with a copy of it
+//               scaled to x_size by y_size pixels.  The original
+//               image is then released again.  Returns true if
+//               successful, or false if the original image could not
+//               be read.
+//
+//               Unlike read_source_image(), this may be called for
+//               the same TextureImage from several threads at once,
+//               as happens when palette images that share a texture
+//               are generated in parallel.
+////////////////////////////////////////////////////////////////////
+bool TextureImage::
+read_scaled_source_image(PNMImage &image, int x_size, int y_size) {
+  MutexHolder holder(_source_image_lock);
+
+  const PNMImage &source_full = read_source_image();
+  if (!source_full.is_valid()) {
+    return false;
+  }
+
+  image.clear(x_size, y_size, source_full.get_num_channels(),
+              source_full.get_maxval());
+  image.quick_filter_from(source_full);
+
+  release_source_image();
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: TextureImage::set_source_image
 //       Access: Public
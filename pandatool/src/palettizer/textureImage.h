@@ -25,6 +25,7 @@
 #include "filename.h"
 #include "pnmImage.h"
 #include "eggRenderMode.h"
+#include "pmutex.h"
 
 #include "pmap.h"
 #include "pset.h"
@@ -89,6 +90,7 @@ public:
 
   const PNMImage &read_source_image();
   void release_source_image();
+  bool read_scaled_source_image(PNMImage &image, int x_size, int y_size);
   void set_source_image(const PNMImage &image);
   void read_header();
   bool is_newer_than(const Filename &reference_filename);
@@ -154,6 +156,7 @@ private:
   bool _read_source_image;
   bool _allow_release_source_image;
   PNMImage _source_image;
+  Mutex _source_image_lock;
   bool _texture_named;
   bool _got_txa_file;
 
@@ -828,16 +828,12 @@ fill_image(PNMImage &image) {
 
   // Now we get a PNMImage that represents the source texture at that
   // size.
-  const PNMImage &source_full = _texture->read_source_image();
-  if (!source_full.is_valid()) {
+  PNMImage source;
+  if (!_texture->read_scaled_source_image(source, x_size, y_size)) {
     flag_error_image(image);
     return;
   }
 
-  PNMImage source(x_size, y_size, source_full.get_num_channels(),
-                  source_full.get_maxval());
-  source.quick_filter_from(source_full);
-
   bool alpha = image.has_alpha();
   bool source_alpha = source.has_alpha();
 
@@ -881,8 +877,6 @@ fill_image(PNMImage &image) {
       }
     }
   }
-
-  _texture->release_source_image();
 }
 
 
@@ -931,16 +925,12 @@ fill_swapped_image(PNMImage &image, int index) {
   TextureSwaps::iterator tsi;
   tsi = _textureSwaps.begin() + index;
   TextureImage *swapTexture = (*tsi);
-  const PNMImage &source_full = swapTexture->read_source_image();
-  if (!source_full.is_valid()) {
+  PNMImage source;
+  if (!swapTexture->read_scaled_source_image(source, x_size, y_size)) {
     flag_error_image(image);
     return;
   }
 
-  PNMImage source(x_size, y_size, source_full.get_num_channels(),
-                  source_full.get_maxval());
-  source.quick_filter_from(source_full);
-
   bool alpha = image.has_alpha();
   bool source_alpha = source.has_alpha();
 
@@ -984,8 +974,6 @@ fill_swapped_image(PNMImage &image, int index) {
       }
     }
   }
-
-  swapTexture->release_source_image();
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -15,7 +15,8 @@
   #define COMBINED_SOURCES $[TARGET]_composite1.cxx  $[TARGET]_composite2.cxx
 
   #define SOURCES \
-     config_dna.h dnaBuildings.h dnaConstants.h dnaCornice.h dnaData.I  \
+     config_dna.h dnaBinary.h dnaBinary.I dnaGraphCache.h dnaGraphCache.I \
+     dnaBuildings.h dnaConstants.h dnaCornice.h dnaData.I  \
      dnaData.h dnaDoor.h dnaGroup.h dnaVisGroup.h dnaSign.I  \
      dnaSign.h dnaSignBaseline.I dnaSignBaseline.h  \
      dnaSignGraphic.I dnaSignGraphic.h dnaSignText.I  \
@@ -24,17 +25,18 @@
      dnaLoader.h dnaNode.I dnaNode.h dnaProp.h dnaProp.I \
      dnaAnimProp.h dnaAnimProp.I dnaInteractiveProp.h \
      dnaInteractiveProp.I dnaAnimBuilding.h dnaAnimBuilding.I \
-     dnaStorage.h dnaStorage.I \
+     dnaStorage.h dnaStorage.I dnaSuitRouteTable.h dnaSuitRouteTable.I \
      dnaStreet.h dnaWindow.h lexerDefs.h load_dna_file.h  \
      loaderFileTypeDNA.h parserDefs.h parser.yxx lexer.lxx  \
     
   #define INCLUDED_SOURCES \
-     config_dna.cxx dnaBuildings.cxx dnaCornice.cxx dnaData.cxx   \
+     config_dna.cxx dnaBinary.cxx dnaGraphCache.cxx \
+     dnaBuildings.cxx dnaCornice.cxx dnaData.cxx   \
      dnaDoor.cxx dnaGroup.cxx dnaVisGroup.cxx dnaSign.cxx   \
      dnaSignBaseline.cxx dnaSignGraphic.cxx dnaSignText.cxx   \
      dnaSuitPoint.cxx dnaSuitEdge.cxx dnaSuitPath.cxx   \
      dnaBattleCell.cxx dnaLoader.cxx dnaNode.cxx dnaProp.cxx   \
-     dnaStorage.cxx dnaStreet.cxx dnaWindow.cxx load_dna_file.cxx   \
+     dnaStorage.cxx dnaSuitRouteTable.cxx dnaStreet.cxx dnaWindow.cxx load_dna_file.cxx   \
      dnaAnimProp.cxx dnaInteractiveProp.cxx dnaAnimBuilding.cxx \
      loaderFileTypeDNA.cxx
 
@@ -79,3 +81,34 @@
 
 #end test_bin_target
 
+#begin test_bin_target
+  #define TARGET test_dna_binary
+  #define LOCAL_LIBS \
+    dnaLoader
+  #define OTHER_LIBS \
+    express:c pandaexpress:m \
+    panda:m \
+    interrogatedb:c dconfig:c dtoolconfig:m \
+    dtoolutil:c dtoolbase:c dtool:m \
+    pystub
+
+  #define SOURCES \
+    test_dna_binary.cxx
+
+#end test_bin_target
+
+#begin test_bin_target
+  #define TARGET test_suit_routes
+  #define LOCAL_LIBS \
+    dnaLoader
+  #define OTHER_LIBS \
+    express:c pandaexpress:m \
+    panda:m \
+    interrogatedb:c dconfig:c dtoolconfig:m \
+    dtoolutil:c dtoolbase:c dtool:m \
+    pystub
+
+  #define SOURCES \
+    test_suit_routes.cxx
+
+#end test_bin_target
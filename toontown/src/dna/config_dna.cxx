@@ -39,6 +39,50 @@ ConfigVariableList dna_preload
 ConfigVariableSearchPath dna_path
 ("dna-path");
 
+ConfigVariableBool dna_prefer_binary
+("dna-prefer-binary", false,
+ PRC_DESC("When this is true, load_DNA_file() will load a precompiled "
+          ".pdna file in place of the requested .dna file, if one exists "
+          "alongside it and is not older than the .dna file.  The .pdna "
+          "file is much faster to load, since it need not be parsed.  "
+          "This is false by default until the binary format has been "
+          "proven against the text files."));
+
+ConfigVariableBool dna_cache_graphs
+("dna-cache-graphs", true,
+ PRC_DESC("When this is true, and the model cache is enabled, the scene "
+          "graph built from each DNA file is stored in the model cache, "
+          "and reused the next time the same file is loaded with the "
+          "same DNA storage."));
+
+ConfigVariableInt dna_flatten_vis_groups
+("dna-flatten-vis-groups", 0,
+ PRC_DESC("Set this to 1, 2, or 3 to flatten_light(), flatten_medium(), or "
+          "flatten_strong() each vis group of a DNA file's graph after it "
+          "is built.  When dna-cache-graphs is true and the model cache is "
+          "active, the flattened graph is what is cached, so the flatten "
+          "is done only once; a load from the cache returns the same graph "
+          "as a load that builds it.  Graphs built for the level editor "
+          "are never flattened.  The default, 0, leaves the vis groups "
+          "unflattened."));
+
+ConfigVariableBool dna_suit_routes
+("dna-suit-routes", true,
+ PRC_DESC("When this is true, discover_continuity() also builds a table "
+          "of the shortest route between each pair of suit points, and "
+          "get_suit_path() answers from that table instead of searching "
+          "the suit graph each time.  Set it false to use the original "
+          "breadth-first search."));
+
+ConfigVariableInt dna_suit_route_min_lengths
+("dna-suit-route-min-lengths", "40",
+ PRC_DESC("The minimum path lengths, greater than 2, for which the suit "
+          "route table works out in advance every walk from each suit "
+          "point, so that get_suit_path() can answer them from the table.  "
+          "The default is the DistributedSuitPlannerAI's MIN_PATH_LEN.  "
+          "Paths with any other minimum length greater than 2 are found "
+          "with the breadth-first search."));
+
 ConfigureFn(config_dna) {
   DNAGroup::init_type();
   DNAVisGroup::init_type();
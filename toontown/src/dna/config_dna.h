@@ -12,6 +12,8 @@
 #include "dconfig.h"
 #include "configVariableList.h"
 #include "configVariableSearchPath.h"
+#include "configVariableBool.h"
+#include "configVariableInt.h"
 
 class DSearchPath;
 
@@ -19,6 +21,11 @@ NotifyCategoryDecl(dna, EXPCL_TOONTOWN, EXPTP_TOONTOWN);
 
 extern ConfigVariableList dna_preload;
 extern ConfigVariableSearchPath dna_path;
+extern ConfigVariableBool dna_prefer_binary;
+extern ConfigVariableBool dna_cache_graphs;
+extern ConfigVariableInt dna_flatten_vis_groups;
+extern ConfigVariableBool dna_suit_routes;
+extern ConfigVariableInt dna_suit_route_min_lengths;
 
 BEGIN_PUBLISH
 EXPCL_TOONTOWN const ConfigVariableSearchPath &get_dna_path();
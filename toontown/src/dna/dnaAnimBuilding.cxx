@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaAnimBuilding.h"
+#include "dnaBinary.h"
 #include "sceneGraphReducer.h"
 #include "modelNode.h"
 #include "config_linmath.h"
@@ -162,6 +163,28 @@ void DNAAnimBuilding::write(ostream &out, DNAStorage *store, int indent_level) c
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAAnimBuilding::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAAnimBuilding::
+write_binary(DNABinaryWriter &writer) const {
+  DNALandmarkBuilding::write_binary(writer);
+  writer.add_string(_anim);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAAnimBuilding::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAAnimBuilding::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNALandmarkBuilding::fillin_binary(reader, store);
+  _anim = reader.get_string();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAAnimBuilding::make_copy
 //       Access: Public
@@ -32,6 +32,10 @@ private:
   virtual DNAGroup* make_copy();
   string _anim;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaAnimProp.h"
+#include "dnaBinary.h"
 #include "sceneGraphReducer.h"
 #include "modelNode.h"
 #include "config_linmath.h"
@@ -145,6 +146,28 @@ void DNAAnimProp::write(ostream &out, DNAStorage *store, int indent_level) const
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAAnimProp::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAAnimProp::
+write_binary(DNABinaryWriter &writer) const {
+  DNAProp::write_binary(writer);
+  writer.add_string(_anim);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAAnimProp::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAAnimProp::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAProp::fillin_binary(reader, store);
+  _anim = reader.get_string();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAAnimProp::make_copy
 //       Access: Public
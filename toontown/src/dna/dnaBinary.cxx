@@ -0,0 +1,673 @@
+// Filename: dnaBinary.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "dnaBinary.h"
+#include "config_dna.h"
+#include "dnaData.h"
+#include "dnaStorage.h"
+#include "dnaGroup.h"
+#include "dnaVisGroup.h"
+#include "dnaNode.h"
+#include "dnaProp.h"
+#include "dnaAnimProp.h"
+#include "dnaInteractiveProp.h"
+#include "dnaAnimBuilding.h"
+#include "dnaBuildings.h"
+#include "dnaCornice.h"
+#include "dnaStreet.h"
+#include "dnaWindow.h"
+#include "dnaDoor.h"
+#include "dnaSign.h"
+#include "dnaSignBaseline.h"
+#include "dnaSignGraphic.h"
+#include "dnaSignText.h"
+#include "dnaSuitPoint.h"
+#include "config_linmath.h"
+#include "virtualFileSystem.h"
+#include "loader.h"
+#include "loaderOptions.h"
+#include "texturePool.h"
+#include "fontPool.h"
+
+const char DNABinary::_magic[] = { 'p', 'd', 'n', 'a', '\0', '\n', '\r' };
+const size_t DNABinary::_magic_length = sizeof(DNABinary::_magic);
+
+// A corrupt file could otherwise send us recursing without bound.
+static const int max_group_depth = 1000;
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinary::is_binary_filename
+//       Access: Public, Static
+//  Description: Returns true if the filename names a precompiled DNA
+//               file, rather than a text DNA file.
+////////////////////////////////////////////////////////////////////
+bool DNABinary::
+is_binary_filename(const Filename &filename) {
+  return filename.get_extension() == "pdna";
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryWriter::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+DNABinaryWriter::
+DNABinaryWriter() {
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryWriter::write_file
+//       Access: Public
+//  Description: Writes the indicated DNAData, including the load
+//               commands that were recorded when it was read, to the
+//               indicated .pdna file.  Returns true on success.
+////////////////////////////////////////////////////////////////////
+bool DNABinaryWriter::
+write_file(const Filename &filename, const DNAData *data, ostream &error) {
+  Datagram dg;
+  write_data(data, dg);
+
+  Filename binary_filename = Filename::binary_filename(filename);
+  binary_filename.unlink();
+
+  pofstream file;
+  if (!binary_filename.open_write(file)) {
+    error << "Unable to open " << binary_filename << " for writing.\n";
+    return false;
+  }
+
+  file.write((const char *)dg.get_data(), dg.get_length());
+  if (file.fail()) {
+    error << "Error writing " << binary_filename << "\n";
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryWriter::write_data
+//       Access: Public
+//  Description: Fills the datagram with the complete contents of a
+//               .pdna file for the indicated DNAData.
+////////////////////////////////////////////////////////////////////
+void DNABinaryWriter::
+write_data(const DNAData *data, Datagram &dg) {
+  _body.clear();
+  _string_index.clear();
+  _strings.clear();
+
+  // First, the load commands, in the order they appeared in the file.
+  const DNAData::LoadCommands &commands = data->get_load_commands();
+  add_uint32(commands.size());
+  DNAData::LoadCommands::const_iterator ci;
+  for (ci = commands.begin(); ci != commands.end(); ++ci) {
+    const DNAData::LoadCommand &command = (*ci);
+    add_uint8(command._type);
+    switch (command._type) {
+    case DNABinary::LT_model:
+    case DNABinary::LT_hood_model:
+    case DNABinary::LT_place_model:
+      add_string(command._str);
+      break;
+
+    case DNABinary::LT_store_node:
+    case DNABinary::LT_store_texture:
+    case DNABinary::LT_store_font:
+      add_string(command._category);
+      add_string(command._code);
+      add_string(command._str);
+      break;
+
+    case DNABinary::LT_store_suit_point:
+      {
+        const DNASuitPoint *point = command._suit_point;
+        add_int32(point->get_index());
+        add_uint8((PN_uint8)point->get_point_type());
+        add_vec3(point->get_pos());
+        add_int32(point->get_landmark_building_index());
+      }
+      break;
+    }
+  }
+
+  // Then the group tree.  The DNAData itself is not written, only its
+  // children.
+  add_uint32(data->_group_vector.size());
+  pvector<PT(DNAGroup)>::const_iterator gi;
+  for (gi = data->_group_vector.begin(); gi != data->_group_vector.end(); ++gi) {
+    write_group(*gi);
+  }
+
+  // Now that we know all of the strings, put together the file.
+  dg.clear();
+  dg.append_data(DNABinary::_magic, DNABinary::_magic_length);
+  dg.add_uint16(DNABinary::major_version);
+  dg.add_uint16(DNABinary::minor_version);
+  PN_uint8 flags = 0;
+  if (temp_hpr_fix) {
+    flags |= DNABinary::HF_hpr_fix;
+  }
+  dg.add_uint8(flags);
+
+  dg.add_uint32(_strings.size());
+  pvector<string>::const_iterator si;
+  for (si = _strings.begin(); si != _strings.end(); ++si) {
+    dg.add_string32(*si);
+  }
+
+  dg.append_data(_body.get_data(), _body.get_length());
+  _body.clear();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryWriter::add_string
+//       Access: Public
+//  Description: Adds the string to the table, if it is not already
+//               there, and writes its index.
+////////////////////////////////////////////////////////////////////
+void DNABinaryWriter::
+add_string(const string &str) {
+  pair<StringIndex::iterator, bool> result =
+    _string_index.insert(StringIndex::value_type(str, (PN_uint32)_strings.size()));
+  if (result.second) {
+    _strings.push_back(str);
+  }
+  _body.add_uint32((*result.first).second);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryWriter::write_group
+//       Access: Public
+//  Description: Writes the indicated group and all of its children.
+////////////////////////////////////////////////////////////////////
+void DNABinaryWriter::
+write_group(const DNAGroup *group) {
+  add_uint8(get_group_type(group));
+  group->write_binary(*this);
+
+  add_uint32(group->_group_vector.size());
+  pvector<PT(DNAGroup)>::const_iterator gi;
+  for (gi = group->_group_vector.begin(); gi != group->_group_vector.end(); ++gi) {
+    write_group(*gi);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryWriter::get_group_type
+//       Access: Private
+//  Description: Returns the DNABinary::GroupType code for the
+//               indicated group's exact type.
+////////////////////////////////////////////////////////////////////
+int DNABinaryWriter::
+get_group_type(const DNAGroup *group) const {
+  TypeHandle type = group->get_type();
+  if (type == DNAVisGroup::get_class_type()) {
+    return DNABinary::GT_vis_group;
+  } else if (type == DNANode::get_class_type()) {
+    return DNABinary::GT_node;
+  } else if (type == DNAProp::get_class_type()) {
+    return DNABinary::GT_prop;
+  } else if (type == DNAAnimProp::get_class_type()) {
+    return DNABinary::GT_anim_prop;
+  } else if (type == DNAInteractiveProp::get_class_type()) {
+    return DNABinary::GT_interactive_prop;
+  } else if (type == DNAWall::get_class_type()) {
+    return DNABinary::GT_wall;
+  } else if (type == DNAFlatBuilding::get_class_type()) {
+    return DNABinary::GT_flat_building;
+  } else if (type == DNALandmarkBuilding::get_class_type()) {
+    return DNABinary::GT_landmark_building;
+  } else if (type == DNAAnimBuilding::get_class_type()) {
+    return DNABinary::GT_anim_building;
+  } else if (type == DNAStreet::get_class_type()) {
+    return DNABinary::GT_street;
+  } else if (type == DNAWindows::get_class_type()) {
+    return DNABinary::GT_windows;
+  } else if (type == DNACornice::get_class_type()) {
+    return DNABinary::GT_cornice;
+  } else if (type == DNADoor::get_class_type()) {
+    return DNABinary::GT_door;
+  } else if (type == DNAFlatDoor::get_class_type()) {
+    return DNABinary::GT_flat_door;
+  } else if (type == DNASign::get_class_type()) {
+    return DNABinary::GT_sign;
+  } else if (type == DNASignBaseline::get_class_type()) {
+    return DNABinary::GT_sign_baseline;
+  } else if (type == DNASignText::get_class_type()) {
+    return DNABinary::GT_sign_text;
+  } else if (type == DNASignGraphic::get_class_type()) {
+    return DNABinary::GT_sign_graphic;
+  }
+
+  nassertr(type == DNAGroup::get_class_type(), DNABinary::GT_group);
+  return DNABinary::GT_group;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+DNABinaryReader::
+DNABinaryReader() :
+  _data(NULL),
+  _size(0),
+  _pos(0),
+  _error(false),
+  _file_hpr_fix(true),
+  _convert_hpr(false),
+  _current_model_type(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::Destructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+DNABinaryReader::
+~DNABinaryReader() {
+  close();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::open
+//       Access: Public
+//  Description: Reads the indicated .pdna file into memory, through
+//               the VirtualFileSystem, in preparation for read().
+//               Returns true if the file could be read.
+////////////////////////////////////////////////////////////////////
+bool DNABinaryReader::
+open(const Filename &filename) {
+  close();
+
+  Filename binary_filename = Filename::binary_filename(filename);
+  VirtualFileSystem *vfs = VirtualFileSystem::get_global_ptr();
+  if (!vfs->read_file(binary_filename, _buffer, true)) {
+    return false;
+  }
+  _data = (const unsigned char *)_buffer.data();
+  _size = _buffer.size();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::set_data
+//       Access: Public
+//  Description: Prepares to read the .pdna contents in the indicated
+//               string, instead of from a file.
+////////////////////////////////////////////////////////////////////
+void DNABinaryReader::
+set_data(const string &data) {
+  close();
+  _buffer = data;
+  _data = (const unsigned char *)_buffer.data();
+  _size = _buffer.size();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::close
+//       Access: Public
+//  Description: Releases the file opened by open() or set_data().
+////////////////////////////////////////////////////////////////////
+void DNABinaryReader::
+close() {
+  _buffer = string();
+  _strings.clear();
+  _current_model = NodePath();
+  _current_model_type = 0;
+  _current_zone = string();
+  _data = NULL;
+  _size = 0;
+  _pos = 0;
+  _error = false;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::read
+//       Access: Public
+//  Description: Reads the opened file into the indicated DNAData,
+//               storing models, textures, suit points, and so on in
+//               its DNAStorage.  Returns true on success, or false if
+//               the file was malformed, in which case the data may be
+//               partially read.
+////////////////////////////////////////////////////////////////////
+bool DNABinaryReader::
+read(DNAData *data, ostream &error) {
+  _pos = 0;
+  _error = false;
+
+  if (!check_remaining(DNABinary::_magic_length) ||
+      memcmp(_data, DNABinary::_magic, DNABinary::_magic_length) != 0) {
+    error << data->get_dna_filename() << " is not a precompiled DNA file.\n";
+    return false;
+  }
+  _pos += DNABinary::_magic_length;
+
+  int major = get_uint16();
+  int minor = get_uint16();
+  if (major != DNABinary::major_version || minor > DNABinary::minor_version) {
+    error << data->get_dna_filename() << " is version " << major << "."
+          << minor << "; this program can only read version "
+          << DNABinary::major_version << "." << DNABinary::minor_version
+          << ".\n";
+    return false;
+  }
+
+  PN_uint8 flags = get_uint8();
+  _file_hpr_fix = (flags & DNABinary::HF_hpr_fix) != 0;
+  _convert_hpr = (_file_hpr_fix != (bool)temp_hpr_fix);
+
+  if (!read_strings()) {
+    error << data->get_dna_filename() << " has a corrupt string table.\n";
+    return false;
+  }
+
+  DNAStorage *store = data->get_dna_storage();
+  nassertr(store != (DNAStorage *)NULL, false);
+
+  bool load_ok = true;
+  if (!read_load_commands(data, store, error, load_ok)) {
+    error << data->get_dna_filename() << " is truncated or corrupt.\n";
+    return false;
+  }
+
+  PN_uint32 num_children = get_uint32();
+  for (PN_uint32 i = 0; i < num_children && !_error; ++i) {
+    PT(DNAGroup) child = read_group(store, 0);
+    if (child != (DNAGroup *)NULL) {
+      data->add(child);
+    }
+  }
+
+  // The model was only needed for the store_node commands.
+  _current_model = NodePath();
+
+  if (_error) {
+    error << data->get_dna_filename() << " is truncated or corrupt.\n";
+    return false;
+  }
+
+  if (!load_ok) {
+    error << "Errors loading " << data->get_dna_filename() << "\n";
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::read_strings
+//       Access: Private
+//  Description: Reads the string table.  Returns true on success.
+////////////////////////////////////////////////////////////////////
+bool DNABinaryReader::
+read_strings() {
+  _strings.clear();
+  PN_uint32 num_strings = get_uint32();
+
+  // Each string takes at least four bytes, for its length.
+  if (_error || num_strings > (_size - _pos) / 4) {
+    _error = true;
+    return false;
+  }
+
+  _strings.reserve(num_strings);
+  for (PN_uint32 i = 0; i < num_strings; ++i) {
+    PN_uint32 length = get_uint32();
+    if (!check_remaining(length)) {
+      return false;
+    }
+    _strings.push_back(string((const char *)_data + _pos, length));
+    _pos += length;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::read_load_commands
+//       Access: Private
+//  Description: Reads and performs each of the load commands, and
+//               records them in the DNAData so that it may be written
+//               out again.  Returns true on success, or false if the
+//               file is malformed.  If any command cannot be carried
+//               out, an error message is written and load_ok is set
+//               false, but the remaining commands are still performed,
+//               as the parser does.
+////////////////////////////////////////////////////////////////////
+bool DNABinaryReader::
+read_load_commands(DNAData *data, DNAStorage *store, ostream &error,
+                   bool &load_ok) {
+  PN_uint32 num_commands = get_uint32();
+  for (PN_uint32 i = 0; i < num_commands && !_error; ++i) {
+    int load_type = get_uint8();
+    switch (load_type) {
+    case DNABinary::LT_model:
+    case DNABinary::LT_hood_model:
+    case DNABinary::LT_place_model:
+      {
+        const string &filename = get_string();
+        if (!_error) {
+          data->record_load_command(load_type, string(), string(), filename);
+          if (!do_load_command(load_type, string(), string(), filename,
+                               store, error)) {
+            load_ok = false;
+          }
+        }
+      }
+      break;
+
+    case DNABinary::LT_store_node:
+    case DNABinary::LT_store_texture:
+    case DNABinary::LT_store_font:
+      {
+        const string &category = get_string();
+        const string &code = get_string();
+        const string &str = get_string();
+        if (!_error) {
+          data->record_load_command(load_type, category, code, str);
+          if (!do_load_command(load_type, category, code, str, store,
+                               error)) {
+            load_ok = false;
+          }
+        }
+      }
+      break;
+
+    case DNABinary::LT_store_suit_point:
+      {
+        int index = get_int32();
+        int point_type = get_uint8();
+        LVecBase3f pos = get_vec3();
+        int lb_index = get_int32();
+        if (!_error) {
+          PT(DNASuitPoint) point =
+            new DNASuitPoint(index, (DNASuitPoint::DNASuitPointType)point_type,
+                             LPoint3f(pos), lb_index);
+          data->record_suit_point(point);
+          store->store_suit_point(point);
+        }
+      }
+      break;
+
+    default:
+      _error = true;
+    }
+  }
+
+  return !_error;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::do_load_command
+//       Access: Private
+//  Description: Performs one model, store_node, texture, or font
+//               command, in the same way as the corresponding rule
+//               in the parser.  Returns false if the parser would
+//               have reported an error for it: that is, if a node
+//               named by a store_node command is not found.
+////////////////////////////////////////////////////////////////////
+bool DNABinaryReader::
+do_load_command(int load_type, const string &category,
+                const string &code, const string &str,
+                DNAStorage *store, ostream &error) {
+  bool okflag = true;
+  switch (load_type) {
+  case DNABinary::LT_model:
+  case DNABinary::LT_hood_model:
+  case DNABinary::LT_place_model:
+    {
+      Filename model = str;
+      model.set_extension("bam");
+      LoaderOptions options;
+      if (load_type != DNABinary::LT_model) {
+        // Hood and place models are deleted when the hood is left, so
+        // keep them out of the ModelPool.
+        options.set_flags(options.get_flags() | LoaderOptions::LF_no_ram_cache);
+      }
+      _current_model = NodePath(Loader::get_global_ptr()->load_sync(model, options));
+      _current_model_type = load_type;
+    }
+    break;
+
+  case DNABinary::LT_store_node:
+    {
+      // An empty search string means to use the top node of the model.
+      NodePath node = _current_model;
+      if (!str.empty() && !_current_model.is_empty()) {
+        node = _current_model.find("**/" + str);
+      }
+      if (!str.empty() && node.is_empty()) {
+        error << "Unable to find " << str << " for " << code << "\n";
+        okflag = false;
+      }
+      if (_current_model_type == DNABinary::LT_hood_model) {
+        store->store_hood_node(code, node, category);
+      } else if (_current_model_type == DNABinary::LT_place_model) {
+        store->store_place_node(code, node, category);
+      } else {
+        store->store_node(code, node, category);
+      }
+      store->store_catalog_string(category, code);
+    }
+    break;
+
+  case DNABinary::LT_store_texture:
+    {
+      PT(Texture) texture = TexturePool::load_texture(str);
+      if (texture == (Texture *)NULL) {
+        dna_cat.error()
+          << "Unable to load texture file " << str << "\n";
+      } else {
+        store->store_texture(code, texture);
+        store->store_catalog_string(category, code);
+      }
+    }
+    break;
+
+  case DNABinary::LT_store_font:
+    {
+      Filename model = str;
+      if (model.get_extension() == "") {
+        model.set_extension("bam");
+      }
+      PT(TextFont) font = FontPool::load_font(model);
+      if (font != (TextFont *)NULL && font->is_valid()) {
+        store->store_font(code, font);
+        store->store_catalog_string(category, code);
+      } else {
+        dna_cat.warning()
+          << "Unable to load font file " << str << "\n";
+      }
+    }
+    break;
+  }
+
+  return okflag;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::read_group
+//       Access: Private
+//  Description: Reads a group and all of its children.  Returns NULL
+//               and sets the error flag if the file is malformed.
+////////////////////////////////////////////////////////////////////
+PT(DNAGroup) DNABinaryReader::
+read_group(DNAStorage *store, int depth) {
+  if (depth > max_group_depth) {
+    _error = true;
+    return NULL;
+  }
+
+  int group_type = get_uint8();
+  PT(DNAGroup) group = make_group(group_type);
+  if (group == (DNAGroup *)NULL) {
+    _error = true;
+    return NULL;
+  }
+
+  group->fillin_binary(*this, store);
+
+  PN_uint32 num_children = get_uint32();
+  for (PN_uint32 i = 0; i < num_children && !_error; ++i) {
+    PT(DNAGroup) child = read_group(store, depth + 1);
+    if (child != (DNAGroup *)NULL) {
+      group->add(child);
+    }
+  }
+
+  return group;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNABinaryReader::make_group
+//       Access: Private
+//  Description: Returns a new, empty group of the indicated
+//               DNABinary::GroupType, or NULL if the type is unknown.
+////////////////////////////////////////////////////////////////////
+PT(DNAGroup) DNABinaryReader::
+make_group(int group_type) {
+  switch (group_type) {
+  case DNABinary::GT_group:
+    return new DNAGroup;
+  case DNABinary::GT_vis_group:
+    return new DNAVisGroup;
+  case DNABinary::GT_node:
+    return new DNANode("");
+  case DNABinary::GT_prop:
+    return new DNAProp;
+  case DNABinary::GT_anim_prop:
+    return new DNAAnimProp;
+  case DNABinary::GT_interactive_prop:
+    return new DNAInteractiveProp;
+  case DNABinary::GT_wall:
+    return new DNAWall;
+  case DNABinary::GT_flat_building:
+    return new DNAFlatBuilding;
+  case DNABinary::GT_landmark_building:
+    return new DNALandmarkBuilding;
+  case DNABinary::GT_anim_building:
+    return new DNAAnimBuilding;
+  case DNABinary::GT_street:
+    return new DNAStreet("");
+  case DNABinary::GT_windows:
+    return new DNAWindows;
+  case DNABinary::GT_cornice:
+    return new DNACornice;
+  case DNABinary::GT_door:
+    return new DNADoor;
+  case DNABinary::GT_flat_door:
+    return new DNAFlatDoor;
+  case DNABinary::GT_sign:
+    return new DNASign;
+  case DNABinary::GT_sign_baseline:
+    return new DNASignBaseline;
+  case DNABinary::GT_sign_text:
+    return new DNASignText;
+  case DNABinary::GT_sign_graphic:
+    return new DNASignGraphic;
+  }
+
+  return NULL;
+}
@@ -0,0 +1,194 @@
+// Filename: dnaBinary.h
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef DNABINARY_H
+#define DNABINARY_H
+
+#include "toontownbase.h"
+#include "datagram.h"
+#include "filename.h"
+#include "luse.h"
+#include "pmap.h"
+#include "pvector.h"
+#include "pointerTo.h"
+#include "numeric_types.h"
+#include "compose_matrix.h"
+#include "nodePath.h"
+
+class DNAGroup;
+class DNAData;
+class DNAStorage;
+
+////////////////////////////////////////////////////////////////////
+//       Class : DNABinary
+// Description : Constants shared by the reader and writer of
+//               precompiled (.pdna) DNA files.
+//
+//               A .pdna file holds exactly what the parser would
+//               have built from the corresponding .dna file: the
+//               load commands (models, store_node, textures, fonts,
+//               suit points) in order, followed by the DNAGroup
+//               tree.  All strings are gathered into a table at the
+//               front of the file and referred to by index.
+////////////////////////////////////////////////////////////////////
+class EXPCL_TOONTOWN DNABinary {
+public:
+  // A reader accepts files with its own major version and any minor
+  // version up to its own.  Bump the minor version when extending the
+  // format in a way the reader can still handle older files for;
+  // bump the major version otherwise.
+  enum Version {
+    major_version = 1,
+    minor_version = 0,
+  };
+
+  enum HeaderFlags {
+    HF_hpr_fix = 0x01,
+  };
+
+  // The type of each group in the tree.  These values are written to
+  // the file; do not renumber them.
+  enum GroupType {
+    GT_group = 1,
+    GT_vis_group,
+    GT_node,
+    GT_prop,
+    GT_anim_prop,
+    GT_interactive_prop,
+    GT_wall,
+    GT_flat_building,
+    GT_landmark_building,
+    GT_anim_building,
+    GT_street,
+    GT_windows,
+    GT_cornice,
+    GT_door,
+    GT_flat_door,
+    GT_sign,
+    GT_sign_baseline,
+    GT_sign_text,
+    GT_sign_graphic,
+  };
+
+  // The load commands that precede the group tree.
+  enum LoadType {
+    LT_model = 1,
+    LT_hood_model,
+    LT_place_model,
+    LT_store_node,
+    LT_store_texture,
+    LT_store_font,
+    LT_store_suit_point,
+  };
+
+  static const char _magic[];
+  static const size_t _magic_length;
+
+  static bool is_binary_filename(const Filename &filename);
+};
+
+////////////////////////////////////////////////////////////////////
+//       Class : DNABinaryWriter
+// Description : Accumulates a DNAData structure in the .pdna binary
+//               format, and writes it to disk.
+////////////////////////////////////////////////////////////////////
+class EXPCL_TOONTOWN DNABinaryWriter {
+public:
+  DNABinaryWriter();
+
+  bool write_file(const Filename &filename, const DNAData *data,
+                  ostream &error);
+  void write_data(const DNAData *data, Datagram &dg);
+
+  INLINE void add_uint8(PN_uint8 value);
+  INLINE void add_int32(PN_int32 value);
+  INLINE void add_uint32(PN_uint32 value);
+  INLINE void add_float32(float value);
+  INLINE void add_vec3(const LVecBase3f &value);
+  INLINE void add_color(const Colorf &value);
+  void add_string(const string &str);
+
+  void write_group(const DNAGroup *group);
+
+private:
+  int get_group_type(const DNAGroup *group) const;
+
+  Datagram _body;
+  typedef pmap<string, PN_uint32> StringIndex;
+  StringIndex _string_index;
+  pvector<string> _strings;
+};
+
+////////////////////////////////////////////////////////////////////
+//       Class : DNABinaryReader
+// Description : Reads a .pdna file back into a DNAData structure,
+//               replaying the load commands into the DNAStorage as
+//               it goes, exactly as the parser would have done.
+//
+//               The whole file is read into memory with one read
+//               through the VirtualFileSystem, and decoded from
+//               there.  Every string is copied out of the table once,
+//               since the DNA classes all store their own strings.
+////////////////////////////////////////////////////////////////////
+class EXPCL_TOONTOWN DNABinaryReader {
+public:
+  DNABinaryReader();
+  ~DNABinaryReader();
+
+  bool open(const Filename &filename);
+  void set_data(const string &data);
+  void close();
+
+  bool read(DNAData *data, ostream &error);
+
+  INLINE PN_uint8 get_uint8();
+  INLINE PN_uint16 get_uint16();
+  INLINE PN_int32 get_int32();
+  INLINE PN_uint32 get_uint32();
+  INLINE float get_float32();
+  INLINE LVecBase3f get_vec3();
+  INLINE LVecBase3f get_hpr();
+  INLINE Colorf get_color();
+  INLINE const string &get_string();
+
+  INLINE bool is_error() const;
+
+  INLINE void set_current_zone(const string &zone_name);
+  INLINE const string &get_current_zone() const;
+
+private:
+  INLINE bool check_remaining(size_t length);
+  bool read_strings();
+  bool read_load_commands(DNAData *data, DNAStorage *store,
+                          ostream &error, bool &load_ok);
+  bool do_load_command(int load_type, const string &category,
+                       const string &code, const string &str,
+                       DNAStorage *store, ostream &error);
+  PT(DNAGroup) read_group(DNAStorage *store, int depth);
+  PT(DNAGroup) make_group(int group_type);
+
+  const unsigned char *_data;
+  size_t _size;
+  size_t _pos;
+  bool _error;
+  bool _file_hpr_fix;
+  bool _convert_hpr;
+
+  pvector<string> _strings;
+  string _empty_string;
+  string _current_zone;
+
+  // The model most recently loaded by a model command, for the
+  // store_node commands that follow it.
+  NodePath _current_model;
+  int _current_model_type;
+
+  // Holds the file contents.
+  string _buffer;
+};
+
+#include "dnaBinary.I"
+
+#endif
@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaBuildings.h"
+#include "dnaBinary.h"
 #include "dnaStorage.h"
 #include "modelNode.h"
 #include "pandaNode.h"
@@ -124,6 +125,32 @@ void DNAWall::write(ostream &out, DNAStorage *store, int indent_level) const {
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAWall::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAWall::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_float32(_height);
+  writer.add_color(_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAWall::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAWall::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _height = reader.get_float32();
+  _color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAWall::make_copy
 //       Access: Public
@@ -400,6 +427,28 @@ void DNAFlatBuilding::write(ostream &out, DNAStorage *store, int indent_level) c
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAFlatBuilding::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAFlatBuilding::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_float32(_width);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAFlatBuilding::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAFlatBuilding::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _width = reader.get_float32();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAFlatBuilding::make_copy
 //       Access: Public
@@ -593,6 +642,42 @@ void DNALandmarkBuilding::write(ostream &out, DNAStorage *store, int indent_leve
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNALandmarkBuilding::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNALandmarkBuilding::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_wall_color);
+  writer.add_string(_title);
+  writer.add_string(_article);
+  writer.add_string(_building_type);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNALandmarkBuilding::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNALandmarkBuilding::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _wall_color = reader.get_color();
+  _title = reader.get_string();
+  _article = reader.get_string();
+  _building_type = reader.get_string();
+
+  // Store info on which blocks are in each zone, as the parser does.
+  store->store_block_number(get_name(), reader.get_current_zone());
+  if (!_building_type.empty()) {
+    store->store_block_building_type(get_name(), _building_type);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNALandmarkBuilding::make_copy
 //       Access: Public
@@ -54,6 +54,10 @@ private:
   float _height;
   Colorf _color;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -103,6 +107,10 @@ private:
 private:
   float _width;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -164,6 +172,10 @@ protected:
   string _article;
   string _building_type;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
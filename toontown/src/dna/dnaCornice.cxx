@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaCornice.h"
+#include "dnaBinary.h"
 #include "nodePath.h"
 
 ////////////////////////////////////////////////////////////////////
@@ -153,6 +154,30 @@ void DNACornice::write(ostream &out, DNAStorage *store, int indent_level) const
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNACornice::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNACornice::
+write_binary(DNABinaryWriter &writer) const {
+  DNAGroup::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNACornice::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNACornice::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAGroup::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNACornice::make_copy
 //       Access: Public
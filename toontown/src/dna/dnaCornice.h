@@ -38,6 +38,10 @@ private:
   string _code;
   Colorf _color;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -12,6 +12,7 @@
 #include "dSearchPath.h"
 #include "config_util.h"
 #include "virtualFileSystem.h"
+#include "dnaBinary.h"
 
 extern int dnayyparse(void);
 #include "parserDefs.h"
@@ -90,6 +91,7 @@ read(istream &in, ostream &error) {
   // replace them with the new data.
   dna_cat.debug() << "start of dnData.read\n";
   _group_vector.clear();
+  _load_commands.clear();
 
   dna_init_parser(in, error, get_dna_filename(), this);
   dnayyparse();
@@ -101,6 +103,37 @@ read(istream &in, ostream &error) {
   return (dna_error_count() == 0);
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAData::read_pdna
+//       Access: Public
+//  Description: Reads the contents of a precompiled .pdna file, as
+//               written by write_pdna().  The file's load commands
+//               are performed on the DNAStorage just as if the
+//               original .dna file had been read.  Returns true on
+//               success, false if the file could not be read or was
+//               malformed, in which case the data may be partially
+//               read.
+////////////////////////////////////////////////////////////////////
+bool DNAData::
+read_pdna(Filename filename, ostream &error) {
+  _group_vector.clear();
+  _load_commands.clear();
+
+  DNABinaryReader reader;
+  if (!reader.open(filename)) {
+    error << "Could not open " << filename << " for reading.\n";
+    return false;
+  }
+
+  if (dna_cat.is_debug()) {
+    dna_cat.debug()
+      << "Reading " << filename << "\n";
+  }
+
+  bool okflag = reader.read(this, error);
+  post_read(error);
+  return okflag;
+}
 
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAData::resolve_externals
@@ -151,6 +184,55 @@ write_dna(ostream &out, ostream &, DNAStorage *store) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAData::write_pdna
+//       Access: Public
+//  Description: Writes the data, along with the load commands that
+//               were recorded when it was read, to a precompiled
+//               .pdna file, which may be loaded much more quickly
+//               than the original .dna file.
+////////////////////////////////////////////////////////////////////
+bool DNAData::
+write_pdna(Filename filename, ostream &error) const {
+  DNABinaryWriter writer;
+  return writer.write_file(filename, this, error);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAData::record_load_command
+//       Access: Public
+//  Description: Called by the parser (and by the .pdna reader) for
+//               each model, store_node, texture, or font command; see
+//               DNABinary::LoadType.  The meaning of str depends on
+//               the command: it is the filename for models, textures,
+//               and fonts, and the node to search for with
+//               store_node.
+////////////////////////////////////////////////////////////////////
+void DNAData::
+record_load_command(int type, const string &category,
+                    const string &code, const string &str) {
+  LoadCommand command;
+  command._type = type;
+  command._category = category;
+  command._code = code;
+  command._str = str;
+  _load_commands.push_back(command);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAData::record_suit_point
+//       Access: Public
+//  Description: Called by the parser for each store_suit_point
+//               command.
+////////////////////////////////////////////////////////////////////
+void DNAData::
+record_suit_point(DNASuitPoint *point) {
+  LoadCommand command;
+  command._type = DNABinary::LT_store_suit_point;
+  command._suit_point = point;
+  _load_commands.push_back(command);
+}
+
 
 
 ////////////////////////////////////////////////////////////////////
@@ -18,6 +18,8 @@
 
 #include "dnaGroup.h"
 #include "dnaStorage.h"
+#include "dnaSuitPoint.h"
+#include "pvector.h"
 
 ///////////////////////////////////////////////////////////////////
 //       Class : DNAData
@@ -35,6 +37,7 @@ PUBLISHED:
 
   bool read(Filename filename, ostream &error = nout);
   bool read(istream &in, ostream &error = nout);
+  bool read_pdna(Filename filename, ostream &error = nout);
 
   static bool resolve_dna_filename(Filename &dna_filename,
                                    const DSearchPath &searchpath = DSearchPath());
@@ -42,6 +45,7 @@ PUBLISHED:
 
   bool write_dna(Filename filename, ostream &error, DNAStorage *store);
   bool write_dna(ostream &out, ostream &error, DNAStorage *store);
+  bool write_pdna(Filename filename, ostream &error = nout) const;
 
   void set_coordinate_system(CoordinateSystem coordsys);
   INLINE CoordinateSystem get_coordinate_system() const;
@@ -54,6 +58,25 @@ PUBLISHED:
 
   virtual void write(ostream &out, DNAStorage *store, int indent_level = 0) const;
 
+public:
+  // The model, store_node, texture, font, and suit point commands at
+  // the top of the file, in order.  These are recorded as the file is
+  // read so that it may be written out again as a .pdna file.
+  class LoadCommand {
+  public:
+    int _type;
+    string _category;
+    string _code;
+    string _str;
+    PT(DNASuitPoint) _suit_point;
+  };
+  typedef pvector<LoadCommand> LoadCommands;
+
+  void record_load_command(int type, const string &category,
+                           const string &code, const string &str);
+  void record_suit_point(DNASuitPoint *point);
+  INLINE const LoadCommands &get_load_commands() const;
+
 private:
   virtual DNAGroup* make_copy();
 
@@ -64,6 +87,7 @@ private:
   CoordinateSystem _coordsys;
   Filename _dna_filename;
   DNAStorage *_dna_store;
+  LoadCommands _load_commands;
 
 public:
   static TypeHandle get_class_type() {
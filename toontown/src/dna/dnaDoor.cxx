@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaDoor.h"
+#include "dnaBinary.h"
 #include "nodePath.h"
 #include "dnaStorage.h"
 #include "decalEffect.h"
@@ -217,6 +218,30 @@ void DNADoor::write(ostream &out, DNAStorage *store, int indent_level) const {
   indent(out, indent_level) << "]\n";
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNADoor::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNADoor::
+write_binary(DNABinaryWriter &writer) const {
+  DNAGroup::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNADoor::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNADoor::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAGroup::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNADoor::make_copy
 //       Access: Public
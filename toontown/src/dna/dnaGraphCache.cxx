@@ -0,0 +1,385 @@
+// Filename: dnaGraphCache.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "dnaGraphCache.h"
+#include "config_dna.h"
+#include "dnaData.h"
+#include "dnaVisGroup.h"
+#include "bamCache.h"
+#include "nodePath.h"
+#include "datagram.h"
+#include "datagramIterator.h"
+#include "dcast.h"
+#include "pmap.h"
+#include "string_utils.h"
+
+const string DNAGraphCache::_tag_key = "dna-graph-cache";
+
+// Bump this when the format of the record stored with the graph
+// changes, or when the traversal itself changes in a way that should
+// invalidate graphs already in the cache.
+static const int graph_cache_version = 2;
+
+// The record is stored in tags on the root of the graph.  A tag is
+// written with a 16-bit length, so a large record is split across
+// several tags of no more than this many bytes each.
+static const size_t tag_chunk_size = 0xf000;
+
+// Returns the key of the tag that holds the nth piece of the record.
+static string
+chunk_key(const string &tag_key, int n) {
+  return tag_key + "-" + format_string(n);
+}
+
+// Fills the map with each vis group in the tree, by name.
+typedef pmap<string, DNAVisGroup *> VisGroupsByName;
+static void
+r_collect_vis_groups(DNAGroup *group, VisGroupsByName &vis_groups) {
+  if (group->is_of_type(DNAVisGroup::get_class_type())) {
+    vis_groups[group->get_name()] = DCAST(DNAVisGroup, group);
+  }
+  int num_children = group->get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    r_collect_vis_groups(group->at(i), vis_groups);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+DNAGraphCache::
+DNAGraphCache(DNAData *data, DNAStorage *store) :
+  _data(data),
+  _store(store),
+  _recording(false)
+{
+  BamCache *cache = BamCache::get_global_ptr();
+  _active = (dna_cache_graphs && cache->get_active() &&
+             cache->get_cache_models() && !_data->get_dna_filename().empty());
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::Destructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+DNAGraphCache::
+~DNAGraphCache() {
+  if (_recording) {
+    _store->set_traverse_record(NULL);
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::load
+//       Access: Public
+//  Description: Looks for the graph for this DNA file and storage in
+//               the cache.  If it is found, applies its changes to
+//               the DNAStorage and returns it; otherwise, returns
+//               NULL, and the caller should traverse the DNA between
+//               calls to begin_traverse() and end_traverse().
+////////////////////////////////////////////////////////////////////
+PT(PandaNode) DNAGraphCache::
+load() {
+  if (!_active) {
+    return NULL;
+  }
+
+  // The key includes everything in the storage that the traversal
+  // might use; the source files themselves are checked for changes
+  // by the BamCacheRecord.
+  _source_files.clear();
+  size_t hash = _store->hash_sources(_source_files);
+
+  ostringstream strm;
+  strm << "dnag" << graph_cache_version << "_" << hex << hash << dec
+       << "_" << dna_flatten_vis_groups;
+
+  BamCache *cache = BamCache::get_global_ptr();
+  _record = cache->lookup(_data->get_dna_filename(), strm.str());
+  if (_record == (BamCacheRecord *)NULL) {
+    // A hash conflict in the cache; we'll have to do without.
+    _active = false;
+    return NULL;
+  }
+
+  if (_record->has_data() &&
+      _record->get_data()->is_of_type(PandaNode::get_class_type())) {
+    PT(PandaNode) result = DCAST(PandaNode, _record->get_data());
+    int num_chunks = atoi(result->get_tag(_tag_key).c_str());
+    result->clear_tag(_tag_key);
+    string encoded;
+    for (int n = 0; n < num_chunks; ++n) {
+      encoded += result->get_tag(chunk_key(_tag_key, n));
+      result->clear_tag(chunk_key(_tag_key, n));
+    }
+
+    Datagram dg(encoded);
+    DatagramIterator scan(dg);
+    DNAStorage::TraverseRecord record;
+    if (decode_record(result, scan, record)) {
+      if (dna_cat.is_debug()) {
+        dna_cat.debug()
+          << "Found " << _data->get_dna_filename() << " in graph cache.\n";
+      }
+      _store->apply_traverse_record(record);
+      _record.clear();
+      return result;
+    }
+
+    dna_cat.warning()
+      << "Ignoring invalid graph cache record for "
+      << _data->get_dna_filename() << "\n";
+  }
+
+  _record->clear_dependent_files();
+  _record->add_dependent_file(_data->get_dna_filename());
+  pset<Filename>::const_iterator fi;
+  for (fi = _source_files.begin(); fi != _source_files.end(); ++fi) {
+    _record->add_dependent_file(*fi);
+  }
+  return NULL;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::begin_traverse
+//       Access: Public
+//  Description: Called just before traversing the DNA, if load() did
+//               not find the graph, or the cache is not active.
+//               Starts recording the changes the traversal makes to
+//               the DNAStorage, if the graph is to be stored in the
+//               cache or its vis groups flattened.
+////////////////////////////////////////////////////////////////////
+void DNAGraphCache::
+begin_traverse() {
+  bool caching = (_active && _record != (BamCacheRecord *)NULL);
+  if (!caching && dna_flatten_vis_groups <= 0) {
+    return;
+  }
+  nassertv(_store->get_traverse_record() == (DNAStorage::TraverseRecord *)NULL);
+  _store->set_traverse_record(&_traverse_record);
+  _recording = true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::end_traverse
+//       Access: Public
+//  Description: Called with the result of the traversal.  Flattens
+//               the vis groups, if requested, and stores the result
+//               in the cache, if it is active.  The graph returned is
+//               then the same whether it came from the cache or not.
+////////////////////////////////////////////////////////////////////
+void DNAGraphCache::
+end_traverse(PandaNode *result) {
+  if (!_recording) {
+    return;
+  }
+  _store->set_traverse_record(NULL);
+  _recording = false;
+
+  flatten_vis_groups();
+
+  if (result == (PandaNode *)NULL ||
+      !_active || _record == (BamCacheRecord *)NULL) {
+    return;
+  }
+
+  Datagram dg;
+  if (!encode_record(result, dg)) {
+    // This graph can't be reconstructed from the cache.
+    dna_cat.debug()
+      << "Not caching graph for " << _data->get_dna_filename() << "\n";
+    return;
+  }
+
+  const string &message = dg.get_message();
+  int num_chunks = 0;
+  for (size_t p = 0; p < message.size(); p += tag_chunk_size) {
+    result->set_tag(chunk_key(_tag_key, num_chunks),
+                    message.substr(p, tag_chunk_size));
+    ++num_chunks;
+  }
+  result->set_tag(_tag_key, format_string(num_chunks));
+
+  _record->set_data(result, result);
+  BamCache::get_global_ptr()->store(_record);
+
+  result->clear_tag(_tag_key);
+  for (int n = 0; n < num_chunks; ++n) {
+    result->clear_tag(chunk_key(_tag_key, n));
+  }
+  _record.clear();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::flatten_vis_groups
+//       Access: Private
+//  Description: Flattens each of the vis groups created by the
+//               traversal, according to dna-flatten-vis-groups.
+////////////////////////////////////////////////////////////////////
+void DNAGraphCache::
+flatten_vis_groups() {
+  int level = dna_flatten_vis_groups;
+  if (level <= 0) {
+    return;
+  }
+
+  Node2VisGroupMap::const_iterator vi;
+  for (vi = _traverse_record._vis_groups.begin();
+       vi != _traverse_record._vis_groups.end();
+       ++vi) {
+    NodePath vis_group((*vi).first);
+    switch (level) {
+    case 1:
+      vis_group.flatten_light();
+      break;
+    case 2:
+      vis_group.flatten_medium();
+      break;
+    default:
+      vis_group.flatten_strong();
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::encode_record
+//       Access: Private
+//  Description: Writes the traverse record to the datagram, so that
+//               it may be stored with the graph.  Each vis group's
+//               node is written as the path of child indices from
+//               result.  Returns false if a vis group is not within
+//               the graph, so the record cannot be stored.
+////////////////////////////////////////////////////////////////////
+bool DNAGraphCache::
+encode_record(PandaNode *result, Datagram &dg) const {
+  const DNAStorage::TraverseRecord &record = _traverse_record;
+
+  dg.add_uint32(record._door_pos_hprs.size());
+  BlockToPosHprMap::const_iterator pi;
+  for (pi = record._door_pos_hprs.begin(); pi != record._door_pos_hprs.end(); ++pi) {
+    dg.add_int32((*pi).first);
+    (*pi).second.get_pos().write_datagram(dg);
+    (*pi).second.get_hpr().write_datagram(dg);
+  }
+
+  dg.add_uint32(record._sign_transforms.size());
+  BlockToTransformMap::const_iterator ti;
+  for (ti = record._sign_transforms.begin(); ti != record._sign_transforms.end(); ++ti) {
+    dg.add_int32((*ti).first);
+    (*ti).second.write_datagram(dg);
+  }
+
+  dg.add_uint32(record._titles.size());
+  BlockToTitleMap::const_iterator si;
+  for (si = record._titles.begin(); si != record._titles.end(); ++si) {
+    dg.add_int32((*si).first);
+    dg.add_string32((*si).second);
+  }
+
+  dg.add_uint32(record._articles.size());
+  for (si = record._articles.begin(); si != record._articles.end(); ++si) {
+    dg.add_int32((*si).first);
+    dg.add_string32((*si).second);
+  }
+
+  dg.add_uint32(record._vis_groups.size());
+  Node2VisGroupMap::const_iterator vi;
+  for (vi = record._vis_groups.begin(); vi != record._vis_groups.end(); ++vi) {
+    dg.add_string32((*vi).second->get_name());
+
+    // Walk up to the result, recording the index of each node within
+    // its parent.
+    pvector<int> path;
+    PandaNode *node = (*vi).first;
+    while (node != result) {
+      if (node->get_num_parents() != 1) {
+        // The vis group is not within the graph we are returning.
+        return false;
+      }
+      PandaNode *parent = node->get_parent(0);
+      path.push_back(parent->find_child(node));
+      node = parent;
+    }
+
+    dg.add_uint32(path.size());
+    pvector<int>::reverse_iterator ri;
+    for (ri = path.rbegin(); ri != path.rend(); ++ri) {
+      dg.add_uint32(*ri);
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGraphCache::decode_record
+//       Access: Private
+//  Description: The inverse of encode_record().  Returns true on
+//               success, or false if the record does not match this
+//               graph and DNA file.
+////////////////////////////////////////////////////////////////////
+bool DNAGraphCache::
+decode_record(PandaNode *result, DatagramIterator &scan,
+              DNAStorage::TraverseRecord &record) const {
+  if (scan.get_remaining_size() == 0) {
+    return false;
+  }
+
+  PN_uint32 num_door_pos_hprs = scan.get_uint32();
+  for (PN_uint32 i = 0; i < num_door_pos_hprs; ++i) {
+    int block = scan.get_int32();
+    LPoint3f pos, hpr;
+    pos.read_datagram(scan);
+    hpr.read_datagram(scan);
+    record._door_pos_hprs[block] = PosHpr(pos, hpr);
+  }
+
+  PN_uint32 num_sign_transforms = scan.get_uint32();
+  for (PN_uint32 i = 0; i < num_sign_transforms; ++i) {
+    int block = scan.get_int32();
+    record._sign_transforms[block].read_datagram(scan);
+  }
+
+  PN_uint32 num_titles = scan.get_uint32();
+  for (PN_uint32 i = 0; i < num_titles; ++i) {
+    int block = scan.get_int32();
+    record._titles[block] = scan.get_string32();
+  }
+
+  PN_uint32 num_articles = scan.get_uint32();
+  for (PN_uint32 i = 0; i < num_articles; ++i) {
+    int block = scan.get_int32();
+    record._articles[block] = scan.get_string32();
+  }
+
+  VisGroupsByName vis_groups;
+  r_collect_vis_groups(_data, vis_groups);
+
+  PN_uint32 num_vis_groups = scan.get_uint32();
+  for (PN_uint32 i = 0; i < num_vis_groups; ++i) {
+    string name = scan.get_string32();
+    PandaNode *node = result;
+    PN_uint32 depth = scan.get_uint32();
+    for (PN_uint32 d = 0; d < depth; ++d) {
+      int index = (int)scan.get_uint32();
+      if (index >= node->get_num_children()) {
+        return false;
+      }
+      node = node->get_child(index);
+    }
+
+    VisGroupsByName::const_iterator gi = vis_groups.find(name);
+    if (gi == vis_groups.end() || node->get_name() != name) {
+      return false;
+    }
+    record._vis_groups[node] = (*gi).second;
+  }
+
+  return true;
+}
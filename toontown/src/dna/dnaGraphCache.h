@@ -0,0 +1,71 @@
+// Filename: dnaGraphCache.h
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef DNAGRAPHCACHE_H
+#define DNAGRAPHCACHE_H
+
+#include "toontownbase.h"
+#include "dnaStorage.h"
+#include "bamCacheRecord.h"
+#include "pandaNode.h"
+#include "filename.h"
+#include "pointerTo.h"
+#include "pset.h"
+
+class DNAData;
+class Datagram;
+class DatagramIterator;
+
+////////////////////////////////////////////////////////////////////
+//       Class : DNAGraphCache
+// Description : Stores the scene graph built by traversing a DNA
+//               file in the BamCache, so that loading the same street
+//               again need not find and copy every prop, wall, and
+//               sign again.
+//
+//               Each entry is keyed on the DNA file and on a hash of
+//               the contents of the DNAStorage, and is invalidated
+//               when the DNA file or any model or texture in the
+//               storage changes on disk.  The changes that the
+//               traversal makes to the DNAStorage (vis groups, door
+//               positions, sign transforms, block titles) are stored
+//               with the graph and reapplied on a cache hit.
+//
+//               If dna-flatten-vis-groups is set, each vis group is
+//               flattened after the traversal, whether or not the
+//               cache is active, so the graph is the same either way;
+//               when it is cached, the flatten is paid for only once.
+////////////////////////////////////////////////////////////////////
+class EXPCL_TOONTOWN DNAGraphCache {
+public:
+  DNAGraphCache(DNAData *data, DNAStorage *store);
+  ~DNAGraphCache();
+
+  INLINE bool is_active() const;
+
+  PT(PandaNode) load();
+  void begin_traverse();
+  void end_traverse(PandaNode *result);
+
+private:
+  void flatten_vis_groups();
+  bool encode_record(PandaNode *result, Datagram &dg) const;
+  bool decode_record(PandaNode *result, DatagramIterator &scan,
+                     DNAStorage::TraverseRecord &record) const;
+
+  DNAData *_data;
+  DNAStorage *_store;
+  bool _active;
+  bool _recording;
+  PT(BamCacheRecord) _record;
+  pset<Filename> _source_files;
+  DNAStorage::TraverseRecord _traverse_record;
+
+  static const string _tag_key;
+};
+
+#include "dnaGraphCache.I"
+
+#endif
@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaGroup.h"
+#include "dnaBinary.h"
 #include "dnaStorage.h"
 #include "pandaNode.h"
 #include "pointerTo.h"
@@ -172,6 +173,30 @@ void DNAGroup::ls() const {
   write(cout, 0);
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGroup::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group, but not its
+//               children, to the .pdna file.  Each derived class
+//               writes its parent's fields first, then its own.
+////////////////////////////////////////////////////////////////////
+void DNAGroup::
+write_binary(DNABinaryWriter &writer) const {
+  writer.add_string(get_name());
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAGroup::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary(), and
+//               performs any side effects on the DNAStorage that the
+//               parser would have performed for this group.
+////////////////////////////////////////////////////////////////////
+void DNAGroup::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  set_name(reader.get_string());
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAGroup::make_copy
 //       Access: Public
@@ -21,6 +21,8 @@
 #include "typedReferenceCount.h"
 
 class DNAStorage;
+class DNABinaryWriter;
+class DNABinaryReader;
 
 ////////////////////////////////////////////////////////////////////
 //       Class : DNAGroup
@@ -60,6 +62,10 @@ private:
   // so they will have NULL pointers, and not "bad" pointers
   DNAGroup* _parent;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -79,6 +85,8 @@ public:
 
 private:
   static TypeHandle _type_handle;
+
+  friend class DNABinaryWriter;
 };
 
 
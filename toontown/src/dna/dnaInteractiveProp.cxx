@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaInteractiveProp.h"
+#include "dnaBinary.h"
 #include "sceneGraphReducer.h"
 #include "modelNode.h"
 #include "config_linmath.h"
@@ -151,6 +152,28 @@ void DNAInteractiveProp::write(ostream &out, DNAStorage *store, int indent_level
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAInteractiveProp::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAInteractiveProp::
+write_binary(DNABinaryWriter &writer) const {
+  DNAAnimProp::write_binary(writer);
+  writer.add_int32(_cell_id);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAInteractiveProp::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAInteractiveProp::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAAnimProp::fillin_binary(reader, store);
+  _cell_id = reader.get_int32();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAInteractiveProp::make_copy
 //       Access: Public
@@ -5,6 +5,8 @@
 
 #include "dnaLoader.h"
 #include "dnaStorage.h"
+#include "dnaGraphCache.h"
+#include "config_dna.h"
 #include "pandaNode.h"
 #include "nodePath.h"
 #include "pointerTo.h"
@@ -29,16 +31,38 @@ DNALoader::DNALoader() {
 ////////////////////////////////////////////////////////////////////
 PT(PandaNode) DNALoader::
 build_graph(DNAStorage *dna_store, int editing) {
+  // The level editor needs the DNAGroup for each node, which can't be
+  // restored from the cache.
+  DNAGraphCache cache(_data, dna_store);
+  if (!editing) {
+    if (cache.is_active()) {
+      PT(PandaNode) result = cache.load();
+      if (result != (PandaNode *)NULL) {
+        // Parent it just as top_level_traverse() would have; some
+        // callers look at the parent.
+        NodePath top = _root.attach_new_node(_data->get_name());
+        top.node()->add_child(result);
+        return result;
+      }
+    }
+    cache.begin_traverse();
+  }
+
   // Return the first child of the root
+  PT(PandaNode) result;
   NodePath top = _data->top_level_traverse(_root, dna_store, editing);
   if (!(top.get_num_children() == 0)) {
-    return top.get_child(0).node();
+    result = top.get_child(0).node();
   }
   else {
     dna_cat.debug()
       << "DNA File contained no geometry, returning empty node" << endl;
-    return (PandaNode *)NULL;
   }
+
+  if (!editing) {
+    cache.end_traverse(result);
+  }
+  return result;
 }
 
 PT(DNAData) DNALoader::get_data() {
@@ -10,7 +10,10 @@
 #include "dnaInteractiveProp.cxx"
 #include "dnaAnimBuilding.cxx"
 #include "dnaStorage.cxx"
+#include "dnaSuitRouteTable.cxx"
 #include "dnaStreet.cxx"
 #include "dnaWindow.cxx"
 #include "load_dna_file.cxx"
+#include "dnaBinary.cxx"
+#include "dnaGraphCache.cxx"
 #include "loaderFileTypeDNA.cxx"
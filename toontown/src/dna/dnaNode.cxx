@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaNode.h"
+#include "dnaBinary.h"
 #include "config_linmath.h"
 
 ////////////////////////////////////////////////////////////////////
@@ -110,6 +111,32 @@ void DNANode::write(ostream &out, DNAStorage *store, int indent_level) const {
 
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNANode::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNANode::
+write_binary(DNABinaryWriter &writer) const {
+  DNAGroup::write_binary(writer);
+  writer.add_vec3(_pos);
+  writer.add_vec3(_hpr);
+  writer.add_vec3(_scale);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNANode::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNANode::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAGroup::fillin_binary(reader, store);
+  _pos = reader.get_vec3();
+  _hpr = reader.get_hpr();
+  _scale = reader.get_vec3();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNANode::make_copy
 //       Access: Public
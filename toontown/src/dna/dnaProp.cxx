@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaProp.h"
+#include "dnaBinary.h"
 #include "sceneGraphReducer.h"
 #include "modelNode.h"
 #include "config_linmath.h"
@@ -141,6 +142,30 @@ void DNAProp::write(ostream &out, DNAStorage *store, int indent_level) const {
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAProp::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAProp::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAProp::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAProp::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAProp::make_copy
 //       Access: Public
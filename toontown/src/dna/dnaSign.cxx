@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaSign.h"
+#include "dnaBinary.h"
 #include "nodePath.h"
 #include "decalEffect.h"
 #include "sceneGraphReducer.h"
@@ -176,6 +177,30 @@ void DNASign::write(ostream &out, DNAStorage *store, int indent_level) const {
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNASign::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNASign::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASign::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNASign::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNASign::make_copy
 //       Access: Public
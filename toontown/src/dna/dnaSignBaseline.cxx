@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaSignBaseline.h"
+#include "dnaBinary.h"
 #include "dnaSign.h"
 #include "dnaSignText.h"
 #include "staticTextFont.h"
@@ -449,6 +450,46 @@ void DNASignBaseline::circle_next_pos_hpr_scale(
 }
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNASignBaseline::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNASignBaseline::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_string(_flags);
+  writer.add_color(_color);
+  writer.add_float32(_indent);
+  writer.add_float32(_kern);
+  writer.add_float32(_wiggle);
+  writer.add_float32(_stumble);
+  writer.add_float32(_stomp);
+  writer.add_float32(_width);
+  writer.add_float32(_height);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASignBaseline::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNASignBaseline::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _flags = reader.get_string();
+  _color = reader.get_color();
+  _indent = reader.get_float32();
+  _kern = reader.get_float32();
+  _wiggle = reader.get_float32();
+  _stumble = reader.get_float32();
+  _stomp = reader.get_float32();
+  _width = reader.get_float32();
+  _height = reader.get_float32();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNASignBaseline::make_copy
 //       Access: Public
@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaSignGraphic.h"
+#include "dnaBinary.h"
 #include "dnaSignBaseline.h"
 #include "nodePath.h"
 #include "decalEffect.h"
@@ -151,6 +152,36 @@ void DNASignGraphic::write(ostream &out, DNAStorage *store, int indent_level) co
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNASignGraphic::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNASignGraphic::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_color);
+  writer.add_float32(_width);
+  writer.add_float32(_height);
+  writer.add_uint8(_use_baseline_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASignGraphic::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNASignGraphic::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _color = reader.get_color();
+  _width = reader.get_float32();
+  _height = reader.get_float32();
+  _use_baseline_color = (reader.get_uint8() != 0);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNASignGraphic::make_copy
 //       Access: Public
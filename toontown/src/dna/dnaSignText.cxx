@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaSignText.h"
+#include "dnaBinary.h"
 #include "dnaSignBaseline.h"
 #include "dnaSign.h"
 #include "modelPool.h"
@@ -215,6 +216,34 @@ void DNASignText::write(ostream &out, DNAStorage *store, int indent_level) const
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNASignText::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNASignText::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_color(_color);
+  writer.add_string(_letters);
+  writer.add_uint8(_use_baseline_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASignText::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNASignText::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _color = reader.get_color();
+  _letters = reader.get_string();
+  _use_baseline_color = (reader.get_uint8() != 0);
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNASignText::make_copy
 //       Access: Public
@@ -4,6 +4,9 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaStorage.h"
+#include "modelRoot.h"
+#include "dcast.h"
+#include "stl_compares.h"
 #include <deque>
 
 DNAStorage::WorkingSuitPath *DNAStorage::WorkingSuitPath::_deleted_chain = (DNAStorage::WorkingSuitPath *)NULL;
@@ -13,7 +16,9 @@ DNAStorage::WorkingSuitPath *DNAStorage::WorkingSuitPath::_deleted_chain = (DNAS
 //       Access: Public
 //  Description:
 ////////////////////////////////////////////////////////////////////
-DNAStorage::DNAStorage() {
+DNAStorage::DNAStorage() :
+  _traverse_record(NULL)
+{
 }
 
 
@@ -374,6 +379,10 @@ int DNAStorage::remove_suit_point(PT(DNASuitPoint) point) {
     result += 1;
   }
 
+  if (_suit_routes.is_built()) {
+    _suit_routes.build(*this);
+  }
+
   return result;
 }
 
@@ -456,7 +465,11 @@ void DNAStorage::store_block_door_pos_hpr(const string& block,
     const LPoint3f& pos,
     const LPoint3f& hpr) {
   nassertv(!block.empty());
-  _block_door_pos_hpr_map[atoi(block.c_str())]=PosHpr(pos, hpr);
+  int block_number = atoi(block.c_str());
+  _block_door_pos_hpr_map[block_number]=PosHpr(pos, hpr);
+  if (_traverse_record != (TraverseRecord *)NULL) {
+    _traverse_record->_door_pos_hprs[block_number] = PosHpr(pos, hpr);
+  }
 }
 
 
@@ -524,7 +537,11 @@ int DNAStorage::get_door_pos_hpr_block_at(uint index) const {
 void DNAStorage::store_block_sign_transform(const string& block,
                                             const LMatrix4f& mat) {
   nassertv(!block.empty());
-  _block_sign_transform_map[atoi(block.c_str())]=mat;
+  int block_number = atoi(block.c_str());
+  _block_sign_transform_map[block_number]=mat;
+  if (_traverse_record != (TraverseRecord *)NULL) {
+    _traverse_record->_sign_transforms[block_number] = mat;
+  }
 }
 
 
@@ -591,7 +608,11 @@ int DNAStorage::get_sign_transform_block_at(uint index) const {
 void DNAStorage::store_block_title(const string& block,
     const string& title) {
   nassertv(!block.empty());
-  _block_title_map[atoi(block.c_str())]=title;
+  int block_number = atoi(block.c_str());
+  _block_title_map[block_number]=title;
+  if (_traverse_record != (TraverseRecord *)NULL) {
+    _traverse_record->_titles[block_number] = title;
+  }
 }
 
 
@@ -621,7 +642,11 @@ string DNAStorage::get_title_from_block_number(int block_number) const {
 void DNAStorage::store_block_article(const string& block,
     const string& article) {
   nassertv(!block.empty());
-  _block_article_map[atoi(block.c_str())]=article;
+  int block_number = atoi(block.c_str());
+  _block_article_map[block_number]=article;
+  if (_traverse_record != (TraverseRecord *)NULL) {
+    _traverse_record->_articles[block_number] = article;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -790,6 +815,7 @@ PT(DNASuitEdge) DNAStorage::store_suit_edge(PT(DNASuitEdge) edge) {
   }
   
   sev.push_back(edge);
+  _suit_routes.update_edge(*this, edge);
   return edge;
 }
 
@@ -818,6 +844,7 @@ int DNAStorage::remove_suit_edge(PT(DNASuitEdge) edge) {
       dna_cat.debug() << "removed edge from suit edge vector" << endl;
       (*i).second.erase(ei);
       found = 1;
+      _suit_routes.update_edge(*this, edge);
     }
   }
 
@@ -1233,6 +1260,104 @@ string DNAStorage::get_visible_name(uint visgroup_index, uint visible_index) con
   }
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: apply_traverse_record
+//       Access: Public
+//  Description: Stores all of the block information and vis groups
+//               in the record, as if the traversal that made it had
+//               just been performed again.
+////////////////////////////////////////////////////////////////////
+void DNAStorage::apply_traverse_record(const TraverseRecord &record) {
+  BlockToPosHprMap::const_iterator pi;
+  for (pi = record._door_pos_hprs.begin(); pi != record._door_pos_hprs.end(); ++pi) {
+    _block_door_pos_hpr_map[(*pi).first] = (*pi).second;
+  }
+  BlockToTransformMap::const_iterator ti;
+  for (ti = record._sign_transforms.begin(); ti != record._sign_transforms.end(); ++ti) {
+    _block_sign_transform_map[(*ti).first] = (*ti).second;
+  }
+  BlockToTitleMap::const_iterator si;
+  for (si = record._titles.begin(); si != record._titles.end(); ++si) {
+    _block_title_map[(*si).first] = (*si).second;
+  }
+  for (si = record._articles.begin(); si != record._articles.end(); ++si) {
+    _block_article_map[(*si).first] = (*si).second;
+  }
+  Node2VisGroupMap::const_iterator vi;
+  for (vi = record._vis_groups.begin(); vi != record._vis_groups.end(); ++vi) {
+    store_DNAVisGroup((*vi).first, (*vi).second);
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: hash_sources
+//       Access: Public
+//  Description: Returns a hash of all of the codes in the storage,
+//               along with the models and textures they were taken
+//               from, and adds the filenames of those models and
+//               textures to source_files.  Two storages that return
+//               the same hash will produce the same scene graph from
+//               the same DNA file, as long as none of the source
+//               files have changed on disk.
+////////////////////////////////////////////////////////////////////
+size_t DNAStorage::hash_sources(pset<Filename> &source_files) const {
+  size_t hash = 0;
+  hash = hash_node_map(hash, _node_map, source_files);
+  hash = hash_node_map(hash, _hood_node_map, source_files);
+  hash = hash_node_map(hash, _place_node_map, source_files);
+
+  TextureMap::const_iterator ti;
+  for (ti = _texture_map.begin(); ti != _texture_map.end(); ++ti) {
+    hash = string_hash::add_hash(hash, (*ti).first);
+    Texture *texture = (*ti).second;
+    if (texture != (Texture *)NULL) {
+      hash = string_hash::add_hash(hash, texture->get_fullpath().get_fullpath());
+      source_files.insert(texture->get_fullpath());
+    }
+  }
+
+  FontMap::const_iterator fi;
+  for (fi = _font_map.begin(); fi != _font_map.end(); ++fi) {
+    hash = string_hash::add_hash(hash, (*fi).first);
+    TextFont *font = (*fi).second;
+    if (font != (TextFont *)NULL) {
+      hash = string_hash::add_hash(hash, font->get_name());
+    }
+  }
+
+  return hash;
+}
+
+
+////////////////////////////////////////////////////////////////////
+//     Function: hash_node_map
+//       Access: Private, Static
+//  Description: Adds the codes in the indicated map, and the model
+//               and node each was found in, to the running hash.
+////////////////////////////////////////////////////////////////////
+size_t DNAStorage::hash_node_map(size_t hash, const NodeMap &node_map,
+                                 pset<Filename> &source_files) {
+  NodeMap::const_iterator ni;
+  for (ni = node_map.begin(); ni != node_map.end(); ++ni) {
+    hash = string_hash::add_hash(hash, (*ni).first);
+    const NodePath &node = (*ni).second;
+    if (node.is_empty()) {
+      continue;
+    }
+    hash = string_hash::add_hash(hash, node.get_name());
+
+    PandaNode *top = node.get_top().node();
+    if (top->is_of_type(ModelRoot::get_class_type())) {
+      const Filename &fullpath = DCAST(ModelRoot, top)->get_fullpath();
+      hash = string_hash::add_hash(hash, fullpath.get_fullpath());
+      source_files.insert(fullpath);
+    }
+  }
+  return hash;
+}
+
+
 ////////////////////////////////////////////////////////////////////
 //     Function: store_DNAVisGroupAI
 //       Access: Public
@@ -1411,8 +1536,13 @@ get_suit_path(const DNASuitPoint *start_point, const DNASuitPoint *end_point,
       << max_length << "\n";
   }
 
-  PT(DNASuitPath) path = 
-    get_suit_path_breadth_first(start_point, end_point, min_length, max_length);
+  // The route table can usually answer without searching; it is
+  // built by discover_continuity().
+  PT(DNASuitPath) path;
+  if (!dna_suit_routes ||
+      !_suit_routes.find_path(start_point, end_point, min_length, max_length, path)) {
+    path = get_suit_path_breadth_first(start_point, end_point, min_length, max_length);
+  }
   if (path != (DNASuitPath *)NULL) {
     if (dna_cat.is_debug()) {
       dna_cat.debug()
@@ -1493,6 +1623,12 @@ discover_continuity() {
       r_discover_connections(point, graph_id);
     }
   }
+
+  if (dna_suit_routes) {
+    _suit_routes.build(*this);
+  } else {
+    _suit_routes.clear();
+  }
   
   return graph_id;
 }
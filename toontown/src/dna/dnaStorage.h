@@ -21,6 +21,7 @@
 #include "dnaSuitPoint.h"
 #include "dnaSuitEdge.h"
 #include "dnaSuitPath.h"
+#include "dnaSuitRouteTable.h"
 #include "dnaBattleCell.h"
 
 //////////////////////////////////////////////////
@@ -213,6 +214,25 @@ PUBLISHED:
   void write(ostream &out, int indent_level) const;
 
 public:
+  // Collects the changes that traversing the DNA makes to the
+  // storage, so that they may be reapplied when the traversal's
+  // result is taken from the DNAGraphCache instead.
+  class TraverseRecord {
+  public:
+    BlockToPosHprMap _door_pos_hprs;
+    BlockToTransformMap _sign_transforms;
+    BlockToTitleMap _titles;
+    BlockToArticleMap _articles;
+    Node2VisGroupMap _vis_groups;
+  };
+
+  INLINE void set_traverse_record(TraverseRecord *record);
+  INLINE TraverseRecord *get_traverse_record() const;
+  void apply_traverse_record(const TraverseRecord &record);
+
+  size_t hash_sources(pset<Filename> &source_files) const;
+
+  INLINE const DNASuitRouteTable &get_suit_routes() const;
 
   class WorkingSuitPath : public ReferenceCount {
   public:
@@ -259,8 +279,11 @@ private:
   NodeMap _place_node_map;
   Node2GroupMap _n2group_map;
   Node2VisGroupMap _n2visgroup_map;
+  TraverseRecord *_traverse_record;
 
   void r_discover_connections(DNASuitPoint *point, int graph_id);
+  static size_t hash_node_map(size_t hash, const NodeMap &node_map,
+                              pset<Filename> &source_files);
 
   PT(DNASuitEdge) get_suit_edge(int start_index, int end_index) const;
   PT(DNASuitPath)
@@ -277,9 +300,12 @@ private:
   SuitPointVector _suit_point_vector;
   SuitPointMap _suit_point_map;
   SuitStartPointMap _suit_start_point_map;
+  DNASuitRouteTable _suit_routes;
   BattleCellVector _battle_cell_vector;
   VisGroupVectorAI _vis_group_vector;
 
+  friend class DNASuitRouteTable;
+
 };
 
 #include "dnaStorage.I"
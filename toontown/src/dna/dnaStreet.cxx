@@ -5,6 +5,7 @@
 
 
 #include "dnaStreet.h"
+#include "dnaBinary.h"
 #include "dnaStorage.h"
 #include "pandaNode.h"
 #include "pointerTo.h"
@@ -159,6 +160,40 @@ void DNAStreet::write(ostream &out, DNAStorage *store, int indent_level) const {
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAStreet::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAStreet::
+write_binary(DNABinaryWriter &writer) const {
+  DNANode::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_string(_street_texture);
+  writer.add_string(_sidewalk_texture);
+  writer.add_string(_curb_texture);
+  writer.add_color(_street_color);
+  writer.add_color(_sidewalk_color);
+  writer.add_color(_curb_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAStreet::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAStreet::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNANode::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _street_texture = reader.get_string();
+  _sidewalk_texture = reader.get_string();
+  _curb_texture = reader.get_string();
+  _street_color = reader.get_color();
+  _sidewalk_color = reader.get_color();
+  _curb_color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAStreet::make_copy
 //       Access: Public
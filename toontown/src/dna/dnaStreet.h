@@ -65,6 +65,10 @@ private:
   Colorf _sidewalk_color;
   Colorf _curb_color;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -0,0 +1,624 @@
+// Filename: dnaSuitRouteTable.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "dnaSuitRouteTable.h"
+#include "dnaStorage.h"
+#include "config_dna.h"
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::Constructor
+//       Access: Public
+//  Description:
+////////////////////////////////////////////////////////////////////
+DNASuitRouteTable::
+DNASuitRouteTable() :
+  _built(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::clear
+//       Access: Public
+//  Description: Empties the table.  get_suit_path() will search the
+//               graph until the table is built again.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::
+clear() {
+  _components.clear();
+  _locations.clear();
+  _built = false;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::build
+//       Access: Public
+//  Description: Rebuilds the whole table from the suit points and
+//               edges currently in the storage.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::
+build(const DNAStorage &store) {
+  clear();
+
+  // Collect every point, including any that are named only by an
+  // edge, and find the connected graphs among them by merging the
+  // two ends of each edge.
+  typedef pmap<int, const DNASuitPoint *> Points;
+  Points points;
+  pmap<int, int> parents;
+
+  SuitPointVector::const_iterator pi;
+  for (pi = store._suit_point_vector.begin();
+       pi != store._suit_point_vector.end();
+       ++pi) {
+    points[(*pi)->get_index()] = (*pi);
+    parents[(*pi)->get_index()] = (*pi)->get_index();
+  }
+
+  SuitStartPointMap::const_iterator si;
+  for (si = store._suit_start_point_map.begin();
+       si != store._suit_start_point_map.end();
+       ++si) {
+    SuitEdgeVector::const_iterator ei;
+    for (ei = (*si).second.begin(); ei != (*si).second.end(); ++ei) {
+      const DNASuitPoint *a = (*ei)->get_start_point();
+      const DNASuitPoint *b = (*ei)->get_end_point();
+      if (points.insert(Points::value_type(a->get_index(), a)).second) {
+        parents[a->get_index()] = a->get_index();
+      }
+      if (points.insert(Points::value_type(b->get_index(), b)).second) {
+        parents[b->get_index()] = b->get_index();
+      }
+
+      int ra = a->get_index();
+      while (parents[ra] != ra) {
+        ra = parents[ra];
+      }
+      int rb = b->get_index();
+      while (parents[rb] != rb) {
+        rb = parents[rb];
+      }
+      if (ra != rb) {
+        parents[rb] = ra;
+      }
+    }
+  }
+
+  pmap<int, int> component_of_root;
+  Points::const_iterator ti;
+  for (ti = points.begin(); ti != points.end(); ++ti) {
+    int root = (*ti).first;
+    while (parents[root] != root) {
+      root = parents[root];
+    }
+
+    pmap<int, int>::iterator ci = component_of_root.find(root);
+    if (ci == component_of_root.end()) {
+      ci = component_of_root.insert(pmap<int, int>::value_type(root, _components.size())).first;
+      _components.push_back(Component());
+    }
+
+    Component &comp = _components[(*ci).second];
+    Location &loc = _locations[(*ti).first];
+    loc._component = (*ci).second;
+    loc._local = comp._points.size();
+    comp._points.push_back((*ti).first);
+    comp._terminal.push_back((*ti).second->is_terminal());
+  }
+
+  for (int ci = 0; ci < (int)_components.size(); ++ci) {
+    build_component(store, ci);
+  }
+
+  _built = true;
+
+  if (dna_cat.is_debug()) {
+    dna_cat.debug()
+      << "Built suit routes for " << points.size() << " points in "
+      << _components.size() << " graphs, " << get_memory_usage()
+      << " bytes.\n";
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::update_edge
+//       Access: Public
+//  Description: Should be called after the indicated edge has been
+//               added to or removed from the storage.  Only the graph
+//               containing the edge is recomputed, unless the edge
+//               joins two graphs or names a new point, in which case
+//               the whole table is rebuilt.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::
+update_edge(const DNAStorage &store, const DNASuitEdge *edge) {
+  if (!_built) {
+    return;
+  }
+
+  Locations::const_iterator si = _locations.find(edge->get_start_point()->get_index());
+  Locations::const_iterator ei = _locations.find(edge->get_end_point()->get_index());
+  if (si == _locations.end() || ei == _locations.end() ||
+      (*si).second._component != (*ei).second._component) {
+    build(store);
+    return;
+  }
+
+  // Removing an edge might split the graph in two, but there is no
+  // harm in keeping both halves in the same table.
+  build_component(store, (*si).second._component);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::find_path
+//       Access: Public
+//  Description: Looks up the shortest path from start_point to
+//               end_point that is at least min_length points long
+//               (not counting any loops it must make to get that
+//               long), and no longer than max_length, in the same way
+//               as DNAStorage::get_suit_path_breadth_first().
+//
+//               Returns true if the table was able to answer the
+//               question, in which case path is filled in with the
+//               path found or NULL if there is none, or false if the
+//               caller should search the graph instead.
+//
+//               The path is always the same length as the one the
+//               search would find, but where there are several paths
+//               of that length, the two may choose different ones.
+////////////////////////////////////////////////////////////////////
+bool DNASuitRouteTable::
+find_path(const DNASuitPoint *start_point, const DNASuitPoint *end_point,
+          int min_length, int max_length, PT(DNASuitPath) &path) const {
+  if (!_built) {
+    return false;
+  }
+
+  Locations::const_iterator si = _locations.find(start_point->get_index());
+  Locations::const_iterator ei = _locations.find(end_point->get_index());
+  if (si == _locations.end() || ei == _locations.end()) {
+    // This point was added since the table was built.
+    return false;
+  }
+
+  path = NULL;
+  if ((*si).second._component != (*ei).second._component) {
+    return true;
+  }
+
+  const Component &comp = _components[(*si).second._component];
+  int start = (*si).second._local;
+  int end = (*ei).second._local;
+
+  if (min_length > 2) {
+    return find_long_path(comp, start, end, min_length, max_length, path);
+  }
+
+  if (comp.get_next(start, end) == no_route) {
+    return true;
+  }
+
+  PT(DNASuitPath) result = new DNASuitPath;
+  result->add_point(comp._points[start]);
+  add_route(comp, start, end, result);
+  if (result->get_num_points() <= max_length) {
+    path = result;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::get_memory_usage
+//       Access: Public
+//  Description: Returns the approximate number of bytes used by the
+//               table.
+////////////////////////////////////////////////////////////////////
+size_t DNASuitRouteTable::
+get_memory_usage() const {
+  size_t total = sizeof(*this);
+  Components::const_iterator ci;
+  for (ci = _components.begin(); ci != _components.end(); ++ci) {
+    const Component &comp = (*ci);
+    total += sizeof(Component);
+    total += comp._points.size() * sizeof(int);
+    total += comp._terminal.size() / 8;
+    total += (comp._edge_begin.size() + comp._rev_begin.size()) * sizeof(int);
+    total += (comp._edge_start.size() + comp._edge_end.size() +
+              comp._rev_edge.size()) * sizeof(LocalIndex);
+    total += (comp._next.size() + comp._distance.size()) * sizeof(LocalIndex);
+
+    WalksBySteps::const_iterator wi;
+    for (wi = comp._walks.begin(); wi != comp._walks.end(); ++wi) {
+      const StartWalks &starts = (*wi).second;
+      total += starts.size() * sizeof(Walks);
+      StartWalks::const_iterator sti;
+      for (sti = starts.begin(); sti != starts.end(); ++sti) {
+        total += (*sti)._reached.size() * sizeof(PN_uint32);
+        total += ((*sti)._last_edge.size() + (*sti)._next_point.size()) * sizeof(LocalIndex);
+      }
+    }
+  }
+
+  // Each map entry also carries the overhead of its tree node.
+  total += _locations.size() * (sizeof(Locations::value_type) + 4 * sizeof(void *));
+  return total;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::build_component
+//       Access: Private
+//  Description: Reads the edges among the points of the indicated
+//               graph from the storage, and recomputes its routes.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::
+build_component(const DNAStorage &store, int ci) {
+  Component &comp = _components[ci];
+  int num_points = comp.get_num_points();
+  if (num_points >= no_route) {
+    // Too big to index with a LocalIndex.  This is far bigger than
+    // any street, so we don't bother to handle it; get_suit_path()
+    // will search these points instead.
+    dna_cat.warning()
+      << "Not building suit routes for graph with " << num_points
+      << " points.\n";
+    for (int i = 0; i < num_points; ++i) {
+      _locations.erase(comp._points[i]);
+    }
+    comp._points.clear();
+    comp._terminal.clear();
+    num_points = 0;
+  }
+
+  comp._edge_begin.clear();
+  comp._edge_start.clear();
+  comp._edge_end.clear();
+  comp._edge_begin.reserve(num_points + 1);
+
+  pvector<int> num_in(num_points + 1, 0);
+  for (int i = 0; i < num_points; ++i) {
+    comp._edge_begin.push_back(comp._edge_end.size());
+
+    SuitStartPointMap::const_iterator si =
+      store._suit_start_point_map.find(comp._points[i]);
+    if (si == store._suit_start_point_map.end()) {
+      continue;
+    }
+
+    SuitEdgeVector::const_iterator ei;
+    for (ei = (*si).second.begin(); ei != (*si).second.end(); ++ei) {
+      Locations::const_iterator li =
+        _locations.find((*ei)->get_end_point()->get_index());
+      nassertv(li != _locations.end() && (*li).second._component == ci);
+      int j = (*li).second._local;
+
+      // The same two points may be joined by more than one edge, in
+      // different zones; we only need the step once.
+      if (j != i &&
+          find(comp._edge_end.begin() + comp._edge_begin[i],
+               comp._edge_end.end(), (LocalIndex)j) == comp._edge_end.end()) {
+        comp._edge_start.push_back(i);
+        comp._edge_end.push_back(j);
+        num_in[j + 1]++;
+      }
+    }
+  }
+  comp._edge_begin.push_back(comp._edge_end.size());
+
+  // Now invert the edges, so that we can search backwards from each
+  // destination.
+  for (int i = 0; i < num_points; ++i) {
+    num_in[i + 1] += num_in[i];
+  }
+  comp._rev_begin = num_in;
+  comp._rev_edge.assign(comp._edge_end.size(), 0);
+  for (int e = 0; e < (int)comp._edge_end.size(); ++e) {
+    comp._rev_edge[num_in[comp._edge_end[e]]++] = e;
+  }
+
+  comp.build_routes();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::find_long_path
+//       Access: Private
+//  Description: The implementation of find_path() for min_length
+//               greater than 2.  The breadth-first search first walks
+//               every way it can go in (min_length - 2) steps, turning
+//               around at door points and never immediately
+//               doubling back, and then looks for the shortest way
+//               from any of those walks to end.
+//
+//               The walks from start are worked out when the graph
+//               is built, for each minimum length named by
+//               dna-suit-route-min-lengths (see build_walks()), and
+//               the walk is read back one step at a time, so the cost
+//               is only the length of the path.  For any other
+//               minimum length, this returns false, and the caller
+//               searches instead.
+////////////////////////////////////////////////////////////////////
+bool DNASuitRouteTable::
+find_long_path(const Component &comp, int start, int end,
+               int min_length, int max_length, PT(DNASuitPath) &path) const {
+  if (comp._edge_end.size() >= search_route) {
+    // Too many edges to index with a LocalIndex.
+    return false;
+  }
+
+  int num_steps = min_length - 2;
+  const Walks *walks_ptr = comp.find_walks(start, num_steps);
+  if (walks_ptr == (const Walks *)NULL) {
+    return false;
+  }
+  const Walks &walks = *walks_ptr;
+
+  int pe = walks._last_edge[end];
+  if (pe == search_route) {
+    return false;
+  }
+  if (pe == no_route) {
+    return true;
+  }
+
+  int next_point = walks._next_point[end];
+  int length = 2 + num_steps;
+  if (next_point != end) {
+    length += comp.get_distance(next_point, end);
+  }
+  if (length > max_length) {
+    return true;
+  }
+
+  // Walk back through the steps to recover the walk.  At each step
+  // we take the lowest-numbered edge that some walk arrives along,
+  // which is the same walk build_walks() would have found going
+  // forwards.
+  pvector<int> walk(num_steps);
+  for (int s = num_steps - 1; s >= 0; --s) {
+    int point = comp._edge_end[pe];
+    walk[s] = comp._points[point];
+    if (s != 0) {
+      int from = comp._edge_start[pe];
+      int r = comp._rev_begin[from];
+      while (r < comp._rev_begin[from + 1] &&
+             (comp._edge_start[comp._rev_edge[r]] == point ||
+              !walks.is_reached(s - 1, comp._rev_edge[r]))) {
+        ++r;
+      }
+      nassertr(r < comp._rev_begin[from + 1], false);
+      pe = comp._rev_edge[r];
+    }
+  }
+
+  path = new DNASuitPath(length);
+  path->add_point(comp._points[start]);
+  for (int s = 0; s < num_steps; ++s) {
+    path->add_point(walk[s]);
+  }
+  path->add_point(comp._points[next_point]);
+  if (next_point != end) {
+    add_route(comp, next_point, end, path);
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::add_route
+//       Access: Private, Static
+//  Description: Appends the points of the route from from to to,
+//               not including from itself, to the path.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::
+add_route(const Component &comp, int from, int to, DNASuitPath *path) {
+  int num_points = comp.get_num_points();
+  int point = from;
+  for (int i = 0; i < num_points; ++i) {
+    point = comp.get_next(point, to);
+    nassertv(point != no_route);
+    path->add_point(comp._points[point]);
+    if (point == to) {
+      return;
+    }
+  }
+
+  // The route didn't reach to; the table is inconsistent.
+  nassertv(false);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::Component::build_routes
+//       Access: Public
+//  Description: Fills in the next-point and distance matrices by
+//               searching backwards from each point in turn.  A route
+//               may start at a door point, but may not pass through
+//               one.
+//
+//               Then works out the walks from each point for each
+//               minimum length named by dna-suit-route-min-lengths.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::Component::
+build_routes() {
+  int num_points = get_num_points();
+  _next.assign(num_points * num_points, (LocalIndex)no_route);
+  _distance.assign(num_points * num_points, (LocalIndex)no_route);
+  _walks.clear();
+
+  pvector<LocalIndex> queue;
+  queue.reserve(num_points);
+  pvector<bool> visited;
+
+  for (int to = 0; to < num_points; ++to) {
+    visited.assign(num_points, false);
+    visited[to] = true;
+    _distance[to * num_points + to] = 0;
+    queue.clear();
+    queue.push_back(to);
+
+    for (size_t q = 0; q < queue.size(); ++q) {
+      int point = queue[q];
+      if (point != to && _terminal[point]) {
+        continue;
+      }
+      for (int r = _rev_begin[point]; r < _rev_begin[point + 1]; ++r) {
+        int from = _edge_start[_rev_edge[r]];
+        if (from == to) {
+          // This is the shortest way back around to the destination,
+          // for a path that starts and ends at the same point.
+          if (_next[to * num_points + to] == no_route) {
+            _next[to * num_points + to] = point;
+          }
+        } else if (!visited[from]) {
+          visited[from] = true;
+          _next[from * num_points + to] = point;
+          _distance[from * num_points + to] = _distance[point * num_points + to] + 1;
+          queue.push_back(from);
+        }
+      }
+    }
+  }
+
+  if (_edge_end.size() >= search_route) {
+    // Too many edges to index with a LocalIndex; find_long_path()
+    // will leave these to the search.
+    return;
+  }
+
+  int num_lengths = dna_suit_route_min_lengths.get_num_words();
+  for (int i = 0; i < num_lengths; ++i) {
+    int num_steps = dna_suit_route_min_lengths[i] - 2;
+    if (num_steps <= 0 || _walks.find(num_steps) != _walks.end()) {
+      // Short paths are read straight from the route matrix.
+      continue;
+    }
+    StartWalks &starts = _walks[num_steps];
+    starts.insert(starts.end(), num_points, Walks());
+    for (int start = 0; start < num_points; ++start) {
+      build_walks(starts[start], start, num_steps);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::Component::find_walks
+//       Access: Public
+//  Description: Returns the walks of num_steps steps from the
+//               indicated start point, or NULL if they were not
+//               worked out when the graph was built.
+////////////////////////////////////////////////////////////////////
+const DNASuitRouteTable::Walks *DNASuitRouteTable::Component::
+find_walks(int start, int num_steps) const {
+  WalksBySteps::const_iterator wi = _walks.find(num_steps);
+  if (wi == _walks.end()) {
+    return NULL;
+  }
+  return &(*wi).second[start];
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNASuitRouteTable::Component::build_walks
+//       Access: Public
+//  Description: Works out the walks of num_steps steps from start,
+//               and the walk that leads most quickly from them to
+//               each end point.
+//
+//               Rather than enumerating each walk, as the search
+//               does, we only need to know which edges they can
+//               arrive along at each step, so this is linear in
+//               num_steps.
+////////////////////////////////////////////////////////////////////
+void DNASuitRouteTable::Component::
+build_walks(Walks &walks, int start, int num_steps) const {
+  int num_points = get_num_points();
+  int num_edges = _edge_end.size();
+  int num_words = (num_edges + 31) / 32;
+  walks._num_words = num_words;
+  walks._reached.assign(num_steps * num_words, 0);
+
+  int e;
+  for (e = _edge_begin[start]; e < _edge_begin[start + 1]; ++e) {
+    if (!_terminal[_edge_end[e]]) {
+      walks._reached[e >> 5] |= ((PN_uint32)1 << (e & 31));
+    }
+  }
+
+  // Each edge we arrive along at one step leads on to the edges out
+  // of its end point at the next.
+  int pe;
+  for (int s = 1; s < num_steps; ++s) {
+    int this_step = s * num_words;
+    for (pe = 0; pe < num_edges; ++pe) {
+      if (!walks.is_reached(s - 1, pe)) {
+        continue;
+      }
+      int point = _edge_end[pe];
+      int prev_point = _edge_start[pe];
+      for (e = _edge_begin[point]; e < _edge_begin[point + 1]; ++e) {
+        int next_point = _edge_end[e];
+        if (!_terminal[next_point] && next_point != prev_point) {
+          walks._reached[this_step + (e >> 5)] |= ((PN_uint32)1 << (e & 31));
+        }
+      }
+    }
+  }
+
+  // Every way of taking one more step from the end of a walk is a
+  // candidate for the step that leaves the walks behind.
+  pvector<LocalIndex> cand_edge, cand_next;
+  for (pe = 0; pe < num_edges; ++pe) {
+    if (!walks.is_reached(num_steps - 1, pe)) {
+      continue;
+    }
+    int point = _edge_end[pe];
+    for (e = _edge_begin[point]; e < _edge_begin[point + 1]; ++e) {
+      cand_edge.push_back(pe);
+      cand_next.push_back(_edge_end[e]);
+    }
+  }
+
+  walks._last_edge.assign(num_points, (LocalIndex)no_route);
+  walks._next_point.assign(num_points, (LocalIndex)no_route);
+
+  int num_cands = cand_edge.size();
+  for (int end = 0; end < num_points; ++end) {
+    int best_length = -1;
+    int best_cand = 0;
+    int shortest_skipped = -1;
+
+    for (int c = 0; c < num_cands; ++c) {
+      int point = _edge_end[cand_edge[c]];
+      int prev_point = _edge_start[cand_edge[c]];
+      int next_point = cand_next[c];
+      int length;
+      if (next_point == end) {
+        length = 1;
+      } else if (!_terminal[next_point] && next_point != prev_point &&
+                 get_distance(next_point, end) != no_route) {
+        length = 1 + get_distance(next_point, end);
+        if (get_next(next_point, end) == point) {
+          // The table's route from next_point turns straight back to
+          // point, which the search would not allow.  There may be
+          // another route just as short that the table doesn't know
+          // about.
+          if (shortest_skipped < 0 || length < shortest_skipped) {
+            shortest_skipped = length;
+          }
+          continue;
+        }
+      } else {
+        continue;
+      }
+
+      if (best_length < 0 || length < best_length) {
+        best_length = length;
+        best_cand = c;
+      }
+    }
+
+    if (shortest_skipped >= 0 &&
+        (best_length < 0 || shortest_skipped < best_length)) {
+      walks._last_edge[end] = search_route;
+    } else if (best_length >= 0) {
+      walks._last_edge[end] = cand_edge[best_cand];
+      walks._next_point[end] = cand_next[best_cand];
+    }
+  }
+}
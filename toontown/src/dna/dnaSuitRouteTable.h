@@ -0,0 +1,136 @@
+// Filename: dnaSuitRouteTable.h
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef DNASUITROUTETABLE_H
+#define DNASUITROUTETABLE_H
+
+#include "toontownbase.h"
+#include "dnaSuitPoint.h"
+#include "dnaSuitEdge.h"
+#include "dnaSuitPath.h"
+#include "pvector.h"
+#include "pmap.h"
+#include "numeric_types.h"
+
+class DNAStorage;
+
+////////////////////////////////////////////////////////////////////
+//       Class : DNASuitRouteTable
+// Description : A precomputed table of the shortest route between
+//               every pair of suit points in a DNAStorage, used by
+//               get_suit_path() in place of a breadth-first search
+//               through the suit graph for each new suit.
+//
+//               The points are divided into their connected graphs,
+//               and each graph keeps an n x n matrix giving, for each
+//               point and destination, the next point along the
+//               shortest path between them.  A path is read from the
+//               table one step at a time, so its cost is only the
+//               length of the path.  Each graph also keeps the length
+//               of each of those routes, and, for each minimum length
+//               named by dna-suit-route-min-lengths, the walks of
+//               that length from each point, which find_path() needs
+//               for paths with a minimum length.  The table is not
+//               changed by a query.
+//
+//               The routes obey the same rules as the search: a path
+//               may begin or end at a door point, but never passes
+//               through one.
+////////////////////////////////////////////////////////////////////
+class EXPCL_TOONTOWN DNASuitRouteTable {
+public:
+  DNASuitRouteTable();
+
+  void clear();
+  INLINE bool is_built() const;
+
+  void build(const DNAStorage &store);
+  void update_edge(const DNAStorage &store, const DNASuitEdge *edge);
+
+  bool find_path(const DNASuitPoint *start_point,
+                 const DNASuitPoint *end_point,
+                 int min_length, int max_length,
+                 PT(DNASuitPath) &path) const;
+
+  INLINE int get_num_components() const;
+  size_t get_memory_usage() const;
+
+private:
+  typedef PN_uint16 LocalIndex;
+  enum { no_route = 0xffff, search_route = 0xfffe };
+
+  // The walks that the search makes from one start point before it
+  // begins to look for the end, for find_long_path().  _reached holds
+  // one bit per edge for each step, set if some walk arrives along
+  // that edge at that step.  For each end point, _last_edge is the
+  // last edge of the walk that leads most quickly to it and
+  // _next_point the point that follows, or no_route if there is no
+  // path, or search_route if the table can't tell.
+  class Walks {
+  public:
+    INLINE bool is_reached(int step, int edge) const;
+
+    int _num_words;
+    pvector<PN_uint32> _reached;
+    pvector<LocalIndex> _last_edge;
+    pvector<LocalIndex> _next_point;
+  };
+  typedef pvector<Walks> StartWalks;
+  typedef pmap<int, StartWalks> WalksBySteps;
+
+  // One connected graph of suit points.  The points are numbered
+  // locally from 0, and their out-edges are stored in compressed
+  // rows: the edges from point i are _edge_end[_edge_begin[i]] up to
+  // _edge_end[_edge_begin[i + 1]].  The edges into point i are
+  // likewise listed, in increasing order, from _rev_edge[_rev_begin[i]].
+  class Component {
+  public:
+    INLINE int get_num_points() const;
+    INLINE LocalIndex get_next(int from, int to) const;
+    INLINE LocalIndex get_distance(int from, int to) const;
+
+    void build_routes();
+    const Walks *find_walks(int start, int num_steps) const;
+    void build_walks(Walks &walks, int start, int num_steps) const;
+
+    pvector<int> _points;
+    pvector<bool> _terminal;
+    pvector<int> _edge_begin;
+    pvector<LocalIndex> _edge_start;
+    pvector<LocalIndex> _edge_end;
+    pvector<int> _rev_begin;
+    pvector<LocalIndex> _rev_edge;
+    pvector<LocalIndex> _next;
+    pvector<LocalIndex> _distance;
+
+    // The walks from every start point for each minimum length named
+    // by dna-suit-route-min-lengths, filled in by build_routes().
+    // Queries for any other minimum length are left to the search.
+    WalksBySteps _walks;
+  };
+  typedef pvector<Component> Components;
+
+  class Location {
+  public:
+    int _component;
+    int _local;
+  };
+  typedef pmap<int, Location> Locations;
+
+  void build_component(const DNAStorage &store, int ci);
+  bool find_long_path(const Component &comp, int start, int end,
+                      int min_length, int max_length,
+                      PT(DNASuitPath) &path) const;
+  static void add_route(const Component &comp, int from, int to,
+                        DNASuitPath *path);
+
+  Components _components;
+  Locations _locations;
+  bool _built;
+};
+
+#include "dnaSuitRouteTable.I"
+
+#endif
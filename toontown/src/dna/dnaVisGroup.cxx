@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaVisGroup.h"
+#include "dnaBinary.h"
 #include "dnaStorage.h"
 #include "pandaNode.h"
 #include "pointerTo.h"
@@ -295,6 +296,75 @@ void DNAVisGroup::write(ostream &out, DNAStorage *store, int indent_level) const
 
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAVisGroup::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAVisGroup::
+write_binary(DNABinaryWriter &writer) const {
+  DNAGroup::write_binary(writer);
+
+  writer.add_uint32(_vis_vector.size());
+  pvector<string>::const_iterator vi;
+  for (vi = _vis_vector.begin(); vi != _vis_vector.end(); ++vi) {
+    writer.add_string(*vi);
+  }
+
+  writer.add_uint32(_suit_edge_vector.size());
+  pvector<PT(DNASuitEdge)>::const_iterator ei;
+  for (ei = _suit_edge_vector.begin(); ei != _suit_edge_vector.end(); ++ei) {
+    writer.add_int32((*ei)->get_start_point()->get_index());
+    writer.add_int32((*ei)->get_end_point()->get_index());
+  }
+
+  writer.add_uint32(_battle_cell_vector.size());
+  pvector<PT(DNABattleCell)>::const_iterator ci;
+  for (ci = _battle_cell_vector.begin(); ci != _battle_cell_vector.end(); ++ci) {
+    writer.add_float32((*ci)->get_width());
+    writer.add_float32((*ci)->get_height());
+    writer.add_vec3((*ci)->get_pos());
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAVisGroup::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAVisGroup::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAGroup::fillin_binary(reader, store);
+
+  // As in the parser, the vis group is the current zone for the
+  // buildings within it, and must be stored before its children are
+  // read.
+  reader.set_current_zone(get_name());
+  store->store_DNAVisGroupAI(this);
+
+  PN_uint32 num_vis = reader.get_uint32();
+  for (PN_uint32 i = 0; i < num_vis && !reader.is_error(); ++i) {
+    add_visible(reader.get_string());
+  }
+
+  PN_uint32 num_edges = reader.get_uint32();
+  for (PN_uint32 i = 0; i < num_edges && !reader.is_error(); ++i) {
+    int start_index = reader.get_int32();
+    int end_index = reader.get_int32();
+    add_suit_edge(store->store_suit_edge(start_index, end_index, get_name()));
+  }
+
+  PN_uint32 num_cells = reader.get_uint32();
+  for (PN_uint32 i = 0; i < num_cells && !reader.is_error(); ++i) {
+    float width = reader.get_float32();
+    float height = reader.get_float32();
+    LPoint3f pos = reader.get_vec3();
+    PT(DNABattleCell) cell = new DNABattleCell(width, height, pos);
+    store->store_battle_cell(cell);
+    add_battle_cell(cell);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAVisGroup::make_copy
 //       Access: Public
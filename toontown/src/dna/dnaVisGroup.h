@@ -63,6 +63,10 @@ protected:
   pvector< PT(DNASuitEdge) > _suit_edge_vector;
   pvector< PT(DNABattleCell) > _battle_cell_vector;
 
+public:
+  virtual void write_binary(DNABinaryWriter &writer) const;
+  virtual void fillin_binary(DNABinaryReader &reader, DNAStorage *store);
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "dnaWindow.h"
+#include "dnaBinary.h"
 #include "dnaStorage.h"
 #include "dnaBuildings.h"
 #include "nodePath.h"
@@ -224,6 +225,32 @@ void DNAWindows::write(ostream &out, DNAStorage *store, int indent_level) const
 
 
 
+////////////////////////////////////////////////////////////////////
+//     Function: DNAWindows::write_binary
+//       Access: Public, Virtual
+//  Description: Writes the fields of this group to the .pdna file.
+////////////////////////////////////////////////////////////////////
+void DNAWindows::
+write_binary(DNABinaryWriter &writer) const {
+  DNAGroup::write_binary(writer);
+  writer.add_string(_code);
+  writer.add_int32(_window_count);
+  writer.add_color(_color);
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: DNAWindows::fillin_binary
+//       Access: Public, Virtual
+//  Description: Reads the fields written by write_binary().
+////////////////////////////////////////////////////////////////////
+void DNAWindows::
+fillin_binary(DNABinaryReader &reader, DNAStorage *store) {
+  DNAGroup::fillin_binary(reader, store);
+  _code = reader.get_string();
+  _window_count = reader.get_int32();
+  _color = reader.get_color();
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: DNAWindows::make_copy
 //       Access: Public
@@ -9,8 +9,75 @@
 #include "dnaData.h"
 #include "dnaStorage.h"
 #include "config_util.h"
+#include "dnaBinary.h"
 #include "virtualFileSystem.h"
 
+////////////////////////////////////////////////////////////////////
+//     Function: find_pdna_file
+//  Description: If dna-prefer-binary is set and there is a .pdna file
+//               alongside the indicated .dna file that is at least as
+//               new, returns true and fills in pdna_filename with it.
+////////////////////////////////////////////////////////////////////
+static bool
+find_pdna_file(const Filename &dna_filename, Filename &pdna_filename) {
+  if (!dna_prefer_binary || DNABinary::is_binary_filename(dna_filename)) {
+    return false;
+  }
+
+  pdna_filename = dna_filename;
+  pdna_filename.set_extension("pdna");
+
+  VirtualFileSystem *vfs = VirtualFileSystem::get_global_ptr();
+  PT(VirtualFile) pdna_file = vfs->get_file(pdna_filename, true);
+  if (pdna_file == (VirtualFile *)NULL) {
+    return false;
+  }
+  PT(VirtualFile) dna_file = vfs->get_file(dna_filename, true);
+  if (dna_file != (VirtualFile *)NULL &&
+      pdna_file->get_timestamp() < dna_file->get_timestamp()) {
+    dna_cat.info()
+      << "Ignoring " << pdna_filename << ", which is older than "
+      << dna_filename << "\n";
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: read_dna_data
+//  Description: Reads the indicated file, which has already been
+//               resolved, into the DNAData, from the precompiled
+//               .pdna form if possible.  Returns true on success.
+////////////////////////////////////////////////////////////////////
+static bool
+read_dna_data(DNAData *data, const Filename &dna_filename) {
+  Filename pdna_filename;
+  if (DNABinary::is_binary_filename(dna_filename)) {
+    pdna_filename = dna_filename;
+  } else if (!find_pdna_file(dna_filename, pdna_filename)) {
+    pdna_filename = Filename();
+  }
+
+  if (!pdna_filename.empty()) {
+    dna_cat.info() << "Reading " << pdna_filename << "\n";
+    data->set_dna_filename(pdna_filename);
+    return data->read_pdna(pdna_filename, dna_cat.error(false));
+  }
+
+  dna_cat.info() << "Reading " << dna_filename << "\n";
+
+  VirtualFileSystem *vfs = VirtualFileSystem::get_global_ptr();
+  istream *istr = vfs->open_read_file(dna_filename, true);
+  if (istr == (istream *)NULL) {
+    dna_cat.error()
+      << "Could not open " << dna_filename << " for reading.\n";
+    return false;
+  }
+  bool ok_flag = data->read(*istr);
+  vfs->close_read_file(istr);
+  return ok_flag;
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: load_dna_file
 //  Description: A convenience function.  Loads up the indicated dna
@@ -38,27 +105,13 @@ load_DNA_file(DNAStorage *dna_store,
     }
   }
 
-  dna_cat.info() << "Reading " << dna_filename << "\n";
-
   DNALoader loader;
   loader._data->set_dna_filename(dna_filename);
   loader._data->set_dna_storage(dna_store);
   if (cs != CS_default) {
     loader._data->set_coordinate_system(cs);
   }
-  bool ok_flag;
-
-  VirtualFileSystem *vfs = VirtualFileSystem::get_global_ptr();
-  istream *istr = vfs->open_read_file(dna_filename, true);
-  if (istr == (istream *)NULL) {
-    dna_cat.error()
-      << "Could not open " << dna_filename << " for reading.\n";
-    return (PandaNode *)NULL;
-  }
-  ok_flag = loader._data->read(*istr);
-  vfs->close_read_file(istr);
-
-  if (!ok_flag) {
+  if (!read_dna_data(loader._data, dna_filename)) {
     dna_cat.error() << "Error reading " << dna_filename << "\n";
     return (PandaNode *)NULL;
   }
@@ -86,27 +139,13 @@ load_DNA_file_AI(DNAStorage *dna_store,
     return NULL;
   }
 
-  dna_cat.info() << "Reading " << dna_filename << "\n";
-
   DNALoader loader;
   loader._data->set_dna_filename(dna_filename);
   loader._data->set_dna_storage(dna_store);
   if (cs != CS_default) {
     loader._data->set_coordinate_system(cs);
   }
-  bool ok_flag;
-
-  VirtualFileSystem *vfs = VirtualFileSystem::get_global_ptr();
-  istream *istr = vfs->open_read_file(dna_filename, true);
-  if (istr == (istream *)NULL) {
-    dna_cat.error()
-      << "Could not open " << dna_filename << " for reading.\n";
-    return NULL;
-  }
-  ok_flag = loader._data->read(*istr);
-  vfs->close_read_file(istr);
-
-  if (!ok_flag) {
+  if (!read_dna_data(loader._data, dna_filename)) {
     dna_cat.error() << "Error reading " << dna_filename << "\n";
     return NULL;
   }
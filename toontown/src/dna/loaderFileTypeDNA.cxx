@@ -43,6 +43,18 @@ get_extension() const {
   return "dna";
 }
 
+////////////////////////////////////////////////////////////////////
+//     Function: LoaderFileTypeDNA::get_additional_extensions
+//       Access: Public, Virtual
+//  Description: Returns a space-separated list of extension, in
+//               addition to the one returned by get_extension(), that
+//               are recognized by this loader.
+////////////////////////////////////////////////////////////////////
+string LoaderFileTypeDNA::
+get_additional_extensions() const {
+  return "pdna";
+}
+
 ////////////////////////////////////////////////////////////////////
 //     Function: LoaderFileTypeDNA::resolve_filename
 //       Access: Public, Virtual
@@ -22,6 +22,7 @@ public:
 
   virtual string get_name() const;
   virtual string get_extension() const;
+  virtual string get_additional_extensions() const;
 
   virtual void resolve_filename(Filename &path) const;
   virtual PT(PandaNode) load_file(const Filename &path, const LoaderOptions &options,
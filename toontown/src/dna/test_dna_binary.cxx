@@ -0,0 +1,122 @@
+// Filename: test_dna_binary.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "toontownbase.h"
+#include "dnaData.h"
+#include "dnaStorage.h"
+#include "dnaBinary.h"
+#include "config_dna.h"
+#include "trueClock.h"
+
+#include <stdlib.h>
+
+// This program reads each of the named .dna files, writes it out as a
+// .pdna file, and reads that back in again, reporting the time taken
+// by each read and checking that both produce the same DNAStorage
+// contents.  Run it on the hood files, e.g.
+//
+//   test_dna_binary phase_4/dna/*.dna phase_5/dna/*.dna ...
+//
+// The models and textures named by the files are loaded by both
+// reads; the second read of each will normally find them already in
+// the ModelPool and TexturePool.
+
+static int
+count_groups(DNAGroup *group) {
+  int count = 1;
+  int num_children = group->get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    count += count_groups(group->at(i));
+  }
+  return count;
+}
+
+static bool
+compare(const char *what, int text_count, int binary_count) {
+  if (text_count != binary_count) {
+    nout << "  " << what << ": " << text_count << " from .dna, "
+         << binary_count << " from .pdna\n";
+    return false;
+  }
+  return true;
+}
+
+static bool
+test_file(const Filename &dna_filename, double &text_total,
+          double &binary_total) {
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  DNAStorage text_store;
+  PT(DNAData) text_data = new DNAData("text");
+  text_data->set_dna_filename(dna_filename);
+  text_data->set_dna_storage(&text_store);
+
+  double start = clock->get_short_time();
+  if (!text_data->read(dna_filename)) {
+    nout << "Unable to read " << dna_filename << "\n";
+    return false;
+  }
+  double text_time = clock->get_short_time() - start;
+
+  Filename pdna_filename = Filename::temporary("", "dna", ".pdna");
+  if (!text_data->write_pdna(pdna_filename)) {
+    return false;
+  }
+
+  DNAStorage binary_store;
+  PT(DNAData) binary_data = new DNAData("binary");
+  binary_data->set_dna_filename(pdna_filename);
+  binary_data->set_dna_storage(&binary_store);
+
+  start = clock->get_short_time();
+  bool okflag = binary_data->read_pdna(pdna_filename);
+  double binary_time = clock->get_short_time() - start;
+  pdna_filename.unlink();
+
+  if (!okflag) {
+    nout << "Unable to read back " << dna_filename << "\n";
+    return false;
+  }
+
+  nout << dna_filename << ": " << text_time * 1000.0 << " ms parsed, "
+       << binary_time * 1000.0 << " ms precompiled\n";
+  text_total += text_time;
+  binary_total += binary_time;
+
+  okflag = compare("groups", count_groups(text_data), count_groups(binary_data));
+  okflag = compare("vis groups", text_store.get_num_DNAVisGroupsAI(),
+                   binary_store.get_num_DNAVisGroupsAI()) && okflag;
+  okflag = compare("suit points", text_store.get_num_suit_points(),
+                   binary_store.get_num_suit_points()) && okflag;
+  okflag = compare("block numbers", text_store.get_num_block_numbers(),
+                   binary_store.get_num_block_numbers()) && okflag;
+  okflag = compare("nodes", text_store.get_num_PandaNodes(),
+                   binary_store.get_num_PandaNodes()) && okflag;
+  okflag = compare("load commands", text_data->get_load_commands().size(),
+                   binary_data->get_load_commands().size()) && okflag;
+  return okflag;
+}
+
+int
+main(int argc, char *argv[]) {
+  if (argc < 2) {
+    nout << "Usage: test_dna_binary file.dna [file.dna ...]\n";
+    return 1;
+  }
+
+  double text_total = 0.0;
+  double binary_total = 0.0;
+  bool all_ok = true;
+  for (int i = 1; i < argc; i++) {
+    if (!test_file(Filename::from_os_specific(argv[i]), text_total, binary_total)) {
+      all_ok = false;
+    }
+  }
+
+  nout << "Total: " << text_total * 1000.0 << " ms parsed, "
+       << binary_total * 1000.0 << " ms precompiled\n";
+
+  return all_ok ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+// Filename: test_suit_routes.cxx
+// Created by:  agent (18Oct26)
+//
+////////////////////////////////////////////////////////////////////
+
+#include "toontownbase.h"
+#include "dnaStorage.h"
+#include "dnaSuitRouteTable.h"
+#include "load_dna_file.h"
+#include "config_dna.h"
+#include "trueClock.h"
+#include "string_utils.h"
+
+// This program loads a street's .dna file and asks for suit paths
+// from each of its suit points, once from the route table and once
+// with the breadth-first search, e.g.
+//
+//   test_suit_routes phase_5/dna/toontown_central_2100.dna
+//
+// Each path the table returns is checked step by step against the
+// rules the search follows: it must run from the start point to the
+// end point along the street's edges, be at least min_length points
+// long, never pass through a door point, and never double straight
+// back on itself before its last step.  It must also be exactly as
+// long as the search's path, and the table must find a path whenever
+// the search does.
+//
+// Where several paths share the shortest length, the table and the
+// search may choose different ones; those are counted and reported,
+// but are not errors.  The minimum lengths include the
+// DistributedSuitPlannerAI's MIN_PATH_LEN of 40.  The table is built
+// with walks for 3 and 40; a minimum length of 4 checks that the
+// table leaves any other length to the search.
+
+static const int min_lengths[] = { 2, 3, 4, 40 };
+static const int num_min_lengths = sizeof(min_lengths) / sizeof(int);
+static const int max_length = 300;
+
+// The number of end points asked for from each start point.
+static const int ends_per_start = 16;
+
+class RouteQuery {
+public:
+  PT(DNASuitPoint) _start;
+  PT(DNASuitPoint) _end;
+};
+typedef pvector<RouteQuery> RouteQueries;
+
+////////////////////////////////////////////////////////////////////
+//     Function: check_path
+//  Description: Returns an empty string if the path obeys the rules
+//               of the search, or a description of the first rule it
+//               breaks.
+////////////////////////////////////////////////////////////////////
+static string
+check_path(const DNAStorage &store, const RouteQuery &query,
+           const DNASuitPath *path, int min_length) {
+  int num_points = path->get_num_points();
+  if (num_points < min_length) {
+    return "too short";
+  }
+  if (path->get_point_index(0) != query._start->get_index()) {
+    return "wrong start point";
+  }
+  if (path->get_point_index(num_points - 1) != query._end->get_index()) {
+    return "wrong end point";
+  }
+
+  for (int i = 0; i < num_points - 1; ++i) {
+    int point = path->get_point_index(i);
+    int next_point = path->get_point_index(i + 1);
+
+    PT(DNASuitPath) adjacent =
+      store.get_adjacent_points(store.get_suit_point_with_index(point));
+    int a = 0;
+    while (a < adjacent->get_num_points() &&
+           adjacent->get_point_index(a) != next_point) {
+      ++a;
+    }
+    if (a == adjacent->get_num_points()) {
+      return "no edge from " + format_string(point) + " to " +
+        format_string(next_point);
+    }
+
+    if (i + 1 < num_points - 1) {
+      if (store.get_suit_point_with_index(next_point)->is_terminal()) {
+        return "passes through door point " + format_string(next_point);
+      }
+      if (i > 0 && next_point == path->get_point_index(i - 1)) {
+        return "doubles back at " + format_string(point);
+      }
+    }
+  }
+
+  return string();
+}
+
+////////////////////////////////////////////////////////////////////
+//     Function: run_queries
+//  Description: Asks for each of the paths with the indicated minimum
+//               length from the table and from the search, and checks
+//               the results.  Returns the number of errors.
+////////////////////////////////////////////////////////////////////
+static int
+run_queries(const DNAStorage &store, const RouteQueries &queries,
+            int min_length) {
+  TrueClock *clock = TrueClock::get_global_ptr();
+  int num_queries = queries.size();
+
+  pvector< PT(DNASuitPath) > table_paths;
+  table_paths.reserve(num_queries);
+  dna_suit_routes.set_value(true);
+  double start = clock->get_short_time();
+  RouteQueries::const_iterator qi;
+  for (qi = queries.begin(); qi != queries.end(); ++qi) {
+    table_paths.push_back(store.get_suit_path((*qi)._start, (*qi)._end,
+                                              min_length, max_length));
+  }
+  double table_time = clock->get_short_time() - start;
+
+  pvector< PT(DNASuitPath) > search_paths;
+  search_paths.reserve(num_queries);
+  dna_suit_routes.set_value(false);
+  start = clock->get_short_time();
+  for (qi = queries.begin(); qi != queries.end(); ++qi) {
+    search_paths.push_back(store.get_suit_path((*qi)._start, (*qi)._end,
+                                               min_length, max_length));
+  }
+  double search_time = clock->get_short_time() - start;
+  dna_suit_routes.set_value(true);
+
+  int num_errors = 0;
+  int num_same = 0;
+  int num_different = 0;
+  for (int i = 0; i < num_queries; ++i) {
+    const DNASuitPath *table_path = table_paths[i];
+    const DNASuitPath *search_path = search_paths[i];
+
+    string error;
+    if (table_path == (DNASuitPath *)NULL) {
+      if (search_path != (DNASuitPath *)NULL) {
+        error = "no path from table, search found " + format_string(*search_path);
+      }
+    } else if (search_path == (DNASuitPath *)NULL) {
+      error = "no path from search";
+    } else {
+      error = check_path(store, queries[i], table_path, min_length);
+      if (error.empty() &&
+          table_path->get_num_points() != search_path->get_num_points()) {
+        error = "search found " + format_string(*search_path);
+      }
+    }
+
+    if (!error.empty()) {
+      nout << "  " << *queries[i]._start << " to " << *queries[i]._end
+           << ", min length " << min_length << ": ";
+      if (table_path != (DNASuitPath *)NULL) {
+        nout << *table_path << ": ";
+      }
+      nout << error << "\n";
+      ++num_errors;
+
+    } else if (table_path != (DNASuitPath *)NULL) {
+      int p = 0;
+      while (p < table_path->get_num_points() &&
+             table_path->get_point_index(p) == search_path->get_point_index(p)) {
+        ++p;
+      }
+      if (p == table_path->get_num_points()) {
+        ++num_same;
+      } else {
+        ++num_different;
+      }
+    }
+  }
+
+  nout << "min length " << min_length << ": " << num_same
+       << " paths identical, " << num_different
+       << " different but as short, " << num_errors << " errors; "
+       << table_time * 1000000.0 / num_queries << " us per table query, "
+       << search_time * 1000000.0 / num_queries << " us per search\n";
+  return num_errors;
+}
+
+int
+main(int argc, char *argv[]) {
+  if (argc != 2) {
+    nout << "Usage: test_suit_routes street.dna\n";
+    return 1;
+  }
+
+  DNAStorage store;
+  if (load_DNA_file_AI(&store, argv[1]) == (DNAData *)NULL) {
+    nout << "Unable to read " << argv[1] << "\n";
+    return 1;
+  }
+
+  dna_suit_routes.set_value(true);
+  dna_suit_route_min_lengths.set_string_value("3 40");
+  store.discover_continuity();
+  nout << store.get_num_suit_points() << " suit points in "
+       << store.get_suit_routes().get_num_components() << " graphs, "
+       << store.get_suit_routes().get_memory_usage() << " bytes\n";
+
+  // Ask for paths from every point to an even spread of the others.
+  int num_points = store.get_num_suit_points();
+  int stride = max(num_points / ends_per_start, 1);
+  RouteQueries queries;
+  for (int i = 0; i < num_points; ++i) {
+    for (int j = i % stride; j < num_points; j += stride) {
+      RouteQuery query;
+      query._start = store.get_suit_point_at_index(i);
+      query._end = store.get_suit_point_at_index(j);
+      queries.push_back(query);
+    }
+  }
+  if (queries.empty()) {
+    nout << "No suit points.\n";
+    return 1;
+  }
+
+  int num_errors = 0;
+  PT(DNASuitPath) path;
+  if (store.get_suit_routes().find_path(queries[0]._start, queries[0]._end,
+                                        4, max_length, path)) {
+    nout << "  the table answered a query for min length 4\n";
+    ++num_errors;
+  }
+
+  size_t memory = store.get_suit_routes().get_memory_usage();
+  for (int m = 0; m < num_min_lengths; ++m) {
+    num_errors += run_queries(store, queries, min_lengths[m]);
+  }
+
+  if (store.get_suit_routes().get_memory_usage() != memory) {
+    nout << "  the table grew during the queries\n";
+    ++num_errors;
+  }
+  return (num_errors == 0) ? 0 : 1;
+}
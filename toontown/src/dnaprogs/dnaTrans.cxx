@@ -17,6 +17,8 @@
 ////////////////////////////////////////////////////////////////////
 
 #include "load_dna_file.h"
+#include "dnaBinary.h"
+#include "config_dna.h"
 #include "filename.h"
 #include "config_linmath.h"
 
@@ -54,6 +56,7 @@ show_usage() {
   cerr
     << "\nUsage:\n"
     << "  dna-trans [opts] -o output.dna input.dna\n"
+    << "  dna-trans [opts] -o output.pdna input.dna\n"
     << "  dna-trans -h\n\n";
 }
 
@@ -63,6 +66,10 @@ void show_help() {
     << "dna-trans can be used to read a Toontown DNA file, check it for valid\n"
     << "syntax, and output an essentially equivalent DNA file.\n\n"
 
+    << "If the output filename ends in .pdna, a precompiled binary DNA file is\n"
+    << "written instead.  load_DNA_file() will load this in place of the\n"
+    << "original .dna file, much more quickly, when it is found alongside it.\n\n"
+
     << "Options:\n\n"
 
     << "  -hpr\n"
@@ -123,12 +130,25 @@ main(int argc, char *argv[]) {
 
   Filename input_filename = Filename::from_os_specific(argv[1]);
 
+  // Always read the file that was named, even if there is a .pdna
+  // file alongside it.
+  dna_prefer_binary.set_value(false);
+
   DNAStorage dna_store;
   PT(DNAData) dna_data = load_DNA_file_AI(&dna_store, input_filename);
-
-  if (!dna_data->write_dna(output_filename, cerr, &dna_store)) {
+  if (dna_data == (DNAData *)NULL) {
     exit(1);
   }
 
+  if (DNABinary::is_binary_filename(output_filename)) {
+    if (!dna_data->write_pdna(output_filename, cerr)) {
+      exit(1);
+    }
+  } else {
+    if (!dna_data->write_dna(output_filename, cerr, &dna_store)) {
+      exit(1);
+    }
+  }
+
   return (0);
 }